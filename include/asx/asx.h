@@ -48,5 +48,6 @@
 /* Runtime (walking skeleton — bd-ix8.8) */
 #include <asx/runtime/runtime.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/instance.h>
 
 #endif /* ASX_ASX_H */
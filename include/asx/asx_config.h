@@ -68,6 +68,40 @@
   #define ASX_DETERMINISTIC 1
 #endif
 
+/* Thread-local storage class for the per-thread current runtime
+ * instance (asx/runtime/instance.h). Empty where the toolchain or
+ * profile has no TLS; all threads then share one current instance. */
+#ifndef ASX_THREAD_LOCAL
+  #if defined(ASX_PROFILE_FREESTANDING) || defined(ASX_PROFILE_EMBEDDED_ROUTER)
+    #define ASX_THREAD_LOCAL
+  #elif defined(_MSC_VER)
+    #define ASX_THREAD_LOCAL __declspec(thread)
+  #elif defined(__GNUC__) || defined(__clang__)
+    #define ASX_THREAD_LOCAL __thread
+  #else
+    #define ASX_THREAD_LOCAL
+  #endif
+#endif
+
+/* Cache line size used to keep producer- and consumer-written fields
+ * of shared structures apart, and a struct attribute aligning a type
+ * to it (placed between `struct` and the tag). ASX_CACHE_ALIGNED is
+ * empty where the toolchain has no alignment attribute; objects of
+ * such types must then be placed on an ASX_CACHE_LINE boundary by the
+ * caller for the separation to hold. */
+#ifndef ASX_CACHE_LINE
+  #define ASX_CACHE_LINE 64
+#endif
+#ifndef ASX_CACHE_ALIGNED
+  #if defined(_MSC_VER)
+    #define ASX_CACHE_ALIGNED __declspec(align(ASX_CACHE_LINE))
+  #elif defined(__GNUC__) || defined(__clang__)
+    #define ASX_CACHE_ALIGNED __attribute__((aligned(ASX_CACHE_LINE)))
+  #else
+    #define ASX_CACHE_ALIGNED
+  #endif
+#endif
+
 /* ------------------------------------------------------------------ */
 /* Resource classes                                                     */
 /*                                                                     */
@@ -274,6 +308,20 @@ typedef enum {
     ASX_WAIT_SLEEP     = 2
 } asx_wait_policy;
 
+/* Idle strategy (resource-plane only): how the scheduler waits once
+ * every live task is parked. Phases run in order and each ends early
+ * on a due wake deadline or reactor readiness:
+ *   spin  — busy-poll the clock with a CPU pause for up to spin_ns,
+ *   yield — up to yield_count zero-timeout reactor polls,
+ *   park  — one reactor wait of up to park_timeout_ms, shortened to
+ *           the earliest wake deadline.
+ * Zero disables a phase; yield and park need a reactor hook. */
+typedef struct {
+    uint64_t spin_ns;
+    uint32_t yield_count;
+    uint32_t park_timeout_ms;
+} asx_idle_strategy;
+
 /* Obligation leak response policy */
 typedef enum {
     ASX_LEAK_PANIC   = 0,
@@ -359,7 +407,9 @@ ASX_API asx_status asx_runtime_random_u64(uint64_t *out_value);
  * Returns ASX_E_HOOK_MISSING if no reactor hook installed. */
 ASX_API asx_status asx_runtime_reactor_wait(uint32_t timeout_ms, uint32_t *out_ready_count, uint64_t logical_step);
 /* Write a log message at the given severity level.
- * Returns ASX_E_HOOK_MISSING if no log hook installed. */
+ * Returns ASX_E_HOOK_MISSING if no log hook installed. With a log ring
+ * attached (asx/runtime/log_ring.h) the message is queued instead and
+ * ASX_E_RESOURCE_EXHAUSTED reports a full ring. */
 ASX_API asx_status asx_runtime_log_write(int level, const char *message);
 
 #endif /* ASX_CONFIG_H */
@@ -35,6 +35,8 @@ typedef uint64_t asx_task_id;
 typedef uint64_t asx_obligation_id;
 typedef uint64_t asx_timer_id;
 typedef uint64_t asx_channel_id;
+typedef uint64_t asx_broadcast_id;
+typedef uint64_t asx_subscriber_id;
 
 /* Sentinel value for invalid/uninitialized handles */
 #define ASX_INVALID_ID ((uint64_t)0)
@@ -50,6 +52,8 @@ typedef uint64_t asx_channel_id;
 #define ASX_TYPE_CANCEL_WITNESS  ((uint16_t)0x0004)
 #define ASX_TYPE_TIMER           ((uint16_t)0x0005)
 #define ASX_TYPE_CHANNEL         ((uint16_t)0x0006)
+#define ASX_TYPE_BROADCAST       ((uint16_t)0x0007)
+#define ASX_TYPE_SUBSCRIBER      ((uint16_t)0x0008)
 
 /* ------------------------------------------------------------------ */
 /* Handle packing/unpacking helpers                                   */
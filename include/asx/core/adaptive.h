@@ -9,6 +9,9 @@
  * From plan section 6.11: no adaptive controller ships without fallback
  * mode and replayable decision logs.
  *
+ * Policy and ledger are per runtime instance: calls act on the calling
+ * thread's current instance (asx/runtime/instance.h).
+ *
  * SPDX-License-Identifier: MIT
  */
 
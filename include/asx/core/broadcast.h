@@ -0,0 +1,132 @@
+/*
+ * asx/core/broadcast.h — bounded single-producer broadcast channel
+ *
+ * Fan-out without copies: the producer writes each message once into
+ * a ring, and every subscriber reads it through its own cursor. The
+ * ring retains messages until the slowest subscriber has read them.
+ *
+ * A full ring is handled by the overload policy given at creation
+ * (hft_instrument.h), evaluated on the slowest subscriber's lag:
+ *   REJECT       — the send fails with ASX_E_ADMISSION_CLOSED
+ *   BACKPRESSURE — the send fails with ASX_E_WOULD_BLOCK; retry later
+ *   SHED_OLDEST  — the oldest messages (policy shed_max, at least one
+ *                  when full) are dropped; lagging cursors skip past
+ *                  them and each subscriber is told how many it missed
+ * Nothing is dropped without being reported: try_recv returns the
+ * count missed since the last call, and the stats count every
+ * rejected, deferred and shed message.
+ *
+ * Messages are uint64_t tokens, as for the MPSC channel. Walking
+ * skeleton: single-threaded, non-blocking.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_CORE_BROADCAST_H
+#define ASX_CORE_BROADCAST_H
+
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/runtime/hft_instrument.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Capacity limits (walking skeleton: fixed-size arenas)              */
+/* ------------------------------------------------------------------ */
+
+#define ASX_MAX_BROADCASTS             4u
+#define ASX_BROADCAST_MAX_CAPACITY     64u
+#define ASX_BROADCAST_MAX_SUBSCRIBERS  16u
+
+/* ------------------------------------------------------------------ */
+/* Producer-side counters                                             */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    uint64_t sent;      /* messages written to the ring */
+    uint64_t rejected;  /* sends refused (REJECT) */
+    uint64_t deferred;  /* sends refused until readers catch up
+                           (BACKPRESSURE) */
+    uint64_t shed;      /* messages dropped unread (SHED_OLDEST) */
+    uint32_t max_lag;   /* largest slowest-subscriber lag at a send */
+} asx_broadcast_stats;
+
+/* ------------------------------------------------------------------ */
+/* Broadcast lifecycle                                                */
+/* ------------------------------------------------------------------ */
+
+/* Create a broadcast channel within a region. capacity must be > 0
+ * and <= ASX_BROADCAST_MAX_CAPACITY. policy is copied; NULL means
+ * REJECT once the ring is full. A policy threshold_pct must be in
+ * 1..100.
+ * Returns ASX_OK and sets *out_id, ASX_E_INVALID_ARGUMENT for bad
+ * arguments, ASX_E_RESOURCE_EXHAUSTED if all slots are in use. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_create(
+    asx_region_id region, uint32_t capacity,
+    const asx_overload_policy *policy, asx_broadcast_id *out_id);
+
+/* Close the producer side. Subscribers read what is retained, then
+ * get ASX_E_DISCONNECTED. Returns ASX_E_INVALID_STATE if already
+ * closed. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_close(asx_broadcast_id id);
+
+/* Add a subscriber. It sees messages sent after this call.
+ * Returns ASX_OK and sets *out_sub, ASX_E_INVALID_STATE if the
+ * producer closed, ASX_E_RESOURCE_EXHAUSTED if the broadcast has
+ * ASX_BROADCAST_MAX_SUBSCRIBERS subscribers. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_subscribe(
+    asx_broadcast_id id, asx_subscriber_id *out_sub);
+
+/* Remove a subscriber; the messages only it still held are released.
+ * The handle becomes stale. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_unsubscribe(
+    asx_subscriber_id sub);
+
+/* ------------------------------------------------------------------ */
+/* Send / receive                                                     */
+/* ------------------------------------------------------------------ */
+
+/* Write value once for every current subscriber, applying the
+ * overload policy if the slowest subscriber lags (see above).
+ * Returns ASX_OK (also when older messages were shed),
+ * ASX_E_ADMISSION_CLOSED or ASX_E_WOULD_BLOCK under the policy,
+ * ASX_E_DISCONNECTED if there are no subscribers (not written),
+ * ASX_E_INVALID_STATE if the producer closed. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_send(asx_broadcast_id id,
+                                                   uint64_t value);
+
+/* Read the subscriber's next message. If out_missed is not NULL it
+ * receives the number of messages shed past this subscriber since
+ * the previous report (0 normally), whatever the return status.
+ * Returns ASX_OK, ASX_E_WOULD_BLOCK if caught up, ASX_E_DISCONNECTED
+ * if caught up and the producer closed. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_try_recv(
+    asx_subscriber_id sub, uint64_t *out_value, uint64_t *out_missed);
+
+/* Report a subscriber's lag without consuming anything: *out_pending
+ * messages retained and unread, *out_missed shed and not yet reported
+ * by try_recv. Either pointer may be NULL. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_lag(asx_subscriber_id sub,
+                                                  uint32_t *out_pending,
+                                                  uint64_t *out_missed);
+
+/* Copy the producer-side counters. */
+ASX_API ASX_MUST_USE asx_status asx_broadcast_get_stats(
+    asx_broadcast_id id, asx_broadcast_stats *out);
+
+/* ------------------------------------------------------------------ */
+/* Reset (test support)                                               */
+/* ------------------------------------------------------------------ */
+
+/* Reset all broadcast state. For tests only. */
+ASX_API void asx_broadcast_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_CORE_BROADCAST_H */
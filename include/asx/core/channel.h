@@ -32,8 +32,27 @@ extern "C" {
 /* ------------------------------------------------------------------ */
 
 #define ASX_MAX_CHANNELS         16u
-#define ASX_CHANNEL_MAX_CAPACITY 64u
 #define ASX_CHANNEL_MAX_WAITERS  32u
+#define ASX_CHANNEL_SELECT_MAX   ASX_MAX_CHANNELS
+
+/* Ring storage is sized per channel: capacity rounded up to a power of
+ * two, so index wrapping is a mask. Tunable at build time:
+ *   ASX_CHANNEL_MAX_CAPACITY  — largest capacity a channel may have
+ *   ASX_CHANNEL_RESERVE_SLOTS — per-instance static reserve, in
+ *                               messages (a power of two, or 0 for
+ *                               none) that rings are carved from;
+ *                               beyond it rings come from the
+ *                               allocator hook (if unsealed)
+ * The default reserve is 256 messages (2 KiB per instance): enough for
+ * a handful of small channels after the allocator is sealed. Builds
+ * that never seal can set it to 0 and take every ring from the hook;
+ * builds that create large channels after sealing must raise it. */
+#ifndef ASX_CHANNEL_MAX_CAPACITY
+#define ASX_CHANNEL_MAX_CAPACITY 1024u
+#endif
+#ifndef ASX_CHANNEL_RESERVE_SLOTS
+#define ASX_CHANNEL_RESERVE_SLOTS 256u
+#endif
 
 /* ------------------------------------------------------------------ */
 /* Channel lifecycle states                                           */
@@ -62,7 +81,8 @@ typedef struct asx_send_permit {
 
 /* Create a bounded channel within a region.
  * capacity must be > 0 and <= ASX_CHANNEL_MAX_CAPACITY.
- * Returns ASX_OK and sets *out_id on success. */
+ * Returns ASX_OK and sets *out_id on success, or
+ * ASX_E_RESOURCE_EXHAUSTED if no slot or ring storage is available. */
 ASX_API ASX_MUST_USE asx_status asx_channel_create(asx_region_id region,
                                                     uint32_t capacity,
                                                     asx_channel_id *out_id);
@@ -93,6 +113,15 @@ ASX_API ASX_MUST_USE asx_status asx_channel_queue_len(asx_channel_id id,
 ASX_API ASX_MUST_USE asx_status asx_channel_reserved_count(asx_channel_id id,
                                                             uint32_t *out);
 
+/* Change the capacity of a quiescent channel: no outstanding permits
+ * and no more queued messages than the new capacity. Queued messages
+ * keep their order. Returns ASX_E_INVALID_ARGUMENT for a capacity of 0
+ * or above ASX_CHANNEL_MAX_CAPACITY, ASX_E_INVALID_STATE if the
+ * channel is not quiescent, ASX_E_RESOURCE_EXHAUSTED if no ring
+ * storage is available (the channel is then unchanged). */
+ASX_API ASX_MUST_USE asx_status asx_channel_set_capacity(asx_channel_id id,
+                                                          uint32_t capacity);
+
 /* ------------------------------------------------------------------ */
 /* Two-phase send protocol                                            */
 /* ------------------------------------------------------------------ */
@@ -126,6 +155,37 @@ ASX_API void asx_send_permit_abort(asx_send_permit *permit);
 ASX_API ASX_MUST_USE asx_status asx_channel_try_recv(asx_channel_id id,
                                                       uint64_t *out_value);
 
+/* ------------------------------------------------------------------ */
+/* Select                                                             */
+/* ------------------------------------------------------------------ */
+
+/* Receive from whichever of count channels is ready, from inside a
+ * poll function. Each region keeps a readiness bitmap of its channels,
+ * so select costs one load per region involved plus a find-first-set,
+ * not a try_recv per channel. Ties go to the lowest channel slot, so
+ * the choice is deterministic; *out_index is the position in ids of
+ * the channel received from (the first, if listed twice).
+ *
+ * If none is ready, self is registered as receive waiter on all of
+ * them and parked; ASX_E_PENDING is returned and the poll function
+ * should return it. The first channel to become ready (a send, or the
+ * sender closing) wakes self and drops the other registrations; the
+ * next select then finds it. Pass ASX_INVALID_ID as self to select
+ * without parking.
+ *
+ * Returns ASX_OK with *out_value received, ASX_E_DISCONNECTED if the
+ *   chosen channel's sender closed and its queue is empty,
+ *   ASX_E_PENDING if self was parked, ASX_E_WOULD_BLOCK if nothing is
+ *   ready and self is ASX_INVALID_ID, ASX_E_INVALID_ARGUMENT for NULL
+ *   pointers or count not in 1..ASX_CHANNEL_SELECT_MAX, a channel or
+ *   task lookup error, ASX_E_INVALID_STATE if another parked task is
+ *   already waiting on one of the channels. */
+ASX_API ASX_MUST_USE asx_status asx_channel_select(asx_task_id self,
+                                                    const asx_channel_id *ids,
+                                                    uint32_t count,
+                                                    uint32_t *out_index,
+                                                    uint64_t *out_value);
+
 /* ------------------------------------------------------------------ */
 /* Reset (test support)                                               */
 /* ------------------------------------------------------------------ */
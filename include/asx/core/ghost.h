@@ -97,6 +97,12 @@ ASX_API void asx_ghost_obligation_reserved(asx_obligation_id id);
  * double-resolution. */
 ASX_API void asx_ghost_obligation_resolved(asx_obligation_id id);
 
+/* Track resolution of a batch of obligations in one pass over the
+ * tracking table. ids must be sorted ascending. Records violations
+ * as asx_ghost_obligation_resolved does. */
+ASX_API void asx_ghost_obligations_resolved(const asx_obligation_id *ids,
+                                            uint32_t count);
+
 /* Scan for leaked obligations (reserved but never resolved) in a region.
  * Returns the count of leaked obligations found and records violations.
  * No ASX_MUST_USE — primarily a side-effect operation. */
@@ -179,6 +185,7 @@ ASX_API ASX_MUST_USE uint32_t asx_ghost_determinism_event_count(void);
 #define asx_ghost_check_obligation_transition(id,f,t) (ASX_OK)
 #define asx_ghost_obligation_reserved(id)           ((void)0)
 #define asx_ghost_obligation_resolved(id)           ((void)0)
+#define asx_ghost_obligations_resolved(ids,n)       ((void)(ids), (void)(n))
 #define asx_ghost_check_obligation_leaks(r)         ((uint32_t)0)
 #define asx_ghost_violation_count()                  ((uint32_t)0)
 #define asx_ghost_violation_get(i,o)                ((int)0)
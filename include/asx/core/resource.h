@@ -80,7 +80,10 @@ ASX_API ASX_MUST_USE asx_status asx_resource_admit(
 /* Per-region resource queries                                         */
 /* ------------------------------------------------------------------ */
 
-/* Remaining capture arena bytes for a specific region.
+/* Largest captured-state size the region can allocate right now:
+ * the smaller of its remaining quota and what its current chunk plus
+ * the chunk pool (static reserve, pooled chunks, allocator hook) can
+ * actually supply.
  * Returns ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE on invalid region. */
 ASX_API ASX_MUST_USE asx_status asx_resource_region_capture_remaining(
     asx_region_id region, uint32_t *out_bytes);
@@ -0,0 +1,110 @@
+/*
+ * asx/runtime/admission.h — closed-loop admission control
+ *
+ * Ties the overload policies (hft_instrument.h, overload_catalog.h) to
+ * the paths that admit work. With a controller enabled on a region,
+ * asx_task_spawn into it and asx_channel_try_reserve on its channels
+ * evaluate the region's policy against live load before admitting:
+ *   spawn    live tasks of the region against config.task_capacity
+ *   reserve  queued plus reserved messages against channel capacity
+ * and once a signal is in overload apply the policy's mode:
+ *   REJECT       — ASX_E_ADMISSION_CLOSED
+ *   BACKPRESSURE — ASX_E_WOULD_BLOCK; asx_admission_wait parks the
+ *                  caller until the region's signals have released
+ *   SHED_OLDEST  — on spawn, admit after cancelling up to shed_max
+ *                  of the region's oldest live tasks (ASX_CANCEL_RESOURCE,
+ *                  origin the region); on reserve, defer as BACKPRESSURE:
+ *                  queued messages were committed by their senders and
+ *                  are never dropped
+ *
+ * Hysteresis: a signal enters overload at policy.threshold_pct and
+ * leaves it only once its load falls below release_pct, re-checked as
+ * tasks retire and messages are received, so a burst hovering at the
+ * threshold does not flap between admitting and refusing.
+ *
+ * Each decision taken in overload, and each release, is logged to the
+ * adaptive evidence ledger (core/adaptive.h) under the surface
+ * "admission", with the load and thresholds as evidence. The ledger
+ * is the one of the instance owning the region, so shards admitting
+ * on their own threads never share it.
+ *
+ * Regions without a controller pay one flag test per spawn/reserve.
+ * Controllers are not carried across asx_runtime_reset or warm restart.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_ADMISSION_H
+#define ASX_RUNTIME_ADMISSION_H
+
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/runtime/hft_instrument.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Default gap between engage and release thresholds, in percent. */
+#define ASX_ADMISSION_RELEASE_BAND 10u
+
+/* Adaptive ledger actions recorded for admission decisions. */
+#define ASX_ADMISSION_ACTION_ADMIT         0u
+#define ASX_ADMISSION_ACTION_REJECT        1u
+#define ASX_ADMISSION_ACTION_SHED_OLDEST   2u
+#define ASX_ADMISSION_ACTION_BACKPRESSURE  3u
+
+typedef struct {
+    asx_overload_policy policy;        /* mode, threshold_pct, shed_max */
+    uint32_t            release_pct;   /* leave overload below this
+                                          (1..policy.threshold_pct) */
+    uint32_t            task_capacity; /* live tasks the region is
+                                          sized for (> 0) */
+} asx_admission_config;
+
+typedef struct {
+    uint64_t admitted;     /* spawns and reserves let through */
+    uint64_t rejected;     /* refused (REJECT) */
+    uint64_t deferred;     /* refused until load releases (BACKPRESSURE,
+                              SHED_OLDEST on reserve) */
+    uint64_t shed;         /* tasks cancelled */
+    uint32_t engagements;  /* times a signal entered overload */
+    int      engaged;      /* 1 while any signal is in overload */
+} asx_admission_stats;
+
+/* Defaults: the overload catalog policy of the active profile,
+ * release_pct ASX_ADMISSION_RELEASE_BAND below its threshold (at
+ * least 1), task_capacity ASX_MAX_TASKS. */
+ASX_API void asx_admission_config_init(asx_admission_config *cfg);
+
+/* Enable (or reconfigure) the controller of a region; NULL cfg uses
+ * the defaults. Reconfiguring keeps the stats and overload state.
+ * Returns ASX_E_INVALID_ARGUMENT for a bad config, NOT_FOUND /
+ * STALE_HANDLE for the region. */
+ASX_API ASX_MUST_USE asx_status asx_admission_enable(
+    asx_region_id region, const asx_admission_config *cfg);
+
+/* Remove a region's controller, waking a task parked in
+ * asx_admission_wait. ASX_E_INVALID_STATE if none is enabled. */
+ASX_API ASX_MUST_USE asx_status asx_admission_disable(asx_region_id region);
+
+/* From inside a poll function, after a BACKPRESSURE refusal: returns
+ * ASX_OK if no signal of the region is in overload (or it has no
+ * controller), otherwise parks self until one releases and returns
+ * ASX_E_PENDING. One task may wait per region: ASX_E_INVALID_STATE if
+ * another is parked there. */
+ASX_API ASX_MUST_USE asx_status asx_admission_wait(asx_task_id self,
+                                                   asx_region_id region);
+
+/* Counters of a region's controller. ASX_E_INVALID_STATE if none is
+ * enabled. */
+ASX_API ASX_MUST_USE asx_status asx_admission_get_stats(
+    asx_region_id region, asx_admission_stats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_ADMISSION_H */
@@ -200,7 +200,8 @@ ASX_API void asx_auto_compliance_evaluate(
 /* -------------------------------------------------------------------
  * Global automotive instrumentation state
  *
- * Singleton for per-process automotive metrics. Reset via
+ * One set of automotive metrics per runtime instance: calls act on
+ * the calling thread's current instance (see instance.h). Reset via
  * asx_auto_instrument_reset().
  * ------------------------------------------------------------------- */
 
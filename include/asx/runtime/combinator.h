@@ -0,0 +1,156 @@
+/*
+ * asx/runtime/combinator.h — join/race/select/timeout/retry combinators
+ *
+ * Structured combinators over the task kernel (DS-C02). Each
+ * combinator is itself a task, spawned with region-owned captured
+ * state, that owns a fixed set of child tasks in the same region.
+ *
+ * Semantics:
+ *   - The combinator parks while children run and is woken by child
+ *     completion; it never re-polls children itself.
+ *   - The combinator completes only after all its children have
+ *     completed (no orphaned children).
+ *   - Losers (race/select) and expired children (timeout) are
+ *     cancelled with origin_region/origin_task set to the combinator.
+ *   - Cancelling the combinator forwards the cancel kind to all live
+ *     children with the combinator as origin.
+ *   - The combinator's outcome (asx_task_get_outcome) is:
+ *       join    — asx_outcome_join over all children
+ *       race    — outcome of the first child to complete
+ *       select  — outcome of the first child to complete OK, or the
+ *                 join over all children if none succeeded
+ *       timeout — child outcome (CANCELLED if the deadline expired)
+ *       retry   — outcome of the last attempt
+ *     or CANCELLED if the combinator itself was cancelled.
+ *
+ * "First" is deterministic: children are polled in arena order, so
+ * ties within a round resolve to the lowest child index.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_COMBINATOR_H
+#define ASX_RUNTIME_COMBINATOR_H
+
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/runtime/runtime.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum children per combinator (and attempts per retry). */
+#define ASX_COMBINATOR_MAX_CHILDREN 8u
+
+/* Child task description: poll function plus its user data. */
+typedef struct {
+    asx_task_poll_fn poll_fn;
+    void            *user_data;
+} asx_task_spec;
+
+/* -------------------------------------------------------------------
+ * Spawn
+ *
+ * All spawn functions share these rules:
+ *   Preconditions: region is a valid OPEN region; out_id not NULL;
+ *     every spec has a non-NULL poll_fn.
+ *   Postconditions: on success the combinator task and its children
+ *     exist in region; *out_id is the combinator task.
+ *   Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT for bad
+ *     arguments, ASX_E_REGION_NOT_OPEN / ASX_E_REGION_POISONED for
+ *     region state, ASX_E_RESOURCE_EXHAUSTED if the task arena or
+ *     capture arena cannot hold the combinator and all its children,
+ *     or the region's admission status (admission.h) if it refuses
+ *     one of them. On any failure nothing is left to run: tasks
+ *     already spawned for the call complete CANCELLED without being
+ *     polled, and their arena slots stay used.
+ *   Thread-safety: not thread-safe; single-threaded mode only.
+ * ------------------------------------------------------------------- */
+
+/* Run all specs concurrently; complete when all have completed. */
+ASX_API ASX_MUST_USE asx_status asx_join_spawn(asx_region_id region,
+                                               const asx_task_spec *specs,
+                                               uint32_t count,
+                                               asx_task_id *out_id);
+
+/* Run all specs; the first to complete (any outcome) wins and the
+ * rest are cancelled with ASX_CANCEL_RACE_LOST. */
+ASX_API ASX_MUST_USE asx_status asx_race_spawn(asx_region_id region,
+                                               const asx_task_spec *specs,
+                                               uint32_t count,
+                                               asx_task_id *out_id);
+
+/* Run all specs; the first to complete with an OK outcome wins and
+ * the rest are cancelled with ASX_CANCEL_RACE_LOST. Failed children
+ * do not win. */
+ASX_API ASX_MUST_USE asx_status asx_select_spawn(asx_region_id region,
+                                                 const asx_task_spec *specs,
+                                                 uint32_t count,
+                                                 asx_task_id *out_id);
+
+/* Run spec until it completes or the runtime clock reaches deadline
+ * (absolute, asx_runtime_now_ns time base); on expiry the child is
+ * cancelled with ASX_CANCEL_TIMEOUT. The combinator parks with a wake
+ * deadline, so expiry is noticed without re-polling. */
+ASX_API ASX_MUST_USE asx_status asx_timeout_spawn(asx_region_id region,
+                                                  const asx_task_spec *spec,
+                                                  asx_time deadline,
+                                                  asx_task_id *out_id);
+
+/* Run spec; while an attempt completes with an ERR outcome, spawn a
+ * fresh attempt (same poll_fn and user_data) up to max_attempts in
+ * total. Retrying stops once the region stops admitting tasks.
+ * max_attempts must be in [1, ASX_COMBINATOR_MAX_CHILDREN]. */
+ASX_API ASX_MUST_USE asx_status asx_retry_spawn(asx_region_id region,
+                                                const asx_task_spec *spec,
+                                                uint32_t max_attempts,
+                                                asx_task_id *out_id);
+
+/* -------------------------------------------------------------------
+ * Queries
+ *
+ * Queries remain valid after the combinator completes, for as long as
+ * its region has not been closed.
+ * ------------------------------------------------------------------- */
+
+/* Number of children spawned so far (retry: attempts so far).
+ *
+ * Preconditions: combinator is a task returned by a *_spawn above;
+ *   out_count not NULL.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if combinator is not a
+ *   combinator task or out_count is NULL, ASX_E_NOT_FOUND /
+ *   ASX_E_STALE_HANDLE for bad handles, ASX_E_INVALID_STATE once its
+ *   region has closed.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_combinator_child_count(
+    asx_task_id combinator, uint32_t *out_count);
+
+/* Task handle of child index (spec order; retry: attempt order).
+ *
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if out_child is NULL, index is
+ *   out of range or combinator is not a combinator task,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for bad handles,
+ *   ASX_E_INVALID_STATE once its region has closed.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_combinator_child(
+    asx_task_id combinator, uint32_t index, asx_task_id *out_child);
+
+/* Index of the winning child of a race or select.
+ *
+ * Returns ASX_OK with *out_index set once a winner is decided,
+ *   ASX_E_NOT_FOUND if no winner (yet, or select with no success),
+ *   ASX_E_INVALID_ARGUMENT if out_index is NULL or combinator is not
+ *   a race/select task, ASX_E_INVALID_STATE once its region has
+ *   closed.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_combinator_winner(
+    asx_task_id combinator, uint32_t *out_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_COMBINATOR_H */
@@ -6,6 +6,12 @@
  * The hash chain digests event (kind, entity, sequence) tuples, producing
  * a single 64-bit fingerprint that captures the full execution ordering.
  *
+ * The log is a view over the trace ring (trace.h), not a separate
+ * store: runtime trace records of the mapped kinds appear here, and
+ * asx_event_emit writes a trace record. parent_id is the record's aux
+ * payload (the region for open, spawn and create; the round for
+ * scheduler events).
+ *
  * SPDX-License-Identifier: MIT
  */
 
@@ -54,18 +60,26 @@ typedef struct {
     asx_status     status;       /* ASX_OK for success events */
 } asx_event_record;
 
+/* Events are retained while their trace record is (ASX_TRACE_CAPACITY
+ * records per trace); the count keeps running past it. */
 enum {
-    ASX_EVENT_LOG_CAPACITY = 512u
+    ASX_EVENT_LOG_CAPACITY = 1024u
 };
 
+/* Returned by asx_event_emit for an out-of-range kind */
+#define ASX_EVENT_SEQ_INVALID 0xFFFFFFFFu
+
 /* ------------------------------------------------------------------ */
 /* Event log API                                                       */
 /* ------------------------------------------------------------------ */
 
-/* Reset event log and hash chain. Call before scenario execution. */
+/* Restart the event log and hash chain at the current end of the
+ * trace. Call before scenario execution. asx_trace_reset also resets
+ * the log. */
 ASX_API void asx_event_log_reset(void);
 
-/* Emit an event into the log. Returns the sequence number assigned. */
+/* Emit an event into the log (one trace record). Returns the sequence
+ * number assigned, or ASX_EVENT_SEQ_INVALID for an unknown kind. */
 ASX_API uint32_t asx_event_emit(asx_event_kind kind,
                                 uint64_t entity_id,
                                 uint64_t parent_id,
@@ -81,7 +95,7 @@ ASX_API int asx_event_log_get(uint32_t index, asx_event_record *out);
 /* Hash chain for deterministic replay verification                    */
 /* ------------------------------------------------------------------ */
 
-/* Read the running hash chain digest. */
+/* Read the running hash chain digest over the retained events. */
 ASX_API uint64_t asx_event_hash_chain(void);
 
 /* ------------------------------------------------------------------ */
@@ -204,7 +204,8 @@ ASX_API void asx_hft_gate_evaluate(const asx_hft_gate *gate,
 /* -------------------------------------------------------------------
  * Global HFT instrumentation state
  *
- * Singleton for per-process HFT metrics. Reset via
+ * One set of HFT metrics per runtime instance: calls act on the
+ * calling thread's current instance (see instance.h). Reset via
  * asx_hft_instrument_reset().
  * ------------------------------------------------------------------- */
 
@@ -220,6 +221,14 @@ ASX_API asx_hft_jitter_tracker *asx_hft_sched_jitter(void);
 /* Record a scheduler poll latency sample (convenience wrapper). */
 ASX_API void asx_hft_record_poll_latency(uint64_t ns);
 
+/* Get pointer to the global idle wake-up latency histogram. Samples
+ * are the lateness of an idle wait's end past the earliest task wake
+ * deadline (see asx_scheduler_set_idle_strategy). */
+ASX_API asx_hft_histogram *asx_hft_wake_histogram(void);
+
+/* Record an idle wake-up latency sample. */
+ASX_API void asx_hft_record_wake_latency(uint64_t ns);
+
 #ifdef __cplusplus
 }
 #endif
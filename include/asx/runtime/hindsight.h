@@ -59,6 +59,9 @@ typedef enum {
     /* Timer resolution (0x50–0x5F) */
     ASX_ND_TIMER_COALESCE    = 0x50,  /* timer coalescing decision */
 
+    /* External wake boundary (0x60–0x6F) */
+    ASX_ND_WAKE_DRAIN        = 0x60,  /* wake handle inbox drained */
+
     /* Sentinel */
     ASX_ND_KIND_COUNT
 } asx_nd_event_kind;
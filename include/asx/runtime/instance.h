@@ -0,0 +1,270 @@
+/*
+ * asx/runtime/instance.h — runtime instances (asx_runtime)
+ *
+ * An asx_runtime owns everything a runtime needs: the region, task and
+ * obligation arenas, capture-chunk reserve, hooks and fault injection,
+ * scheduler policy and event log, channels, the timer wheel, and the
+ * trace and hindsight rings. Independent instances share nothing, so
+ * one can run per core with no synchronization between them.
+ *
+ * The existing global API operates on the calling thread's current
+ * instance, which is the default instance until asx_runtime_enter()
+ * selects another. The asx_rt_* variants below take the instance
+ * explicitly: each makes rt current for the duration of the call,
+ * so task poll functions invoked from asx_rt_scheduler_run() may keep
+ * using the global API. Passing rt == NULL selects the default
+ * instance. Anything without an asx_rt_* variant is reached by
+ * entering the instance around the call.
+ *
+ * Not per instance: ghost monitors, the error ledger and the affinity
+ * current domain are per thread; the affinity binding table, adaptive
+ * policy, telemetry and profile instrumentation are process-wide.
+ *
+ * Thread-safety: the current instance is thread-local where the
+ * toolchain supports it (ASX_THREAD_LOCAL); an instance itself must
+ * only be used by one thread at a time.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_INSTANCE_H
+#define ASX_RUNTIME_INSTANCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/asx_config.h>
+#include <asx/core/channel.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/trace.h>
+#include <asx/time/timer_wheel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct asx_runtime asx_runtime;
+
+/* -------------------------------------------------------------------
+ * Lifecycle
+ * ------------------------------------------------------------------- */
+
+/* Create an independent runtime instance. Its storage is obtained
+ * from hooks->allocator (libc defaults when hooks is NULL), which
+ * then becomes the instance's installed hook table.
+ *
+ * Preconditions: out not NULL; cls < ASX_CLASS_COUNT.
+ * Postconditions: the instance is in the asx_runtime_reset() state
+ *   with hooks installed; the calling thread's current instance is
+ *   unchanged.
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT for bad arguments or hooks without
+ *     malloc_fn/free_fn,
+ *   the asx_runtime_hooks_validate() status for hooks that fail
+ *     validation in the build's determinism mode,
+ *   ASX_E_RESOURCE_EXHAUSTED if the allocation fails.
+ * Thread-safety: thread-safe. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_create(
+    const asx_runtime_hooks *hooks, asx_resource_class cls,
+    asx_runtime **out);
+
+/* Release an instance created by asx_runtime_create. Live regions
+ * and tasks are discarded without running their destructors. If rt
+ * is current on the calling thread, the default instance becomes
+ * current. NULL and the default instance are ignored.
+ * Thread-safety: rt must not be in use by any thread. */
+ASX_API void asx_runtime_destroy(asx_runtime *rt);
+
+/* The process-wide default instance (statically allocated). */
+ASX_API asx_runtime *asx_runtime_default(void);
+
+/* The calling thread's current instance. Never NULL. */
+ASX_API asx_runtime *asx_runtime_current(void);
+
+/* Make rt (NULL = default) current on the calling thread and return
+ * the previously current instance, so scopes nest:
+ *   asx_runtime *prev = asx_runtime_enter(rt);
+ *   ... global API calls act on rt ...
+ *   asx_runtime_enter(prev); */
+ASX_API asx_runtime *asx_runtime_enter(asx_runtime *rt);
+
+/* Resource class the instance was created with (ASX_CLASS_R2 for the
+ * default instance and for rt == NULL). */
+ASX_API asx_resource_class asx_runtime_resource_class(const asx_runtime *rt);
+
+/* -------------------------------------------------------------------
+ * Context-taking variants
+ *
+ * asx_rt_<name>(rt, ...) behaves exactly like asx_<name>(...) run on
+ * instance rt (hook calls: asx_runtime_<name>). See the global
+ * declarations for contracts.
+ * ------------------------------------------------------------------- */
+
+/* Regions */
+ASX_API ASX_MUST_USE asx_status asx_rt_region_open(asx_runtime *rt,
+                                                   asx_region_id *out_id);
+ASX_API ASX_MUST_USE asx_status asx_rt_region_open_child(asx_runtime *rt,
+                                                         asx_region_id parent,
+                                                         asx_region_id *out_id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_region_get_parent(asx_runtime *rt, asx_region_id id,
+                         asx_region_id *out_parent);
+ASX_API ASX_MUST_USE asx_status asx_rt_region_close(asx_runtime *rt,
+                                                    asx_region_id id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_region_get_state(asx_runtime *rt, asx_region_id id,
+                        asx_region_state *out_state);
+ASX_API ASX_MUST_USE asx_status asx_rt_region_poison(asx_runtime *rt,
+                                                     asx_region_id id);
+ASX_API ASX_MUST_USE asx_status asx_rt_region_is_poisoned(asx_runtime *rt,
+                                                          asx_region_id id,
+                                                          int *out);
+ASX_API ASX_MUST_USE asx_status asx_rt_region_contain_fault(asx_runtime *rt,
+                                                            asx_region_id id,
+                                                            asx_status fault);
+ASX_API ASX_MUST_USE asx_status asx_rt_region_drain(asx_runtime *rt,
+                                                    asx_region_id id,
+                                                    asx_budget *budget);
+ASX_API ASX_MUST_USE asx_status asx_rt_quiescence_check(asx_runtime *rt,
+                                                        asx_region_id id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_quiescence_check_subtree(asx_runtime *rt, asx_region_id id);
+
+/* Tasks */
+ASX_API ASX_MUST_USE asx_status asx_rt_task_spawn(asx_runtime *rt,
+                                                  asx_region_id region,
+                                                  asx_task_poll_fn poll_fn,
+                                                  void *user_data,
+                                                  asx_task_id *out_id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_task_spawn_captured(asx_runtime *rt, asx_region_id region,
+                           asx_task_poll_fn poll_fn, uint32_t state_size,
+                           asx_task_state_dtor_fn state_dtor,
+                           asx_task_id *out_id, void **out_state);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_task_get_state(asx_runtime *rt, asx_task_id id,
+                      asx_task_state *out_state);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_task_get_outcome(asx_runtime *rt, asx_task_id id,
+                        asx_outcome *out_outcome);
+ASX_API ASX_MUST_USE asx_status asx_rt_task_await(asx_runtime *rt,
+                                                  asx_task_id self,
+                                                  asx_task_id child);
+ASX_API ASX_MUST_USE asx_status asx_rt_task_cancel(asx_runtime *rt,
+                                                   asx_task_id id,
+                                                   asx_cancel_kind kind);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_task_cancel_with_origin(asx_runtime *rt, asx_task_id id,
+                               asx_cancel_kind kind,
+                               asx_region_id origin_region,
+                               asx_task_id origin_task);
+ASX_API uint32_t asx_rt_cancel_propagate(asx_runtime *rt, asx_region_id region,
+                                         asx_cancel_kind kind);
+ASX_API ASX_MUST_USE asx_status asx_rt_checkpoint(asx_runtime *rt,
+                                                  asx_task_id self,
+                                                  asx_checkpoint_result *out);
+ASX_API ASX_MUST_USE asx_status asx_rt_task_finalize(asx_runtime *rt,
+                                                     asx_task_id id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_task_get_cancel_phase(asx_runtime *rt, asx_task_id id,
+                             asx_cancel_phase *out);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_task_set_budget(asx_runtime *rt, asx_task_id id,
+                       const asx_budget *budget);
+ASX_API ASX_MUST_USE asx_status asx_rt_task_report_cost(asx_runtime *rt,
+                                                        asx_task_id self,
+                                                        uint64_t cost);
+
+/* Obligations */
+ASX_API ASX_MUST_USE asx_status
+asx_rt_obligation_reserve(asx_runtime *rt, asx_region_id region,
+                          asx_obligation_id *out_id);
+ASX_API ASX_MUST_USE asx_status asx_rt_obligation_commit(asx_runtime *rt,
+                                                         asx_obligation_id id);
+ASX_API ASX_MUST_USE asx_status asx_rt_obligation_abort(asx_runtime *rt,
+                                                        asx_obligation_id id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_obligation_get_state(asx_runtime *rt, asx_obligation_id id,
+                            asx_obligation_state *out_state);
+
+/* Scheduler */
+ASX_API ASX_MUST_USE asx_status asx_rt_scheduler_run(asx_runtime *rt,
+                                                     asx_region_id region,
+                                                     asx_budget *budget);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_scheduler_set_policy(asx_runtime *rt, asx_sched_policy policy);
+ASX_API asx_sched_policy asx_rt_scheduler_get_policy(asx_runtime *rt);
+ASX_API void asx_rt_scheduler_set_deadline_monitor(asx_runtime *rt,
+                                                   int enabled);
+ASX_API void asx_rt_scheduler_set_idle_strategy(
+    asx_runtime *rt, const asx_idle_strategy *strategy);
+ASX_API uint32_t asx_rt_scheduler_event_count(asx_runtime *rt);
+ASX_API int asx_rt_scheduler_event_get(asx_runtime *rt, uint32_t index,
+                                       asx_scheduler_event *out);
+ASX_API void asx_rt_scheduler_event_reset(asx_runtime *rt);
+
+/* Channels */
+ASX_API ASX_MUST_USE asx_status asx_rt_channel_create(asx_runtime *rt,
+                                                      asx_region_id region,
+                                                      uint32_t capacity,
+                                                      asx_channel_id *out_id);
+ASX_API ASX_MUST_USE asx_status asx_rt_channel_close_sender(asx_runtime *rt,
+                                                            asx_channel_id id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_channel_close_receiver(asx_runtime *rt, asx_channel_id id);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_channel_get_state(asx_runtime *rt, asx_channel_id id,
+                         asx_channel_state *out);
+ASX_API ASX_MUST_USE asx_status asx_rt_channel_queue_len(asx_runtime *rt,
+                                                         asx_channel_id id,
+                                                         uint32_t *out);
+ASX_API ASX_MUST_USE asx_status asx_rt_channel_reserved_count(asx_runtime *rt,
+                                                              asx_channel_id id,
+                                                              uint32_t *out);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_channel_set_capacity(asx_runtime *rt, asx_channel_id id,
+                            uint32_t capacity);
+ASX_API ASX_MUST_USE asx_status
+asx_rt_channel_try_reserve(asx_runtime *rt, asx_channel_id id,
+                           asx_send_permit *out);
+ASX_API ASX_MUST_USE asx_status asx_rt_send_permit_send(asx_runtime *rt,
+                                                        asx_send_permit *permit,
+                                                        uint64_t value);
+ASX_API void asx_rt_send_permit_abort(asx_runtime *rt,
+                                      asx_send_permit *permit);
+ASX_API ASX_MUST_USE asx_status asx_rt_channel_try_recv(asx_runtime *rt,
+                                                        asx_channel_id id,
+                                                        uint64_t *out_value);
+ASX_API void asx_rt_channel_reset(asx_runtime *rt);
+
+/* Trace */
+ASX_API void asx_rt_trace_emit(asx_runtime *rt, asx_trace_event_kind kind,
+                               uint64_t entity_id, uint64_t aux);
+ASX_API uint32_t asx_rt_trace_event_count(asx_runtime *rt);
+ASX_API int asx_rt_trace_event_get(asx_runtime *rt, uint32_t index,
+                                   asx_trace_event *out);
+ASX_API void asx_rt_trace_reset(asx_runtime *rt);
+ASX_API uint64_t asx_rt_trace_digest(asx_runtime *rt);
+ASX_API asx_status asx_rt_snapshot_capture(asx_runtime *rt,
+                                           asx_snapshot_buffer *out);
+
+/* Hooks */
+ASX_API asx_status asx_rt_set_hooks(asx_runtime *rt,
+                                    const asx_runtime_hooks *hooks);
+ASX_API asx_status asx_rt_seal_allocator(asx_runtime *rt);
+ASX_API asx_status asx_rt_alloc(asx_runtime *rt, size_t size, void **out_ptr);
+ASX_API asx_status asx_rt_free(asx_runtime *rt, void *ptr);
+ASX_API asx_status asx_rt_now_ns(asx_runtime *rt, asx_time *out_now);
+ASX_API void asx_rt_reset(asx_runtime *rt);
+
+/* Timer wheel owned by rt (NULL = default), as asx_timer_wheel_global()
+ * returns for the current instance. */
+ASX_API asx_timer_wheel *asx_rt_timer_wheel(asx_runtime *rt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_INSTANCE_H */
@@ -0,0 +1,138 @@
+/*
+ * asx/runtime/log_ring.h — asynchronous bounded log pipeline
+ *
+ * With a log ring attached to an instance, asx_runtime_log_write no
+ * longer calls the log sink on the caller's thread. It copies the
+ * message into a fixed-size record of a bounded lock-free MPSC ring
+ * and returns. A drainer writes the records to the sink in order:
+ * either a background thread (asx_posix_log_drainer_start), or a
+ * bounded drain step that asx_scheduler_run takes at the start of
+ * each round (drain_per_round), or explicit asx_log_ring_drain calls.
+ *
+ * Overflow never blocks and never loses records silently
+ * (ASX_FORBID_SILENT_DROP, overload_catalog.h): a full ring rejects
+ * the record with ASX_E_RESOURCE_EXHAUSTED and counts it, and the
+ * next drain writes one ASX_LOG_RING_DROP_LEVEL record reporting how
+ * many were dropped since the last report. Messages longer than
+ * ASX_LOG_RECORD_BYTES - 1 are truncated and counted.
+ *
+ * Thread-safety: asx_log_ring_push (and so asx_runtime_log_write on
+ * any instance sharing the ring) is safe from any thread. Draining
+ * must be done by one thread at a time.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_LOG_RING_H
+#define ASX_RUNTIME_LOG_RING_H
+
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------
+ * Limits
+ * ------------------------------------------------------------------- */
+
+#define ASX_LOG_RING_CAPACITY  256u  /* records; power of two */
+#define ASX_LOG_RECORD_BYTES   120u  /* message bytes incl. terminator */
+
+/* Level of the synthetic record reporting dropped records */
+#define ASX_LOG_RING_DROP_LEVEL 2
+
+/* -------------------------------------------------------------------
+ * Types (caller-owned; treat fields as private)
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    volatile uint32_t seq;      /* slot turn (bounded MPMC sequence) */
+    int32_t           level;
+    char              msg[ASX_LOG_RECORD_BYTES];
+} asx_log_record;
+
+typedef struct {
+    volatile uint32_t enqueue_pos;
+    uint8_t           pad_enqueue_[60];
+    volatile uint32_t dropped;     /* producers: records rejected */
+    volatile uint32_t truncated;   /* producers: messages cut */
+    uint8_t           pad_counts_[56];
+    uint32_t          dequeue_pos; /* drainer only */
+    uint32_t          reported_drops;
+    uint32_t          written;
+    uint32_t          drain_per_round; /* scheduler drain step; 0 = off */
+    asx_log_hooks     sink;
+    asx_log_record    records[ASX_LOG_RING_CAPACITY];
+} asx_log_ring;
+
+typedef struct {
+    uint32_t written;    /* records delivered to the sink */
+    uint32_t dropped;    /* records rejected on a full ring */
+    uint32_t truncated;  /* messages cut to ASX_LOG_RECORD_BYTES - 1 */
+    uint32_t pending;    /* records waiting for a drain */
+} asx_log_ring_stats;
+
+/* -------------------------------------------------------------------
+ * Ring lifecycle and I/O
+ * ------------------------------------------------------------------- */
+
+/* Initialize an empty ring delivering to sink (copied).
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL arguments or a
+ * sink without write_fn. */
+ASX_API ASX_MUST_USE asx_status asx_log_ring_init(asx_log_ring *ring,
+                                                  const asx_log_hooks *sink);
+
+/* Copy one record into the ring. Lock-free; never blocks.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT for a NULL ring,
+ * ASX_E_RESOURCE_EXHAUSTED if the ring is full (counted as dropped). */
+ASX_API ASX_MUST_USE asx_status asx_log_ring_push(asx_log_ring *ring,
+                                                  int level,
+                                                  const char *message);
+
+/* Write up to max records (0 = all pending) to the sink, FIFO, then
+ * report new drops. Returns the number of ring records written. */
+ASX_API uint32_t asx_log_ring_drain(asx_log_ring *ring, uint32_t max);
+
+ASX_API ASX_MUST_USE asx_status asx_log_ring_stats_get(
+    const asx_log_ring *ring, asx_log_ring_stats *out);
+
+/* -------------------------------------------------------------------
+ * Instance attachment
+ * ------------------------------------------------------------------- */
+
+/* Route the current instance's asx_runtime_log_write into ring
+ * (NULL detaches and restores synchronous writes). With
+ * drain_per_round > 0 the scheduler drains that many records at the
+ * start of every round. */
+ASX_API void asx_runtime_set_log_ring(asx_log_ring *ring,
+                                      uint32_t drain_per_round);
+
+/* The current instance's attached ring, or NULL. */
+ASX_API asx_log_ring *asx_runtime_get_log_ring(void);
+
+#if defined(ASX_PROFILE_POSIX)
+/* Background drainer: a pthread draining the ring every period_us
+ * until stopped; the final stop drains what is left. */
+typedef struct {
+    asx_log_ring *ring;
+    uint32_t      period_us;
+    volatile int  stop;
+    void         *thread;
+} asx_posix_log_drainer;
+
+/* Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL arguments or a zero
+ * period, ASX_E_RESOURCE_EXHAUSTED if the thread cannot start. */
+ASX_API ASX_MUST_USE asx_status asx_posix_log_drainer_start(
+    asx_posix_log_drainer *d, asx_log_ring *ring, uint32_t period_us);
+ASX_API void asx_posix_log_drainer_stop(asx_posix_log_drainer *d);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_LOG_RING_H */
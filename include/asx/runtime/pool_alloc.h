@@ -0,0 +1,142 @@
+/*
+ * asx/runtime/pool_alloc.h — size-class pool allocator hooks
+ *
+ * A built-in asx_allocator_hooks implementation for small, high-churn
+ * objects (codec buffers, trace spill, dynamic arenas). Requests are
+ * rounded up to one of ASX_POOL_CLASS_COUNT power-of-two size classes
+ * and served from per-class free lists in O(1); freed blocks go back
+ * onto their class list, never to the backing allocator.
+ *
+ * Blocks are carved from slabs obtained from a backing allocator
+ * (the runtime's default allocator hooks unless given). Slabs and
+ * requests larger than the largest class, which go to the backing
+ * allocator individually, are charged to one reserve sized by
+ * resource class; once the reserve is spent and a class list is
+ * empty, allocation fails (asx_runtime_alloc reports
+ * ASX_E_RESOURCE_EXHAUSTED). Freeing an oversize block returns its
+ * bytes to the reserve; slabs are kept until destroy.
+ *
+ * Free lists and the reserve live in the asx_pool_allocator instance,
+ * which is the hook ctx. Give each thread (or runtime instance) its
+ * own pool for thread-local caches; each then has its own reserve,
+ * so the process-wide bound is the sum. A pool is not thread-safe.
+ *
+ * Installation:
+ *   asx_pool_allocator pool;
+ *   asx_runtime_hooks hooks;
+ *   asx_runtime_hooks_init(&hooks);
+ *   asx_pool_allocator_init(&pool, ASX_CLASS_R2, NULL);
+ *   asx_pool_allocator_bind(&pool, &hooks.allocator);
+ *   asx_runtime_set_hooks(&hooks);
+ *
+ * Seal and fault injection (ASX_FAULT_ALLOC_FAIL) are enforced by
+ * asx_runtime_alloc before the pool is reached, so they apply
+ * unchanged; frees remain valid after sealing.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_POOL_ALLOC_H
+#define ASX_RUNTIME_POOL_ALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------
+ * Geometry
+ * ------------------------------------------------------------------- */
+
+#define ASX_POOL_CLASS_COUNT     8u      /* 16, 32, ..., 2048 bytes */
+#define ASX_POOL_MIN_BLOCK       16u
+#define ASX_POOL_MAX_BLOCK       2048u
+#define ASX_POOL_SLAB_BYTES      16384u  /* backing request per refill */
+
+/* Class index returned for requests above ASX_POOL_MAX_BLOCK. */
+#define ASX_POOL_CLASS_OVERSIZE  ASX_POOL_CLASS_COUNT
+
+/* Per-class occupancy counters */
+typedef struct {
+    uint32_t block_size;   /* payload bytes per block */
+    uint32_t in_use;       /* blocks handed out */
+    uint32_t cached;       /* blocks on the free list */
+    uint32_t peak_in_use;  /* high-water mark of in_use */
+    uint64_t allocs;       /* successful allocations */
+    uint64_t failures;     /* allocations refused (reserve spent) */
+} asx_pool_class_stats;
+
+/* Pool instance (hook ctx). Treat fields as private. */
+typedef struct {
+    asx_allocator_hooks  backing;        /* slab and oversize source */
+    uint32_t             reserve_limit;  /* bytes of backing allowed */
+    uint32_t             reserve_used;   /* slab + live oversize bytes */
+    void                *slabs;          /* slab chain for destroy */
+    uint8_t             *carve;          /* next uncarved byte */
+    uint32_t             carve_left;     /* bytes left in current slab */
+    void                *free_list[ASX_POOL_CLASS_COUNT];
+    asx_pool_class_stats stats[ASX_POOL_CLASS_COUNT];
+    uint32_t             oversize_in_use;
+    uint32_t             oversize_failures; /* refused: reserve spent */
+    int                  initialized;
+} asx_pool_allocator;
+
+/* -------------------------------------------------------------------
+ * Lifecycle
+ * ------------------------------------------------------------------- */
+
+/* Reserve bytes a pool may carve for a resource class
+ * (R1: 32 KiB, R2: 256 KiB, R3: 2 MiB). Returns 0 for unknown cls. */
+ASX_API uint32_t asx_pool_reserve_for_class(asx_resource_class cls);
+
+/* Initialize a pool. backing may be NULL to use the default allocator
+ * of asx_runtime_hooks_init; otherwise it must provide malloc_fn and
+ * free_fn.
+ *
+ * Preconditions: pool not NULL; cls < ASX_CLASS_COUNT.
+ * Postconditions: pool is empty; no memory is obtained until the
+ *   first allocation.
+ * Returns ASX_OK, or ASX_E_INVALID_ARGUMENT for bad arguments.
+ * Thread-safety: not thread-safe. */
+ASX_API ASX_MUST_USE asx_status asx_pool_allocator_init(
+    asx_pool_allocator *pool, asx_resource_class cls,
+    const asx_allocator_hooks *backing);
+
+/* Return every slab to the backing allocator. Blocks still in use
+ * become invalid. Safe to call on a never-used pool. */
+ASX_API void asx_pool_allocator_destroy(asx_pool_allocator *pool);
+
+/* Fill an asx_allocator_hooks table that routes through pool.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if an argument is NULL,
+ * ASX_E_INVALID_STATE if pool was not initialized. */
+ASX_API ASX_MUST_USE asx_status asx_pool_allocator_bind(
+    asx_pool_allocator *pool, asx_allocator_hooks *out_hooks);
+
+/* -------------------------------------------------------------------
+ * Diagnostics
+ * ------------------------------------------------------------------- */
+
+/* Size class serving a request of size bytes, or
+ * ASX_POOL_CLASS_OVERSIZE if it passes through to the backing. */
+ASX_API uint32_t asx_pool_class_for_size(size_t size);
+
+/* Occupancy counters for one class.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if pool/out is NULL or
+ * class_index >= ASX_POOL_CLASS_COUNT. */
+ASX_API ASX_MUST_USE asx_status asx_pool_class_stats_get(
+    const asx_pool_allocator *pool, uint32_t class_index,
+    asx_pool_class_stats *out);
+
+/* Reserve bytes not yet charged to slabs or live oversize blocks. */
+ASX_API uint32_t asx_pool_reserve_remaining(const asx_pool_allocator *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_POOL_ALLOC_H */
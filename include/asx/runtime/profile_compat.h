@@ -151,6 +151,16 @@ ASX_API asx_status asx_profile_get_descriptor_for_class(
     asx_resource_class cls,
     asx_profile_descriptor *desc);
 
+/* Fill *out with the profile's idle strategy (operational, like the
+ * wait policy). Spin-heavy for HFT, short spin then park for
+ * EMBEDDED_ROUTER, park-first for AUTOMOTIVE, a brief spin then
+ * yield and park elsewhere. Install it with
+ * asx_scheduler_set_idle_strategy.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out is NULL
+ * or id is out of range. */
+ASX_API asx_status asx_profile_get_idle_strategy(asx_profile_id id,
+                                                  asx_idle_strategy *out);
+
 /* Classify a profile property as operational or semantic. */
 ASX_API asx_property_class asx_profile_property_class(asx_profile_property prop);
 
@@ -0,0 +1,107 @@
+/*
+ * asx/runtime/restart.h — warm restart from a runtime state image
+ *
+ * asx_runtime_save writes the live state of the current instance to a
+ * self-contained image: regions (tree, poison, cleanup stacks), tasks
+ * (state, cancellation, captured state), obligations, channel queues
+ * and the timer wheel. asx_runtime_restore rebuilds that state on an
+ * instance of a new process, so work resumes where it stopped instead
+ * of being rebuilt or replayed. Restore cost follows the live state,
+ * not the length of the history that produced it.
+ *
+ * Slots and generations are kept, so every handle issued before the
+ * save (region, task, obligation, channel, timer) stays valid after
+ * the restore. The trace and event history is not carried: the
+ * restored instance starts a fresh trace.
+ *
+ * Pointers cannot cross a process boundary. Each one the image needs
+ * is named by a binding: an entry of the table registered with
+ * asx_runtime_set_restart_bindings, identified by a stable id chosen
+ * by the application. Save fails with ASX_E_NOT_FOUND if a pointer
+ * has no binding. Matching, at save time:
+ *   task        poll_fn and state_dtor equal, and data equals the
+ *               task's user_data (not compared for captured tasks,
+ *               whose state is copied into the image byte for byte;
+ *               completed tasks are never polled and need none);
+ *   cleanup     cleanup_fn and data equal;
+ *   timer       data equals waker_data (NULL needs no binding).
+ * Restore re-binds each pointer from the entry with the saved id.
+ * Cancel reason messages and cause chains are not carried, nor are
+ * asx_channel_select registrations: a task parked in select is
+ * re-polled by the scheduler's idle-round wake. Broadcast channels
+ * and admission controllers are not carried either; restore leaves
+ * none open and no region controlled.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_RESTART_H
+#define ASX_RUNTIME_RESTART_H
+
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/runtime/runtime.h>
+#include <asx/core/cleanup.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Bindings                                                            */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    uint32_t               id;          /* stable across builds; 0 is reserved */
+    asx_task_poll_fn       poll_fn;     /* task entry point, or NULL */
+    asx_task_state_dtor_fn state_dtor;  /* captured-state destructor, or NULL */
+    asx_cleanup_fn         cleanup_fn;  /* region cleanup callback, or NULL */
+    void                  *data;        /* user_data / cleanup or waker data */
+} asx_restart_binding;
+
+/* Register the binding table of the current instance (borrowed; must
+ * outlive the instance or the next call). NULL/0 clears it. */
+ASX_API void asx_runtime_set_restart_bindings(const asx_restart_binding *table,
+                                              uint32_t count);
+
+/* ------------------------------------------------------------------ */
+/* Image                                                               */
+/*                                                                     */
+/* Little-endian; varint = unsigned LEB128.                            */
+/*   magic "ASXw" (0x41535877), version byte, state digest (8 bytes),  */
+/*   then regions, region tree order, tasks, obligations, channels     */
+/*   and timers, then an FNV-1a checksum (8 bytes) of everything       */
+/*   before it. Each arena section is varint(extent) followed by one   */
+/*   record per slot below the extent: alive byte, varint generation,  */
+/*   and the slot's fields when alive.                                 */
+/* ------------------------------------------------------------------ */
+
+#define ASX_RESTART_MAGIC   0x41535877u  /* "ASXw" */
+#define ASX_RESTART_VERSION 1u
+
+/* Save the current instance's state. *out_len receives the bytes
+ * written, or needed on ASX_E_BUFFER_TOO_SMALL (buf is then left
+ * untouched). Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL
+ * arguments, ASX_E_NOT_FOUND if a pointer has no binding. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_save(uint8_t *buf,
+                                                 uint32_t capacity,
+                                                 uint32_t *out_len);
+
+/* Replace the current instance's state with a saved image. The image
+ * is validated in full (structure, checksum, bindings, capture
+ * quotas) before anything changes; on ASX_E_INVALID_ARGUMENT (NULL or
+ * malformed image) or ASX_E_NOT_FOUND (a binding id missing from the
+ * table) the instance is untouched. ASX_E_RESOURCE_EXHAUSTED (capture
+ * or channel ring memory) leaves the instance reset, with no region,
+ * task, channel, broadcast or timer live, as does ASX_E_REPLAY_MISMATCH
+ * if the rebuilt state does not match the digest saved with the
+ * image. Returns ASX_OK on success. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_restore(const uint8_t *buf,
+                                                    uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_RESTART_H */
@@ -17,6 +17,7 @@
 #include <asx/asx_ids.h>
 #include <asx/core/outcome.h>
 #include <asx/core/budget.h>
+#include <asx/asx_config.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,10 +28,27 @@ extern "C" {
  * Phase 3 will replace with dynamic hook-backed allocation.
  * ------------------------------------------------------------------- */
 
-#define ASX_MAX_REGIONS      8
+#define ASX_MAX_REGIONS      32
 #define ASX_MAX_TASKS        64
 #define ASX_MAX_OBLIGATIONS  128
+
+/* Captured task state is bump-allocated from chunks drawn from a
+ * global pool; region drain returns the region's chunks to the pool.
+ *   ASX_REGION_CAPTURE_ARENA_BYTES — per-region capture quota
+ *   ASX_CAPTURE_CHUNK_BYTES        — payload of a standard chunk;
+ *                                    larger states get a sized chunk
+ *   ASX_CAPTURE_RESERVE_BYTES      — static reserve seeding the pool;
+ *                                    beyond it chunks come from the
+ *                                    allocator hook (if unsealed) */
+#ifndef ASX_REGION_CAPTURE_ARENA_BYTES
 #define ASX_REGION_CAPTURE_ARENA_BYTES 16384u
+#endif
+#ifndef ASX_CAPTURE_CHUNK_BYTES
+#define ASX_CAPTURE_CHUNK_BYTES 4096u
+#endif
+#ifndef ASX_CAPTURE_RESERVE_BYTES
+#define ASX_CAPTURE_RESERVE_BYTES 65536u
+#endif
 
 /* -------------------------------------------------------------------
  * Task poll function signature
@@ -89,6 +107,39 @@ typedef struct asx_co_state {
  * See: API_MISUSE_CATALOG.md § Region Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_region_open(asx_region_id *out_id);
 
+/* Open a new region as a child of parent.
+ *
+ * Child regions form a tree: draining or cancelling a region cascades
+ * to every descendant, and a parent cannot reach CLOSED until all of
+ * its children have. Children are visited in open order.
+ *
+ * Preconditions: out_id must not be NULL; parent must be a valid region
+ *   handle in OPEN state.
+ * Postconditions: on success, *out_id holds a valid region handle in OPEN
+ *   state, linked under parent.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out_id is NULL,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE if parent is invalid,
+ *   ASX_E_REGION_POISONED if parent is poisoned,
+ *   ASX_E_REGION_NOT_OPEN if parent is not OPEN,
+ *   ASX_E_RESOURCE_EXHAUSTED if the region arena is full.
+ * Ownership: the child is drained as part of its parent's drain, or may
+ *   be drained on its own earlier.
+ * Thread-safety: not thread-safe; single-threaded mode only.
+ * See: API_MISUSE_CATALOG.md § Region Lifecycle. */
+ASX_API ASX_MUST_USE asx_status asx_region_open_child(asx_region_id parent,
+                                                      asx_region_id *out_id);
+
+/* Query the parent of a region.
+ *
+ * Preconditions: out_parent must not be NULL; id must be a valid handle.
+ * Postconditions: *out_parent holds the parent handle, or ASX_INVALID_ID
+ *   for a root region or a child that has already reached CLOSED.
+ * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if out_parent is NULL,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE if id is invalid.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_region_get_parent(asx_region_id id,
+                                                      asx_region_id *out_parent);
+
 /* Initiate region close. Transitions: Open → Closing → Closed.
  *
  * Preconditions: id must be a valid region handle for an OPEN region.
@@ -229,6 +280,24 @@ ASX_API ASX_MUST_USE asx_status asx_task_get_state(asx_task_id id,
 ASX_API ASX_MUST_USE asx_status asx_task_get_outcome(asx_task_id id,
                                                      asx_outcome *out_outcome);
 
+/* Await another task from inside a poll function.
+ *
+ * If child has already completed, returns ASX_OK immediately.
+ * Otherwise self is parked — the scheduler stops polling it — and
+ * ASX_E_PENDING is returned; the poll function should return it.
+ * self is woken when child completes or when self is cancelled.
+ * Each task has at most one waiter.
+ *
+ * Preconditions: self is the calling task; child is a different task.
+ * Postconditions: on ASX_E_PENDING, self is parked on child.
+ * Returns ASX_OK if child is terminal, ASX_E_PENDING if parked,
+ *   ASX_E_INVALID_ARGUMENT if self == child,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE if either handle is invalid,
+ *   ASX_E_INVALID_STATE if child already has a different waiter.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_await(asx_task_id self,
+                                               asx_task_id child);
+
 /* -------------------------------------------------------------------
  * Cancellation (bd-2cw.3)
  *
@@ -272,11 +341,15 @@ ASX_API ASX_MUST_USE asx_status asx_task_cancel_with_origin(
     asx_region_id origin_region,
     asx_task_id origin_task);
 
-/* Propagate cancellation to all tasks in a region.
+/* Propagate cancellation to all tasks in a region and its descendants.
  *
  * Preconditions: region must be a valid region handle.
- * Postconditions: all running tasks in the region enter CancelRequested.
- * Returns the number of tasks that received the cancel signal.
+ * Postconditions: all running tasks in the subtree enter CancelRequested,
+ *   with origin_region set to region.
+ * Cost is O(regions + live tasks in subtree); regions are visited in
+ * pre-order, tasks within a region in ascending arena order.
+ * Returns the number of tasks that received the cancel signal
+ * (0 if region is invalid or stale).
  * Thread-safety: not thread-safe; single-threaded mode only. */
 ASX_API uint32_t asx_cancel_propagate(asx_region_id region,
                                        asx_cancel_kind kind);
@@ -356,6 +429,43 @@ ASX_API ASX_MUST_USE asx_status asx_obligation_commit(asx_obligation_id id);
  * See: API_MISUSE_CATALOG.md § Obligation Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_obligation_abort(asx_obligation_id id);
 
+/* Commit a batch of reserved obligations. Every handle is validated
+ * before any changes; the batch is then resolved in ascending arena
+ * index order, whatever the order of ids, with one bulk linearity
+ * update and one ASX_TRACE_OBLIGATION_COMMIT_RANGE record.
+ *
+ * Preconditions: ids must not be NULL unless count is 0; every id
+ *   must be a valid obligation handle in RESERVED state, listed once.
+ * Postconditions: on success, every listed obligation is COMMITTED;
+ *   on error, none has changed.
+ * Returns ASX_OK on success (count 0 is a no-op), ASX_E_INVALID_ARGUMENT
+ *   if ids is NULL, the first lookup error of a listed id,
+ *   ASX_E_INVALID_TRANSITION if one is not RESERVED or is listed twice.
+ * Thread-safety: not thread-safe; single-threaded mode only.
+ * See: API_MISUSE_CATALOG.md § Obligation Lifecycle. */
+ASX_API ASX_MUST_USE asx_status asx_obligation_commit_many(
+    const asx_obligation_id *ids, uint32_t count);
+
+/* Abort a batch of reserved obligations. As asx_obligation_commit_many,
+ * with transitions Reserved → Aborted and one
+ * ASX_TRACE_OBLIGATION_ABORT_RANGE record. */
+ASX_API ASX_MUST_USE asx_status asx_obligation_abort_many(
+    const asx_obligation_id *ids, uint32_t count);
+
+/* Abort every RESERVED obligation of a region (not its descendants),
+ * e.g. on connection teardown, in ascending arena index order with
+ * one ASX_TRACE_OBLIGATION_ABORT_RANGE record. Obligations already
+ * committed or aborted are left as they are.
+ *
+ * Preconditions: region must be a valid handle; out_aborted may be NULL.
+ * Postconditions: no obligation of the region is RESERVED;
+ *   *out_aborted (if given) holds the number aborted.
+ * Returns ASX_OK on success, ASX_E_NOT_FOUND if region is invalid,
+ *   ASX_E_STALE_HANDLE if generation mismatch.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_region_abort_obligations(
+    asx_region_id region, uint32_t *out_aborted);
+
 /* Query the current state of an obligation.
  *
  * Preconditions: out_state must not be NULL; id must be a valid handle.
@@ -375,8 +485,8 @@ ASX_API ASX_MUST_USE asx_status asx_obligation_get_state(asx_obligation_id id,
  *
  * Preconditions: region must be a valid handle; budget must not be NULL
  *   and must have remaining polls > 0.
- * Postconditions: tasks are polled in arena-index order; event log is
- *   populated; budget is decremented.
+ * Postconditions: tasks are polled in the order of the active
+ *   scheduling policy; event log is populated; budget is decremented.
  * Returns ASX_OK when all tasks complete (quiescent),
  *   ASX_E_BUDGET_EXHAUSTED if polls ran out before completion,
  *   ASX_E_NOT_FOUND if region is invalid,
@@ -387,6 +497,118 @@ ASX_API ASX_MUST_USE asx_status asx_obligation_get_state(asx_obligation_id id,
 ASX_API ASX_MUST_USE asx_status asx_scheduler_run(asx_region_id region,
                                                   asx_budget *budget);
 
+/* -------------------------------------------------------------------
+ * Scheduling policy and per-task deadlines
+ *
+ * ARENA_ORDER (default) polls each round in ascending arena index.
+ * EDF polls each round earliest-deadline first: tasks are ordered by
+ * (deadline, priority, arena index), where a task without a deadline
+ * sorts after all tasks with one and lower priority values run
+ * first. Under EDF, tasks spawned during a round are first polled in
+ * the next round.
+ *
+ * FAIR is weighted fair queueing on virtual time. Each poll is charged
+ * a cost: the value passed to asx_task_report_cost during that poll,
+ * else 1 in deterministic builds (ASX_DETERMINISTIC), so the order
+ * never depends on the clock; other builds charge the clock-hook delta
+ * across the poll before falling back to 1. The task's
+ * virtual time advances by cost * (priority + 1), and the scheduler
+ * always polls the runnable task with the smallest virtual time
+ * (arena index breaks ties), so cheap tasks are not starved by a few
+ * expensive ones. Runnable tasks sit in a ready heap kept across
+ * rounds, so picking costs O(log n) rather than a pass over the
+ * region. The same cost is drawn from the scheduler budget's
+ * cost_quota; once it is spent the run returns
+ * ASX_E_POLL_BUDGET_EXHAUSTED. asx_region_drain visits child regions
+ * in ascending charged cost and splits a bounded cost quota between
+ * them as it does polls.
+ * ------------------------------------------------------------------- */
+
+typedef enum {
+    ASX_SCHED_POLICY_ARENA_ORDER = 0,
+    ASX_SCHED_POLICY_EDF         = 1,
+    ASX_SCHED_POLICY_FAIR        = 2
+} asx_sched_policy;
+
+/* Select the scheduling policy used by subsequent scheduler runs.
+ * Returns ASX_OK, or ASX_E_INVALID_ARGUMENT for an unknown policy.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_set_policy(asx_sched_policy policy);
+
+/* Current scheduling policy. */
+ASX_API asx_sched_policy asx_scheduler_get_policy(void);
+
+/* Enable or disable deadline monitoring. When enabled, the scheduler
+ * reads the clock hook before polling a task with a deadline and on
+ * its completion; the first of (deadline passed per
+ * asx_budget_is_past_deadline, task completed) is reported once per
+ * task through asx_auto_record_deadline. Disabled by default.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API void asx_scheduler_set_deadline_monitor(int enabled);
+
+/* -------------------------------------------------------------------
+ * Idle strategy
+ *
+ * A round in which every live task is parked is idle. By default the
+ * scheduler then wakes all tasks and polls again at once. With an idle
+ * strategy (asx_idle_strategy in asx_config.h; per-profile defaults
+ * from asx_profile_get_idle_strategy) it first waits for the earliest
+ * task wake deadline or reactor readiness: spin, then yield, then
+ * park. The wait is skipped when neither a wake deadline nor a reactor
+ * hook could end it. Each wait that ends on or after a wake deadline
+ * records its lateness through asx_hft_record_wake_latency. Waiting
+ * never changes poll order, so traces keep their digests.
+ * ------------------------------------------------------------------- */
+
+typedef enum {
+    ASX_IDLE_WAKE_SPIN    = 0,  /* deadline reached while spinning */
+    ASX_IDLE_WAKE_YIELD   = 1,  /* readiness or deadline during yield */
+    ASX_IDLE_WAKE_PARK    = 2,  /* readiness or deadline while parked */
+    ASX_IDLE_WAKE_TIMEOUT = 3,  /* every phase ran out */
+    ASX_IDLE_WAKE_COUNT   = 4
+} asx_idle_wake;
+
+typedef struct {
+    uint64_t waits;                        /* idle waits entered */
+    uint64_t wakes[ASX_IDLE_WAKE_COUNT];   /* how each wait ended */
+} asx_idle_stats;
+
+/* Install an idle strategy for subsequent scheduler runs; NULL
+ * restores the default (no waiting). The strategy is copied.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API void asx_scheduler_set_idle_strategy(const asx_idle_strategy *strategy);
+
+/* Counters since the last asx_scheduler_idle_stats_reset.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if out is NULL. */
+ASX_API ASX_MUST_USE asx_status asx_scheduler_idle_stats(asx_idle_stats *out);
+
+ASX_API void asx_scheduler_idle_stats_reset(void);
+
+/* Attach scheduling constraints to a task. Only budget->deadline
+ * (absolute, asx_runtime_now_ns time base; 0 = none) and
+ * budget->priority are used; quotas stay with the scheduler budget.
+ * Replaces any previous constraints.
+ *
+ * Preconditions: budget not NULL; task not yet completed.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if budget is NULL,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for bad handles,
+ *   ASX_E_INVALID_STATE if the task has completed.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_set_budget(asx_task_id id,
+                                                    const asx_budget *budget);
+
+/* Report the cost of the current poll (any unit consistent across the
+ * region, e.g. microseconds of work). Call from inside the task's
+ * poll function; the value replaces the measured cost for that poll
+ * under ASX_SCHED_POLICY_FAIR and is ignored by other policies.
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT if cost is 0,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for bad handles,
+ *   ASX_E_INVALID_STATE if the task has completed.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_task_report_cost(asx_task_id self,
+                                                     uint64_t cost);
+
 /* -------------------------------------------------------------------
  * Scheduler event sequencing (deterministic replay support)
  *
@@ -397,6 +619,12 @@ ASX_API ASX_MUST_USE asx_status asx_scheduler_run(asx_region_id region,
  *
  * Tie-break rule: tasks are polled in arena index order within a
  * round. Index order is stable and deterministic.
+ *
+ * The log is a view over the trace ring (trace.h): each scheduler
+ * action is recorded once, as a trace record, and read back here from
+ * the start of the current run. Events whose record falls past
+ * ASX_TRACE_CAPACITY are counted but cannot be read; asx_trace_reset
+ * (also done by asx_runtime_reset) frees the ring.
  * ------------------------------------------------------------------- */
 
 typedef enum {
@@ -426,7 +654,8 @@ ASX_API uint32_t asx_scheduler_event_count(void);
  * See: API_MISUSE_CATALOG.md § Scheduler. */
 ASX_API int asx_scheduler_event_get(uint32_t index, asx_scheduler_event *out);
 
-/* Reset event log (called automatically by asx_scheduler_run). */
+/* Restart the event log at the current end of the trace (called
+ * automatically by asx_scheduler_run). */
 ASX_API void asx_scheduler_event_reset(void);
 
 /* -------------------------------------------------------------------
@@ -443,15 +672,31 @@ ASX_API void asx_scheduler_event_reset(void);
  * Thread-safety: not thread-safe; single-threaded mode only. */
 ASX_API ASX_MUST_USE asx_status asx_quiescence_check(asx_region_id id);
 
+/* Check whether a region's subtree has no outstanding work: no live
+ * tasks in the region or any descendant, and no descendant region
+ * short of CLOSED. The region itself may still be OPEN. O(1).
+ *
+ * Preconditions: id must be a valid region handle.
+ * Returns ASX_OK if the subtree is idle, ASX_E_NOT_FOUND if id is invalid,
+ *   ASX_E_INCOMPLETE_CHILDREN if a descendant region is not CLOSED,
+ *   ASX_E_QUIESCENCE_TASKS_LIVE if tasks remain in the subtree.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API ASX_MUST_USE asx_status asx_quiescence_check_subtree(asx_region_id id);
+
 /* Drain a region: run scheduler then close through to CLOSED.
  * This is the high-level "shut down cleanly" operation.
  *
+ * Child regions are closed, cancelled and drained first; the poll
+ * budget is split evenly (via asx_budget_meet) across the children
+ * and the region's own tasks, with unspent polls flowing onward.
+ *
  * Preconditions: id must be a valid region handle; budget must not be NULL.
  * Postconditions: on success, region reaches CLOSED state; all tasks
  *   completed; cleanup destructors called in LIFO order.
  * Returns ASX_OK on success, ASX_E_NOT_FOUND if id is invalid,
  *   ASX_E_INVALID_ARGUMENT if budget is NULL,
- *   ASX_E_BUDGET_EXHAUSTED if not all tasks completed within budget.
+ *   ASX_E_QUIESCENCE_TASKS_LIVE if not all tasks completed within budget,
+ *   ASX_E_INCOMPLETE_CHILDREN if a child region did not reach CLOSED.
  * Thread-safety: not thread-safe; single-threaded mode only.
  * See: API_MISUSE_CATALOG.md § Region Lifecycle. */
 ASX_API ASX_MUST_USE asx_status asx_region_drain(asx_region_id id,
@@ -0,0 +1,263 @@
+/*
+ * asx/runtime/shard.h — shard-per-core deployment with cross-shard rings
+ *
+ * A shard group runs N independent runtime instances (asx_runtime),
+ * one per shard. Each shard opens a root region in its own instance,
+ * lets the application populate it (setup_fn), then runs the ordinary
+ * single-threaded scheduler over that region in poll_quantum slices
+ * until it quiesces, the shard's poll budget is spent, or the group is
+ * stopped. The root region is then drained to CLOSED, in poll_quantum
+ * slices, with up to a further poll_budget polls. Kernel semantics
+ * inside a shard are unchanged and lock-free: shards share no runtime
+ * state.
+ *
+ * Shards talk only through bounded SPSC rings, one per ordered pair
+ * (from, to). Rings follow the two-phase permit contract of
+ * asx_channel_try_reserve / asx_send_permit_send: reserve claims
+ * capacity, send commits the value FIFO, abort returns the capacity.
+ * Messaging calls are made from inside the sending or receiving
+ * shard (e.g. a task poll function); the shard is identified by the
+ * calling thread's current runtime instance.
+ *
+ * Execution:
+ *   - With thread hooks (start_fn/join_fn), each shard runs on its own
+ *     OS thread, pinned to CPU first_cpu + index where the hooks
+ *     support it, with asx_affinity_set_domain(index + 1).
+ *   - Without thread hooks, shards are stepped round-robin, one
+ *     quantum at a time, on the calling thread. This mode is fully
+ *     deterministic and needs no platform threading.
+ *
+ * Digests: each shard keeps its own deterministic trace;
+ * asx_shard_group_digest folds the per-shard trace digests in shard
+ * order. It is reproducible whenever every shard's trace is, which
+ * holds in inline mode and for shards whose tasks do not observe the
+ * timing of cross-shard messages.
+ *
+ * Profile instrumentation (e.g. the deadline monitor) is process-wide
+ * and must not be enabled while threaded shards run.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_SHARD_H
+#define ASX_RUNTIME_SHARD_H
+
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/asx_config.h>
+#include <asx/runtime/instance.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------
+ * Limits
+ * ------------------------------------------------------------------- */
+
+#define ASX_MAX_SHARDS            8u
+#define ASX_SHARD_RING_CAPACITY   64u   /* slots per directed ring */
+#define ASX_SHARD_DEFAULT_QUANTUM 64u   /* polls per scheduler slice */
+
+/* Returned by asx_shard_self() off any shard of the group. */
+#define ASX_SHARD_NONE            UINT32_MAX
+
+/* -------------------------------------------------------------------
+ * Configuration
+ * ------------------------------------------------------------------- */
+
+typedef void (*asx_shard_entry_fn)(void *arg);
+
+/* Platform threading. start_fn runs entry(arg) on a new thread, pinned
+ * to cpu if supported, and stores a joinable handle in *out_thread.
+ * join_fn waits for that thread to return. */
+typedef struct {
+    void *ctx;
+    asx_status (*start_fn)(void *ctx, uint32_t cpu, asx_shard_entry_fn entry,
+                           void *arg, void **out_thread);
+    asx_status (*join_fn)(void *ctx, void *thread);
+} asx_shard_thread_hooks;
+
+/* Populate a shard. Runs on the shard with its instance current;
+ * root is an open region owned by the shard. A non-OK status stops
+ * the shard before its first slice. */
+typedef asx_status (*asx_shard_setup_fn)(void *arg, uint32_t shard,
+                                         asx_region_id root);
+
+typedef struct {
+    uint32_t                 shard_count;    /* 1..ASX_MAX_SHARDS */
+    asx_resource_class       resource_class; /* for every shard instance */
+    const asx_runtime_hooks *hooks;          /* per-shard hooks; NULL = defaults */
+    asx_shard_setup_fn       setup_fn;       /* required */
+    void                    *setup_arg;
+    uint32_t                 poll_quantum;   /* polls per slice (> 0) */
+    uint32_t                 poll_budget;    /* per shard; 0 = unbounded */
+    asx_shard_thread_hooks   threads;        /* start_fn NULL = inline */
+    uint32_t                 first_cpu;      /* shard i pinned to first_cpu + i */
+} asx_shard_config;
+
+/* -------------------------------------------------------------------
+ * Group state (caller-owned; treat fields as private)
+ * ------------------------------------------------------------------- */
+
+/* Directed SPSC ring. head is written only by the consumer; tail,
+ * reserved and next_token only by the producer. */
+typedef struct {
+    volatile uint32_t head;
+    uint8_t           pad_head_[60];
+    volatile uint32_t tail;
+    uint32_t          reserved;
+    uint32_t          next_token;
+    uint8_t           pad_tail_[52];
+    uint64_t          slots[ASX_SHARD_RING_CAPACITY];
+} asx_shard_ring;
+
+struct asx_shard_group;
+
+typedef struct {
+    struct asx_shard_group *group;
+    uint32_t                index;
+    asx_runtime            *rt;
+    void                   *thread;
+    asx_region_id           root;
+    asx_status              status;   /* final status once done */
+    uint32_t                polls;    /* polls consumed */
+    uint64_t                digest;   /* trace digest once done */
+    uint64_t                sent;
+    uint64_t                received;
+    volatile int            done;
+} asx_shard;
+
+typedef struct asx_shard_group {
+    asx_shard_config config;
+    asx_shard        shards[ASX_MAX_SHARDS];
+    asx_shard_ring   rings[ASX_MAX_SHARDS][ASX_MAX_SHARDS]; /* [from][to] */
+    volatile int     stop;
+    int              initialized;
+    int              ran;
+} asx_shard_group;
+
+/* Two-phase send token for a cross-shard ring. */
+typedef struct {
+    asx_shard_group *group;
+    uint32_t         from;
+    uint32_t         to;
+    uint32_t         token;
+    int              consumed;
+} asx_shard_permit;
+
+/* Per-shard counters (valid after asx_shard_group_run). */
+typedef struct {
+    asx_status status;
+    uint32_t   polls;
+    uint64_t   trace_digest;
+    uint64_t   sent;
+    uint64_t   received;
+} asx_shard_stats;
+
+/* -------------------------------------------------------------------
+ * Group lifecycle
+ * ------------------------------------------------------------------- */
+
+/* Defaults: one shard, ASX_CLASS_R2, default hooks, inline execution,
+ * ASX_SHARD_DEFAULT_QUANTUM, unbounded budget. setup_fn stays NULL. */
+ASX_API void asx_shard_config_init(asx_shard_config *cfg);
+
+/* Create one runtime instance per shard and empty rings.
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT for a NULL group/cfg/setup_fn, a shard
+ *     count outside 1..ASX_MAX_SHARDS, a zero quantum, or thread
+ *     hooks with start_fn but no join_fn,
+ *   any asx_runtime_create status (already-created shards are
+ *     destroyed).
+ * Thread-safety: not thread-safe. */
+ASX_API ASX_MUST_USE asx_status asx_shard_group_init(
+    asx_shard_group *group, const asx_shard_config *cfg);
+
+/* Run every shard to completion (see file comment) and join them.
+ * Returns ASX_OK if every shard quiesced and closed its root region,
+ * otherwise the status of the lowest-indexed shard that did not
+ * (ASX_E_POLL_BUDGET_EXHAUSTED, ASX_E_CANCELLED when stopped, or a
+ * setup/scheduler error). ASX_E_INVALID_STATE if the group is not
+ * initialized or already ran; a thread start failure is returned
+ * after the shards already started have been stopped and joined.
+ * Thread-safety: call from one thread; blocks until all shards end. */
+ASX_API ASX_MUST_USE asx_status asx_shard_group_run(asx_shard_group *group);
+
+/* Ask every shard to stop after its current slice. Shards then drain
+ * their root regions (cancelling live tasks) and finish.
+ * Thread-safety: safe from any thread, including shard tasks. */
+ASX_API void asx_shard_group_stop(asx_shard_group *group);
+
+/* Destroy the shard instances. The group may be re-initialized. */
+ASX_API void asx_shard_group_destroy(asx_shard_group *group);
+
+/* -------------------------------------------------------------------
+ * Queries
+ * ------------------------------------------------------------------- */
+
+/* Index of the shard whose instance is current on the calling thread,
+ * or ASX_SHARD_NONE. */
+ASX_API uint32_t asx_shard_self(const asx_shard_group *group);
+
+/* Runtime instance of a shard, or NULL for a bad index. */
+ASX_API asx_runtime *asx_shard_runtime(const asx_shard_group *group,
+                                       uint32_t shard);
+
+/* Returns ASX_OK, ASX_E_INVALID_ARGUMENT for bad arguments. */
+ASX_API ASX_MUST_USE asx_status asx_shard_stats_get(
+    const asx_shard_group *group, uint32_t shard, asx_shard_stats *out);
+
+/* Combined digest over the shards' trace digests in shard order. */
+ASX_API uint64_t asx_shard_group_digest(const asx_shard_group *group);
+
+/* -------------------------------------------------------------------
+ * Cross-shard messaging (two-phase, bounded, SPSC per direction)
+ * ------------------------------------------------------------------- */
+
+/* Reserve a slot on the ring from the calling shard to shard `to`.
+ * Returns ASX_OK and fills *out,
+ *   ASX_E_CHANNEL_FULL if the ring has no free capacity,
+ *   ASX_E_DISCONNECTED if shard `to` has finished,
+ *   ASX_E_INVALID_STATE if the caller is not a shard of the group,
+ *   ASX_E_INVALID_ARGUMENT for bad arguments or to == self. */
+ASX_API ASX_MUST_USE asx_status asx_shard_try_reserve(asx_shard_group *group,
+                                                      uint32_t to,
+                                                      asx_shard_permit *out);
+
+/* Commit a permit: the value becomes visible to the receiver FIFO.
+ * Returns ASX_OK, ASX_E_INVALID_STATE if the permit was already
+ * consumed, ASX_E_INVALID_ARGUMENT if permit is NULL. */
+ASX_API ASX_MUST_USE asx_status asx_shard_permit_send(asx_shard_permit *permit,
+                                                      uint64_t value);
+
+/* Release a permit's capacity without sending. Idempotent. */
+ASX_API void asx_shard_permit_abort(asx_shard_permit *permit);
+
+/* Receive the oldest value sent by shard `from` to the calling shard.
+ * Returns ASX_OK,
+ *   ASX_E_WOULD_BLOCK if the ring is empty and `from` is running,
+ *   ASX_E_DISCONNECTED if the ring is empty and `from` has finished,
+ *   ASX_E_INVALID_STATE if the caller is not a shard of the group,
+ *   ASX_E_INVALID_ARGUMENT for bad arguments or from == self. */
+ASX_API ASX_MUST_USE asx_status asx_shard_try_recv(asx_shard_group *group,
+                                                   uint32_t from,
+                                                   uint64_t *out_value);
+
+/* -------------------------------------------------------------------
+ * Platform thread hooks
+ * ------------------------------------------------------------------- */
+
+#if defined(ASX_PROFILE_POSIX)
+/* pthread-based hooks; pins with pthread_setaffinity_np on Linux.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if out is NULL. */
+ASX_API asx_status asx_posix_shard_thread_hooks(asx_shard_thread_hooks *out);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_SHARD_H */
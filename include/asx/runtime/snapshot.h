@@ -4,7 +4,16 @@
  * Captures a point-in-time view of all live runtime entities
  * (regions, tasks, obligations) for replay validation and
  * conformance testing. Snapshots are serializable to JSON for
- * comparison against fixture expected_final_snapshot fields.
+ * comparison against fixture expected_final_snapshot fields, and to
+ * a compact binary form for periodic health reporting.
+ *
+ * The runtime marks every slot whose snapshot record changes, so a
+ * snapshot can be brought up to date in O(changed entities) with
+ * asx_runtime_snapshot_update instead of re-read in full, and
+ * asx_runtime_state_digest folds only changed records into a digest
+ * of the live state. The digest is the XOR of one FNV-1a hash per
+ * record, so it is independent of record order and equals
+ * asx_runtime_snapshot_hash of a snapshot taken at the same moment.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -39,7 +48,9 @@ typedef struct {
     asx_task_id    id;
     asx_task_state state;
     asx_region_id  region;
-    asx_status     outcome_status;
+    asx_status     outcome_status; /* ASX_E_TASK_NOT_COMPLETED while live,
+                                    * then ASX_OK, ASX_E_CANCELLED, or
+                                    * ASX_E_INVALID_STATE (error/panic) */
 } asx_snapshot_task;
 
 typedef struct {
@@ -50,12 +61,15 @@ typedef struct {
 
 /* ------------------------------------------------------------------ */
 /* Aggregate snapshot                                                   */
+/*                                                                     */
+/* Records are ordered by arena slot. Ids are the handles returned by  */
+/* open/spawn/reserve.                                                 */
 /* ------------------------------------------------------------------ */
 
 enum {
-    ASX_SNAPSHOT_MAX_REGIONS     = 8u,
-    ASX_SNAPSHOT_MAX_TASKS       = 64u,
-    ASX_SNAPSHOT_MAX_OBLIGATIONS = 128u
+    ASX_SNAPSHOT_MAX_REGIONS     = ASX_MAX_REGIONS,
+    ASX_SNAPSHOT_MAX_TASKS       = ASX_MAX_TASKS,
+    ASX_SNAPSHOT_MAX_OBLIGATIONS = ASX_MAX_OBLIGATIONS
 };
 
 typedef struct {
@@ -66,6 +80,10 @@ typedef struct {
     uint32_t              obligation_count;
     asx_snapshot_obligation obligations[ASX_SNAPSHOT_MAX_OBLIGATIONS];
     uint64_t              event_hash;    /* hash chain at capture time */
+    uint64_t              digest;        /* asx_runtime_state_digest */
+    /* Update tracking (private) */
+    const void           *owner;         /* instance captured from */
+    uint32_t              epoch;         /* owner's epoch at capture */
 } asx_runtime_snapshot;
 
 /* ------------------------------------------------------------------ */
@@ -80,18 +98,75 @@ ASX_API void asx_runtime_snapshot_init(asx_runtime_snapshot *snap);
 ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_capture(
     asx_runtime_snapshot *snap);
 
+/* Bring snap up to date by re-reading only the entities that changed
+ * since it was captured or last updated. Only the most recent
+ * snapshot captured or updated on the current instance can be
+ * patched; any other snapshot (or an initialized one) is recaptured
+ * in full. out_changed (optional) receives the number of records
+ * re-read, or ASX_SNAPSHOT_FULL for a full capture.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT if snap is NULL. */
+#define ASX_SNAPSHOT_FULL 0xFFFFFFFFu
+ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_update(
+    asx_runtime_snapshot *snap, uint32_t *out_changed);
+
+/* Digest of the live runtime state, maintained incrementally: each
+ * call folds in only the records changed since the previous call. */
+ASX_API uint64_t asx_runtime_state_digest(void);
+
+/* The same digest computed from a snapshot's records (0 for NULL). */
+ASX_API uint64_t asx_runtime_snapshot_hash(const asx_runtime_snapshot *snap);
+
 /* Serialize snapshot to JSON.
  * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if snap or out is NULL. */
 ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_to_json(
     const asx_runtime_snapshot *snap,
     asx_codec_buffer *out);
 
-/* Compare two snapshots for equality.
+/* Compare two snapshots for equality (records and event hash).
  * Returns ASX_OK if identical, ASX_E_EQUIVALENCE_MISMATCH if not. */
 ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_eq(
     const asx_runtime_snapshot *a,
     const asx_runtime_snapshot *b);
 
+/* ------------------------------------------------------------------ */
+/* Binary encoding                                                     */
+/*                                                                     */
+/* Little-endian; varint = unsigned LEB128.                            */
+/*   [0..3]   magic "ASXs" (0x41535873)                                */
+/*   [4]      version 1                                                */
+/*   [5..12]  digest                                                   */
+/*   [13..20] event_hash                                               */
+/*   Three sections (regions, tasks, obligations), each a varint       */
+/*   count followed by records in slot order. Every record starts      */
+/*   with varint(slot - previous slot) and varint(generation) (the     */
+/*   id), then a state byte, then:                                     */
+/*     region:     varint task_count, varint task_total, byte poisoned */
+/*     task:       region ref, varint outcome_status                   */
+/*     obligation: region ref                                          */
+/*   A region ref is varint(slot + 1) and varint(generation); slot 0   */
+/*   with no generation encodes ASX_INVALID_ID.                        */
+/* A typical record takes 4-6 bytes against 16-24 in memory.           */
+/* ------------------------------------------------------------------ */
+
+#define ASX_SNAPSHOT_BINARY_MAGIC   0x41535873u  /* "ASXs" */
+#define ASX_SNAPSHOT_BINARY_VERSION 1u
+#define ASX_SNAPSHOT_BINARY_HEADER  21u
+
+/* Encode snap. *out_len receives the bytes written, or needed on
+ * ASX_E_BUFFER_TOO_SMALL (buf is then left untouched).
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL arguments. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_encode(
+    const asx_runtime_snapshot *snap,
+    uint8_t *buf, uint32_t capacity, uint32_t *out_len);
+
+/* Decode a buffer written by asx_runtime_snapshot_encode. The result
+ * is detached from any instance (asx_runtime_snapshot_update
+ * recaptures it). Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL
+ * arguments or a malformed buffer, including one whose records do not
+ * hash to the stored digest. */
+ASX_API ASX_MUST_USE asx_status asx_runtime_snapshot_decode(
+    const uint8_t *buf, uint32_t len, asx_runtime_snapshot *snap);
+
 #ifdef __cplusplus
 }
 #endif
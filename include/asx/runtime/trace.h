@@ -6,6 +6,11 @@
  * verification (compare emitted events against expected) and runtime
  * snapshot export for conformance testing.
  *
+ * The trace ring is the runtime's only event store: every emission
+ * writes one record here. The scheduler event log (runtime.h) and the
+ * event record log (event.h) are filtered views over the same ring,
+ * so all three agree on ordering and share ASX_TRACE_CAPACITY.
+ *
  * Event ordering is deterministic for identical input and seed —
  * suitable for replay identity verification across runs and platforms.
  *
@@ -44,11 +49,17 @@ typedef enum {
     ASX_TRACE_REGION_CLOSED    = 0x12,
     ASX_TRACE_TASK_SPAWN       = 0x13,
     ASX_TRACE_TASK_TRANSITION  = 0x14,
+    ASX_TRACE_DRAIN_BEGIN      = 0x15,
+    ASX_TRACE_DRAIN_END        = 0x16,
 
     /* Obligation events (0x20–0x2F) */
     ASX_TRACE_OBLIGATION_RESERVE = 0x20,
     ASX_TRACE_OBLIGATION_COMMIT  = 0x21,
     ASX_TRACE_OBLIGATION_ABORT   = 0x22,
+    /* Batch resolution: entity = lowest handle in the batch,
+     * aux = count | (highest arena index << 32) */
+    ASX_TRACE_OBLIGATION_COMMIT_RANGE = 0x23,
+    ASX_TRACE_OBLIGATION_ABORT_RANGE  = 0x24,
 
     /* Channel events (0x30–0x3F) */
     ASX_TRACE_CHANNEL_SEND     = 0x30,
@@ -66,6 +77,8 @@ typedef enum {
  * Each event carries a monotonic sequence number, the event kind,
  * an entity handle (task/region/obligation/channel/timer ID), and
  * an auxiliary payload field whose meaning depends on the kind.
+ * The status is carried for the views and in the binary wire format;
+ * it is not part of the digest.
  * ------------------------------------------------------------------- */
 
 typedef struct {
@@ -73,6 +86,8 @@ typedef struct {
     asx_trace_event_kind  kind;
     uint64_t              entity_id;   /* handle of primary entity */
     uint64_t              aux;         /* kind-dependent payload */
+    asx_status            status;      /* ASX_OK, or ASX_E_CANCELLED for
+                                          a forced completion */
 } asx_trace_event;
 
 /* -------------------------------------------------------------------
@@ -84,8 +99,9 @@ typedef struct {
 /* -------------------------------------------------------------------
  * Trace emission API
  *
- * Events are recorded into a global ring buffer. The trace is
- * automatically reset at the start of each asx_scheduler_run call.
+ * Events are recorded into the instance's ring buffer. Events past
+ * ASX_TRACE_CAPACITY are counted but not retained. The trace spans
+ * scheduler runs; asx_scheduler_run only restarts the scheduler view.
  * ------------------------------------------------------------------- */
 
 /* Emit a trace event. Thread-safe: none (single-threaded runtime). */
@@ -99,7 +115,7 @@ ASX_API uint32_t asx_trace_event_count(void);
 /* Read event at index (0 = oldest). Returns 1 on success, 0 on OOB. */
 ASX_API int asx_trace_event_get(uint32_t index, asx_trace_event *out);
 
-/* Reset trace state. Called automatically by scheduler_run. */
+/* Reset trace state, including the scheduler and event views. */
 ASX_API void asx_trace_reset(void);
 
 /* -------------------------------------------------------------------
@@ -109,17 +125,38 @@ ASX_API void asx_trace_reset(void);
  * is deterministic for identical event sequences. Uses FNV-1a 64-bit
  * for the walking skeleton; Phase 4 will add SHA-256 for fixture
  * parity with the Rust reference implementation.
+ *
+ * The digest is rolled forward over records added since the previous
+ * call, so repeated reads cost only the new records and emission
+ * itself never hashes.
+ *
+ * While rolling, the digest is checkpointed every
+ * ASX_TRACE_CHECKPOINT_INTERVAL records: checkpoint j is the digest of
+ * records [0, (j + 1) * interval). Two traces agree up to the first
+ * checkpoint that differs, so divergence is found by binary search
+ * over checkpoints and a scan of one interval.
  * ------------------------------------------------------------------- */
 
-/* Compute the current trace digest (FNV-1a over all events). */
+#define ASX_TRACE_CHECKPOINT_INTERVAL 64u
+#define ASX_TRACE_CHECKPOINTS (ASX_TRACE_CAPACITY / ASX_TRACE_CHECKPOINT_INTERVAL)
+
+/* Current trace digest (FNV-1a over all retained events). */
 ASX_API uint64_t asx_trace_digest(void);
 
+/* Number of complete checkpoints over the retained events. */
+ASX_API uint32_t asx_trace_checkpoint_count(void);
+
+/* Read checkpoint digest j. Returns 1 on success, 0 on OOB. */
+ASX_API int asx_trace_checkpoint_get(uint32_t index, uint64_t *out);
+
 /* -------------------------------------------------------------------
  * Replay verification mode
  *
  * Load a reference event sequence, then run the scenario. After
  * completion, check for divergence between emitted and expected
- * events. The first divergence index is reported.
+ * events. The first divergence index is reported. Checkpoints of the
+ * reference are taken when it is loaded; verification compares them
+ * against the trace's before scanning a single interval.
  * ------------------------------------------------------------------- */
 
 typedef enum {
@@ -189,33 +226,85 @@ ASX_API const char *asx_replay_result_kind_str(asx_replay_result_kind kind);
  * Wire format (little-endian):
  *   Header (24 bytes):
  *     [0..3]   magic      "ASXt" (0x41535874)
- *     [4..7]   version    1
+ *     [4..7]   version    1, or 2 for the compact format below
  *     [8..11]  event_count
- *     [12..15] reserved   0
+ *     [12..15] checkpoint_interval (0 = no checkpoint table)
  *     [16..23] trace_digest (FNV-1a 64-bit)
  *
- *   Per event (24 bytes each):
- *     [0..3]   sequence   (uint32)
- *     [4..7]   kind       (uint32)
- *     [8..15]  entity_id  (uint64)
- *     [16..23] aux        (uint64)
+ *   v1, after the header:
+ *     Per event (24 bytes each):
+ *       [0..3]   sequence   (uint32)
+ *       [4..7]   kind       (uint32)
+ *       [8..15]  entity_id  (uint64)
+ *       [16..23] aux        (uint64)
+ *     Checkpoint table (8 bytes each, event_count / interval entries):
+ *       digest of events [0, (j + 1) * interval)
+ *     Status section, only if some event's status is not ASX_OK:
+ *       [0..3]   magic      "ASXs" (0x41535873)
+ *       [4..7]   entry_count
+ *       Per entry (8 bytes each, ascending event index):
+ *         [0..3] event index
+ *         [4..7] status     (uint32)
+ *     Events without an entry, and all events of a buffer without
+ *     the section, have status ASX_OK.
+ *
+ *   v2, after the header:
+ *     Checkpoint table (12 bytes each, event_count / interval entries):
+ *       [0..7]   digest of events [0, (j + 1) * interval)
+ *       [8..11]  stream offset of event (j + 1) * interval
+ *     Event stream, per event:
+ *       tag      kind in bits 0-5 (0x3F: varint kind follows);
+ *                bit 6: varint sequence follows, else previous + 1;
+ *                bit 7: varint status follows, else ASX_OK
+ *       ref      entity code in bits 0-3, aux code in bits 4-7:
+ *                0..7 slot of an 8-entry move-to-front table of
+ *                recent values, 8 varint XOR table front, 9 varint
+ *       literals entity then aux, for codes 8 and 9
+ *     The table and the expected sequence restart at every interval,
+ *     so a reader can start decoding at any checkpoint offset.
+ *     Scheduler traces encode in about 3-5 bytes per event.
+ *
+ * v1 is the default output. v2 is written only on request, by
+ * asx_trace_export_binary_v2; readers built before v2 reject it on
+ * the version field. Both versions carry the same digest over the
+ * same decoded events, and this reader accepts both. The v1 interval
+ * field was reserved (0) in earlier writers, so their buffers read as
+ * having no table; earlier readers ignore the field, the table and the
+ * status section, and read every status as ASX_OK.
  * ------------------------------------------------------------------- */
 
 #define ASX_TRACE_BINARY_MAGIC    0x41535874u  /* "ASXt" */
 #define ASX_TRACE_BINARY_VERSION  1u
+#define ASX_TRACE_BINARY_VERSION_V2 2u
 #define ASX_TRACE_BINARY_HEADER   24u
-#define ASX_TRACE_BINARY_EVENT    24u
-
-/* Export the current trace to a binary buffer.
+#define ASX_TRACE_BINARY_EVENT    24u  /* v1 */
+#define ASX_TRACE_BINARY_EVENT_MAX 37u /* v2 worst case */
+#define ASX_TRACE_BINARY_CHECKPOINT 8u /* v1 */
+#define ASX_TRACE_BINARY_V2_CHECKPOINT 12u
+#define ASX_TRACE_BINARY_STATUS_MAGIC 0x41535873u /* "ASXs", v1 */
+#define ASX_TRACE_BINARY_STATUS_HEADER 8u /* v1 */
+#define ASX_TRACE_BINARY_STATUS   8u   /* v1 */
+
+/* Export the current trace to a binary buffer (v1).
  * Returns ASX_OK on success, ASX_E_INVALID_ARGUMENT if buf/out_len
- * is NULL, ASX_E_BUFFER_TOO_SMALL if capacity insufficient.
- * On success, *out_len receives the number of bytes written. */
+ * is NULL, ASX_E_BUFFER_TOO_SMALL if capacity insufficient (buf is
+ * left untouched). *out_len receives the number of bytes written, or
+ * needed on ASX_E_BUFFER_TOO_SMALL. */
 ASX_API asx_status asx_trace_export_binary(uint8_t *buf,
                                             uint32_t capacity,
                                             uint32_t *out_len);
 
-/* Import a binary trace buffer as the replay reference.
- * Validates header magic, version, and digest. On success, the
+/* Export in the compact v2 format. Same contract as
+ * asx_trace_export_binary; the reader must accept version 2. A buffer
+ * of ASX_TRACE_BINARY_HEADER + ASX_TRACE_CAPACITY *
+ * ASX_TRACE_BINARY_EVENT_MAX + ASX_TRACE_CHECKPOINTS *
+ * ASX_TRACE_BINARY_V2_CHECKPOINT bytes suffices for either version. */
+ASX_API asx_status asx_trace_export_binary_v2(uint8_t *buf,
+                                               uint32_t capacity,
+                                               uint32_t *out_len);
+
+/* Import a binary trace buffer (v1 or v2) as the replay reference.
+ * Validates header magic, version, encoding, digest and checkpoints. On success, the
  * events are loaded as the replay reference (same as
  * asx_replay_load_reference). Returns ASX_OK on success. */
 ASX_API asx_status asx_trace_import_binary(const uint8_t *buf,
@@ -227,6 +316,19 @@ ASX_API asx_status asx_trace_import_binary(const uint8_t *buf,
 ASX_API asx_status asx_trace_continuity_check(const uint8_t *buf,
                                                uint32_t len);
 
+/* Find the first divergence between two exported traces, expected
+ * against actual, without re-hashing either: checkpoint tables are
+ * bisected (when both carry one at the same interval) and one
+ * interval is decoded and scanned. Either buffer may be v1 or v2. A content divergence within the shorter trace
+ * is reported before a length mismatch; equal contents with different
+ * header digests report ASX_REPLAY_DIGEST_MISMATCH.
+ * Returns ASX_OK with *out filled, ASX_E_INVALID_ARGUMENT for NULL
+ * arguments or a malformed buffer. */
+ASX_API ASX_MUST_USE asx_status asx_trace_binary_bisect(
+    const uint8_t *expected, uint32_t expected_len,
+    const uint8_t *actual, uint32_t actual_len,
+    asx_replay_result *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,188 @@
+/*
+ * asx/runtime/wake.h — cross-thread wake handles for external producers
+ *
+ * A wake handle lets a thread that is not running the runtime (a NIC
+ * poller, a market-data decoder) hand work to a scheduler that may be
+ * parked in asx_runtime_reactor_wait. Producers push caller-owned
+ * intrusive nodes onto a lock-free inbox; the scheduler drains the
+ * inbox in submission (FIFO) order on its own thread and passes each
+ * node to the handle's drain function, which typically forwards the
+ * value into a channel of the bound region.
+ *
+ * Wakeups are coalesced: only the first submission after a drain
+ * calls the signal hook, so a burst of submissions costs one signal
+ * (one eventfd/pipe write with the POSIX adapter) however long it is.
+ * The application registers the signal's readable fd with its
+ * reactor, so a parked scheduler returns from the reactor wait.
+ *
+ * asx_scheduler_run drains every handle bound to the region it runs
+ * at the start of each round, and an idle wait (asx_idle_strategy)
+ * ends as soon as a bound handle has pending work. Each drain that
+ * delivers nodes is logged as ASX_ND_WAKE_DRAIN in the hindsight ring
+ * (entity: region, value: nodes delivered), marking where external
+ * input entered the deterministic schedule.
+ *
+ * Thread-safety: asx_wake_submit may be called from any thread. All
+ * other calls belong to the thread running the handle's instance.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_RUNTIME_WAKE_H
+#define ASX_RUNTIME_WAKE_H
+
+#include <stdint.h>
+#include <asx/asx_config.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/runtime/instance.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------
+ * Limits
+ * ------------------------------------------------------------------- */
+
+#define ASX_MAX_WAKE_HANDLES 8u   /* bound handles per instance */
+
+/* -------------------------------------------------------------------
+ * Types
+ * ------------------------------------------------------------------- */
+
+/* Intrusive inbox node, owned by the producer. It must stay valid
+ * from asx_wake_submit until the drain function accepts it; after
+ * that the producer may reuse it. */
+typedef struct asx_wake_node {
+    struct asx_wake_node *next;
+    uint64_t              value;
+} asx_wake_node;
+
+/* Consume one node, in FIFO order. ASX_OK accepts it; any other
+ * status leaves it (and everything behind it) queued for the next
+ * drain, so ASX_E_CHANNEL_FULL or ASX_E_WOULD_BLOCK apply
+ * backpressure without losing submissions. */
+typedef asx_status (*asx_wake_drain_fn)(void *ctx, asx_wake_node *node);
+
+/* Wake signal. signal_fn is called from a producer thread when the
+ * inbox becomes non-empty; clear_fn on the scheduler thread before
+ * each drain takes the inbox, whether or not a signal is pending, so
+ * it must not block on an empty signal. Either may be NULL. */
+typedef struct {
+    void *ctx;
+    void (*signal_fn)(void *ctx);
+    void (*clear_fn)(void *ctx);
+} asx_wake_signal;
+
+/* Handle state (caller-owned; treat fields as private). Producer
+ * fields fill the first ASX_CACHE_LINE bytes and consumer fields start
+ * at the next line. The type is aligned to ASX_CACHE_LINE through
+ * ASX_CACHE_ALIGNED; where that is empty, or when the handle comes
+ * from an allocator that ignores the alignment, place it on an
+ * ASX_CACHE_LINE boundary yourself. */
+typedef struct ASX_CACHE_ALIGNED asx_wake_handle {
+    asx_wake_node *volatile inbox;     /* LIFO stack of submissions */
+    volatile uint32_t       pending;   /* 1 from first submit to drain */
+    volatile uint32_t       signals;   /* signal_fn calls */
+    uint8_t                 pad_[ASX_CACHE_LINE - sizeof(asx_wake_node *)
+                                 - 2u * sizeof(uint32_t)];
+    asx_wake_node          *backlog_head; /* drained, not yet accepted */
+    asx_wake_node          *backlog_tail;
+    asx_runtime            *rt;
+    asx_region_id           region;
+    asx_wake_drain_fn       drain_fn;
+    void                   *drain_ctx;
+    asx_wake_signal         signal;
+    uint64_t                delivered;
+    uint32_t                drains;
+    uint32_t                stalls;    /* drains stopped by the drain fn */
+} asx_wake_handle;
+
+typedef struct {
+    uint32_t signals;    /* wake signals raised by producers */
+    uint32_t drains;     /* drains that delivered at least one node */
+    uint32_t stalls;     /* drains stopped early by the drain fn */
+    uint64_t delivered;  /* nodes accepted by the drain fn */
+} asx_wake_stats;
+
+/* -------------------------------------------------------------------
+ * Handle lifecycle
+ * ------------------------------------------------------------------- */
+
+/* Bind a handle to an open region of the current instance. signal
+ * may be NULL when the scheduler never parks in the reactor.
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT for a NULL handle or drain_fn,
+ *   ASX_E_NOT_FOUND / ASX_E_STALE_HANDLE for an unknown region,
+ *   ASX_E_INVALID_STATE if h is already bound to this instance
+ *   (destroy it first),
+ *   ASX_E_RESOURCE_EXHAUSTED if ASX_MAX_WAKE_HANDLES are bound. */
+ASX_API ASX_MUST_USE asx_status asx_wake_handle_init(
+    asx_wake_handle *h, asx_region_id region, asx_wake_drain_fn drain_fn,
+    void *drain_ctx, const asx_wake_signal *signal);
+
+/* Unbind the handle. Undelivered nodes are returned to their
+ * producers' ownership undrained. Producers must have stopped. */
+ASX_API void asx_wake_handle_destroy(asx_wake_handle *h);
+
+/* -------------------------------------------------------------------
+ * Producer side
+ * ------------------------------------------------------------------- */
+
+/* Push a node onto the inbox and signal the scheduler if this is the
+ * first submission since the last drain. Lock-free.
+ * Returns ASX_OK,
+ *   ASX_E_INVALID_ARGUMENT for a NULL handle or node,
+ *   ASX_E_INVALID_STATE if the handle is not bound.
+ * Thread-safety: safe from any thread. */
+ASX_API ASX_MUST_USE asx_status asx_wake_submit(asx_wake_handle *h,
+                                                asx_wake_node *node);
+
+/* -------------------------------------------------------------------
+ * Consumer side
+ * ------------------------------------------------------------------- */
+
+/* Drain the inbox now, in FIFO order, with the handle's instance
+ * current. asx_scheduler_run does this at the start of every round;
+ * call it directly to drain outside the scheduler.
+ * *out_count (optional) receives the nodes accepted.
+ * Returns ASX_OK (also when the drain fn applied backpressure),
+ *   ASX_E_INVALID_ARGUMENT for a NULL handle,
+ *   ASX_E_INVALID_STATE if the handle is not bound,
+ *   any other status the drain fn returned. */
+ASX_API ASX_MUST_USE asx_status asx_wake_drain(asx_wake_handle *h,
+                                               uint32_t *out_count);
+
+/* Drain function forwarding node->value into a channel; ctx points at
+ * the asx_channel_id. A full channel applies backpressure. */
+ASX_API asx_status asx_wake_drain_to_channel(void *ctx, asx_wake_node *node);
+
+ASX_API ASX_MUST_USE asx_status asx_wake_stats_get(const asx_wake_handle *h,
+                                                   asx_wake_stats *out);
+
+/* -------------------------------------------------------------------
+ * Platform wake signal
+ * ------------------------------------------------------------------- */
+
+#if defined(ASX_PROFILE_POSIX)
+/* eventfd on Linux, a non-blocking pipe elsewhere. Register read_fd
+ * with the reactor; signal writes it, clear empties it. */
+typedef struct {
+    int read_fd;
+    int write_fd;   /* equals read_fd for eventfd */
+} asx_posix_wake_fd;
+
+/* Returns ASX_OK, ASX_E_INVALID_ARGUMENT for NULL arguments,
+ * ASX_E_RESOURCE_EXHAUSTED if the descriptor cannot be created. */
+ASX_API ASX_MUST_USE asx_status asx_posix_wake_fd_open(asx_posix_wake_fd *w,
+                                                       asx_wake_signal *out);
+ASX_API void asx_posix_wake_fd_close(asx_posix_wake_fd *w);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_RUNTIME_WAKE_H */
@@ -5,6 +5,7 @@
  *   - Deterministic tie-break: same-deadline timers fire in insertion order
  *   - O(1) cancel via generation-validated handles
  *   - Fixed-size arena (no dynamic allocation)
+ *   - Optional per-timer slack, letting nearby timers share one expiry
  *
  * SPDX-License-Identifier: MIT
  */
@@ -66,6 +67,44 @@ ASX_API ASX_MUST_USE asx_status asx_timer_register(
     void *waker_data,
     asx_timer_handle *out_handle);
 
+/* -------------------------------------------------------------------
+ * Slack (coalescing)
+ *
+ * A timer registered with slack_ns may fire anywhere in
+ * [deadline, deadline + slack_ns]. asx_timer_next_expiry() picks the
+ * next batch time as the earliest deadline + slack over live timers;
+ * waiting until then and collecting fires every timer whose deadline
+ * has passed in one batch, so timers spread across a window cost one
+ * reactor wakeup instead of one each. Within a batch the usual
+ * (deadline ASC, insertion_seq ASC) order holds. Slack 0 is the exact
+ * behaviour of asx_timer_register.
+ * ------------------------------------------------------------------- */
+
+/* Register a timer that may fire up to slack_ns after deadline.
+ * Returns as asx_timer_register; the duration limit applies to
+ * deadline (slack saturates at the end of the time range). */
+ASX_API ASX_MUST_USE asx_status asx_timer_register_slack(
+    asx_timer_wheel *wheel,
+    asx_time deadline,
+    uint64_t slack_ns,
+    void *waker_data,
+    asx_timer_handle *out_handle);
+
+/* Time the next batch must fire: the minimum deadline + slack over
+ * live timers. Returns 1 and fills *out_time, or 0 if no timer is
+ * live. Collecting at *out_time fires at least one timer.
+ *
+ * Preconditions: wheel and out_time must not be NULL.
+ * Thread-safety: not thread-safe; single-threaded mode only. */
+ASX_API int asx_timer_next_expiry(const asx_timer_wheel *wheel,
+                                  asx_time *out_time);
+
+/* Milliseconds a reactor wait may block before the next batch is due
+ * at time now, rounded up and capped at max_ms (max_ms when no timer
+ * is live, 0 when a batch is already due). */
+ASX_API uint32_t asx_timer_wait_ms(const asx_timer_wheel *wheel,
+                                   asx_time now, uint32_t max_ms);
+
 /* -------------------------------------------------------------------
  * Timer cancellation (O(1) logical cancel)
  *
@@ -106,8 +145,8 @@ ASX_API uint32_t asx_timer_collect_expired(
 /* -------------------------------------------------------------------
  * Timer update (cancel + re-register)
  *
- * Cancels the old timer and registers a new one with a fresh handle.
- * Returns ASX_OK on success. If the old handle is stale, the new
+ * Cancels the old timer and registers a new one with a fresh handle
+ * and no slack. Returns ASX_OK on success. If the old handle is stale, the new
  * timer is still registered (old cancel is a no-op).
  * ------------------------------------------------------------------- */
 
@@ -139,10 +178,11 @@ ASX_API void asx_timer_set_max_duration(asx_timer_wheel *wheel,
 ASX_API void asx_timer_advance(asx_timer_wheel *wheel, asx_time now);
 
 /* -------------------------------------------------------------------
- * Singleton wheel (global instance for walking skeleton)
+ * Instance wheel (one per asx_runtime, see asx/runtime/instance.h)
  * ------------------------------------------------------------------- */
 
-/* Get the global timer wheel instance. */
+/* Get the timer wheel of the calling thread's current runtime
+ * instance (the default instance unless another was entered). */
 ASX_API asx_timer_wheel *asx_timer_wheel_global(void);
 
 #ifdef __cplusplus
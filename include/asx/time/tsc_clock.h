@@ -0,0 +1,107 @@
+/*
+ * asx/time/tsc_clock.h — calibrated cycle-counter clock hook
+ *
+ * Converts a raw cycle counter (TSC on x86-64, CNTVCT on AArch64)
+ * into nanoseconds on the time base of a reference clock (e.g.
+ * CLOCK_MONOTONIC), so a clock read costs one counter read and a
+ * multiply instead of a system call:
+ *
+ *   ns = base_ns + ((cycles - base_cycles) * mult) >> ASX_TSC_SHIFT
+ *
+ * Calibration samples the counter against the reference over a short
+ * window at init. Every resync interval (measured in counter cycles)
+ * the clock reads the reference once, re-derives mult over the whole
+ * interval and rebases, so rate error and drift cannot accumulate.
+ * Readings never go backwards across a resync.
+ *
+ * A source that is not invariant (its rate changes with P/C-states)
+ * puts the clock in fallback mode: every read goes to the reference.
+ *
+ * The portable conversion lives here; the platform adapter supplies
+ * the counter and reference reads. In deterministic builds the
+ * runtime reads the logical clock, so the hook only affects live
+ * (ASX_DETERMINISTIC=0) builds and direct callers.
+ *
+ * Thread-safety: a clock is owned by one thread (one per shard).
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef ASX_TIME_TSC_CLOCK_H
+#define ASX_TIME_TSC_CLOCK_H
+
+#include <stdint.h>
+#include <asx/asx_export.h>
+#include <asx/asx_status.h>
+#include <asx/asx_ids.h>
+#include <asx/asx_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fractional bits of mult (ns per cycle) */
+#define ASX_TSC_SHIFT 32u
+
+/* Defaults for asx_tsc_clock_init (0 selects them) */
+#define ASX_TSC_DEFAULT_CALIBRATION_NS 10000000ULL    /* 10 ms */
+#define ASX_TSC_DEFAULT_RESYNC_NS      1000000000ULL  /* 1 s */
+
+typedef uint64_t (*asx_tsc_counter_fn)(void *ctx);
+
+typedef struct {
+    void               *ctx;
+    asx_tsc_counter_fn  read_counter; /* raw cycle counter */
+    asx_clock_now_ns_fn read_ref;     /* reference clock, ns */
+    int                 invariant;    /* 1 if the counter rate is constant */
+} asx_tsc_source;
+
+/* Clock state (caller-owned; treat fields as private). */
+typedef struct {
+    asx_tsc_source src;
+    uint64_t       base_cycles;
+    asx_time       base_ns;
+    uint64_t       mult;           /* ns per cycle << ASX_TSC_SHIFT */
+    uint64_t       resync_ns;
+    uint64_t       resync_cycles;  /* resync_ns converted at calibration */
+    asx_time       last_ns;        /* monotonic clamp */
+    uint32_t       resyncs;
+    int            fallback;       /* 1: every read goes to read_ref */
+} asx_tsc_clock;
+
+/* Calibrate against the reference for calibration_ns (busy-waits that
+ * long) and set the resync interval. A non-invariant source, or a
+ * counter that does not advance during calibration, selects fallback
+ * mode; that is not an error.
+ * Returns ASX_OK, ASX_E_INVALID_ARGUMENT for a NULL clock/source or a
+ * source without read_ref (read_counter may be NULL only when the
+ * source is not invariant). */
+ASX_API ASX_MUST_USE asx_status asx_tsc_clock_init(asx_tsc_clock *clk,
+                                                   const asx_tsc_source *src,
+                                                   uint64_t calibration_ns,
+                                                   uint64_t resync_ns);
+
+/* Current time in ns on the reference time base. */
+ASX_API asx_time asx_tsc_clock_now(asx_tsc_clock *clk);
+
+/* 1 if reads go straight to the reference clock. */
+ASX_API int asx_tsc_clock_is_fallback(const asx_tsc_clock *clk);
+
+/* Point out->now_ns_fn at this clock (out->ctx = clk). The logical
+ * clock entry is left as is; it must not depend on ctx. */
+ASX_API void asx_tsc_clock_hooks(asx_tsc_clock *clk, asx_clock_hooks *out);
+
+#if defined(ASX_PROFILE_POSIX)
+/* Platform source: TSC (rdtsc; invariant per CPUID 0x80000007 EDX[8])
+ * on x86-64, CNTVCT_EL0 (always invariant) on AArch64, CLOCK_MONOTONIC
+ * as reference. Other targets get a non-invariant source, i.e.
+ * fallback to CLOCK_MONOTONIC. Returns ASX_OK, ASX_E_INVALID_ARGUMENT
+ * if out is NULL. */
+ASX_API asx_status asx_posix_tsc_source(asx_tsc_source *out);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASX_TIME_TSC_CLOCK_H */
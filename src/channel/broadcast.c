@@ -0,0 +1,437 @@
+/*
+ * broadcast.c — bounded single-producer broadcast channel
+ *
+ * Walking skeleton: single-threaded, non-blocking. Fixed-size arena of
+ * broadcast slots, each with a message ring and a fixed table of
+ * subscriber cursors.
+ *
+ * A message is written once at values[seq % capacity]; a subscriber
+ * reads sequences [cursor, head). The ring keeps [tail, head) with tail
+ * the slowest live cursor, so its lag (head - tail) is what the
+ * overload policy is evaluated against on each send.
+ *
+ * Capacity invariant: head - tail <= capacity
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/core/broadcast.h>
+#include <string.h>
+#include "../runtime/runtime_internal.h"
+
+/* ------------------------------------------------------------------ */
+/* Broadcast arena (owned by the current runtime instance)            */
+/* ------------------------------------------------------------------ */
+
+#define g_broadcasts (g_rt->broadcasts)
+
+/* ------------------------------------------------------------------ */
+/* Internal helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+static asx_status broadcast_slot_lookup(asx_broadcast_id id,
+                                        asx_broadcast_slot **out)
+{
+    uint16_t slot_idx;
+    asx_broadcast_slot *b;
+
+    if (!asx_handle_is_valid(id)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (asx_handle_type_tag(id) != ASX_TYPE_BROADCAST) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    slot_idx = asx_handle_slot(id);
+    if (slot_idx >= ASX_MAX_BROADCASTS) {
+        return ASX_E_NOT_FOUND;
+    }
+
+    b = &g_broadcasts[slot_idx];
+    if (!b->alive) {
+        return ASX_E_NOT_FOUND;
+    }
+    if (b->generation != asx_handle_generation(id)) {
+        return ASX_E_STALE_HANDLE;
+    }
+
+    *out = b;
+    return ASX_OK;
+}
+
+/* Subscriber handles index a flat [broadcast][subscriber] table. */
+static asx_status broadcast_sub_lookup(asx_subscriber_id id,
+                                       asx_broadcast_slot **out_b,
+                                       asx_broadcast_sub **out_s)
+{
+    uint16_t slot_idx;
+    asx_broadcast_slot *b;
+    asx_broadcast_sub *s;
+
+    if (!asx_handle_is_valid(id)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (asx_handle_type_tag(id) != ASX_TYPE_SUBSCRIBER) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    slot_idx = asx_handle_slot(id);
+    if (slot_idx >= ASX_MAX_BROADCASTS * ASX_BROADCAST_MAX_SUBSCRIBERS) {
+        return ASX_E_NOT_FOUND;
+    }
+
+    b = &g_broadcasts[slot_idx / ASX_BROADCAST_MAX_SUBSCRIBERS];
+    s = &b->subs[slot_idx % ASX_BROADCAST_MAX_SUBSCRIBERS];
+    if (!b->alive || !s->alive) {
+        return ASX_E_NOT_FOUND;
+    }
+    if (s->generation != asx_handle_generation(id)) {
+        return ASX_E_STALE_HANDLE;
+    }
+
+    *out_b = b;
+    *out_s = s;
+    return ASX_OK;
+}
+
+/* Recompute tail as the slowest live cursor. */
+static void broadcast_update_tail(asx_broadcast_slot *b)
+{
+    uint64_t tail = b->head;
+    uint32_t i;
+
+    for (i = 0; i < ASX_BROADCAST_MAX_SUBSCRIBERS; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by subscriber table");
+        if (b->subs[i].alive && b->subs[i].cursor < tail) {
+            tail = b->subs[i].cursor;
+        }
+    }
+    b->tail = tail;
+}
+
+/* Drop the n oldest retained messages: cursors still on them skip to
+ * the new tail and count what they missed. */
+static void broadcast_shed(asx_broadcast_slot *b, uint32_t n)
+{
+    uint64_t new_tail = b->tail + n;
+    uint32_t i;
+
+    for (i = 0; i < ASX_BROADCAST_MAX_SUBSCRIBERS; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by subscriber table");
+        asx_broadcast_sub *s = &b->subs[i];
+        if (s->alive && s->cursor < new_tail) {
+            s->missed += new_tail - s->cursor;
+            s->cursor = new_tail;
+        }
+    }
+    b->tail = new_tail;
+    b->stats.shed += n;
+}
+
+/* ------------------------------------------------------------------ */
+/* Broadcast lifecycle                                                */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_broadcast_create(asx_region_id region,
+                                uint32_t capacity,
+                                const asx_overload_policy *policy,
+                                asx_broadcast_id *out_id)
+{
+    uint16_t i;
+    asx_broadcast_slot *b;
+
+    if (out_id == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (capacity == 0 || capacity > ASX_BROADCAST_MAX_CAPACITY) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (!asx_handle_is_valid(region)
+        || asx_handle_type_tag(region) != ASX_TYPE_REGION) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (policy != NULL
+        && (policy->threshold_pct == 0 || policy->threshold_pct > 100u
+            || (policy->mode != ASX_OVERLOAD_REJECT
+                && policy->mode != ASX_OVERLOAD_SHED_OLDEST
+                && policy->mode != ASX_OVERLOAD_BACKPRESSURE))) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < ASX_MAX_BROADCASTS; i++) {
+        if (!g_broadcasts[i].alive) {
+            uint16_t gen = g_broadcasts[i].generation;
+            b = &g_broadcasts[i];
+
+            memset(b, 0, sizeof(*b));
+            b->generation = gen;
+            b->alive      = 1;
+            b->region     = region;
+            b->capacity   = capacity;
+            if (policy != NULL) {
+                b->policy = *policy;
+            } else {
+                asx_overload_policy_init(&b->policy);
+                b->policy.threshold_pct = 100u;
+            }
+
+            *out_id = asx_handle_pack(ASX_TYPE_BROADCAST, 0,
+                                      asx_handle_pack_index(gen, i));
+            return ASX_OK;
+        }
+    }
+
+    return ASX_E_RESOURCE_EXHAUSTED;
+}
+
+asx_status asx_broadcast_close(asx_broadcast_id id)
+{
+    asx_broadcast_slot *b;
+    asx_status st;
+
+    st = broadcast_slot_lookup(id, &b);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (b->closed) {
+        return ASX_E_INVALID_STATE;
+    }
+    b->closed = 1;
+    return ASX_OK;
+}
+
+asx_status asx_broadcast_subscribe(asx_broadcast_id id,
+                                   asx_subscriber_id *out_sub)
+{
+    asx_broadcast_slot *b;
+    asx_broadcast_sub *s;
+    asx_status st;
+    uint32_t i, flat;
+
+    if (out_sub == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = broadcast_slot_lookup(id, &b);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (b->closed) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    for (i = 0; i < ASX_BROADCAST_MAX_SUBSCRIBERS; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by subscriber table");
+        s = &b->subs[i];
+        if (s->alive) {
+            continue;
+        }
+        s->alive  = 1;
+        s->cursor = b->head;
+        s->missed = 0;
+        b->sub_count++;
+        if (b->sub_count == 1u) {
+            b->tail = b->head;
+        }
+
+        flat = (uint32_t)(b - g_broadcasts) * ASX_BROADCAST_MAX_SUBSCRIBERS
+             + i;
+        *out_sub = asx_handle_pack(ASX_TYPE_SUBSCRIBER, 0,
+                                   asx_handle_pack_index(s->generation,
+                                                         (uint16_t)flat));
+        return ASX_OK;
+    }
+
+    return ASX_E_RESOURCE_EXHAUSTED;
+}
+
+asx_status asx_broadcast_unsubscribe(asx_subscriber_id sub)
+{
+    asx_broadcast_slot *b;
+    asx_broadcast_sub *s;
+    asx_status st;
+
+    st = broadcast_sub_lookup(sub, &b, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    s->alive = 0;
+    s->generation++;
+    b->sub_count--;
+    broadcast_update_tail(b);
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Send                                                               */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_broadcast_send(asx_broadcast_id id, uint64_t value)
+{
+    asx_broadcast_slot *b;
+    asx_overload_decision d;
+    asx_status st;
+    uint32_t used, shed;
+
+    st = broadcast_slot_lookup(id, &b);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (b->closed) {
+        return ASX_E_INVALID_STATE;
+    }
+    if (b->sub_count == 0) {
+        return ASX_E_DISCONNECTED;
+    }
+
+    used = (uint32_t)(b->head - b->tail);
+    if (used > b->stats.max_lag) {
+        b->stats.max_lag = used;
+    }
+
+    asx_overload_evaluate(&b->policy, used, b->capacity, &d);
+    if (d.triggered) {
+        switch (d.mode) {
+        case ASX_OVERLOAD_REJECT:
+            b->stats.rejected++;
+            return d.admit_status;
+        case ASX_OVERLOAD_BACKPRESSURE:
+            b->stats.deferred++;
+            return d.admit_status;
+        case ASX_OVERLOAD_SHED_OLDEST:
+            shed = d.shed_count;
+            if (shed == 0 && used == b->capacity) {
+                shed = 1;
+            }
+            if (shed > 0) {
+                broadcast_shed(b, shed);
+            }
+            break;
+        }
+    }
+
+    b->values[b->head % b->capacity] = value;
+    b->head++;
+    b->stats.sent++;
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Receive                                                            */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_broadcast_try_recv(asx_subscriber_id sub,
+                                  uint64_t *out_value,
+                                  uint64_t *out_missed)
+{
+    asx_broadcast_slot *b;
+    asx_broadcast_sub *s;
+    asx_status st;
+    int was_slowest;
+
+    if (out_value == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = broadcast_sub_lookup(sub, &b, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    if (out_missed != NULL) {
+        *out_missed = s->missed;
+        s->missed = 0;
+    }
+
+    if (s->cursor < b->head) {
+        was_slowest = s->cursor == b->tail;
+        *out_value = b->values[s->cursor % b->capacity];
+        s->cursor++;
+        if (was_slowest) {
+            broadcast_update_tail(b);
+        }
+        return ASX_OK;
+    }
+
+    if (b->closed) {
+        return ASX_E_DISCONNECTED;
+    }
+    return ASX_E_WOULD_BLOCK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Queries                                                            */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_broadcast_lag(asx_subscriber_id sub,
+                             uint32_t *out_pending,
+                             uint64_t *out_missed)
+{
+    asx_broadcast_slot *b;
+    asx_broadcast_sub *s;
+    asx_status st;
+
+    st = broadcast_sub_lookup(sub, &b, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    if (out_pending != NULL) {
+        *out_pending = (uint32_t)(b->head - s->cursor);
+    }
+    if (out_missed != NULL) {
+        *out_missed = s->missed;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_broadcast_get_stats(asx_broadcast_id id,
+                                   asx_broadcast_stats *out)
+{
+    asx_broadcast_slot *b;
+    asx_status st;
+
+    if (out == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = broadcast_slot_lookup(id, &b);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    *out = b->stats;
+    return ASX_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/* Reset (test support)                                               */
+/* ------------------------------------------------------------------ */
+
+void asx_broadcast_reset(void)
+{
+    uint16_t i;
+    uint32_t j;
+
+    for (i = 0; i < ASX_MAX_BROADCASTS; i++) {
+        asx_broadcast_slot *b = &g_broadcasts[i];
+        uint16_t gen = b->generation;
+        uint16_t sub_gen[ASX_BROADCAST_MAX_SUBSCRIBERS];
+
+        if (b->alive) {
+            gen++;
+        }
+        for (j = 0; j < ASX_BROADCAST_MAX_SUBSCRIBERS; j++) {
+            ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by "
+                                  "subscriber table");
+            sub_gen[j] = (uint16_t)(b->subs[j].generation
+                                    + (b->subs[j].alive ? 1u : 0u));
+        }
+        memset(b, 0, sizeof(*b));
+        b->generation = gen;
+        for (j = 0; j < ASX_BROADCAST_MAX_SUBSCRIBERS; j++) {
+            ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by "
+                                  "subscriber table");
+            b->subs[j].generation = sub_gen[j];
+        }
+    }
+}
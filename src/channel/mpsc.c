@@ -4,6 +4,12 @@
  * Walking skeleton: single-threaded, non-blocking (try_reserve/try_recv).
  * Fixed-size arena of channel slots with ring-buffer message queues.
  *
+ * Ring storage is sized per channel: capacity rounded up to a power of
+ * two, so positions wrap with a mask. Rings are carved from a static
+ * per-instance reserve managed as a buddy system (freed blocks merge
+ * with their free buddy) and, once it is exhausted, allocated through
+ * the allocator hook.
+ *
  * Two-phase protocol:
  *   1. try_reserve — claims capacity, returns permit
  *   2. send (via permit) — enqueues value FIFO
@@ -11,6 +17,12 @@
  *
  * Capacity invariant: queue_len + reserved_count <= capacity
  *
+ * Readiness: each channel keeps a bit in its owning region's readiness
+ * word, set while try_recv would not block. asx_channel_select finds a
+ * ready channel of a set with find-first-set and otherwise parks the
+ * task as receive waiter on every channel of the set; the first one
+ * to become ready wakes it.
+ *
  * Semantics specified in docs/CHANNEL_TIMER_KERNEL_SEMANTICS.md.
  *
  * SPDX-License-Identifier: MIT
@@ -18,31 +30,30 @@
 
 #include <asx/asx.h>
 #include <asx/core/channel.h>
+#include <asx/core/transition.h>
 #include <string.h>
+#include "../runtime/runtime_internal.h"
 
 /* ------------------------------------------------------------------ */
-/* Internal channel slot                                              */
+/* Channel arena (owned by the current runtime instance)              */
 /* ------------------------------------------------------------------ */
 
-typedef struct {
-    asx_channel_state state;
-    asx_region_id     region;
-    uint16_t          generation;
-    int               alive;
-
-    /* Bounded ring buffer */
-    uint32_t          capacity;
-    uint64_t          queue[ASX_CHANNEL_MAX_CAPACITY];
-    uint32_t          queue_head;   /* next read position */
-    uint32_t          queue_len;    /* committed messages in queue */
-
-    /* Two-phase accounting */
-    uint32_t          reserved;     /* outstanding permits */
-    uint32_t          next_token;   /* monotonic permit token */
-} asx_channel_slot;
-
-static asx_channel_slot g_channels[ASX_MAX_CHANNELS];
-static uint32_t         g_channel_count;
+#define g_channels      (g_rt->channels)
+#define g_channel_count (g_rt->channel_count)
+#define g_channel_ready (g_rt->channel_ready)
+#define g_channel_reserve (g_rt->channel_reserve)
+#define g_channel_free    (g_rt->channel_free)
+
+#if ASX_MAX_CHANNELS > 32u
+#error "channel readiness words hold one bit per channel slot"
+#endif
+#if ASX_CHANNEL_RESERVE_SLOTS != 0u \
+    && (ASX_CHANNEL_RESERVE_SLOTS & (ASX_CHANNEL_RESERVE_SLOTS - 1u)) != 0u
+#error "ASX_CHANNEL_RESERVE_SLOTS must be 0 or a power of two"
+#endif
+#if ASX_CHANNEL_MAX_CAPACITY > 0x80000000u
+#error "ASX_CHANNEL_MAX_CAPACITY must round up to a 32-bit power of two"
+#endif
 
 /* ------------------------------------------------------------------ */
 /* Internal helpers                                                   */
@@ -87,6 +98,250 @@ static asx_channel_id channel_make_handle(uint16_t slot_idx, uint16_t gen)
     return asx_handle_pack(ASX_TYPE_CHANNEL, 0, index);
 }
 
+/* ------------------------------------------------------------------ */
+/* Readiness                                                          */
+/* ------------------------------------------------------------------ */
+
+static uint32_t channel_lowest_bit(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(v);
+#else
+    uint32_t n = 0;
+    while ((v & 1u) == 0) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bit scan bounded by word width");
+        v >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static int channel_recv_ready(const asx_channel_slot *s)
+{
+    return s->queue_len > 0
+        || s->state == ASX_CHANNEL_SENDER_CLOSED
+        || s->state == ASX_CHANNEL_FULLY_CLOSED;
+}
+
+/* Drop every select registration of task. */
+static void channel_clear_waiter(asx_task_id task)
+{
+    uint32_t i;
+
+    for (i = 0; i < ASX_MAX_CHANNELS; i++) {
+        if (g_channels[i].recv_waiter == task) {
+            g_channels[i].recv_waiter = ASX_INVALID_ID;
+        }
+    }
+}
+
+/* Refresh s's readiness bit after a queue or state change; a channel
+ * that became ready wakes the task parked on it in select. */
+static void channel_sync_ready(asx_channel_slot *s)
+{
+    uint32_t bit = 1u << (uint32_t)(s - g_channels);
+    uint32_t *word = &g_channel_ready[asx_handle_slot(s->region)];
+    asx_task_id waiter;
+    asx_task_slot *t;
+
+    if (!channel_recv_ready(s)) {
+        *word &= ~bit;
+        return;
+    }
+    *word |= bit;
+
+    waiter = s->recv_waiter;
+    if (waiter == ASX_INVALID_ID) {
+        return;
+    }
+    channel_clear_waiter(waiter);
+    if (asx_task_slot_lookup(waiter, &t) == ASX_OK) {
+        ASX_TASK_UNPARK(t);
+    }
+}
+
+void asx_channel_ready_rebuild(void)
+{
+    uint32_t i;
+
+    memset(g_channel_ready, 0, sizeof(g_channel_ready));
+    for (i = 0; i < ASX_MAX_CHANNELS; i++) {
+        if (g_channels[i].alive) {
+            g_channels[i].recv_waiter = ASX_INVALID_ID;
+            channel_sync_ready(&g_channels[i]);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Ring storage                                                       */
+/* ------------------------------------------------------------------ */
+
+/* Smallest k with 2^k >= n. */
+static uint32_t channel_order(uint32_t n)
+{
+    uint32_t k = 0;
+
+    while ((1u << k) < n) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by word width");
+        k++;
+    }
+    return k;
+}
+
+static void reserve_push(uint32_t k, uint32_t off)
+{
+    g_channel_reserve[off] = g_channel_free[k];
+    g_channel_free[k] = off + 1u;
+}
+
+/* Unlink the block at off from free list k; 0 if it is not on it. */
+static int reserve_unlink(uint32_t k, uint32_t off)
+{
+    uint32_t prev = 0;
+    uint32_t cur = g_channel_free[k];
+
+    while (cur != 0) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by free blocks "
+                              "of one order in the reserve");
+        if (cur == off + 1u) {
+            if (prev == 0) {
+                g_channel_free[k] = (uint32_t)g_channel_reserve[off];
+            } else {
+                g_channel_reserve[prev - 1u] = g_channel_reserve[off];
+            }
+            return 1;
+        }
+        prev = cur;
+        cur = (uint32_t)g_channel_reserve[cur - 1u];
+    }
+    return 0;
+}
+
+/* Take a block of 2^k messages, splitting a larger one if needed. */
+static int reserve_take(uint32_t k, uint32_t *out_off)
+{
+    uint32_t top = channel_order(ASX_CHANNEL_RESERVE_SLOTS);
+    uint32_t j = k;
+    uint32_t off;
+
+    if (ASX_CHANNEL_RESERVE_SLOTS == 0u) {
+        return 0;   /* no reserve: every ring comes from the hook */
+    }
+    if (!g_rt->channel_reserve_ready) {
+        memset(g_channel_free, 0, sizeof(g_channel_free));
+        reserve_push(top, 0);
+        g_rt->channel_reserve_ready = 1;
+    }
+
+    while (j <= top && g_channel_free[j] == 0) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by reserve orders");
+        j++;
+    }
+    if (j > top) {
+        return 0;
+    }
+
+    off = g_channel_free[j] - 1u;
+    g_channel_free[j] = (uint32_t)g_channel_reserve[off];
+    while (j > k) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by reserve orders");
+        j--;
+        reserve_push(j, off + (1u << j));
+    }
+    *out_off = off;
+    return 1;
+}
+
+/* Return a block of 2^k messages, merging it with free buddies. */
+static void reserve_give(uint32_t k, uint32_t off)
+{
+    uint32_t top = channel_order(ASX_CHANNEL_RESERVE_SLOTS);
+
+    while (k < top && reserve_unlink(k, off ^ (1u << k))) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by reserve orders");
+        off &= ~(1u << k);
+        k++;
+    }
+    reserve_push(k, off);
+}
+
+static asx_status channel_ring_alloc(uint32_t k, uint64_t **out_ring,
+                                     int *out_heap)
+{
+    uint32_t off;
+    void *mem;
+
+    if (reserve_take(k, &off)) {
+        *out_ring = &g_channel_reserve[off];
+        *out_heap = 0;
+        return ASX_OK;
+    }
+    if (asx_runtime_alloc(sizeof(uint64_t) << k, &mem) != ASX_OK) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    *out_ring = (uint64_t *)mem;
+    *out_heap = 1;
+    return ASX_OK;
+}
+
+static void channel_ring_release(asx_channel_slot *s)
+{
+    if (s->queue == NULL) {
+        return;
+    }
+    if (s->queue_heap) {
+        (void)asx_runtime_free(s->queue);
+    } else {
+        reserve_give(channel_order(s->queue_mask + 1u),
+                     (uint32_t)(s->queue - g_channel_reserve));
+    }
+    s->queue      = NULL;
+    s->queue_mask = 0;
+    s->queue_heap = 0;
+}
+
+/* Move s's queued messages into a fresh ring of 2^k entries. */
+static asx_status channel_ring_resize(asx_channel_slot *s, uint32_t k)
+{
+    uint64_t *ring;
+    uint32_t i;
+    int heap;
+    asx_status st;
+
+    st = channel_ring_alloc(k, &ring, &heap);
+    if (st != ASX_OK) {
+        return st;
+    }
+    for (i = 0; i < s->queue_len; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: bounded by queue length");
+        ring[i] = s->queue[(s->queue_head + i) & s->queue_mask];
+    }
+    channel_ring_release(s);
+    s->queue      = ring;
+    s->queue_mask = (1u << k) - 1u;
+    s->queue_heap = heap;
+    s->queue_head = 0;
+    return ASX_OK;
+}
+
+asx_status asx_channel_storage_attach(asx_channel_slot *ch,
+                                      uint32_t capacity)
+{
+    uint32_t len = ch->queue_len;
+    asx_status st;
+
+    ch->queue_len = 0;
+    st = channel_ring_resize(ch, channel_order(capacity));
+    if (st != ASX_OK) {
+        ch->queue_len = len;
+        return st;
+    }
+    ch->capacity = capacity;
+    return ASX_OK;
+}
+
 /* ------------------------------------------------------------------ */
 /* Channel lifecycle                                                  */
 /* ------------------------------------------------------------------ */
@@ -104,7 +359,9 @@ asx_status asx_channel_create(asx_region_id region,
     if (capacity == 0 || capacity > ASX_CHANNEL_MAX_CAPACITY) {
         return ASX_E_INVALID_ARGUMENT;
     }
-    if (!asx_handle_is_valid(region)) {
+    if (!asx_handle_is_valid(region)
+        || asx_handle_type_tag(region) != ASX_TYPE_REGION
+        || asx_handle_slot(region) >= ASX_MAX_REGIONS) {
         return ASX_E_INVALID_ARGUMENT;
     }
 
@@ -112,15 +369,18 @@ asx_status asx_channel_create(asx_region_id region,
         if (!g_channels[i].alive) {
             s = &g_channels[i];
 
+            s->queue_len = 0;
+            if (asx_channel_storage_attach(s, capacity) != ASX_OK) {
+                return ASX_E_RESOURCE_EXHAUSTED;
+            }
             s->state       = ASX_CHANNEL_OPEN;
             s->region      = region;
             s->alive       = 1;
-            s->capacity    = capacity;
-            s->queue_head  = 0;
-            s->queue_len   = 0;
             s->reserved    = 0;
             s->next_token  = 1;
-            memset(s->queue, 0, sizeof(s->queue));
+            s->recv_waiter = ASX_INVALID_ID;
+            s->admit_engaged = 0;
+            channel_sync_ready(s);
 
             g_channel_count++;
             *out_id = channel_make_handle(i, s->generation);
@@ -144,9 +404,11 @@ asx_status asx_channel_close_sender(asx_channel_id id)
     switch (s->state) {
     case ASX_CHANNEL_OPEN:
         s->state = ASX_CHANNEL_SENDER_CLOSED;
+        channel_sync_ready(s);
         return ASX_OK;
     case ASX_CHANNEL_RECEIVER_CLOSED:
         s->state = ASX_CHANNEL_FULLY_CLOSED;
+        channel_sync_ready(s);
         return ASX_OK;
     case ASX_CHANNEL_SENDER_CLOSED:
     case ASX_CHANNEL_FULLY_CLOSED:
@@ -171,11 +433,19 @@ asx_status asx_channel_close_receiver(asx_channel_id id)
         s->state = ASX_CHANNEL_RECEIVER_CLOSED;
         s->queue_len = 0;
         s->queue_head = 0;
+        channel_sync_ready(s);
+        if (s->admit_engaged) {
+            asx_admission_on_channel_drain(s);
+        }
         return ASX_OK;
     case ASX_CHANNEL_SENDER_CLOSED:
         s->state = ASX_CHANNEL_FULLY_CLOSED;
         s->queue_len = 0;
         s->queue_head = 0;
+        channel_sync_ready(s);
+        if (s->admit_engaged) {
+            asx_admission_on_channel_drain(s);
+        }
         return ASX_OK;
     case ASX_CHANNEL_RECEIVER_CLOSED:
     case ASX_CHANNEL_FULLY_CLOSED:
@@ -240,6 +510,39 @@ asx_status asx_channel_reserved_count(asx_channel_id id, uint32_t *out)
     return ASX_OK;
 }
 
+/* ------------------------------------------------------------------ */
+/* Capacity change                                                    */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_channel_set_capacity(asx_channel_id id, uint32_t capacity)
+{
+    asx_channel_slot *s;
+    asx_status st;
+    uint32_t k;
+
+    if (capacity == 0 || capacity > ASX_CHANNEL_MAX_CAPACITY) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = channel_slot_lookup(id, &s);
+    if (st != ASX_OK) {
+        return st;
+    }
+    if (s->reserved > 0 || s->queue_len > capacity) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    /* Storage changes only when the rounded size does */
+    k = channel_order(capacity);
+    if ((1u << k) != s->queue_mask + 1u) {
+        st = channel_ring_resize(s, k);
+        if (st != ASX_OK) {
+            return st;
+        }
+    }
+    s->capacity = capacity;
+    return ASX_OK;
+}
+
 /* ------------------------------------------------------------------ */
 /* Two-phase send: reserve                                            */
 /* ------------------------------------------------------------------ */
@@ -268,6 +571,13 @@ asx_status asx_channel_try_reserve(asx_channel_id id,
         return ASX_E_DISCONNECTED;
     }
 
+    if (g_rt->admission[asx_handle_slot(s->region)].enabled) {
+        st = asx_admission_on_reserve(s);
+        if (st != ASX_OK) {
+            return st;
+        }
+    }
+
     if (s->queue_len + s->reserved >= s->capacity) {
         return ASX_E_CHANNEL_FULL;
     }
@@ -313,9 +623,10 @@ asx_status asx_send_permit_send(asx_send_permit *permit, uint64_t value)
         return ASX_E_DISCONNECTED;
     }
 
-    write_pos = (s->queue_head + s->queue_len) % s->capacity;
+    write_pos = (s->queue_head + s->queue_len) & s->queue_mask;
     s->queue[write_pos] = value;
     s->queue_len++;
+    channel_sync_ready(s);
 
     return ASX_OK;
 }
@@ -343,6 +654,9 @@ void asx_send_permit_abort(asx_send_permit *permit)
     if (s->reserved > 0) {
         s->reserved--;
     }
+    if (s->admit_engaged) {
+        asx_admission_on_channel_drain(s);
+    }
 }
 
 /* ------------------------------------------------------------------ */
@@ -365,8 +679,12 @@ asx_status asx_channel_try_recv(asx_channel_id id, uint64_t *out_value)
 
     if (s->queue_len > 0) {
         *out_value = s->queue[s->queue_head];
-        s->queue_head = (s->queue_head + 1u) % s->capacity;
+        s->queue_head = (s->queue_head + 1u) & s->queue_mask;
         s->queue_len--;
+        channel_sync_ready(s);
+        if (s->admit_engaged) {
+            asx_admission_on_channel_drain(s);
+        }
         return ASX_OK;
     }
 
@@ -378,6 +696,101 @@ asx_status asx_channel_try_recv(asx_channel_id id, uint64_t *out_value)
     return ASX_E_WOULD_BLOCK;
 }
 
+/* ------------------------------------------------------------------ */
+/* Select                                                             */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_channel_select(asx_task_id self,
+                              const asx_channel_id *ids,
+                              uint32_t count,
+                              uint32_t *out_index,
+                              uint64_t *out_value)
+{
+    asx_channel_slot *slots[ASX_MAX_CHANNELS];
+    uint32_t pos[ASX_MAX_CHANNELS];
+    asx_channel_slot *s;
+    asx_task_slot *t = NULL;
+    asx_task_slot *other;
+    asx_status st;
+    uint32_t set = 0;
+    uint32_t regions = 0;
+    uint32_t ready = 0;
+    uint32_t i, bit, slot;
+
+    if (ids == NULL || out_index == NULL || out_value == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (count == 0 || count > ASX_CHANNEL_SELECT_MAX) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (self != ASX_INVALID_ID) {
+        st = asx_task_slot_lookup(self, &t);
+        if (st != ASX_OK) {
+            return st;
+        }
+    }
+
+    /* Set of channel slots, first position of each in ids, and the
+     * regions whose readiness words cover them */
+    for (i = 0; i < count; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: select set bounded by "
+                              "ASX_CHANNEL_SELECT_MAX");
+        st = channel_slot_lookup(ids[i], &s);
+        if (st != ASX_OK) {
+            return st;
+        }
+        slot = (uint32_t)(s - g_channels);
+        bit = 1u << slot;
+        if ((set & bit) == 0) {
+            set |= bit;
+            pos[slot] = i;
+            slots[slot] = s;
+        }
+        regions |= 1u << asx_handle_slot(s->region);
+    }
+    while (regions != 0) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: one word per region, "
+                              "bounded by ASX_MAX_REGIONS");
+        i = channel_lowest_bit(regions);
+        regions &= regions - 1u;
+        ready |= g_channel_ready[i];
+    }
+    ready &= set;
+
+    if (ready != 0) {
+        /* Deterministic tie-break: lowest channel slot */
+        slot = channel_lowest_bit(ready);
+        if (self != ASX_INVALID_ID) {
+            channel_clear_waiter(self);
+        }
+        *out_index = pos[slot];
+        return asx_channel_try_recv(ids[pos[slot]], out_value);
+    }
+
+    if (t == NULL) {
+        return ASX_E_WOULD_BLOCK;
+    }
+
+    /* Nothing ready: register on the whole set, then park once */
+    for (bit = set; bit != 0; bit &= bit - 1u) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: select set bounded by "
+                              "ASX_MAX_CHANNELS");
+        s = slots[channel_lowest_bit(bit)];
+        if (s->recv_waiter != ASX_INVALID_ID && s->recv_waiter != self
+            && asx_task_slot_lookup(s->recv_waiter, &other) == ASX_OK
+            && other->parked && !asx_task_is_terminal(other->state)) {
+            return ASX_E_INVALID_STATE;
+        }
+    }
+    for (bit = set; bit != 0; bit &= bit - 1u) {
+        ASX_CHECKPOINT_WAIVER("kernel-channel: select set bounded by "
+                              "ASX_MAX_CHANNELS");
+        slots[channel_lowest_bit(bit)]->recv_waiter = self;
+    }
+    asx_task_park(t, ASX_TASK_LINK_NONE, 0);
+    return ASX_E_PENDING;
+}
+
 /* ------------------------------------------------------------------ */
 /* Reset (test support)                                               */
 /* ------------------------------------------------------------------ */
@@ -390,13 +803,24 @@ void asx_channel_reset(void)
         if (g_channels[i].alive) {
             g_channels[i].generation++;
         }
+        /* The reserve is rebuilt whole; only hook rings are freed */
+        if (g_channels[i].queue_heap) {
+            (void)asx_runtime_free(g_channels[i].queue);
+        }
+        g_channels[i].queue      = NULL;
+        g_channels[i].queue_mask = 0;
+        g_channels[i].queue_heap = 0;
         g_channels[i].alive      = 0;
         g_channels[i].state      = ASX_CHANNEL_OPEN;
+        g_channels[i].capacity   = 0;
         g_channels[i].queue_head = 0;
         g_channels[i].queue_len  = 0;
         g_channels[i].reserved   = 0;
         g_channels[i].next_token = 1;
-        memset(g_channels[i].queue, 0, sizeof(g_channels[i].queue));
+        g_channels[i].recv_waiter = ASX_INVALID_ID;
+        g_channels[i].admit_engaged = 0;
     }
+    memset(g_channel_ready, 0, sizeof(g_channel_ready));
+    g_rt->channel_reserve_ready = 0;
     g_channel_count = 0;
 }
@@ -10,20 +10,21 @@
 #include <asx/core/adaptive.h>
 #include <asx/asx_config.h>
 #include <string.h>
+#include "../runtime/runtime_internal.h"
 
 /* -------------------------------------------------------------------
- * Internal state (static, zero-allocation)
+ * Internal state (per runtime instance, zero-allocation)
  * ------------------------------------------------------------------- */
 
-static asx_adaptive_policy g_policy;
-static uint32_t            g_decision_seq;
-static uint32_t            g_fallback_count;
-static int                 g_in_fallback;
+#define g_policy         (g_rt->adaptive_policy)
+#define g_decision_seq   (g_rt->adaptive_decision_seq)
+#define g_fallback_count (g_rt->adaptive_fallback_count)
+#define g_in_fallback    (g_rt->adaptive_in_fallback)
 
 /* Ring buffer for evidence ledger */
-static asx_adaptive_ledger_entry g_ledger[ASX_ADAPTIVE_LEDGER_DEPTH];
-static uint32_t g_ledger_write;  /* next write position */
-static uint32_t g_ledger_total;  /* total entries written */
+#define g_ledger         (g_rt->adaptive_ledger)
+#define g_ledger_write   (g_rt->adaptive_ledger_write)
+#define g_ledger_total   (g_rt->adaptive_ledger_total)
 
 /* -------------------------------------------------------------------
  * Init / reset
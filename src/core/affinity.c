@@ -25,9 +25,12 @@ typedef struct {
     int                 occupied;
 } asx_affinity_entry;
 
+/* Process-wide: bind, transfer and reset entities from one thread at
+ * a time (shards only switch their thread's current domain). */
 static asx_affinity_entry g_affinity_table[ASX_AFFINITY_TABLE_CAPACITY];
 static uint32_t           g_affinity_count;
-static asx_affinity_domain g_current_domain = ASX_AFFINITY_DOMAIN_ANY;
+/* Current domain is per thread; the binding table is shared. */
+static ASX_THREAD_LOCAL asx_affinity_domain g_current_domain = ASX_AFFINITY_DOMAIN_ANY;
 
 /* -------------------------------------------------------------------
  * Internal helpers
@@ -4,6 +4,8 @@
  * Compile-time gated: entire file is a no-op unless ASX_DEBUG_GHOST is
  * defined. When active, provides deterministic violation recording with
  * zero heap allocation (fixed-size ring buffer and tracking table).
+ * Monitor state is per thread (ASX_THREAD_LOCAL), so shards running
+ * on their own threads keep independent violation records.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -20,10 +22,10 @@
  * Violation ring buffer
  * ------------------------------------------------------------------- */
 
-static asx_ghost_violation g_ghost_ring[ASX_GHOST_RING_CAPACITY];
-static uint32_t g_ghost_ring_write;   /* next write position */
-static uint32_t g_ghost_ring_count;   /* total violations recorded */
-static int      g_ghost_ring_overflow; /* set once ring wraps */
+static ASX_THREAD_LOCAL asx_ghost_violation g_ghost_ring[ASX_GHOST_RING_CAPACITY];
+static ASX_THREAD_LOCAL uint32_t g_ghost_ring_write;   /* next write position */
+static ASX_THREAD_LOCAL uint32_t g_ghost_ring_count;   /* total violations recorded */
+static ASX_THREAD_LOCAL int      g_ghost_ring_overflow; /* set once ring wraps */
 
 /* -------------------------------------------------------------------
  * Linearity tracking table
@@ -43,8 +45,8 @@ typedef struct {
     int resolved;
 } asx_ghost_linearity_entry;
 
-static asx_ghost_linearity_entry g_ghost_linearity[ASX_GHOST_LINEARITY_CAPACITY];
-static uint32_t g_ghost_linearity_count;
+static ASX_THREAD_LOCAL asx_ghost_linearity_entry g_ghost_linearity[ASX_GHOST_LINEARITY_CAPACITY];
+static ASX_THREAD_LOCAL uint32_t g_ghost_linearity_count;
 
 /* -------------------------------------------------------------------
  * Borrow ledger state (forward declarations; full API below)
@@ -57,19 +59,19 @@ typedef struct {
     int      occupied;
 } asx_ghost_borrow_entry;
 
-static asx_ghost_borrow_entry g_ghost_borrows[ASX_GHOST_BORROW_TABLE_CAPACITY];
-static uint32_t g_ghost_borrow_count;
+static ASX_THREAD_LOCAL asx_ghost_borrow_entry g_ghost_borrows[ASX_GHOST_BORROW_TABLE_CAPACITY];
+static ASX_THREAD_LOCAL uint32_t g_ghost_borrow_count;
 
 /* -------------------------------------------------------------------
  * Determinism monitor state (forward declarations; full API below)
  * ------------------------------------------------------------------- */
 
-static uint64_t g_ghost_det_events[ASX_GHOST_DETERMINISM_CAPACITY];
-static uint32_t g_ghost_det_count;
+static ASX_THREAD_LOCAL uint64_t g_ghost_det_events[ASX_GHOST_DETERMINISM_CAPACITY];
+static ASX_THREAD_LOCAL uint32_t g_ghost_det_count;
 
-static uint64_t g_ghost_det_reference[ASX_GHOST_DETERMINISM_CAPACITY];
-static uint32_t g_ghost_det_ref_count;
-static int      g_ghost_det_sealed;
+static ASX_THREAD_LOCAL uint64_t g_ghost_det_reference[ASX_GHOST_DETERMINISM_CAPACITY];
+static ASX_THREAD_LOCAL uint32_t g_ghost_det_ref_count;
+static ASX_THREAD_LOCAL int      g_ghost_det_sealed;
 
 /* Forward declaration for use in asx_ghost_reset */
 static void ghost_determinism_reset_impl(void);
@@ -199,6 +201,41 @@ void asx_ghost_obligation_resolved(asx_obligation_id id)
     entry->resolved = 1;
 }
 
+void asx_ghost_obligations_resolved(const asx_obligation_id *ids,
+                                    uint32_t count)
+{
+    uint32_t i;
+
+    if (ids == NULL || count == 0) {
+        return;
+    }
+
+    for (i = 0; i < g_ghost_linearity_count; i++) {
+        asx_ghost_linearity_entry *entry = &g_ghost_linearity[i];
+        uint32_t lo = 0;
+        uint32_t hi = count;
+
+        /* Binary search: ids are sorted ascending */
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2u;
+            if (ids[mid] < entry->id) {
+                lo = mid + 1u;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == count || ids[lo] != entry->id) {
+            continue;
+        }
+
+        if (entry->resolved) {
+            ghost_record_violation(ASX_GHOST_LINEARITY_DOUBLE, entry->id, -1, -1);
+            continue;
+        }
+        entry->resolved = 1;
+    }
+}
+
 uint32_t asx_ghost_check_obligation_leaks(asx_region_id region)
 {
     uint32_t i;
@@ -6,6 +6,8 @@
 
 #include <asx/asx.h>
 
+/* Error ledgers are per thread (ASX_THREAD_LOCAL): the task bound by
+ * the scheduler is the one running on the calling thread. */
 typedef struct asx_task_ledger {
     asx_task_id            owner;
     uint32_t               used;
@@ -15,9 +17,9 @@ typedef struct asx_task_ledger {
     asx_error_ledger_entry entries[ASX_ERROR_LEDGER_DEPTH];
 } asx_task_ledger;
 
-static asx_task_ledger g_task_ledgers[ASX_ERROR_LEDGER_TASK_SLOTS];
-static asx_task_ledger g_fallback_ledger;
-static asx_task_id     g_bound_task = ASX_INVALID_ID;
+static ASX_THREAD_LOCAL asx_task_ledger g_task_ledgers[ASX_ERROR_LEDGER_TASK_SLOTS];
+static ASX_THREAD_LOCAL asx_task_ledger g_fallback_ledger;
+static ASX_THREAD_LOCAL asx_task_id     g_bound_task = ASX_INVALID_ID;
 
 static const char *g_must_use_surfaces[] = {
     "asx_region_transition_check",
@@ -1,11 +1,298 @@
 /*
- * posix/hooks.c — POSIX platform adapter (stub)
+ * posix/hooks.c — POSIX platform adapter
+ *
+ * Shard thread hooks: one pthread per shard, pinned to its CPU with
+ * pthread_setaffinity_np on Linux (best effort; a pinning failure
+ * leaves the thread unpinned).
+ *
+ * Wake signal: an eventfd on Linux, a non-blocking self-pipe
+ * elsewhere. signal writes one token, clear reads until empty.
+ *
+ * TSC clock source: rdtsc / CNTVCT_EL0 against CLOCK_MONOTONIC.
+ *
+ * Log drainer: a pthread that drains a log ring every period.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #ifdef ASX_PROFILE_POSIX
-/* Stub: POSIX hooks pending */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#elif !defined(__linux__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/eventfd.h>
+#endif
+#include <asx/runtime/shard.h>
+#include <asx/runtime/wake.h>
+#include <asx/time/tsc_clock.h>
+#include <asx/runtime/log_ring.h>
+
+typedef struct {
+    pthread_t          thread;
+    asx_shard_entry_fn entry;
+    void              *arg;
+} asx_posix_shard_thread;
+
+static void *posix_shard_trampoline(void *p)
+{
+    asx_posix_shard_thread *t = (asx_posix_shard_thread *)p;
+
+    t->entry(t->arg);
+    return NULL;
+}
+
+static asx_status posix_shard_start(void *ctx, uint32_t cpu,
+                                    asx_shard_entry_fn entry, void *arg,
+                                    void **out_thread)
+{
+    asx_posix_shard_thread *t;
+
+    (void)ctx;
+    if (entry == NULL || out_thread == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    t = (asx_posix_shard_thread *)malloc(sizeof(*t));
+    if (t == NULL) return ASX_E_RESOURCE_EXHAUSTED;
+    t->entry = entry;
+    t->arg = arg;
+    if (pthread_create(&t->thread, NULL, posix_shard_trampoline, t) != 0) {
+        free(t);
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+#if defined(__linux__)
+    {
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET((int)(cpu % (uint32_t)CPU_SETSIZE), &set);
+        (void)pthread_setaffinity_np(t->thread, sizeof(set), &set);
+    }
+#else
+    (void)cpu;
+#endif
+    *out_thread = t;
+    return ASX_OK;
+}
+
+static asx_status posix_shard_join(void *ctx, void *thread)
+{
+    asx_posix_shard_thread *t = (asx_posix_shard_thread *)thread;
+    int rc;
+
+    (void)ctx;
+    if (t == NULL) return ASX_E_INVALID_ARGUMENT;
+    rc = pthread_join(t->thread, NULL);
+    free(t);
+    return rc == 0 ? ASX_OK : ASX_E_INVALID_STATE;
+}
+
+asx_status asx_posix_shard_thread_hooks(asx_shard_thread_hooks *out)
+{
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->ctx = NULL;
+    out->start_fn = posix_shard_start;
+    out->join_fn = posix_shard_join;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Wake signal
+ * ------------------------------------------------------------------- */
+
+static void posix_wake_signal(void *ctx)
+{
+    asx_posix_wake_fd *w = (asx_posix_wake_fd *)ctx;
+#if defined(__linux__)
+    uint64_t one = 1;
+#else
+    char one = 1;
+#endif
+    ssize_t n;
+
+    /* EAGAIN means a token is already queued: still signalled */
+    n = write(w->write_fd, &one, sizeof(one));
+    (void)n;
+}
+
+static void posix_wake_clear(void *ctx)
+{
+    asx_posix_wake_fd *w = (asx_posix_wake_fd *)ctx;
+    uint64_t buf[8];
+
+    while (read(w->read_fd, buf, sizeof(buf)) > 0) {
+        /* non-blocking: ends with EAGAIN once empty */
+    }
+}
+
+asx_status asx_posix_wake_fd_open(asx_posix_wake_fd *w, asx_wake_signal *out)
+{
+    if (w == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+#if defined(__linux__)
+    w->read_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (w->read_fd < 0) return ASX_E_RESOURCE_EXHAUSTED;
+    w->write_fd = w->read_fd;
+#else
+    {
+        int fds[2];
+
+        if (pipe(fds) != 0) return ASX_E_RESOURCE_EXHAUSTED;
+        (void)fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+        (void)fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+        (void)fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        (void)fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+        w->read_fd = fds[0];
+        w->write_fd = fds[1];
+    }
+#endif
+    out->ctx = w;
+    out->signal_fn = posix_wake_signal;
+    out->clear_fn = posix_wake_clear;
+    return ASX_OK;
+}
+
+void asx_posix_wake_fd_close(asx_posix_wake_fd *w)
+{
+    if (w == NULL || w->read_fd < 0) return;
+    (void)close(w->read_fd);
+    if (w->write_fd != w->read_fd) (void)close(w->write_fd);
+    w->read_fd = -1;
+    w->write_fd = -1;
+}
+
+/* -------------------------------------------------------------------
+ * TSC clock source
+ * ------------------------------------------------------------------- */
+
+static asx_time posix_monotonic_ns(void *ctx)
+{
+    struct timespec ts;
+
+    (void)ctx;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) return 0;
+    return (asx_time)ts.tv_sec * 1000000000u + (asx_time)ts.tv_nsec;
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+static uint64_t posix_read_tsc(void *ctx)
+{
+    uint32_t lo, hi;
+
+    (void)ctx;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/* Invariant TSC: CPUID leaf 0x80000007, EDX bit 8 */
+static int posix_tsc_invariant(void)
+{
+    uint32_t a, b, c, d;
+
+    __asm__ __volatile__("cpuid"
+                         : "=a"(a), "=b"(b), "=c"(c), "=d"(d)
+                         : "a"(0x80000000u), "c"(0u));
+    if (a < 0x80000007u) return 0;
+    __asm__ __volatile__("cpuid"
+                         : "=a"(a), "=b"(b), "=c"(c), "=d"(d)
+                         : "a"(0x80000007u), "c"(0u));
+    return (d >> 8) & 1u;
+}
+#elif defined(__GNUC__) && defined(__aarch64__)
+static uint64_t posix_read_tsc(void *ctx)
+{
+    uint64_t v;
+
+    (void)ctx;
+    __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+}
+
+/* The generic timer runs at a fixed frequency by architecture */
+static int posix_tsc_invariant(void)
+{
+    return 1;
+}
+#endif
+
+asx_status asx_posix_tsc_source(asx_tsc_source *out)
+{
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->ctx = NULL;
+    out->read_ref = posix_monotonic_ns;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__))
+    out->read_counter = posix_read_tsc;
+    out->invariant = posix_tsc_invariant();
+#else
+    out->read_counter = NULL;
+    out->invariant = 0;
+#endif
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Log drainer
+ * ------------------------------------------------------------------- */
+
+static void *posix_log_drainer_main(void *p)
+{
+    asx_posix_log_drainer *d = (asx_posix_log_drainer *)p;
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(d->period_us / 1000000u);
+    ts.tv_nsec = (long)(d->period_us % 1000000u) * 1000L;
+    while (!__atomic_load_n(&d->stop, __ATOMIC_ACQUIRE)) {
+        (void)asx_log_ring_drain(d->ring, 0);
+        (void)nanosleep(&ts, NULL);
+    }
+    return NULL;
+}
+
+asx_status asx_posix_log_drainer_start(asx_posix_log_drainer *d,
+                                       asx_log_ring *ring, uint32_t period_us)
+{
+    pthread_t *t;
+
+    if (d == NULL || ring == NULL || period_us == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    t = (pthread_t *)malloc(sizeof(*t));
+    if (t == NULL) return ASX_E_RESOURCE_EXHAUSTED;
+    d->ring = ring;
+    d->period_us = period_us;
+    d->stop = 0;
+    if (pthread_create(t, NULL, posix_log_drainer_main, d) != 0) {
+        free(t);
+        d->thread = NULL;
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+    d->thread = t;
+    return ASX_OK;
+}
+
+void asx_posix_log_drainer_stop(asx_posix_log_drainer *d)
+{
+    pthread_t *t;
+
+    if (d == NULL || d->thread == NULL) return;
+    t = (pthread_t *)d->thread;
+    __atomic_store_n(&d->stop, 1, __ATOMIC_RELEASE);
+    (void)pthread_join(*t, NULL);
+    free(t);
+    d->thread = NULL;
+    /* Records pushed after the last periodic drain */
+    while (asx_log_ring_drain(d->ring, 0) > 0) {
+        /* ring refills only while producers still run */
+    }
+}
+
 #else
 typedef int asx_no_empty_tu_warning;
 #endif
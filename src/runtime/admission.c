@@ -0,0 +1,462 @@
+/*
+ * admission.c — closed-loop admission control on spawn and reserve
+ *
+ * One controller per region slot, enabled on demand. Each admission
+ * signal (the region's live tasks, each of its channels' occupancy)
+ * carries a hysteresis flag: evaluated against threshold_pct while
+ * released and against release_pct while engaged. The policy itself
+ * is asx_overload_evaluate; this file supplies the load, applies the
+ * decision, wakes the backpressure waiter and logs to the adaptive
+ * ledger.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/admission.h>
+#include <asx/runtime/overload_catalog.h>
+#include <asx/runtime/profile_compat.h>
+#include <asx/core/adaptive.h>
+#include <string.h>
+#include "runtime_internal.h"
+
+#define g_admission (g_rt->admission)
+
+/* ------------------------------------------------------------------ */
+/* Internal helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+/* Controller of region slot r, or NULL. A controller left behind by a
+ * region whose slot has since been reclaimed is dropped here. */
+static asx_admission_ctl *admission_ctl(const asx_region_slot *r)
+{
+    asx_admission_ctl *ctl = &g_admission[r - g_regions];
+
+    if (!ctl->enabled) {
+        return NULL;
+    }
+    if (ctl->generation != r->generation || !r->alive) {
+        memset(ctl, 0, sizeof(*ctl));
+        return NULL;
+    }
+    return ctl;
+}
+
+static int admission_config_valid(const asx_admission_config *cfg)
+{
+    const asx_overload_policy *pol = &cfg->policy;
+
+    if (pol->mode != ASX_OVERLOAD_REJECT
+        && pol->mode != ASX_OVERLOAD_SHED_OLDEST
+        && pol->mode != ASX_OVERLOAD_BACKPRESSURE) {
+        return 0;
+    }
+    if (pol->threshold_pct == 0 || pol->threshold_pct > 100u) {
+        return 0;
+    }
+    if (cfg->release_pct == 0 || cfg->release_pct > pol->threshold_pct) {
+        return 0;
+    }
+    return cfg->task_capacity > 0;
+}
+
+static void admission_wake(asx_admission_ctl *ctl)
+{
+    asx_task_slot *t;
+
+    if (ctl->waiter == ASX_INVALID_ID) {
+        return;
+    }
+    if (asx_task_slot_lookup(ctl->waiter, &t) == ASX_OK) {
+        ASX_TASK_UNPARK(t);
+    }
+    ctl->waiter = ASX_INVALID_ID;
+}
+
+/* ------------------------------------------------------------------ */
+/* Adaptive ledger                                                    */
+/*                                                                    */
+/* The surface has one action per outcome and two states, released   */
+/* and in overload. Its losses make the applied outcome the only      */
+/* zero-loss action of each state, so the logged decision, its        */
+/* counterfactual and the fallback all agree with what was applied.   */
+/* ------------------------------------------------------------------ */
+
+static asx_adaptive_action admission_action(asx_overload_mode mode)
+{
+    switch (mode) {
+    case ASX_OVERLOAD_REJECT:
+        return ASX_ADMISSION_ACTION_REJECT;
+    case ASX_OVERLOAD_SHED_OLDEST:
+        return ASX_ADMISSION_ACTION_SHED_OLDEST;
+    case ASX_OVERLOAD_BACKPRESSURE:
+        return ASX_ADMISSION_ACTION_BACKPRESSURE;
+    }
+    return ASX_ADMISSION_ACTION_REJECT;
+}
+
+/* ctx is the action applied in overload */
+static uint32_t admission_loss(void *ctx, asx_adaptive_action action,
+                               uint8_t state)
+{
+    asx_adaptive_action want = state == 0
+        ? (asx_adaptive_action)ASX_ADMISSION_ACTION_ADMIT
+        : *(const asx_adaptive_action *)ctx;
+
+    return action == want ? 0u : 65536u;
+}
+
+static uint32_t admission_pct_fp32(uint32_t pct)
+{
+    if (pct >= 100u) {
+        return UINT32_MAX;
+    }
+    return (uint32_t)(((uint64_t)pct << 32) / 100u);
+}
+
+static void admission_log(const asx_admission_ctl *ctl, uint8_t state,
+                          asx_overload_mode applied, uint32_t load_pct)
+{
+    asx_adaptive_action overload = admission_action(applied);
+    asx_adaptive_surface surface;
+    asx_adaptive_posterior post;
+    asx_adaptive_evidence_term ev[3];
+    asx_adaptive_decision d;
+    asx_status st;
+
+    surface.name         = "admission";
+    surface.action_count = 4;
+    surface.state_count  = 2;
+    surface.loss_fn      = admission_loss;
+    surface.loss_ctx     = &overload;
+    surface.fallback     = state == 0
+        ? (asx_adaptive_action)ASX_ADMISSION_ACTION_ADMIT
+        : overload;
+
+    memset(&post, 0, sizeof(post));
+    post.state_count     = 2;
+    post.posterior[state] = UINT32_MAX;
+    post.confidence_fp32 = UINT32_MAX;
+
+    ev[0].label      = "load_pct";
+    ev[0].value_fp32 = admission_pct_fp32(load_pct);
+    ev[1].label      = "threshold_pct";
+    ev[1].value_fp32 = admission_pct_fp32(ctl->config.policy.threshold_pct);
+    ev[2].label      = "release_pct";
+    ev[2].value_fp32 = admission_pct_fp32(ctl->config.release_pct);
+
+    st = asx_adaptive_decide(&surface, &post, ev, 3, &d);
+    (void)st;
+}
+
+/* ------------------------------------------------------------------ */
+/* Decisions                                                          */
+/* ------------------------------------------------------------------ */
+
+/* Re-evaluate one signal under hysteresis. Returns 1 if it is (still)
+ * in overload; a release is logged and wakes the waiter. */
+static int admission_update(asx_admission_ctl *ctl, uint32_t used,
+                            uint32_t capacity, int *engaged,
+                            asx_overload_decision *d)
+{
+    asx_overload_policy pol = ctl->config.policy;
+
+    if (*engaged) {
+        pol.threshold_pct = ctl->config.release_pct;
+    }
+    asx_overload_evaluate(&pol, used, capacity, d);
+
+    if (d->triggered && !*engaged) {
+        *engaged = 1;
+        ctl->stats.engagements++;
+    } else if (!d->triggered && *engaged) {
+        *engaged = 0;
+        admission_log(ctl, 0u, d->mode, d->load_pct);
+        admission_wake(ctl);
+    }
+    return d->triggered;
+}
+
+/* Admit or refuse one unit of work on a signal. *out_shed receives how
+ * many of the oldest units the caller must shed first. A signal whose
+ * units cannot be shed (can_shed 0) defers under SHED_OLDEST instead,
+ * as under BACKPRESSURE. */
+static asx_status admission_decide(asx_admission_ctl *ctl, uint32_t used,
+                                   uint32_t capacity, int *engaged,
+                                   int can_shed, uint32_t *out_shed)
+{
+    asx_overload_decision d;
+
+    *out_shed = 0;
+    if (!admission_update(ctl, used, capacity, engaged, &d)) {
+        ctl->stats.admitted++;
+        return ASX_OK;
+    }
+
+    if (d.mode == ASX_OVERLOAD_SHED_OLDEST && !can_shed) {
+        d.mode = ASX_OVERLOAD_BACKPRESSURE;
+        d.admit_status = ASX_E_WOULD_BLOCK;
+    }
+    admission_log(ctl, 1u, d.mode, d.load_pct);
+    switch (d.mode) {
+    case ASX_OVERLOAD_REJECT:
+        ctl->stats.rejected++;
+        return d.admit_status;
+    case ASX_OVERLOAD_BACKPRESSURE:
+        ctl->stats.deferred++;
+        return d.admit_status;
+    case ASX_OVERLOAD_SHED_OLDEST:
+        *out_shed = d.shed_count;
+        ctl->stats.admitted++;
+        return ASX_OK;
+    }
+    return d.admit_status;
+}
+
+/* Cancel up to n of the region's oldest live tasks not already being
+ * cancelled. The region task list is in spawn order. */
+static uint32_t admission_shed_tasks(asx_region_slot *r, uint32_t n)
+{
+    asx_region_id origin = asx_region_handle_at((uint32_t)(r - g_regions));
+    uint32_t shed = 0;
+    uint32_t i;
+
+    for (i = r->task_head; i != ASX_TASK_LINK_NONE && shed < n;
+         i = g_tasks[i].region_next) {
+        ASX_CHECKPOINT_WAIVER("kernel-admission: bounded by shed_max and "
+                              "region live tasks");
+        asx_task_slot *t = &g_tasks[i];
+        asx_task_id tid;
+
+        if (asx_task_is_terminal(t->state) || t->cancel_pending) {
+            continue;
+        }
+        tid = asx_handle_pack(ASX_TYPE_TASK,
+                              (uint16_t)(1u << (unsigned)t->state),
+                              asx_handle_pack_index(t->generation,
+                                                    (uint16_t)i));
+        if (asx_task_cancel_with_origin(tid, ASX_CANCEL_RESOURCE, origin,
+                                        ASX_INVALID_ID) == ASX_OK) {
+            shed++;
+        }
+    }
+    return shed;
+}
+
+/* ------------------------------------------------------------------ */
+/* Hot-path hooks                                                     */
+/* ------------------------------------------------------------------ */
+
+asx_status asx_admission_on_spawn(asx_region_slot *r)
+{
+    asx_admission_ctl *ctl = admission_ctl(r);
+    asx_status st;
+    uint32_t shed;
+
+    if (ctl == NULL) {
+        return ASX_OK;
+    }
+    st = admission_decide(ctl, r->task_count, ctl->config.task_capacity,
+                          &ctl->engaged, 1, &shed);
+    if (st == ASX_OK && shed > 0) {
+        ctl->stats.shed += admission_shed_tasks(r, shed);
+    }
+    return st;
+}
+
+/* Queued messages were committed by their senders and are owed to
+ * the receiver, so a channel is never shed. */
+asx_status asx_admission_on_reserve(asx_channel_slot *ch)
+{
+    asx_region_slot *r = &g_regions[asx_handle_slot(ch->region)];
+    asx_admission_ctl *ctl = admission_ctl(r);
+    uint32_t shed;
+
+    if (ctl == NULL || asx_handle_generation(ch->region) != ctl->generation) {
+        return ASX_OK;
+    }
+    return admission_decide(ctl, ch->queue_len + ch->reserved, ch->capacity,
+                            &ch->admit_engaged, 0, &shed);
+}
+
+void asx_admission_on_task_retire(asx_region_slot *r)
+{
+    asx_admission_ctl *ctl = admission_ctl(r);
+    asx_overload_decision d;
+
+    if (ctl != NULL && ctl->engaged) {
+        (void)admission_update(ctl, r->task_count,
+                               ctl->config.task_capacity,
+                               &ctl->engaged, &d);
+    }
+}
+
+void asx_admission_on_channel_drain(asx_channel_slot *ch)
+{
+    asx_region_slot *r = &g_regions[asx_handle_slot(ch->region)];
+    asx_admission_ctl *ctl = admission_ctl(r);
+    asx_overload_decision d;
+
+    if (ctl == NULL || asx_handle_generation(ch->region) != ctl->generation) {
+        ch->admit_engaged = 0;
+        return;
+    }
+    (void)admission_update(ctl, ch->queue_len + ch->reserved, ch->capacity,
+                           &ch->admit_engaged, &d);
+}
+
+/* ------------------------------------------------------------------ */
+/* Public API                                                         */
+/* ------------------------------------------------------------------ */
+
+void asx_admission_config_init(asx_admission_config *cfg)
+{
+    if (cfg == NULL) {
+        return;
+    }
+    if (asx_overload_catalog_to_policy(asx_profile_active(),
+                                       &cfg->policy) != ASX_OK) {
+        asx_overload_policy_init(&cfg->policy);
+    }
+    cfg->release_pct = cfg->policy.threshold_pct > ASX_ADMISSION_RELEASE_BAND
+        ? cfg->policy.threshold_pct - ASX_ADMISSION_RELEASE_BAND
+        : 1u;
+    cfg->task_capacity = ASX_MAX_TASKS;
+}
+
+asx_status asx_admission_enable(asx_region_id region,
+                                const asx_admission_config *cfg)
+{
+    asx_admission_config def;
+    asx_admission_ctl *ctl;
+    asx_region_slot *r;
+    asx_status st;
+
+    if (cfg == NULL) {
+        asx_admission_config_init(&def);
+        cfg = &def;
+    }
+    if (!admission_config_valid(cfg)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) {
+        return st;
+    }
+
+    ctl = admission_ctl(r);
+    if (ctl == NULL) {
+        ctl = &g_admission[r - g_regions];
+        memset(ctl, 0, sizeof(*ctl));
+        ctl->enabled    = 1;
+        ctl->generation = r->generation;
+    }
+    ctl->config = *cfg;
+    return ASX_OK;
+}
+
+asx_status asx_admission_disable(asx_region_id region)
+{
+    asx_admission_ctl *ctl;
+    asx_region_slot *r;
+    asx_status st;
+    uint32_t i;
+
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) {
+        return st;
+    }
+    ctl = admission_ctl(r);
+    if (ctl == NULL) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    for (i = 0; i < ASX_MAX_CHANNELS; i++) {
+        asx_channel_slot *ch = &g_rt->channels[i];
+        if (ch->alive && asx_handle_slot(ch->region)
+                             == (uint16_t)(r - g_regions)) {
+            ch->admit_engaged = 0;
+        }
+    }
+    admission_wake(ctl);
+    memset(ctl, 0, sizeof(*ctl));
+    return ASX_OK;
+}
+
+/* Whether any signal of the region controlled by ctl is in overload. */
+static int admission_any_engaged(const asx_admission_ctl *ctl,
+                                 const asx_region_slot *r)
+{
+    uint32_t i;
+
+    if (ctl->engaged) {
+        return 1;
+    }
+    for (i = 0; i < ASX_MAX_CHANNELS; i++) {
+        const asx_channel_slot *ch = &g_rt->channels[i];
+        if (ch->alive && ch->admit_engaged
+            && asx_handle_slot(ch->region) == (uint16_t)(r - g_regions)
+            && asx_handle_generation(ch->region) == ctl->generation) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+asx_status asx_admission_wait(asx_task_id self, asx_region_id region)
+{
+    asx_admission_ctl *ctl;
+    asx_region_slot *r;
+    asx_task_slot *t;
+    asx_task_slot *other;
+    asx_status st;
+
+    st = asx_task_slot_lookup(self, &t);
+    if (st != ASX_OK) {
+        return st;
+    }
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) {
+        return st;
+    }
+    ctl = admission_ctl(r);
+    if (ctl == NULL || !admission_any_engaged(ctl, r)) {
+        if (ctl != NULL && ctl->waiter == self) {
+            ctl->waiter = ASX_INVALID_ID;
+        }
+        return ASX_OK;
+    }
+
+    if (ctl->waiter != ASX_INVALID_ID && ctl->waiter != self
+        && asx_task_slot_lookup(ctl->waiter, &other) == ASX_OK
+        && other->parked && !asx_task_is_terminal(other->state)) {
+        return ASX_E_INVALID_STATE;
+    }
+    ctl->waiter = self;
+    asx_task_park(t, ASX_TASK_LINK_NONE, 0);
+    return ASX_E_PENDING;
+}
+
+asx_status asx_admission_get_stats(asx_region_id region,
+                                   asx_admission_stats *out)
+{
+    asx_admission_ctl *ctl;
+    asx_region_slot *r;
+    asx_status st;
+
+    if (out == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) {
+        return st;
+    }
+    ctl = admission_ctl(r);
+    if (ctl == NULL) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    *out = ctl->stats;
+    out->engaged = admission_any_engaged(ctl, r);
+    return ASX_OK;
+}
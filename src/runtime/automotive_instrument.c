@@ -5,13 +5,15 @@
  * degraded-mode audit logging, and compliance gate evaluation.
  *
  * All operations are single-threaded consistent with the asx
- * runtime threading model.
+ * runtime threading model. The global trackers belong to the calling
+ * thread's current runtime instance.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <asx/runtime/automotive_instrument.h>
 #include <string.h>
+#include "runtime_internal.h"
 
 /* -------------------------------------------------------------------
  * Deadline tracker
@@ -258,13 +260,13 @@ void asx_auto_compliance_evaluate(
 }
 
 /* -------------------------------------------------------------------
- * Global instrumentation state
+ * Instrumentation state (per runtime instance, see runtime_internal.h)
  * ------------------------------------------------------------------- */
 
-static asx_auto_deadline_tracker g_deadline;
-static asx_auto_watchdog         g_watchdog;
-static asx_auto_audit_ring       g_audit;
-static int                       g_auto_initialized = 0;
+#define g_deadline         (g_rt->auto_deadline)
+#define g_watchdog         (g_rt->auto_watchdog)
+#define g_audit            (g_rt->auto_audit)
+#define g_auto_initialized (g_rt->auto_initialized)
 
 static void ensure_auto_init(void)
 {
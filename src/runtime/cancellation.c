@@ -25,28 +25,33 @@
 asx_status asx_task_cancel(asx_task_id id, asx_cancel_kind kind)
 {
     asx_task_slot *t;
+    asx_task_cold *tc;
     asx_status st;
     asx_budget cleanup;
 
     st = asx_task_slot_lookup(id, &t);
     if (st != ASX_OK) return st;
+    tc = ASX_TASK_COLD(t);
 
     /* Already cancelled or terminal — strengthen if in cancel phase */
     if (asx_task_is_terminal(t->state)) {
         return ASX_OK; /* no-op for completed tasks */
     }
 
+    /* Cancel delivery wakes a parked task so it can observe it */
+    ASX_TASK_UNPARK(t);
+
     if (t->cancel_pending) {
         /* Strengthen: if new cancel is higher severity, upgrade */
-        if (asx_cancel_severity(kind) > asx_cancel_severity(t->cancel_reason.kind)) {
-            t->cancel_reason.kind = kind;
+        if (asx_cancel_severity(kind) > asx_cancel_severity(tc->cancel_reason.kind)) {
+            tc->cancel_reason.kind = kind;
             cleanup = asx_cancel_cleanup_budget(kind);
             /* Tighten budget: take the minimum polls remaining */
-            if (asx_budget_polls(&cleanup) < t->cleanup_polls_remaining) {
-                t->cleanup_polls_remaining = asx_budget_polls(&cleanup);
+            if (asx_budget_polls(&cleanup) < tc->cleanup_polls_remaining) {
+                tc->cleanup_polls_remaining = asx_budget_polls(&cleanup);
             }
         }
-        t->cancel_epoch++;
+        tc->cancel_epoch++;
         return ASX_OK;
     }
 
@@ -64,19 +69,20 @@ asx_status asx_task_cancel(asx_task_id id, asx_cancel_kind kind)
 
     (void)asx_ghost_check_task_transition(id, t->state, ASX_TASK_CANCEL_REQUESTED);
     t->state = ASX_TASK_CANCEL_REQUESTED;
+    ASX_SNAP_MARK_TASK(t);
 
     t->cancel_pending = 1;
-    t->cancel_reason.kind = kind;
-    t->cancel_reason.origin_region = ASX_INVALID_ID;
-    t->cancel_reason.origin_task = ASX_INVALID_ID;
-    t->cancel_reason.timestamp = 0;
-    t->cancel_reason.message = NULL;
-    t->cancel_reason.cause = NULL;
-    t->cancel_reason.truncated = 0;
-    t->cancel_epoch = 1;
+    tc->cancel_reason.kind = kind;
+    tc->cancel_reason.origin_region = ASX_INVALID_ID;
+    tc->cancel_reason.origin_task = ASX_INVALID_ID;
+    tc->cancel_reason.timestamp = 0;
+    tc->cancel_reason.message = NULL;
+    tc->cancel_reason.cause = NULL;
+    tc->cancel_reason.truncated = 0;
+    tc->cancel_epoch = 1;
 
     cleanup = asx_cancel_cleanup_budget(kind);
-    t->cleanup_polls_remaining = asx_budget_polls(&cleanup);
+    tc->cleanup_polls_remaining = asx_budget_polls(&cleanup);
 
     return ASX_OK;
 }
@@ -91,6 +97,7 @@ asx_status asx_task_cancel_with_origin(asx_task_id id,
                                        asx_task_id origin_task)
 {
     asx_task_slot *t;
+    asx_task_cold *tc;
     asx_status st;
 
     st = asx_task_cancel(id, kind);
@@ -99,8 +106,9 @@ asx_status asx_task_cancel_with_origin(asx_task_id id,
     st = asx_task_slot_lookup(id, &t);
     if (st != ASX_OK) return st;
 
-    t->cancel_reason.origin_region = origin_region;
-    t->cancel_reason.origin_task = origin_task;
+    tc = ASX_TASK_COLD(t);
+    tc->cancel_reason.origin_region = origin_region;
+    tc->cancel_reason.origin_task = origin_task;
 
     return ASX_OK;
 }
@@ -111,27 +119,39 @@ asx_status asx_task_cancel_with_origin(asx_task_id id,
 
 uint32_t asx_cancel_propagate(asx_region_id region, asx_cancel_kind kind)
 {
+    asx_region_slot *r;
+    uint32_t root;
+    uint32_t ri;
     uint32_t i;
     uint32_t count = 0;
 
-    for (i = 0; i < g_task_count; i++) {
-        ASX_CHECKPOINT_WAIVER("kernel-propagation: single-pass cancel sweep bounded by "
-                              "g_task_count <= ASX_MAX_TASKS; O(1) per iteration");
-        asx_task_slot *t = &g_tasks[i];
-        asx_task_id tid;
-
-        if (!t->alive) continue;
-        if (t->region != region) continue;
-        if (asx_task_is_terminal(t->state)) continue;
-
-        tid = asx_handle_pack(ASX_TYPE_TASK,
-                              (uint16_t)(1u << (unsigned)t->state),
-                              asx_handle_pack_index(t->generation, (uint16_t)i));
-
-        if (asx_task_cancel(tid, kind) == ASX_OK) {
-            /* Set origin region for propagation traceability */
-            t->cancel_reason.origin_region = region;
-            count++;
+    if (asx_region_slot_lookup(region, &r) != ASX_OK) return 0;
+
+    /* Cascade over the subtree in pre-order; within each region only
+     * its live-task list is visited, in arena order. */
+    root = (uint32_t)(r - g_regions);
+    for (ri = root; ri != ASX_REGION_LINK_NONE;
+         ri = asx_region_subtree_next(root, ri)) {
+        ASX_CHECKPOINT_WAIVER("kernel-propagation: subtree walk bounded by "
+                              "ASX_MAX_REGIONS");
+        for (i = g_regions[ri].task_head; i != ASX_TASK_LINK_NONE;
+             i = g_tasks[i].region_next) {
+            ASX_CHECKPOINT_WAIVER("kernel-propagation: single-pass cancel sweep bounded by "
+                                  "region live tasks <= ASX_MAX_TASKS; O(1) per iteration");
+            asx_task_slot *t = &g_tasks[i];
+            asx_task_id tid;
+
+            if (asx_task_is_terminal(t->state)) continue;
+
+            tid = asx_handle_pack(ASX_TYPE_TASK,
+                                  (uint16_t)(1u << (unsigned)t->state),
+                                  asx_handle_pack_index(t->generation, (uint16_t)i));
+
+            if (asx_task_cancel(tid, kind) == ASX_OK) {
+                /* Origin is the region propagation started from */
+                ASX_TASK_COLD(t)->cancel_reason.origin_region = region;
+                count++;
+            }
         }
     }
 
@@ -145,6 +165,7 @@ uint32_t asx_cancel_propagate(asx_region_id region, asx_cancel_kind kind)
 asx_status asx_checkpoint(asx_task_id self, asx_checkpoint_result *out)
 {
     asx_task_slot *t;
+    asx_task_cold *tc;
     asx_status st;
 
     if (out == NULL) return ASX_E_INVALID_ARGUMENT;
@@ -162,16 +183,18 @@ asx_status asx_checkpoint(asx_task_id self, asx_checkpoint_result *out)
     }
 
     /* Transition CancelRequested → Cancelling on first checkpoint */
+    tc = ASX_TASK_COLD(t);
     if (t->state == ASX_TASK_CANCEL_REQUESTED) {
         (void)asx_ghost_check_task_transition(self, t->state, ASX_TASK_CANCELLING);
         t->state = ASX_TASK_CANCELLING;
-        t->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
+        tc->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
+        ASX_SNAP_MARK_TASK(t);
     }
 
     out->cancelled = 1;
-    out->phase = t->cancel_phase;
-    out->polls_remaining = t->cleanup_polls_remaining;
-    out->kind = t->cancel_reason.kind;
+    out->phase = tc->cancel_phase;
+    out->polls_remaining = tc->cleanup_polls_remaining;
+    out->kind = tc->cancel_reason.kind;
 
     /* Budget is decremented by the scheduler after each poll,
      * not here. Checkpoint only observes and transitions phases. */
@@ -197,7 +220,8 @@ asx_status asx_task_finalize(asx_task_id id)
 
     (void)asx_ghost_check_task_transition(id, t->state, ASX_TASK_FINALIZING);
     t->state = ASX_TASK_FINALIZING;
-    t->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
+    ASX_TASK_COLD(t)->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
+    ASX_SNAP_MARK_TASK(t);
 
     return ASX_OK;
 }
@@ -216,6 +240,6 @@ asx_status asx_task_get_cancel_phase(asx_task_id id, asx_cancel_phase *out)
     st = asx_task_slot_lookup(id, &t);
     if (st != ASX_OK) return st;
 
-    *out = t->cancel_phase;
+    *out = ASX_TASK_COLD(t)->cancel_phase;
     return ASX_OK;
 }
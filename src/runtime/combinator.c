@@ -0,0 +1,412 @@
+/*
+ * combinator.c — join/race/select/timeout/retry combinators (DS-C02)
+ *
+ * Each combinator is a task spawned via asx_task_spawn_captured whose
+ * captured state lists its children. Children are spawned right after
+ * the combinator (higher arena index) with the combinator registered
+ * as their waiter, so the combinator parks between child completions
+ * instead of re-polling. Outcomes are folded with asx_outcome_join and
+ * reported through the task outcome override.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/combinator.h>
+#include <asx/core/transition.h>
+#include <asx/core/cancel.h>
+#include "runtime_internal.h"
+
+/* -------------------------------------------------------------------
+ * Captured combinator state
+ * ------------------------------------------------------------------- */
+
+typedef enum {
+    ASX_COMB_JOIN    = 0,
+    ASX_COMB_RACE    = 1,
+    ASX_COMB_SELECT  = 2,
+    ASX_COMB_TIMEOUT = 3,
+    ASX_COMB_RETRY   = 4
+} asx_comb_kind;
+
+#define ASX_COMB_NO_WINNER UINT32_MAX
+
+typedef struct {
+    asx_comb_kind kind;
+    uint32_t      count;        /* children spawned so far */
+    asx_task_id   children[ASX_COMBINATOR_MAX_CHILDREN];
+    uint32_t      winner;       /* race/select: child index */
+    int           losers_cancelled;
+    int           cancel_forwarded;
+    asx_time      deadline;     /* timeout */
+    int           timed_out;
+    asx_task_spec spec;         /* retry: re-spawned each attempt */
+    uint32_t      max_attempts; /* retry */
+} asx_comb_state;
+
+static asx_status combinator_poll(void *data, asx_task_id self);
+
+/* -------------------------------------------------------------------
+ * Helpers
+ * ------------------------------------------------------------------- */
+
+static int comb_child_done(const asx_comb_state *cs, uint32_t i,
+                           asx_outcome *out)
+{
+    return asx_task_get_outcome(cs->children[i], out) == ASX_OK;
+}
+
+/* Cancel every live child except `keep` with the combinator as origin. */
+static void comb_cancel_children(const asx_comb_state *cs, uint32_t keep,
+                                 asx_cancel_kind kind,
+                                 asx_region_id region, asx_task_id self)
+{
+    uint32_t i;
+    asx_outcome o;
+
+    for (i = 0; i < cs->count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_COMBINATOR_MAX_CHILDREN");
+        if (i == keep) continue;
+        if (comb_child_done(cs, i, &o)) continue;
+        if (asx_task_cancel_with_origin(cs->children[i], kind,
+                                        region, self) != ASX_OK) {
+            continue; /* child already gone; nothing to signal */
+        }
+    }
+}
+
+/* Park on the first live child; returns 0 if every child is done. */
+static int comb_park_on_live(asx_task_slot *me, const asx_comb_state *cs,
+                             asx_time wake_at)
+{
+    uint32_t i;
+    asx_outcome o;
+
+    for (i = 0; i < cs->count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_COMBINATOR_MAX_CHILDREN");
+        if (!comb_child_done(cs, i, &o)) {
+            /* Every child already names this task as waiter */
+            asx_task_park(me, ASX_TASK_LINK_NONE, wake_at);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static asx_outcome comb_join_all(const asx_comb_state *cs)
+{
+    asx_outcome acc = asx_outcome_make(ASX_OUTCOME_OK);
+    asx_outcome o;
+    uint32_t i;
+
+    for (i = 0; i < cs->count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_COMBINATOR_MAX_CHILDREN");
+        if (comb_child_done(cs, i, &o)) {
+            acc = asx_outcome_join(&acc, &o);
+        }
+    }
+    return acc;
+}
+
+static asx_status comb_spawn_child(asx_comb_state *cs, asx_region_id region,
+                                   const asx_task_spec *spec,
+                                   uint32_t waiter_idx)
+{
+    asx_task_slot *c;
+    asx_task_id cid;
+    asx_status st;
+
+    st = asx_task_spawn(region, spec->poll_fn, spec->user_data, &cid);
+    if (st != ASX_OK) return st;
+    st = asx_task_slot_lookup(cid, &c);
+    if (st != ASX_OK) return st;
+
+    ASX_TASK_COLD(c)->waiter = waiter_idx;
+    cs->children[cs->count++] = cid;
+    return ASX_OK;
+}
+
+static asx_status comb_finish(asx_task_slot *me, asx_outcome result)
+{
+    asx_task_cold *tc = ASX_TASK_COLD(me);
+
+    tc->outcome_override = result;
+    tc->has_outcome_override = 1;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Combinator poll function
+ * ------------------------------------------------------------------- */
+
+static asx_status combinator_poll(void *data, asx_task_id self)
+{
+    asx_comb_state *cs = (asx_comb_state *)data;
+    asx_task_slot *me;
+    asx_region_id region;
+    asx_checkpoint_result cr;
+    asx_outcome o;
+    asx_status st;
+    uint32_t i;
+
+    st = asx_task_slot_lookup(self, &me);
+    if (st != ASX_OK) return st;
+    region = ASX_TASK_COLD(me)->region;
+
+    /* Forward our own cancellation to the children, then wait for
+     * them: the combinator never completes ahead of its children. */
+    if (asx_checkpoint(self, &cr) == ASX_OK && cr.cancelled
+        && !cs->cancel_forwarded) {
+        comb_cancel_children(cs, ASX_COMB_NO_WINNER, cr.kind,
+                             region, self);
+        cs->cancel_forwarded = 1;
+    }
+    if (cs->cancel_forwarded) {
+        if (comb_park_on_live(me, cs, 0)) return ASX_E_PENDING;
+        return comb_finish(me, comb_join_all(cs));
+    }
+
+    switch (cs->kind) {
+    case ASX_COMB_JOIN:
+        if (comb_park_on_live(me, cs, 0)) return ASX_E_PENDING;
+        return comb_finish(me, comb_join_all(cs));
+
+    case ASX_COMB_RACE:
+    case ASX_COMB_SELECT:
+        if (cs->winner == ASX_COMB_NO_WINNER) {
+            for (i = 0; i < cs->count; i++) {
+                ASX_CHECKPOINT_WAIVER("bounded by ASX_COMBINATOR_MAX_CHILDREN");
+                if (!comb_child_done(cs, i, &o)) continue;
+                if (cs->kind == ASX_COMB_SELECT
+                    && o.severity != ASX_OUTCOME_OK) continue;
+                cs->winner = i;
+                break;
+            }
+        }
+        if (cs->winner != ASX_COMB_NO_WINNER && !cs->losers_cancelled) {
+            comb_cancel_children(cs, cs->winner, ASX_CANCEL_RACE_LOST,
+                                 region, self);
+            cs->losers_cancelled = 1;
+        }
+        if (comb_park_on_live(me, cs, 0)) return ASX_E_PENDING;
+        if (cs->winner != ASX_COMB_NO_WINNER
+            && comb_child_done(cs, cs->winner, &o)) {
+            return comb_finish(me, o);
+        }
+        return comb_finish(me, comb_join_all(cs));
+
+    case ASX_COMB_TIMEOUT:
+        if (comb_child_done(cs, 0, &o)) return comb_finish(me, o);
+        if (!cs->timed_out) {
+            asx_time now;
+            if (asx_runtime_now_ns(&now) == ASX_OK && now >= cs->deadline
+                && asx_task_cancel_with_origin(cs->children[0],
+                                               ASX_CANCEL_TIMEOUT,
+                                               region, self) == ASX_OK) {
+                cs->timed_out = 1;
+            }
+        }
+        asx_task_park(me, ASX_TASK_LINK_NONE,
+                      cs->timed_out ? 0 : cs->deadline);
+        return ASX_E_PENDING;
+
+    case ASX_COMB_RETRY:
+        if (!comb_child_done(cs, cs->count - 1u, &o)) {
+            asx_task_park(me, ASX_TASK_LINK_NONE, 0);
+            return ASX_E_PENDING;
+        }
+        if (o.severity == ASX_OUTCOME_ERR && cs->count < cs->max_attempts
+            && comb_spawn_child(cs, region, &cs->spec,
+                                (uint32_t)(me - g_tasks)) == ASX_OK) {
+            asx_task_park(me, ASX_TASK_LINK_NONE, 0);
+            return ASX_E_PENDING;
+        }
+        return comb_finish(me, o);
+
+    default:
+        return ASX_E_INVALID_STATE;
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Spawn
+ * ------------------------------------------------------------------- */
+
+static asx_status comb_spawn(asx_region_id region, asx_comb_kind kind,
+                             const asx_task_spec *specs, uint32_t count,
+                             uint32_t spawn_count, asx_task_id *out_id,
+                             asx_comb_state **out_cs)
+{
+    asx_comb_state *cs;
+    asx_task_slot *me;
+    void *state;
+    asx_status st;
+    uint32_t i;
+    uint32_t me_idx;
+
+    if (out_id == NULL || specs == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (count == 0u || count > ASX_COMBINATOR_MAX_CHILDREN) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    for (i = 0; i < count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_COMBINATOR_MAX_CHILDREN");
+        if (specs[i].poll_fn == NULL) return ASX_E_INVALID_ARGUMENT;
+    }
+
+    /* All-or-nothing: check arena room up front; any later refusal
+     * (capture arena, admission) discards what was spawned. */
+    if (g_task_count + 1u + spawn_count > ASX_MAX_TASKS) {
+        return ASX_E_RESOURCE_EXHAUSTED;
+    }
+
+    st = asx_task_spawn_captured(region, combinator_poll,
+                                 (uint32_t)sizeof(asx_comb_state), NULL,
+                                 out_id, &state);
+    if (st != ASX_OK) return st;
+
+    cs = (asx_comb_state *)state;
+    cs->kind = kind;
+    cs->count = 0;
+    cs->winner = ASX_COMB_NO_WINNER;
+    cs->spec = specs[0];
+
+    st = asx_task_slot_lookup(*out_id, &me);
+    if (st != ASX_OK) return st;
+    me_idx = (uint32_t)(me - g_tasks);
+
+    for (i = 0; i < spawn_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_COMBINATOR_MAX_CHILDREN");
+        st = comb_spawn_child(cs, region, &specs[i], me_idx);
+        if (st != ASX_OK) {
+            while (cs->count > 0) {
+                ASX_CHECKPOINT_WAIVER("bounded by ASX_COMBINATOR_MAX_CHILDREN");
+                cs->count--;
+                asx_task_discard(asx_handle_slot(cs->children[cs->count]));
+            }
+            asx_task_discard(me_idx);
+            return st;
+        }
+    }
+
+    if (out_cs != NULL) *out_cs = cs;
+    return ASX_OK;
+}
+
+asx_status asx_join_spawn(asx_region_id region, const asx_task_spec *specs,
+                          uint32_t count, asx_task_id *out_id)
+{
+    return comb_spawn(region, ASX_COMB_JOIN, specs, count, count, out_id, NULL);
+}
+
+asx_status asx_race_spawn(asx_region_id region, const asx_task_spec *specs,
+                          uint32_t count, asx_task_id *out_id)
+{
+    return comb_spawn(region, ASX_COMB_RACE, specs, count, count, out_id, NULL);
+}
+
+asx_status asx_select_spawn(asx_region_id region, const asx_task_spec *specs,
+                            uint32_t count, asx_task_id *out_id)
+{
+    return comb_spawn(region, ASX_COMB_SELECT, specs, count, count, out_id, NULL);
+}
+
+asx_status asx_timeout_spawn(asx_region_id region, const asx_task_spec *spec,
+                             asx_time deadline, asx_task_id *out_id)
+{
+    asx_comb_state *cs;
+    asx_status st;
+
+    st = comb_spawn(region, ASX_COMB_TIMEOUT, spec, 1u, 1u, out_id, &cs);
+    if (st != ASX_OK) return st;
+    cs->deadline = deadline;
+    return ASX_OK;
+}
+
+asx_status asx_retry_spawn(asx_region_id region, const asx_task_spec *spec,
+                           uint32_t max_attempts, asx_task_id *out_id)
+{
+    asx_comb_state *cs;
+    asx_status st;
+
+    if (max_attempts == 0u || max_attempts > ASX_COMBINATOR_MAX_CHILDREN) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    st = comb_spawn(region, ASX_COMB_RETRY, spec, 1u, 1u, out_id, &cs);
+    if (st != ASX_OK) return st;
+    cs->max_attempts = max_attempts;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Queries
+ * ------------------------------------------------------------------- */
+
+static asx_status comb_state_lookup(asx_task_id id, asx_comb_state **out)
+{
+    asx_task_slot *t;
+    asx_region_slot *r;
+    asx_status st;
+
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+    if (t->poll_fn != combinator_poll || t->user_data == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    /* captured_state is cleared on completion, but user_data still
+     * points into the region capture arena. Task slots outlive the
+     * region; the arena goes back to the pool when the region closes,
+     * after which the state may already belong to someone else. */
+    if (asx_region_slot_lookup(g_task_cold[t - g_tasks].region, &r) != ASX_OK
+        || r->state == ASX_REGION_CLOSED) {
+        return ASX_E_INVALID_STATE;
+    }
+    *out = (asx_comb_state *)t->user_data;
+    return ASX_OK;
+}
+
+asx_status asx_combinator_child_count(asx_task_id combinator,
+                                      uint32_t *out_count)
+{
+    asx_comb_state *cs;
+    asx_status st;
+
+    if (out_count == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = comb_state_lookup(combinator, &cs);
+    if (st != ASX_OK) return st;
+
+    *out_count = cs->count;
+    return ASX_OK;
+}
+
+asx_status asx_combinator_child(asx_task_id combinator, uint32_t index,
+                                asx_task_id *out_child)
+{
+    asx_comb_state *cs;
+    asx_status st;
+
+    if (out_child == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = comb_state_lookup(combinator, &cs);
+    if (st != ASX_OK) return st;
+    if (index >= cs->count) return ASX_E_INVALID_ARGUMENT;
+
+    *out_child = cs->children[index];
+    return ASX_OK;
+}
+
+asx_status asx_combinator_winner(asx_task_id combinator, uint32_t *out_index)
+{
+    asx_comb_state *cs;
+    asx_status st;
+
+    if (out_index == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = comb_state_lookup(combinator, &cs);
+    if (st != ASX_OK) return st;
+    if (cs->kind != ASX_COMB_RACE && cs->kind != ASX_COMB_SELECT) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (cs->winner == ASX_COMB_NO_WINNER) return ASX_E_NOT_FOUND;
+
+    *out_index = cs->winner;
+    return ASX_OK;
+}
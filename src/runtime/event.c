@@ -0,0 +1,259 @@
+/*
+ * event.c — event record log as a view over the trace ring
+ *
+ * Event records are not stored separately: asx_event_emit writes a
+ * trace record, and the log reads trace records of the mapped kinds
+ * back as asx_event_record. parent_id is the trace aux payload
+ * (region for open/spawn/reserve, round for scheduler records). The
+ * hash chain is rolled forward lazily over records added since the
+ * previous read.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("event-view: loops are bounded by "
+ *   "ASX_TRACE_CAPACITY or the caller's expected_count; observability "
+ *   "only, never called from the task poll hot path.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/event.h>
+#include <asx/runtime/trace.h>
+#include <string.h>
+#include "runtime_internal.h"
+
+#define g_event_view      (g_rt->event_view)
+#define g_event_chain     (g_rt->event_chain)
+#define g_event_chain_pos (g_rt->event_chain_pos)
+#define g_event_chain_seq (g_rt->event_chain_seq)
+
+/* -------------------------------------------------------------------
+ * Kind mapping
+ * ------------------------------------------------------------------- */
+
+static const asx_trace_event_kind event_to_trace[ASX_EVENT_KIND_COUNT] = {
+    ASX_TRACE_REGION_OPEN,        /* ASX_EVENT_REGION_OPEN */
+    ASX_TRACE_REGION_CLOSE,       /* ASX_EVENT_REGION_CLOSE */
+    ASX_TRACE_TASK_SPAWN,         /* ASX_EVENT_TASK_SPAWN */
+    ASX_TRACE_SCHED_POLL,         /* ASX_EVENT_TASK_POLL */
+    ASX_TRACE_SCHED_COMPLETE,     /* ASX_EVENT_TASK_COMPLETE */
+    ASX_TRACE_OBLIGATION_RESERVE, /* ASX_EVENT_OBLIGATION_CREATE */
+    ASX_TRACE_OBLIGATION_COMMIT,  /* ASX_EVENT_OBLIGATION_COMMIT */
+    ASX_TRACE_OBLIGATION_ABORT,   /* ASX_EVENT_OBLIGATION_ABORT */
+    ASX_TRACE_SCHED_BUDGET,       /* ASX_EVENT_BUDGET_EXHAUSTED */
+    ASX_TRACE_SCHED_QUIESCENT,    /* ASX_EVENT_QUIESCENT */
+    ASX_TRACE_DRAIN_BEGIN,        /* ASX_EVENT_DRAIN_BEGIN */
+    ASX_TRACE_DRAIN_END           /* ASX_EVENT_DRAIN_END */
+};
+
+static asx_event_kind event_from_trace(asx_trace_event_kind kind)
+{
+    uint32_t k;
+
+    for (k = 0; k < (uint32_t)ASX_EVENT_KIND_COUNT; k++) {
+        if (event_to_trace[k] == kind) return (asx_event_kind)k;
+    }
+    return ASX_EVENT_KIND_COUNT;
+}
+
+static void event_from_record(const asx_trace_event *e, uint32_t index,
+                              asx_event_record *out)
+{
+    out->kind = event_from_trace(e->kind);
+    out->entity_id = e->entity_id;
+    out->parent_id = e->aux;
+    out->sequence = index;
+    out->status = e->status;
+}
+
+/* -------------------------------------------------------------------
+ * Event log API
+ * ------------------------------------------------------------------- */
+
+void asx_event_log_reset(void)
+{
+    asx_trace_view_restart(&g_event_view);
+    g_event_chain_pos = g_event_view.base;
+    g_event_chain_seq = 0;
+}
+
+uint32_t asx_event_emit(asx_event_kind kind,
+                        uint64_t entity_id,
+                        uint64_t parent_id,
+                        asx_status status)
+{
+    uint32_t seq;
+
+    if ((uint32_t)kind >= (uint32_t)ASX_EVENT_KIND_COUNT) {
+        return ASX_EVENT_SEQ_INVALID;
+    }
+    seq = g_event_view.count;
+    asx_trace_record(event_to_trace[kind], entity_id, parent_id, status);
+    return seq;
+}
+
+uint32_t asx_event_log_count(void)
+{
+    return g_event_view.count;
+}
+
+int asx_event_log_get(uint32_t index, asx_event_record *out)
+{
+    const asx_trace_event *e;
+
+    if (out == NULL) return 0;
+    e = asx_trace_view_find(&g_event_view, index, asx_event_view_member);
+    if (e == NULL) return 0;
+    event_from_record(e, index, out);
+    return 1;
+}
+
+/* -------------------------------------------------------------------
+ * Hash chain
+ * ------------------------------------------------------------------- */
+
+static uint64_t event_fnv1a_mix(uint64_t hash, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        hash ^= (uint64_t)p[i];
+        hash *= 0x00000100000001B3ULL;
+    }
+    return hash;
+}
+
+uint64_t asx_event_hash_chain(void)
+{
+    uint64_t hash;
+    uint32_t retained;
+    uint32_t pos;
+
+    retained = g_rt->trace_count < ASX_TRACE_CAPACITY
+               ? g_rt->trace_count
+               : ASX_TRACE_CAPACITY;
+    hash = g_event_chain_seq == 0 ? 0x517cc1b727220a95ULL : g_event_chain;
+    for (pos = g_event_chain_pos; pos < retained; pos++) {
+        const asx_trace_event *e = &g_rt->trace_ring[pos];
+        uint32_t k;
+
+        if (!asx_event_view_member(e->kind)) continue;
+        k = (uint32_t)event_from_trace(e->kind);
+        hash = event_fnv1a_mix(hash, &k, sizeof(k));
+        hash = event_fnv1a_mix(hash, &e->entity_id, sizeof(e->entity_id));
+        hash = event_fnv1a_mix(hash, &g_event_chain_seq,
+                               sizeof(g_event_chain_seq));
+        g_event_chain_seq++;
+    }
+    if (pos > g_event_chain_pos) g_event_chain_pos = pos;
+    g_event_chain = hash;
+    return hash;
+}
+
+/* -------------------------------------------------------------------
+ * Serialization
+ * ------------------------------------------------------------------- */
+
+asx_status asx_event_log_to_json(asx_codec_buffer *out)
+{
+    asx_event_record rec;
+    asx_status st;
+    uint32_t i;
+    int first;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_codec_buffer_append_char(out, '[');
+    for (i = 0; st == ASX_OK && asx_event_log_get(i, &rec); i++) {
+        first = 1;
+        if (i > 0) st = asx_codec_buffer_append_char(out, ',');
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '{');
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "seq",
+                                                   rec.sequence);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_string_field(
+                out, &first, "kind", asx_event_kind_str(rec.kind));
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "entity",
+                                                   rec.entity_id);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "parent",
+                                                   rec.parent_id);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "status",
+                                                   (uint64_t)rec.status);
+        }
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '}');
+    }
+    if (st == ASX_OK) st = asx_codec_buffer_append_char(out, ']');
+    return st;
+}
+
+const char *asx_event_kind_str(asx_event_kind kind)
+{
+    switch (kind) {
+    case ASX_EVENT_REGION_OPEN:       return "region_open";
+    case ASX_EVENT_REGION_CLOSE:      return "region_close";
+    case ASX_EVENT_TASK_SPAWN:        return "task_spawn";
+    case ASX_EVENT_TASK_POLL:         return "task_poll";
+    case ASX_EVENT_TASK_COMPLETE:     return "task_complete";
+    case ASX_EVENT_OBLIGATION_CREATE: return "obligation_create";
+    case ASX_EVENT_OBLIGATION_COMMIT: return "obligation_commit";
+    case ASX_EVENT_OBLIGATION_ABORT:  return "obligation_abort";
+    case ASX_EVENT_BUDGET_EXHAUSTED:  return "budget_exhausted";
+    case ASX_EVENT_QUIESCENT:         return "quiescent";
+    case ASX_EVENT_DRAIN_BEGIN:       return "drain_begin";
+    case ASX_EVENT_DRAIN_END:         return "drain_end";
+    case ASX_EVENT_KIND_COUNT:
+    default:                          return "unknown";
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Replay verification
+ * ------------------------------------------------------------------- */
+
+asx_status asx_event_replay_verify(const asx_event_record *expected,
+                                   uint32_t expected_count,
+                                   asx_replay_divergence *divergence)
+{
+    asx_replay_divergence d;
+    asx_event_record actual;
+    uint32_t actual_count = g_event_view.count;
+    uint32_t i;
+
+    if (expected == NULL && expected_count > 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    memset(&d, 0, sizeof(d));
+    d.expected_count = expected_count;
+    d.actual_count = actual_count;
+
+    for (i = 0; i < expected_count && i < actual_count; i++) {
+        if (!asx_event_log_get(i, &actual)) break; /* past the ring */
+        if (actual.kind != expected[i].kind
+            || actual.entity_id != expected[i].entity_id
+            || actual.parent_id != expected[i].parent_id
+            || actual.status != expected[i].status) {
+            d.diverged = 1;
+            d.first_divergence_index = i;
+            d.expected = expected[i];
+            d.actual = actual;
+            break;
+        }
+    }
+    if (!d.diverged && expected_count != actual_count) {
+        d.diverged = 1;
+        d.count_mismatch = 1;
+        d.first_divergence_index = i;
+    }
+
+    if (divergence != NULL) *divergence = d;
+    return d.diverged ? ASX_E_EQUIVALENCE_MISMATCH : ASX_OK;
+}
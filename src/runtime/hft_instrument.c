@@ -5,13 +5,15 @@
  * overload policy, and metric gate evaluation for the HFT profile.
  *
  * All operations are single-threaded (no locking) consistent with
- * the asx runtime threading model.
+ * the asx runtime threading model. The global histograms and jitter
+ * tracker belong to the calling thread's current runtime instance.
  *
  * SPDX-License-Identifier: MIT
  */
 
 #include <asx/runtime/hft_instrument.h>
 #include <string.h>
+#include "runtime_internal.h"
 
 /* ASX_CHECKPOINT_WAIVER_FILE("hft-instrument: all loops bounded by ASX_HFT_HISTOGRAM_BINS (16)") */
 
@@ -378,18 +380,20 @@ void asx_hft_gate_evaluate(const asx_hft_gate *gate,
 }
 
 /* -------------------------------------------------------------------
- * Global instrumentation state
+ * Instrumentation state (per runtime instance, see runtime_internal.h)
  * ------------------------------------------------------------------- */
 
-static asx_hft_histogram      g_sched_hist;
-static asx_hft_jitter_tracker  g_sched_jitter;
-static int                     g_initialized = 0;
+#define g_sched_hist   (g_rt->hft_sched_hist)
+#define g_sched_jitter (g_rt->hft_sched_jitter)
+#define g_wake_hist    (g_rt->hft_wake_hist)
+#define g_initialized  (g_rt->hft_initialized)
 
 static void ensure_init(void)
 {
     if (!g_initialized) {
         asx_hft_histogram_init(&g_sched_hist);
         asx_hft_jitter_init(&g_sched_jitter, 64);
+        asx_hft_histogram_init(&g_wake_hist);
         g_initialized = 1;
     }
 }
@@ -398,6 +402,7 @@ void asx_hft_instrument_reset(void)
 {
     asx_hft_histogram_init(&g_sched_hist);
     asx_hft_jitter_init(&g_sched_jitter, 64);
+    asx_hft_histogram_init(&g_wake_hist);
     g_initialized = 1;
 }
 
@@ -419,3 +424,15 @@ void asx_hft_record_poll_latency(uint64_t ns)
     asx_hft_histogram_record(&g_sched_hist, ns);
     asx_hft_jitter_record(&g_sched_jitter, ns);
 }
+
+asx_hft_histogram *asx_hft_wake_histogram(void)
+{
+    ensure_init();
+    return &g_wake_hist;
+}
+
+void asx_hft_record_wake_latency(uint64_t ns)
+{
+    ensure_init();
+    asx_hft_histogram_record(&g_wake_hist, ns);
+}
@@ -16,18 +16,19 @@
 #include <asx/runtime/trace.h>
 #include <asx/core/ghost.h>
 #include <string.h>
+#include "runtime_internal.h"
 
 /* -------------------------------------------------------------------
  * Ring buffer state
  * ------------------------------------------------------------------- */
 
-static asx_hindsight_event g_ring[ASX_HINDSIGHT_CAPACITY];
-static uint32_t g_write_index;   /* next slot to write (wrapping) */
-static uint32_t g_total_count;   /* total events ever logged */
-static uint32_t g_next_sequence; /* monotonic per-event sequence */
+#define g_ring          (g_rt->hs_ring)
+#define g_write_index   (g_rt->hs_write_index)   /* next slot (wrapping) */
+#define g_total_count   (g_rt->hs_total_count)   /* events ever logged */
+#define g_next_sequence (g_rt->hs_next_sequence) /* per-event sequence */
 
-/* Default flush policy: both triggers enabled */
-static asx_hindsight_policy g_policy = { 1, 1 };
+/* Flush policy; both triggers enabled by default (instance.c) */
+#define g_policy        (g_rt->hs_policy)
 
 /* -------------------------------------------------------------------
  * Init / Reset
@@ -325,6 +326,7 @@ const char *asx_nd_event_kind_str(asx_nd_event_kind kind)
     case ASX_ND_SIGNAL_ARRIVAL:   return "signal_arrival";
     case ASX_ND_SCHED_TIE_BREAK: return "sched_tie_break";
     case ASX_ND_TIMER_COALESCE:   return "timer_coalesce";
+    case ASX_ND_WAKE_DRAIN:       return "wake_drain";
     case ASX_ND_KIND_COUNT:       return "unknown";
     default:                      return "unknown";
     }
@@ -21,6 +21,7 @@
 #include <asx/codec/codec.h>
 #include <asx/codec/equivalence.h>
 #include "codec_internal.h"
+#include "runtime_internal.h"
 #include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -76,11 +77,11 @@ static asx_status default_ghost_reactor_wait(void *ctx, uint64_t logical_step,
 }
 
 /* ------------------------------------------------------------------ */
-/* Global hook state                                                  */
+/* Hook state (owned by the current runtime instance)                 */
 /* ------------------------------------------------------------------ */
 
-static asx_runtime_hooks g_hooks;
-static int g_hooks_installed = 0;
+#define g_hooks           (g_rt->hooks)
+#define g_hooks_installed (g_rt->hooks_installed)
 
 /* ------------------------------------------------------------------ */
 /* Safety profile queries                                             */
@@ -120,13 +121,11 @@ asx_containment_policy asx_containment_policy_active(void) {
 /* Fault injection state (deterministic-mode only)                    */
 /* ------------------------------------------------------------------ */
 
-#define ASX_FAULT_MAX_ACTIVE 8u
-
-static asx_fault_injection g_faults[ASX_FAULT_MAX_ACTIVE];
-static uint32_t g_fault_count = 0;
-static uint32_t g_fault_clock_calls = 0;
-static uint32_t g_fault_entropy_calls = 0;
-static uint32_t g_fault_alloc_calls = 0;
+#define g_faults              (g_rt->faults)
+#define g_fault_count         (g_rt->fault_count)
+#define g_fault_clock_calls   (g_rt->fault_clock_calls)
+#define g_fault_entropy_calls (g_rt->fault_entropy_calls)
+#define g_fault_alloc_calls   (g_rt->fault_alloc_calls)
 
 asx_status asx_fault_inject(const asx_fault_injection *fault) {
     if (!fault) return ASX_E_INVALID_ARGUMENT;
@@ -298,7 +297,8 @@ asx_status asx_runtime_free(void *ptr) {
     return ASX_OK;
 }
 
-asx_status asx_runtime_now_ns(asx_time *out_now) {
+/* Clock value at the current fault-clock tick, without advancing it. */
+static asx_status clock_read(asx_time *out_now) {
     asx_time raw;
     uint32_t i;
 
@@ -330,6 +330,17 @@ asx_status asx_runtime_now_ns(asx_time *out_now) {
             }
         }
     }
+
+    *out_now = raw;
+    return ASX_OK;
+}
+
+asx_status asx_runtime_now_ns(asx_time *out_now) {
+    asx_time raw;
+    asx_status st;
+
+    st = clock_read(&raw);
+    if (st != ASX_OK) return st;
     g_fault_clock_calls++;
 
     /* Log nondeterministic clock boundary event */
@@ -339,6 +350,10 @@ asx_status asx_runtime_now_ns(asx_time *out_now) {
     return ASX_OK;
 }
 
+asx_status asx_runtime_clock_peek_ns(asx_time *out_now) {
+    return clock_read(out_now);
+}
+
 asx_status asx_runtime_random_u64(uint64_t *out_value) {
     uint32_t i;
 
@@ -401,6 +416,10 @@ asx_status asx_runtime_reactor_wait(uint32_t timeout_ms,
 
 asx_status asx_runtime_log_write(int level, const char *message) {
     if (!g_hooks_installed) return ASX_E_INVALID_STATE;
+    /* Async pipeline: enqueue only; a drainer calls the sink */
+    if (g_rt->log_ring != NULL) {
+        return asx_log_ring_push(g_rt->log_ring, level, message);
+    }
     if (!g_hooks.log.write_fn) return ASX_OK; /* silent if no log hook */
     g_hooks.log.write_fn(g_hooks.log.ctx, level, message);
     return ASX_OK;
@@ -0,0 +1,683 @@
+/*
+ * instance.c — runtime instances and context-taking API variants
+ *
+ * Module state lives in struct asx_runtime (runtime_internal.h) and is
+ * reached through g_rt, the calling thread's current instance. The
+ * asx_rt_* variants switch g_rt for the duration of one call.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/instance.h>
+#include <asx/runtime/hindsight.h>
+#include <string.h>
+#include "runtime_internal.h"
+
+/* -------------------------------------------------------------------
+ * Default and current instance
+ * ------------------------------------------------------------------- */
+
+/* Non-zero fields must match asx_runtime_instance_defaults(). */
+static asx_runtime g_default_runtime = {
+    .resource_class = ASX_CLASS_R2,
+    .sched_policy   = ASX_SCHED_POLICY_ARENA_ORDER,
+    .hs_policy      = { 1, 1 }
+};
+
+ASX_THREAD_LOCAL asx_runtime *g_rt = &g_default_runtime;
+
+void asx_runtime_instance_defaults(asx_runtime *rt)
+{
+    rt->resource_class = ASX_CLASS_R2;
+    rt->sched_policy = ASX_SCHED_POLICY_ARENA_ORDER;
+    rt->hs_policy.flush_on_invariant = 1;
+    rt->hs_policy.flush_on_divergence = 1;
+}
+
+static asx_runtime *rt_enter(asx_runtime *rt)
+{
+    asx_runtime *prev = g_rt;
+
+    g_rt = rt != NULL ? rt : &g_default_runtime;
+    return prev;
+}
+
+asx_runtime *asx_runtime_default(void)
+{
+    return &g_default_runtime;
+}
+
+asx_runtime *asx_runtime_current(void)
+{
+    return g_rt;
+}
+
+asx_runtime *asx_runtime_enter(asx_runtime *rt)
+{
+    return rt_enter(rt);
+}
+
+asx_resource_class asx_runtime_resource_class(const asx_runtime *rt)
+{
+    return rt != NULL ? rt->resource_class : g_default_runtime.resource_class;
+}
+
+/* -------------------------------------------------------------------
+ * Create / destroy
+ * ------------------------------------------------------------------- */
+
+asx_status asx_runtime_create(const asx_runtime_hooks *hooks,
+                              asx_resource_class cls,
+                              asx_runtime **out)
+{
+    asx_runtime_hooks h;
+    asx_runtime *rt;
+    asx_runtime *prev;
+    asx_status st;
+
+    if (out == NULL || cls >= ASX_CLASS_COUNT) return ASX_E_INVALID_ARGUMENT;
+    *out = NULL;
+
+    if (hooks != NULL) {
+        h = *hooks;
+    } else {
+        st = asx_runtime_hooks_init(&h);
+        if (st != ASX_OK) return st;
+    }
+    st = asx_runtime_hooks_validate(&h, ASX_DETERMINISTIC);
+    if (st != ASX_OK) return st;
+
+    rt = (asx_runtime *)h.allocator.malloc_fn(h.allocator.ctx, sizeof(*rt));
+    if (rt == NULL) return ASX_E_RESOURCE_EXHAUSTED;
+    memset(rt, 0, sizeof(*rt));
+    asx_runtime_instance_defaults(rt);
+    rt->resource_class = cls;
+    rt->heap_owned = 1;
+    rt->owner = h.allocator;
+
+    prev = rt_enter(rt);
+    asx_runtime_reset();
+    st = asx_runtime_set_hooks(&h);
+    g_rt = prev;
+    if (st != ASX_OK) {
+        h.allocator.free_fn(h.allocator.ctx, rt);
+        return st;
+    }
+
+    *out = rt;
+    return ASX_OK;
+}
+
+void asx_runtime_destroy(asx_runtime *rt)
+{
+    asx_runtime *prev;
+    asx_allocator_hooks owner;
+
+    if (rt == NULL || !rt->heap_owned) return;
+
+    /* Return region chunks to the pool, then free hook-allocated ones
+     * and channel rings through the instance's own allocator. */
+    prev = rt_enter(rt);
+    asx_runtime_reset();
+    asx_capture_pool_drain();
+    asx_channel_reset();
+    g_rt = prev == rt ? &g_default_runtime : prev;
+
+    owner = rt->owner;
+    owner.free_fn(owner.ctx, rt);
+}
+
+/* -------------------------------------------------------------------
+ * Timer wheel
+ * ------------------------------------------------------------------- */
+
+asx_timer_wheel *asx_rt_timer_wheel(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    g_rt = prev;
+    return w;
+}
+
+/* -------------------------------------------------------------------
+ * Regions
+ * ------------------------------------------------------------------- */
+
+asx_status asx_rt_region_open(asx_runtime *rt, asx_region_id *out_id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_open(out_id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_open_child(asx_runtime *rt, asx_region_id parent,
+                                    asx_region_id *out_id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_open_child(parent, out_id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_get_parent(asx_runtime *rt, asx_region_id id,
+                                    asx_region_id *out_parent)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_get_parent(id, out_parent);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_close(asx_runtime *rt, asx_region_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_close(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_get_state(asx_runtime *rt, asx_region_id id,
+                                   asx_region_state *out_state)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_get_state(id, out_state);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_poison(asx_runtime *rt, asx_region_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_poison(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_is_poisoned(asx_runtime *rt, asx_region_id id,
+                                     int *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_is_poisoned(id, out);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_contain_fault(asx_runtime *rt, asx_region_id id,
+                                       asx_status fault)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_contain_fault(id, fault);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_region_drain(asx_runtime *rt, asx_region_id id,
+                               asx_budget *budget)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_region_drain(id, budget);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_quiescence_check(asx_runtime *rt, asx_region_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_quiescence_check(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_quiescence_check_subtree(asx_runtime *rt, asx_region_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_quiescence_check_subtree(id);
+    g_rt = prev;
+    return r;
+}
+
+/* -------------------------------------------------------------------
+ * Tasks
+ * ------------------------------------------------------------------- */
+
+asx_status asx_rt_task_spawn(asx_runtime *rt, asx_region_id region,
+                             asx_task_poll_fn poll_fn, void *user_data,
+                             asx_task_id *out_id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_spawn(region, poll_fn, user_data, out_id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_spawn_captured(asx_runtime *rt, asx_region_id region,
+                                      asx_task_poll_fn poll_fn,
+                                      uint32_t state_size,
+                                      asx_task_state_dtor_fn state_dtor,
+                                      asx_task_id *out_id, void **out_state)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_spawn_captured(region, poll_fn, state_size,
+                                           state_dtor, out_id, out_state);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_get_state(asx_runtime *rt, asx_task_id id,
+                                 asx_task_state *out_state)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_get_state(id, out_state);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_get_outcome(asx_runtime *rt, asx_task_id id,
+                                   asx_outcome *out_outcome)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_get_outcome(id, out_outcome);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_await(asx_runtime *rt, asx_task_id self,
+                             asx_task_id child)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_await(self, child);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_cancel(asx_runtime *rt, asx_task_id id,
+                              asx_cancel_kind kind)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_cancel(id, kind);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_cancel_with_origin(asx_runtime *rt, asx_task_id id,
+                                          asx_cancel_kind kind,
+                                          asx_region_id origin_region,
+                                          asx_task_id origin_task)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_cancel_with_origin(id, kind, origin_region,
+                                               origin_task);
+    g_rt = prev;
+    return r;
+}
+
+uint32_t asx_rt_cancel_propagate(asx_runtime *rt, asx_region_id region,
+                                 asx_cancel_kind kind)
+{
+    asx_runtime *prev = rt_enter(rt);
+    uint32_t r = asx_cancel_propagate(region, kind);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_checkpoint(asx_runtime *rt, asx_task_id self,
+                             asx_checkpoint_result *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_checkpoint(self, out);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_finalize(asx_runtime *rt, asx_task_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_finalize(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_get_cancel_phase(asx_runtime *rt, asx_task_id id,
+                                        asx_cancel_phase *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_get_cancel_phase(id, out);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_set_budget(asx_runtime *rt, asx_task_id id,
+                                  const asx_budget *budget)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_set_budget(id, budget);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_task_report_cost(asx_runtime *rt, asx_task_id self,
+                                   uint64_t cost)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_task_report_cost(self, cost);
+    g_rt = prev;
+    return r;
+}
+
+/* -------------------------------------------------------------------
+ * Obligations
+ * ------------------------------------------------------------------- */
+
+asx_status asx_rt_obligation_reserve(asx_runtime *rt, asx_region_id region,
+                                     asx_obligation_id *out_id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_obligation_reserve(region, out_id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_obligation_commit(asx_runtime *rt, asx_obligation_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_obligation_commit(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_obligation_abort(asx_runtime *rt, asx_obligation_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_obligation_abort(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_obligation_get_state(asx_runtime *rt, asx_obligation_id id,
+                                       asx_obligation_state *out_state)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_obligation_get_state(id, out_state);
+    g_rt = prev;
+    return r;
+}
+
+/* -------------------------------------------------------------------
+ * Scheduler
+ * ------------------------------------------------------------------- */
+
+asx_status asx_rt_scheduler_run(asx_runtime *rt, asx_region_id region,
+                                asx_budget *budget)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_scheduler_run(region, budget);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_scheduler_set_policy(asx_runtime *rt,
+                                       asx_sched_policy policy)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_scheduler_set_policy(policy);
+    g_rt = prev;
+    return r;
+}
+
+asx_sched_policy asx_rt_scheduler_get_policy(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_sched_policy r = asx_scheduler_get_policy();
+    g_rt = prev;
+    return r;
+}
+
+void asx_rt_scheduler_set_deadline_monitor(asx_runtime *rt, int enabled)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_scheduler_set_deadline_monitor(enabled);
+    g_rt = prev;
+}
+
+void asx_rt_scheduler_set_idle_strategy(asx_runtime *rt,
+                                        const asx_idle_strategy *strategy)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_scheduler_set_idle_strategy(strategy);
+    g_rt = prev;
+}
+
+uint32_t asx_rt_scheduler_event_count(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    uint32_t r = asx_scheduler_event_count();
+    g_rt = prev;
+    return r;
+}
+
+int asx_rt_scheduler_event_get(asx_runtime *rt, uint32_t index,
+                               asx_scheduler_event *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    int r = asx_scheduler_event_get(index, out);
+    g_rt = prev;
+    return r;
+}
+
+void asx_rt_scheduler_event_reset(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_scheduler_event_reset();
+    g_rt = prev;
+}
+
+/* -------------------------------------------------------------------
+ * Channels
+ * ------------------------------------------------------------------- */
+
+asx_status asx_rt_channel_create(asx_runtime *rt, asx_region_id region,
+                                 uint32_t capacity, asx_channel_id *out_id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_create(region, capacity, out_id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_channel_close_sender(asx_runtime *rt, asx_channel_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_close_sender(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_channel_close_receiver(asx_runtime *rt, asx_channel_id id)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_close_receiver(id);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_channel_get_state(asx_runtime *rt, asx_channel_id id,
+                                    asx_channel_state *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_get_state(id, out);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_channel_queue_len(asx_runtime *rt, asx_channel_id id,
+                                    uint32_t *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_queue_len(id, out);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_channel_reserved_count(asx_runtime *rt, asx_channel_id id,
+                                         uint32_t *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_reserved_count(id, out);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_channel_set_capacity(asx_runtime *rt, asx_channel_id id,
+                                       uint32_t capacity)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_set_capacity(id, capacity);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_channel_try_reserve(asx_runtime *rt, asx_channel_id id,
+                                      asx_send_permit *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_try_reserve(id, out);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_send_permit_send(asx_runtime *rt, asx_send_permit *permit,
+                                   uint64_t value)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_send_permit_send(permit, value);
+    g_rt = prev;
+    return r;
+}
+
+void asx_rt_send_permit_abort(asx_runtime *rt, asx_send_permit *permit)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_send_permit_abort(permit);
+    g_rt = prev;
+}
+
+asx_status asx_rt_channel_try_recv(asx_runtime *rt, asx_channel_id id,
+                                   uint64_t *out_value)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_channel_try_recv(id, out_value);
+    g_rt = prev;
+    return r;
+}
+
+void asx_rt_channel_reset(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_channel_reset();
+    g_rt = prev;
+}
+
+/* -------------------------------------------------------------------
+ * Trace
+ * ------------------------------------------------------------------- */
+
+void asx_rt_trace_emit(asx_runtime *rt, asx_trace_event_kind kind,
+                       uint64_t entity_id, uint64_t aux)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_trace_emit(kind, entity_id, aux);
+    g_rt = prev;
+}
+
+uint32_t asx_rt_trace_event_count(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    uint32_t r = asx_trace_event_count();
+    g_rt = prev;
+    return r;
+}
+
+int asx_rt_trace_event_get(asx_runtime *rt, uint32_t index,
+                           asx_trace_event *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    int r = asx_trace_event_get(index, out);
+    g_rt = prev;
+    return r;
+}
+
+void asx_rt_trace_reset(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_trace_reset();
+    g_rt = prev;
+}
+
+uint64_t asx_rt_trace_digest(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    uint64_t r = asx_trace_digest();
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_snapshot_capture(asx_runtime *rt, asx_snapshot_buffer *out)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_snapshot_capture(out);
+    g_rt = prev;
+    return r;
+}
+
+/* -------------------------------------------------------------------
+ * Hooks
+ * ------------------------------------------------------------------- */
+
+asx_status asx_rt_set_hooks(asx_runtime *rt, const asx_runtime_hooks *hooks)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_runtime_set_hooks(hooks);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_seal_allocator(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_runtime_seal_allocator();
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_alloc(asx_runtime *rt, size_t size, void **out_ptr)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_runtime_alloc(size, out_ptr);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_free(asx_runtime *rt, void *ptr)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_runtime_free(ptr);
+    g_rt = prev;
+    return r;
+}
+
+asx_status asx_rt_now_ns(asx_runtime *rt, asx_time *out_now)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_status r = asx_runtime_now_ns(out_now);
+    g_rt = prev;
+    return r;
+}
+
+void asx_rt_reset(asx_runtime *rt)
+{
+    asx_runtime *prev = rt_enter(rt);
+    asx_runtime_reset();
+    g_rt = prev;
+}
@@ -5,7 +5,8 @@
  * and region/task lifecycle operations.
  *
  * Uses fixed-size static arenas. Phase 3 will replace with
- * hook-backed dynamic allocation (bd-hwb.3, bd-2cw.1).
+ * hook-backed dynamic allocation (bd-hwb.3, bd-2cw.1); captured task
+ * state already lives in pooled chunks (see capture chunk pool).
  *
  * SPDX-License-Identifier: MIT
  */
@@ -17,18 +18,10 @@
 #include <string.h>
 #include "runtime_internal.h"
 
-/* -------------------------------------------------------------------
- * Global arenas (walking skeleton: fixed-size, no dynamic allocation)
- * ------------------------------------------------------------------- */
-
-asx_region_slot g_regions[ASX_MAX_REGIONS];
-uint32_t        g_region_count;
+/* Arenas are fixed-size and owned by the current runtime instance
+ * (g_regions, g_tasks, g_obligations; see runtime_internal.h). */
 
-asx_task_slot   g_tasks[ASX_MAX_TASKS];
-uint32_t        g_task_count;
-
-asx_obligation_slot g_obligations[ASX_MAX_OBLIGATIONS];
-uint32_t            g_obligation_count;
+static void asx_capture_pool_reset(void);
 
 /* -------------------------------------------------------------------
  * Reset (test support)
@@ -44,25 +37,54 @@ void asx_runtime_reset(void)
         g_regions[i].generation = 0;
         g_regions[i].alive      = 0;
         asx_cleanup_init(&g_regions[i].cleanup);
-        g_regions[i].capture_used = 0;
+        g_regions[i].task_head = ASX_TASK_LINK_NONE;
+        g_regions[i].task_tail = ASX_TASK_LINK_NONE;
+        g_regions[i].parent = ASX_REGION_LINK_NONE;
+        g_regions[i].child_head = ASX_REGION_LINK_NONE;
+        g_regions[i].child_tail = ASX_REGION_LINK_NONE;
+        g_regions[i].sibling_next = ASX_REGION_LINK_NONE;
+        g_regions[i].sibling_prev = ASX_REGION_LINK_NONE;
+        g_regions[i].child_count = 0;
+        g_regions[i].subtree_tasks = 0;
+        g_regions[i].subtree_regions = 0;
+        g_regions[i].vtime = 0;
+        g_regions[i].vclock = 0;
+        asx_region_capture_release(&g_regions[i]);
     }
     g_region_count = 0;
+    memset(g_rt->admission, 0, sizeof(g_rt->admission));
+    asx_capture_pool_reset();
     for (i = 0; i < ASX_MAX_TASKS; i++) {
+        asx_task_cold *tc = &g_task_cold[i];
+
         g_tasks[i].state      = ASX_TASK_CREATED;
-        g_tasks[i].region     = ASX_INVALID_ID;
         g_tasks[i].poll_fn    = NULL;
         g_tasks[i].user_data  = NULL;
-        g_tasks[i].outcome    = asx_outcome_make(ASX_OUTCOME_OK);
         g_tasks[i].generation = 0;
         g_tasks[i].alive      = 0;
-        g_tasks[i].captured_state = NULL;
-        g_tasks[i].captured_size = 0;
-        g_tasks[i].captured_dtor = NULL;
-        g_tasks[i].cancel_phase = 0;
         g_tasks[i].cancel_pending = 0;
-        g_tasks[i].cancel_epoch = 0;
-        g_tasks[i].cleanup_polls_remaining = 0;
-        memset(&g_tasks[i].cancel_reason, 0, sizeof(g_tasks[i].cancel_reason));
+        g_tasks[i].region_next = ASX_TASK_LINK_NONE;
+        g_tasks[i].region_prev = ASX_TASK_LINK_NONE;
+        g_tasks[i].parked = 0;
+        g_tasks[i].wake_at = 0;
+        g_tasks[i].deadline = 0;
+        g_tasks[i].priority = 255;
+        g_tasks[i].vtime = 0;
+        tc->region = ASX_INVALID_ID;
+        tc->outcome = asx_outcome_make(ASX_OUTCOME_OK);
+        tc->captured_state = NULL;
+        tc->captured_size = 0;
+        tc->captured_dtor = NULL;
+        tc->cancel_phase = 0;
+        tc->cancel_epoch = 0;
+        tc->cleanup_polls_remaining = 0;
+        memset(&tc->cancel_reason, 0, sizeof(tc->cancel_reason));
+        tc->waiter = ASX_TASK_LINK_NONE;
+        tc->has_outcome_override = 0;
+        tc->outcome_override = asx_outcome_make(ASX_OUTCOME_OK);
+        tc->deadline_reported = 0;
+        tc->poll_cost = 0;
+        tc->cost_reported = 0;
     }
     g_task_count = 0;
     for (i = 0; i < ASX_MAX_OBLIGATIONS; i++) {
@@ -72,6 +94,12 @@ void asx_runtime_reset(void)
         g_obligations[i].alive      = 0;
     }
     g_obligation_count = 0;
+    asx_wake_registry_reset();
+
+    /* Handles are reissued from generation 0: earlier trace records
+     * (and the scheduler and event views over them) no longer apply */
+    asx_trace_reset();
+    asx_snapshot_tracking_reset();
 
     /* Reset ghost safety monitors */
     asx_ghost_reset();
@@ -127,6 +155,144 @@ asx_status asx_task_slot_lookup(asx_task_id id, asx_task_slot **out)
     return ASX_OK;
 }
 
+/* -------------------------------------------------------------------
+ * Region task list maintenance
+ * ------------------------------------------------------------------- */
+
+void asx_region_task_link(asx_region_slot *r, uint32_t task_idx)
+{
+    asx_task_slot *t = &g_tasks[task_idx];
+    uint32_t after = r->task_tail;
+
+    /* Keep ascending arena order. Spawn allocates monotonically, so the
+     * walk back from the tail terminates immediately in practice. */
+    while (after != ASX_TASK_LINK_NONE && after > task_idx) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: ordered insert bounded by "
+                              "region live tasks <= ASX_MAX_TASKS");
+        after = g_tasks[after].region_prev;
+    }
+
+    t->region_prev = after;
+    if (after == ASX_TASK_LINK_NONE) {
+        t->region_next = r->task_head;
+        r->task_head = task_idx;
+    } else {
+        t->region_next = g_tasks[after].region_next;
+        g_tasks[after].region_next = task_idx;
+    }
+    if (t->region_next == ASX_TASK_LINK_NONE) {
+        r->task_tail = task_idx;
+    } else {
+        g_tasks[t->region_next].region_prev = task_idx;
+    }
+
+    for (;;) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: ancestor walk bounded by "
+                              "tree depth <= ASX_MAX_REGIONS");
+        r->subtree_tasks++;
+        if (r->parent == ASX_REGION_LINK_NONE) break;
+        r = &g_regions[r->parent];
+    }
+}
+
+void asx_region_task_retire(asx_region_slot *r, uint32_t task_idx)
+{
+    asx_task_slot *t = &g_tasks[task_idx];
+    asx_task_cold *tc = &g_task_cold[task_idx];
+
+    if (t->region_prev == ASX_TASK_LINK_NONE) {
+        r->task_head = t->region_next;
+    } else {
+        g_tasks[t->region_prev].region_next = t->region_next;
+    }
+    if (t->region_next == ASX_TASK_LINK_NONE) {
+        r->task_tail = t->region_prev;
+    } else {
+        g_tasks[t->region_next].region_prev = t->region_prev;
+    }
+    t->region_prev = ASX_TASK_LINK_NONE;
+    r->task_count--;
+    ASX_SNAP_MARK(tasks, task_idx);
+    ASX_SNAP_MARK_REGION(r);
+
+    /* Wake the task awaiting this one */
+    if (tc->waiter != ASX_TASK_LINK_NONE) {
+        ASX_TASK_UNPARK(&g_tasks[tc->waiter]);
+        tc->waiter = ASX_TASK_LINK_NONE;
+    }
+    if (g_rt->admission[r - g_regions].engaged) {
+        asx_admission_on_task_retire(r);
+    }
+
+    for (;;) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: ancestor walk bounded by "
+                              "tree depth <= ASX_MAX_REGIONS");
+        r->subtree_tasks--;
+        if (r->parent == ASX_REGION_LINK_NONE) break;
+        r = &g_regions[r->parent];
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Region tree maintenance
+ * ------------------------------------------------------------------- */
+
+asx_region_id asx_region_handle_at(uint32_t idx)
+{
+    return asx_handle_pack(ASX_TYPE_REGION,
+                           (uint16_t)(1u << (unsigned)g_regions[idx].state),
+                           asx_handle_pack_index(g_regions[idx].generation,
+                                                 (uint16_t)idx));
+}
+
+uint32_t asx_region_subtree_next(uint32_t root, uint32_t idx)
+{
+    if (g_regions[idx].child_head != ASX_REGION_LINK_NONE) {
+        return g_regions[idx].child_head;
+    }
+    while (idx != root) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: upward walk bounded by "
+                              "tree depth <= ASX_MAX_REGIONS");
+        if (g_regions[idx].sibling_next != ASX_REGION_LINK_NONE) {
+            return g_regions[idx].sibling_next;
+        }
+        idx = g_regions[idx].parent;
+    }
+    return ASX_REGION_LINK_NONE;
+}
+
+void asx_region_detach_closed(asx_region_slot *r)
+{
+    asx_region_slot *p;
+
+    if (r->parent == ASX_REGION_LINK_NONE) return;
+    p = &g_regions[r->parent];
+
+    if (r->sibling_prev == ASX_REGION_LINK_NONE) {
+        p->child_head = r->sibling_next;
+    } else {
+        g_regions[r->sibling_prev].sibling_next = r->sibling_next;
+    }
+    if (r->sibling_next == ASX_REGION_LINK_NONE) {
+        p->child_tail = r->sibling_prev;
+    } else {
+        g_regions[r->sibling_next].sibling_prev = r->sibling_prev;
+    }
+    p->child_count--;
+
+    for (;;) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: ancestor walk bounded by "
+                              "tree depth <= ASX_MAX_REGIONS");
+        p->subtree_regions--;
+        if (p->parent == ASX_REGION_LINK_NONE) break;
+        p = &g_regions[p->parent];
+    }
+
+    r->parent = ASX_REGION_LINK_NONE;
+    r->sibling_next = ASX_REGION_LINK_NONE;
+    r->sibling_prev = ASX_REGION_LINK_NONE;
+}
+
 static uint32_t asx_align_up_u32(uint32_t value, uint32_t align)
 {
     uint32_t rem = value % align;
@@ -134,38 +300,238 @@ static uint32_t asx_align_up_u32(uint32_t value, uint32_t align)
     return value + (align - rem);
 }
 
-static void *asx_region_capture_alloc(asx_region_slot *region, uint32_t size, uint32_t *old_used_out)
+/* -------------------------------------------------------------------
+ * Capture chunk pool
+ *
+ * Chunks are carved from the instance's reserve first and, once that
+ * is exhausted, allocated through the allocator hook (unless sealed).
+ * Released chunks go onto the instance free list and are reused
+ * first-fit; hook-allocated chunks stay pooled for the instance
+ * lifetime, reserve chunks are reclaimed wholesale by
+ * asx_runtime_reset().
+ * ------------------------------------------------------------------- */
+
+#define g_capture_reserve      (g_rt->capture_reserve)
+#define g_capture_reserve_used (g_rt->capture_reserve_used)
+#define g_capture_pool         (g_rt->capture_pool)
+
+static int asx_capture_chunk_in_reserve(const asx_capture_chunk *c)
+{
+    const uint8_t *base = (const uint8_t *)g_capture_reserve;
+    const uint8_t *p = (const uint8_t *)c;
+    return p >= base && p < base + sizeof(g_capture_reserve);
+}
+
+static uint32_t asx_capture_reserve_free(void)
+{
+    return (uint32_t)sizeof(g_capture_reserve) - g_capture_reserve_used;
+}
+
+static asx_capture_chunk *asx_capture_chunk_acquire(uint32_t need)
+{
+    asx_capture_chunk **link;
+    asx_capture_chunk *c;
+    const asx_runtime_hooks *hooks;
+    uint32_t cap;
+    void *mem;
+
+    /* Reuse a pooled chunk */
+    for (link = &g_capture_pool; *link != NULL; link = &(*link)->next) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: first-fit over pooled "
+                              "capture chunks, bounded by chunks created");
+        if ((*link)->capacity >= need) {
+            c = *link;
+            *link = c->next;
+            c->next = NULL;
+            c->used = 0;
+            return c;
+        }
+    }
+
+    cap = need > ASX_CAPTURE_CHUNK_BYTES ? need : ASX_CAPTURE_CHUNK_BYTES;
+
+    /* Carve from the static reserve; the tail may yield a short chunk */
+    if (asx_capture_reserve_free() >= ASX_CAPTURE_CHUNK_HDR + need) {
+        if (asx_capture_reserve_free() < ASX_CAPTURE_CHUNK_HDR + cap) {
+            cap = asx_capture_reserve_free() - ASX_CAPTURE_CHUNK_HDR;
+        }
+        c = (asx_capture_chunk *)(void *)
+            ((uint8_t *)g_capture_reserve + g_capture_reserve_used);
+        g_capture_reserve_used += ASX_CAPTURE_CHUNK_HDR + cap;
+        c->next = NULL;
+        c->capacity = cap;
+        c->used = 0;
+        return c;
+    }
+
+    /* Grow through the allocator hook */
+    hooks = asx_runtime_get_hooks();
+    if (hooks == NULL || hooks->allocator_sealed) return NULL;
+    if (asx_runtime_alloc((size_t)ASX_CAPTURE_CHUNK_HDR + cap, &mem) != ASX_OK) {
+        return NULL;
+    }
+    c = (asx_capture_chunk *)mem;
+    c->next = NULL;
+    c->capacity = cap;
+    c->used = 0;
+    return c;
+}
+
+static void asx_capture_chunk_pool_put(asx_capture_chunk *c)
+{
+    c->next = g_capture_pool;
+    g_capture_pool = c;
+}
+
+void asx_region_capture_release(asx_region_slot *r)
+{
+    asx_capture_chunk *c;
+    asx_capture_chunk *next;
+
+    for (c = r->capture_head; c != NULL; c = next) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: returns region chunks to "
+                              "the pool, bounded by chunks owned");
+        next = c->next;
+        asx_capture_chunk_pool_put(c);
+    }
+    r->capture_head = NULL;
+    r->capture_used = 0;
+}
+
+/* Drop reserve chunks from the pool and rewind the reserve. Callers
+ * must have released every region first. */
+static void asx_capture_pool_reset(void)
+{
+    asx_capture_chunk **link = &g_capture_pool;
+
+    while (*link != NULL) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: reset-time pool filter, "
+                              "bounded by chunks created");
+        if (asx_capture_chunk_in_reserve(*link)) {
+            *link = (*link)->next;
+        } else {
+            link = &(*link)->next;
+        }
+    }
+    g_capture_reserve_used = 0;
+}
+
+void asx_capture_pool_drain(void)
+{
+    asx_capture_chunk *c;
+
+    while (g_capture_pool != NULL) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: teardown pool drain, "
+                              "bounded by chunks created");
+        c = g_capture_pool;
+        g_capture_pool = c->next;
+        if (!asx_capture_chunk_in_reserve(c)
+            && asx_runtime_free(c) != ASX_OK) {
+            break;
+        }
+    }
+}
+
+uint32_t asx_region_capture_headroom(const asx_region_slot *r)
+{
+    const asx_runtime_hooks *hooks;
+    const asx_capture_chunk *c;
+    uint32_t quota_left;
+    uint32_t best;
+
+    if (r->capture_used >= ASX_REGION_CAPTURE_ARENA_BYTES) return 0;
+    quota_left = ASX_REGION_CAPTURE_ARENA_BYTES - r->capture_used;
+
+    hooks = asx_runtime_get_hooks();
+    if (hooks != NULL && !hooks->allocator_sealed) return quota_left;
+
+    best = 0;
+    if (r->capture_head != NULL) {
+        best = r->capture_head->capacity - r->capture_head->used;
+    }
+    if (asx_capture_reserve_free() > ASX_CAPTURE_CHUNK_HDR
+        && asx_capture_reserve_free() - ASX_CAPTURE_CHUNK_HDR > best) {
+        best = asx_capture_reserve_free() - ASX_CAPTURE_CHUNK_HDR;
+    }
+    for (c = g_capture_pool; c != NULL && best < quota_left; c = c->next) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: diagnostic pool scan, "
+                              "bounded by chunks created");
+        if (c->capacity > best) best = c->capacity;
+    }
+    return best < quota_left ? best : quota_left;
+}
+
+/* Undo point for a capture allocation whose spawn fails later. */
+typedef struct {
+    asx_capture_chunk *head;
+    uint32_t           head_used;
+    uint32_t           used;
+} asx_capture_mark;
+
+static void *asx_region_capture_alloc(asx_region_slot *region, uint32_t size,
+                                      asx_capture_mark *mark)
 {
-    uint32_t start;
+    asx_capture_chunk *c;
     uint32_t aligned_size;
-    uint32_t end;
+    void *p;
+
+    if (size == 0u || mark == NULL) return NULL;
 
-    if (size == 0u || old_used_out == NULL) return NULL;
+    mark->head = region->capture_head;
+    mark->head_used = region->capture_head != NULL ? region->capture_head->used : 0u;
+    mark->used = region->capture_used;
 
-    *old_used_out = region->capture_used;
-    start = asx_align_up_u32(region->capture_used, 8u);
+    if (size > ASX_REGION_CAPTURE_ARENA_BYTES) return NULL;
     aligned_size = asx_align_up_u32(size, 8u);
+    if (aligned_size > ASX_REGION_CAPTURE_ARENA_BYTES - region->capture_used) {
+        return NULL;
+    }
 
-    if (start > ASX_REGION_CAPTURE_ARENA_BYTES) return NULL;
-    if (aligned_size > (ASX_REGION_CAPTURE_ARENA_BYTES - start)) return NULL;
+    c = region->capture_head;
+    if (c == NULL || c->capacity - c->used < aligned_size) {
+        c = asx_capture_chunk_acquire(aligned_size);
+        if (c == NULL) return NULL;
+        c->next = region->capture_head;
+        region->capture_head = c;
+    }
 
-    end = start + aligned_size;
-    if (end > ASX_REGION_CAPTURE_ARENA_BYTES) return NULL;
+    p = (void *)((uint8_t *)c + ASX_CAPTURE_CHUNK_HDR + c->used);
+    c->used += aligned_size;
+    region->capture_used += aligned_size;
+    return p;
+}
 
-    region->capture_used = end;
-    return (void *)&region->capture_arena[start];
+void *asx_region_capture_restore(asx_region_slot *r, uint32_t size)
+{
+    asx_capture_mark mark;
+
+    return asx_region_capture_alloc(r, size, &mark);
+}
+
+static void asx_region_capture_rollback(asx_region_slot *region,
+                                        const asx_capture_mark *mark)
+{
+    asx_capture_chunk *c = region->capture_head;
+
+    /* At most one chunk was acquired by the failed allocation */
+    if (c != mark->head && c != NULL) {
+        region->capture_head = c->next;
+        asx_capture_chunk_pool_put(c);
+    }
+    if (mark->head != NULL) mark->head->used = mark->head_used;
+    region->capture_used = mark->used;
 }
 
 /* -------------------------------------------------------------------
  * Region lifecycle
  * ------------------------------------------------------------------- */
 
-asx_status asx_region_open(asx_region_id *out_id)
+static asx_status asx_region_open_at(asx_region_slot *parent,
+                                     asx_region_id *out_id)
 {
     uint32_t idx;
     int reclaim;
-
-    if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
+    asx_region_slot *r;
 
     /* Scan for a recyclable slot: unused (alive=0) or CLOSED with no tasks.
      * When ASX_DEBUG_QUARANTINE is defined, CLOSED slots are never recycled
@@ -184,18 +550,57 @@ asx_status asx_region_open(asx_region_id *out_id)
     }
     if (idx >= ASX_MAX_REGIONS) return ASX_E_RESOURCE_EXHAUSTED;
 
+    r = &g_regions[idx];
+
     /* Increment generation on slot reclaim to invalidate stale handles */
     if (reclaim) {
-        g_regions[idx].generation++;
+        r->generation++;
     }
 
-    g_regions[idx].state      = ASX_REGION_OPEN;
-    g_regions[idx].task_count = 0;
-    g_regions[idx].task_total = 0;
-    g_regions[idx].alive      = 1;
-    g_regions[idx].poisoned   = 0;
-    asx_cleanup_init(&g_regions[idx].cleanup);
-    g_regions[idx].capture_used = 0;
+    r->state      = ASX_REGION_OPEN;
+    r->task_count = 0;
+    r->task_total = 0;
+    r->alive      = 1;
+    r->poisoned   = 0;
+    ASX_SNAP_MARK_REGION(r);
+    asx_cleanup_init(&r->cleanup);
+    r->task_head = ASX_TASK_LINK_NONE;
+    r->task_tail = ASX_TASK_LINK_NONE;
+    r->parent = ASX_REGION_LINK_NONE;
+    r->child_head = ASX_REGION_LINK_NONE;
+    r->child_tail = ASX_REGION_LINK_NONE;
+    r->sibling_next = ASX_REGION_LINK_NONE;
+    r->sibling_prev = ASX_REGION_LINK_NONE;
+    r->child_count = 0;
+    r->subtree_tasks = 0;
+    r->subtree_regions = 0;
+    r->vtime = 0;
+    r->vclock = 0;
+    asx_region_capture_release(r);
+
+    /* Append to the parent's child list (open order) and count the new
+     * region in every ancestor's subtree. */
+    if (parent != NULL) {
+        asx_region_slot *a;
+        uint32_t pidx = (uint32_t)(parent - g_regions);
+
+        r->parent = pidx;
+        r->sibling_prev = parent->child_tail;
+        if (parent->child_tail == ASX_REGION_LINK_NONE) {
+            parent->child_head = idx;
+        } else {
+            g_regions[parent->child_tail].sibling_next = idx;
+        }
+        parent->child_tail = idx;
+        parent->child_count++;
+
+        for (a = parent; ; a = &g_regions[a->parent]) {
+            ASX_CHECKPOINT_WAIVER("kernel-lifecycle: ancestor walk bounded by "
+                                  "tree depth <= ASX_MAX_REGIONS");
+            a->subtree_regions++;
+            if (a->parent == ASX_REGION_LINK_NONE) break;
+        }
+    }
 
     if (idx >= g_region_count) {
         g_region_count = idx + 1;
@@ -203,11 +608,50 @@ asx_status asx_region_open(asx_region_id *out_id)
 
     *out_id = asx_handle_pack(ASX_TYPE_REGION,
                               (uint16_t)(1u << (unsigned)ASX_REGION_OPEN),
-                              asx_handle_pack_index(
-                                  g_regions[idx].generation,
-                                  (uint16_t)idx));
+                              asx_handle_pack_index(r->generation,
+                                                    (uint16_t)idx));
+
+    asx_trace_emit(ASX_TRACE_REGION_OPEN, *out_id,
+                   parent != NULL ? (uint64_t)asx_region_handle_at(r->parent) : 0);
+    return ASX_OK;
+}
+
+asx_status asx_region_open(asx_region_id *out_id)
+{
+    if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
+    return asx_region_open_at(NULL, out_id);
+}
+
+asx_status asx_region_open_child(asx_region_id parent, asx_region_id *out_id)
+{
+    asx_region_slot *p;
+    asx_status st;
+
+    if (out_id == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(parent, &p);
+    if (st != ASX_OK) return st;
+    if (p->poisoned) return ASX_E_REGION_POISONED;
+
+    /* Children may only be attached while the parent admits work */
+    if (!asx_region_can_spawn(p->state)) return ASX_E_REGION_NOT_OPEN;
+
+    return asx_region_open_at(p, out_id);
+}
 
-    asx_trace_emit(ASX_TRACE_REGION_OPEN, *out_id, 0);
+asx_status asx_region_get_parent(asx_region_id id, asx_region_id *out_parent)
+{
+    asx_region_slot *r;
+    asx_status st;
+
+    if (out_parent == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_region_slot_lookup(id, &r);
+    if (st != ASX_OK) return st;
+
+    *out_parent = (r->parent == ASX_REGION_LINK_NONE)
+                      ? ASX_INVALID_ID
+                      : asx_region_handle_at(r->parent);
     return ASX_OK;
 }
 
@@ -228,6 +672,7 @@ asx_status asx_region_close(asx_region_id id)
     if (st != ASX_OK) return st;
 
     r->state = ASX_REGION_CLOSING;
+    ASX_SNAP_MARK_REGION(r);
     asx_trace_emit(ASX_TRACE_REGION_CLOSE, id, 0);
     return ASX_OK;
 }
@@ -256,6 +701,7 @@ asx_status asx_region_poison(asx_region_id id)
     if (st != ASX_OK) return st;
 
     r->poisoned = 1;
+    ASX_SNAP_MARK_REGION(r);
     return ASX_OK;
 }
 
@@ -309,6 +755,7 @@ asx_status asx_task_spawn(asx_region_id region,
                           asx_task_id *out_id)
 {
     asx_region_slot *r;
+    asx_task_cold *tc;
     asx_status st;
     uint32_t idx;
 
@@ -324,25 +771,49 @@ asx_status asx_task_spawn(asx_region_id region,
 
     if (g_task_count >= ASX_MAX_TASKS) return ASX_E_RESOURCE_EXHAUSTED;
 
+    /* Last: a SHED_OLDEST decision cancels tasks, so it must only be
+     * taken for a spawn that will otherwise succeed */
+    if (g_rt->admission[r - g_regions].enabled) {
+        st = asx_admission_on_spawn(r);
+        if (st != ASX_OK) return st;
+    }
+
     idx = g_task_count++;
+    tc = &g_task_cold[idx];
     g_tasks[idx].state      = ASX_TASK_CREATED;
-    g_tasks[idx].region     = region;
     g_tasks[idx].poll_fn    = poll_fn;
     g_tasks[idx].user_data  = user_data;
-    g_tasks[idx].outcome    = asx_outcome_make(ASX_OUTCOME_OK);
     g_tasks[idx].generation = 0;
     g_tasks[idx].alive      = 1;
-    g_tasks[idx].captured_state = NULL;
-    g_tasks[idx].captured_size = 0;
-    g_tasks[idx].captured_dtor = NULL;
-    g_tasks[idx].cancel_phase = 0;
     g_tasks[idx].cancel_pending = 0;
-    g_tasks[idx].cancel_epoch = 0;
-    g_tasks[idx].cleanup_polls_remaining = 0;
-    memset(&g_tasks[idx].cancel_reason, 0, sizeof(g_tasks[idx].cancel_reason));
-
+    ASX_TASK_UNPARK(&g_tasks[idx]);   /* a new runnable task */
+    g_tasks[idx].wake_at = 0;
+    g_tasks[idx].deadline = 0;
+    g_tasks[idx].priority = 255;
+    /* Join at the region's virtual clock so a newcomer cannot
+     * monopolize the fair scheduler by starting from zero. */
+    g_tasks[idx].vtime = r->vclock;
+    tc->region = region;
+    tc->outcome = asx_outcome_make(ASX_OUTCOME_OK);
+    tc->captured_state = NULL;
+    tc->captured_size = 0;
+    tc->captured_dtor = NULL;
+    tc->cancel_phase = 0;
+    tc->cancel_epoch = 0;
+    tc->cleanup_polls_remaining = 0;
+    memset(&tc->cancel_reason, 0, sizeof(tc->cancel_reason));
+    tc->waiter = ASX_TASK_LINK_NONE;
+    tc->has_outcome_override = 0;
+    tc->outcome_override = asx_outcome_make(ASX_OUTCOME_OK);
+    tc->deadline_reported = 0;
+    tc->poll_cost = 0;
+    tc->cost_reported = 0;
+
+    asx_region_task_link(r, idx);
     r->task_count++;
     r->task_total++;
+    ASX_SNAP_MARK(tasks, idx);
+    ASX_SNAP_MARK_REGION(r);
 
     *out_id = asx_handle_pack(ASX_TYPE_TASK,
                               (uint16_t)(1u << (unsigned)ASX_TASK_CREATED),
@@ -363,9 +834,10 @@ asx_status asx_task_spawn_captured(asx_region_id region,
 {
     asx_region_slot *r;
     asx_task_slot *t;
+    asx_task_cold *tc;
     asx_status st;
     void *captured;
-    uint32_t old_capture_used;
+    asx_capture_mark mark;
 
     if (out_id == NULL || out_state == NULL) return ASX_E_INVALID_ARGUMENT;
     if (poll_fn == NULL || state_size == 0u) return ASX_E_INVALID_ARGUMENT;
@@ -374,25 +846,26 @@ asx_status asx_task_spawn_captured(asx_region_id region,
     if (st != ASX_OK) return st;
     if (!asx_region_can_spawn(r->state)) return ASX_E_REGION_NOT_OPEN;
 
-    captured = asx_region_capture_alloc(r, state_size, &old_capture_used);
+    captured = asx_region_capture_alloc(r, state_size, &mark);
     if (captured == NULL) return ASX_E_RESOURCE_EXHAUSTED;
     memset(captured, 0, state_size);
 
     st = asx_task_spawn(region, poll_fn, captured, out_id);
     if (st != ASX_OK) {
-        r->capture_used = old_capture_used;
+        asx_region_capture_rollback(r, &mark);
         return st;
     }
 
     st = asx_task_slot_lookup(*out_id, &t);
     if (st != ASX_OK) {
-        r->capture_used = old_capture_used;
+        asx_region_capture_rollback(r, &mark);
         return st;
     }
 
-    t->captured_state = captured;
-    t->captured_size = state_size;
-    t->captured_dtor = state_dtor;
+    tc = ASX_TASK_COLD(t);
+    tc->captured_state = captured;
+    tc->captured_size = state_size;
+    tc->captured_dtor = state_dtor;
     *out_state = captured;
     return ASX_OK;
 }
@@ -424,7 +897,7 @@ asx_status asx_task_get_outcome(asx_task_id id,
     if (st != ASX_OK) return st;
     if (!asx_task_is_terminal(t->state)) return ASX_E_TASK_NOT_COMPLETED;
 
-    *out_outcome = t->outcome;
+    *out_outcome = ASX_TASK_COLD(t)->outcome;
     return ASX_OK;
 }
 
@@ -455,6 +928,15 @@ asx_status asx_obligation_slot_lookup(asx_obligation_id id,
     return ASX_OK;
 }
 
+/* Handle of a live obligation slot (reservation-time state mask) */
+static asx_obligation_id obligation_handle(uint32_t idx)
+{
+    return asx_handle_pack(ASX_TYPE_OBLIGATION,
+                           (uint16_t)(1u << (unsigned)ASX_OBLIGATION_RESERVED),
+                           asx_handle_pack_index(g_obligations[idx].generation,
+                                                 (uint16_t)idx));
+}
+
 asx_status asx_obligation_reserve(asx_region_id region,
                                    asx_obligation_id *out_id)
 {
@@ -479,12 +961,9 @@ asx_status asx_obligation_reserve(asx_region_id region,
     g_obligations[idx].region     = region;
     g_obligations[idx].generation = 0;
     g_obligations[idx].alive      = 1;
+    ASX_SNAP_MARK(obligations, idx);
 
-    *out_id = asx_handle_pack(ASX_TYPE_OBLIGATION,
-                               (uint16_t)(1u << (unsigned)ASX_OBLIGATION_RESERVED),
-                               asx_handle_pack_index(
-                                   g_obligations[idx].generation,
-                                   (uint16_t)idx));
+    *out_id = obligation_handle(idx);
 
     /* Ghost linearity monitor: track obligation reservation */
     asx_ghost_obligation_reserved(*out_id);
@@ -508,6 +987,7 @@ asx_status asx_obligation_commit(asx_obligation_id id)
     if (st != ASX_OK) return st;
 
     o->state = ASX_OBLIGATION_COMMITTED;
+    ASX_SNAP_MARK_OBLIGATION(o);
 
     /* Ghost linearity monitor: track obligation resolution */
     asx_ghost_obligation_resolved(id);
@@ -531,6 +1011,7 @@ asx_status asx_obligation_abort(asx_obligation_id id)
     if (st != ASX_OK) return st;
 
     o->state = ASX_OBLIGATION_ABORTED;
+    ASX_SNAP_MARK_OBLIGATION(o);
 
     /* Ghost linearity monitor: track obligation resolution */
     asx_ghost_obligation_resolved(id);
@@ -538,6 +1019,120 @@ asx_status asx_obligation_abort(asx_obligation_id id)
     return ASX_OK;
 }
 
+/* Resolve a validated batch: by_slot[i] holds the handle for each
+ * index whose bit is set in batch. Walks indices in ascending order,
+ * so the outcome does not depend on the caller's ordering. */
+static void obligation_resolve_batch(const uint32_t *batch,
+                                     const asx_obligation_id *by_slot,
+                                     asx_obligation_state to,
+                                     asx_trace_event_kind kind)
+{
+    asx_obligation_id sorted[ASX_MAX_OBLIGATIONS];
+    uint32_t i, n = 0, last = 0;
+
+    for (i = 0; i < g_obligation_count; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: batch walk bounded by "
+                              "ASX_MAX_OBLIGATIONS");
+        if ((batch[i / 32u] & (1u << (i % 32u))) == 0) continue;
+        g_obligations[i].state = to;
+        ASX_SNAP_MARK(obligations, i);
+        sorted[n++] = by_slot[i];
+        last = i;
+    }
+    if (n == 0) return;
+
+    /* Ghost linearity monitor: one pass for the whole batch */
+    asx_ghost_obligations_resolved(sorted, n);
+
+    asx_trace_emit(kind, sorted[0], (uint64_t)n | ((uint64_t)last << 32));
+}
+
+static asx_status obligation_resolve_many(const asx_obligation_id *ids,
+                                          uint32_t count,
+                                          asx_obligation_state to,
+                                          asx_trace_event_kind kind)
+{
+    uint32_t batch[ASX_SNAP_WORDS(ASX_MAX_OBLIGATIONS)];
+    asx_obligation_id by_slot[ASX_MAX_OBLIGATIONS];
+    asx_obligation_slot *o;
+    asx_status st;
+    uint32_t i, idx;
+
+    if (ids == NULL && count > 0) return ASX_E_INVALID_ARGUMENT;
+    if (count == 0) return ASX_OK;
+
+    /* Validate everything before changing anything */
+    memset(batch, 0, sizeof(batch));
+    for (i = 0; i < count; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: batch validation bounded "
+                              "by caller count");
+        st = asx_obligation_slot_lookup(ids[i], &o);
+        if (st != ASX_OK) return st;
+
+        /* Ghost protocol monitor: validate obligation transition */
+        (void)asx_ghost_check_obligation_transition(ids[i], o->state, to);
+
+        st = asx_obligation_transition_check(o->state, to);
+        if (st != ASX_OK) return st;
+
+        idx = (uint32_t)(o - g_obligations);
+        if (batch[idx / 32u] & (1u << (idx % 32u)))
+            return ASX_E_INVALID_TRANSITION; /* listed twice */
+        batch[idx / 32u] |= 1u << (idx % 32u);
+        by_slot[idx] = ids[i];
+    }
+
+    obligation_resolve_batch(batch, by_slot, to, kind);
+    return ASX_OK;
+}
+
+asx_status asx_obligation_commit_many(const asx_obligation_id *ids,
+                                      uint32_t count)
+{
+    return obligation_resolve_many(ids, count, ASX_OBLIGATION_COMMITTED,
+                                   ASX_TRACE_OBLIGATION_COMMIT_RANGE);
+}
+
+asx_status asx_obligation_abort_many(const asx_obligation_id *ids,
+                                     uint32_t count)
+{
+    return obligation_resolve_many(ids, count, ASX_OBLIGATION_ABORTED,
+                                   ASX_TRACE_OBLIGATION_ABORT_RANGE);
+}
+
+asx_status asx_region_abort_obligations(asx_region_id region,
+                                        uint32_t *out_aborted)
+{
+    uint32_t batch[ASX_SNAP_WORDS(ASX_MAX_OBLIGATIONS)];
+    asx_obligation_id by_slot[ASX_MAX_OBLIGATIONS];
+    asx_region_slot *r;
+    asx_status st;
+    uint32_t i, n = 0;
+
+    st = asx_region_slot_lookup(region, &r);
+    if (st != ASX_OK) return st;
+
+    memset(batch, 0, sizeof(batch));
+    for (i = 0; i < g_obligation_count; i++) {
+        ASX_CHECKPOINT_WAIVER("kernel-lifecycle: region obligation scan "
+                              "bounded by ASX_MAX_OBLIGATIONS");
+        if (!g_obligations[i].alive) continue;
+        if (g_obligations[i].region != region) continue;
+        if (g_obligations[i].state != ASX_OBLIGATION_RESERVED) continue;
+        by_slot[i] = obligation_handle(i);
+        (void)asx_ghost_check_obligation_transition(by_slot[i],
+                                                    ASX_OBLIGATION_RESERVED,
+                                                    ASX_OBLIGATION_ABORTED);
+        batch[i / 32u] |= 1u << (i % 32u);
+        n++;
+    }
+
+    obligation_resolve_batch(batch, by_slot, ASX_OBLIGATION_ABORTED,
+                             ASX_TRACE_OBLIGATION_ABORT_RANGE);
+    if (out_aborted != NULL) *out_aborted = n;
+    return ASX_OK;
+}
+
 asx_status asx_obligation_get_state(asx_obligation_id id,
                                      asx_obligation_state *out_state)
 {
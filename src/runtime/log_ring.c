@@ -0,0 +1,154 @@
+/*
+ * log_ring.c — asynchronous bounded log pipeline
+ *
+ * Bounded MPMC queue with per-slot sequence numbers (Vyukov): a
+ * producer claims position p by CAS on enqueue_pos once slot p's
+ * sequence equals p, fills the record and publishes it by storing
+ * p + 1. The single drainer consumes slot p when its sequence is
+ * p + 1 and hands it back to producers by storing p + capacity.
+ * A slot whose sequence is behind p means the ring is full.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("log ring: the claim loop is lock-free "
+ *   "and retries only when another producer wins the CAS; copies are "
+ *   "bounded by ASX_LOG_RECORD_BYTES and drains by "
+ *   "ASX_LOG_RING_CAPACITY per call.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/log_ring.h>
+#include <stdio.h>
+#include <string.h>
+#include "runtime_internal.h"
+
+#define LOG_RING_MASK (ASX_LOG_RING_CAPACITY - 1u)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOG_LOAD_ACQ(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define LOG_STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define LOG_CAS(p, e, v)    __atomic_compare_exchange_n((p), (e), (v), 0, \
+                                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define LOG_INC(p)          ((void)__atomic_add_fetch((p), 1u, __ATOMIC_RELAXED))
+#else
+/* Volatile-only fallback: producers must be serialized externally. */
+#define LOG_LOAD_ACQ(p)     (*(p))
+#define LOG_STORE_REL(p, v) (*(p) = (v))
+#define LOG_CAS(p, e, v)    (*(p) == *(e) ? (*(p) = (v), 1) : (*(e) = *(p), 0))
+#define LOG_INC(p)          ((void)(*(p) += 1u))
+#endif
+
+/* -------------------------------------------------------------------
+ * Ring
+ * ------------------------------------------------------------------- */
+
+asx_status asx_log_ring_init(asx_log_ring *ring, const asx_log_hooks *sink)
+{
+    uint32_t i;
+
+    if (ring == NULL || sink == NULL || sink->write_fn == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    memset(ring, 0, sizeof(*ring));
+    ring->sink = *sink;
+    for (i = 0; i < ASX_LOG_RING_CAPACITY; i++) {
+        ring->records[i].seq = i;
+    }
+    return ASX_OK;
+}
+
+asx_status asx_log_ring_push(asx_log_ring *ring, int level,
+                             const char *message)
+{
+    asx_log_record *rec;
+    uint32_t pos;
+    uint32_t seq;
+    int32_t diff;
+    size_t len;
+
+    if (ring == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (message == NULL) message = "";
+
+    pos = LOG_LOAD_ACQ(&ring->enqueue_pos);
+    for (;;) {
+        rec = &ring->records[pos & LOG_RING_MASK];
+        seq = LOG_LOAD_ACQ(&rec->seq);
+        diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (LOG_CAS(&ring->enqueue_pos, &pos, pos + 1u)) break;
+        } else if (diff < 0) {
+            LOG_INC(&ring->dropped);
+            return ASX_E_RESOURCE_EXHAUSTED;
+        } else {
+            pos = LOG_LOAD_ACQ(&ring->enqueue_pos);
+        }
+    }
+
+    len = strlen(message);
+    if (len >= ASX_LOG_RECORD_BYTES) {
+        len = ASX_LOG_RECORD_BYTES - 1u;
+        LOG_INC(&ring->truncated);
+    }
+    memcpy(rec->msg, message, len);
+    rec->msg[len] = '\0';
+    rec->level = (int32_t)level;
+    LOG_STORE_REL(&rec->seq, pos + 1u);
+    return ASX_OK;
+}
+
+uint32_t asx_log_ring_drain(asx_log_ring *ring, uint32_t max)
+{
+    asx_log_record *rec;
+    uint32_t n = 0;
+    uint32_t dropped;
+    char note[64];
+
+    if (ring == NULL) return 0;
+    if (max == 0 || max > ASX_LOG_RING_CAPACITY) max = ASX_LOG_RING_CAPACITY;
+
+    while (n < max) {
+        rec = &ring->records[ring->dequeue_pos & LOG_RING_MASK];
+        if (LOG_LOAD_ACQ(&rec->seq) != ring->dequeue_pos + 1u) break;
+        ring->sink.write_fn(ring->sink.ctx, (int)rec->level, rec->msg);
+        LOG_STORE_REL(&rec->seq, ring->dequeue_pos + ASX_LOG_RING_CAPACITY);
+        ring->dequeue_pos++;
+        n++;
+    }
+    ring->written += n;
+
+    /* Never drop silently: report drops since the last report */
+    dropped = LOG_LOAD_ACQ(&ring->dropped);
+    if (dropped != ring->reported_drops) {
+        (void)snprintf(note, sizeof(note), "asx: %lu log records dropped",
+                       (unsigned long)(dropped - ring->reported_drops));
+        ring->sink.write_fn(ring->sink.ctx, ASX_LOG_RING_DROP_LEVEL, note);
+        ring->reported_drops = dropped;
+    }
+    return n;
+}
+
+asx_status asx_log_ring_stats_get(const asx_log_ring *ring,
+                                  asx_log_ring_stats *out)
+{
+    if (ring == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->written = ring->written;
+    out->dropped = ring->dropped;
+    out->truncated = ring->truncated;
+    out->pending = ring->enqueue_pos - ring->dequeue_pos;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Instance attachment
+ * ------------------------------------------------------------------- */
+
+void asx_runtime_set_log_ring(asx_log_ring *ring, uint32_t drain_per_round)
+{
+    g_rt->log_ring = ring;
+    if (ring != NULL) ring->drain_per_round = drain_per_round;
+}
+
+asx_log_ring *asx_runtime_get_log_ring(void)
+{
+    return g_rt->log_ring;
+}
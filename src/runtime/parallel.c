@@ -31,6 +31,9 @@ typedef struct {
 
 /* -------------------------------------------------------------------
  * Global parallel scheduler state
+ *
+ * Process-wide, not per runtime instance: the skeleton is driven from
+ * a single thread, which must not be a shard thread.
  * ------------------------------------------------------------------- */
 
 static int               g_initialized;
@@ -278,14 +281,13 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
         for (i = 0; i < ASX_MAX_LANES; i++) {
             g_lanes[i].count = 0;
         }
-        /* Scan task arena and assign to lanes */
-        for (i = 0; i < g_task_count; i++) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_TASKS") */
+        /* Walk the region's live-task list and assign to lanes */
+        for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+             i = g_tasks[i].region_next) { /* ASX_CHECKPOINT_WAIVER("bounded by ASX_MAX_TASKS") */
             asx_task_slot *t = &g_tasks[i];
             asx_task_id tid;
             asx_lane_class lc;
 
-            if (!t->alive) continue;
-            if (t->region != region) continue;
             if (asx_task_is_terminal(t->state)) continue;
 
             tid = asx_handle_pack(ASX_TYPE_TASK,
@@ -354,6 +356,7 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
             while (j < lane->count && polls_this_lane < quota) {
                 asx_task_id tid;
                 asx_task_slot *t;
+                asx_task_cold *tc;
                 uint16_t slot_idx;
                 asx_status poll_result;
 
@@ -371,6 +374,7 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
                     continue;
                 }
                 t = &g_tasks[slot_idx];
+                tc = &g_task_cold[slot_idx];
 
                 if (!t->alive || asx_task_is_terminal(t->state)) {
                     /* Remove completed task from lane */
@@ -382,21 +386,21 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
                 if (t->cancel_pending &&
                     (t->state == ASX_TASK_CANCELLING ||
                      t->state == ASX_TASK_CANCEL_REQUESTED) &&
-                    t->cleanup_polls_remaining == 0) {
+                    tc->cleanup_polls_remaining == 0) {
                     t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                    rslot->task_count--;
+                    tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+                    asx_region_task_retire(rslot, slot_idx);
                     lane_remove_internal(tid);
                     g_workers[0].tasks_completed++;
-                    asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
-                                   (uint64_t)tid, round);
+                    asx_trace_record(ASX_TRACE_SCHED_COMPLETE,
+                                     (uint64_t)tid, round, ASX_E_CANCELLED);
                     continue;
                 }
 
                 if (t->state == ASX_TASK_FINALIZING) {
                     t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                    rslot->task_count--;
+                    tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+                    asx_region_task_retire(rslot, slot_idx);
                     lane_remove_internal(tid);
                     g_workers[0].tasks_completed++;
                     asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
@@ -412,6 +416,7 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
                 /* Transition Created → Running */
                 if (t->state == ASX_TASK_CREATED) {
                     t->state = ASX_TASK_RUNNING;
+                    ASX_SNAP_MARK_TASK(t);
                 }
 
                 asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)tid, round);
@@ -421,10 +426,14 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
 
                 if (poll_result == ASX_OK) {
                     t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(
-                        t->cancel_pending ? ASX_OUTCOME_CANCELLED
-                                          : ASX_OUTCOME_OK);
-                    rslot->task_count--;
+                    if (t->cancel_pending) {
+                        tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+                    } else if (tc->has_outcome_override) {
+                        tc->outcome = tc->outcome_override;
+                    } else {
+                        tc->outcome = asx_outcome_make(ASX_OUTCOME_OK);
+                    }
+                    asx_region_task_retire(rslot, slot_idx);
                     lane_remove_internal(tid);
                     g_workers[0].tasks_completed++;
                     asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
@@ -432,10 +441,10 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
                     continue;
                 } else if (poll_result != ASX_E_PENDING) {
                     t->state = ASX_TASK_COMPLETED;
-                    t->outcome = asx_outcome_make(
+                    tc->outcome = asx_outcome_make(
                         t->cancel_pending ? ASX_OUTCOME_CANCELLED
                                           : ASX_OUTCOME_ERR);
-                    rslot->task_count--;
+                    asx_region_task_retire(rslot, slot_idx);
                     lane_remove_internal(tid);
                     g_workers[0].tasks_completed++;
                     asx_trace_emit(ASX_TRACE_SCHED_COMPLETE,
@@ -444,8 +453,8 @@ asx_status asx_parallel_run(asx_region_id region, asx_budget *budget)
                 }
 
                 /* PENDING — still active */
-                if (t->cancel_pending && t->cleanup_polls_remaining > 0) {
-                    t->cleanup_polls_remaining--;
+                if (t->cancel_pending && tc->cleanup_polls_remaining > 0) {
+                    tc->cleanup_polls_remaining--;
                 }
 
                 polls_this_lane++;
@@ -0,0 +1,289 @@
+/*
+ * pool_alloc.c — size-class pool allocator hooks
+ *
+ * Each block carries a small header recording its class so free is
+ * O(1) without a size argument. Free blocks are threaded through their
+ * payload. Slabs are chained through their first bytes so destroy can
+ * hand them back to the backing allocator.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("allocator: loops are bounded by "
+ *   "ASX_POOL_CLASS_COUNT or by the slab chain (reserve_limit / "
+ *   "ASX_POOL_SLAB_BYTES). Allocator hooks never poll tasks.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/runtime/pool_alloc.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------
+ * Layout
+ * ------------------------------------------------------------------- */
+
+/* 16 bytes so payloads keep malloc-grade alignment. */
+typedef union {
+    struct {
+        uint32_t cls;   /* class index or ASX_POOL_CLASS_OVERSIZE */
+        uint32_t size;  /* requested size (oversize blocks only) */
+    } h;
+    uint64_t align_[2];
+} asx_pool_block_hdr;
+
+typedef union {
+    void    *next;
+    uint64_t align_[2];
+} asx_pool_slab_hdr;
+
+#define ASX_POOL_HDR ((uint32_t)sizeof(asx_pool_block_hdr))
+
+static uint32_t pool_block_size(uint32_t cls)
+{
+    return ASX_POOL_MIN_BLOCK << cls;
+}
+
+static asx_pool_block_hdr *pool_hdr_of(void *payload)
+{
+    return (asx_pool_block_hdr *)(void *)((uint8_t *)payload - ASX_POOL_HDR);
+}
+
+/* -------------------------------------------------------------------
+ * Sizing
+ * ------------------------------------------------------------------- */
+
+uint32_t asx_pool_reserve_for_class(asx_resource_class cls)
+{
+    switch (cls) {
+    case ASX_CLASS_R1:    return 32u * 1024u;
+    case ASX_CLASS_R2:    return 256u * 1024u;
+    case ASX_CLASS_R3:    return 2u * 1024u * 1024u;
+    case ASX_CLASS_COUNT: return 0;
+    }
+    return 0;
+}
+
+uint32_t asx_pool_class_for_size(size_t size)
+{
+    uint32_t cls;
+
+    for (cls = 0; cls < ASX_POOL_CLASS_COUNT; cls++) {
+        if (size <= (size_t)pool_block_size(cls)) return cls;
+    }
+    return ASX_POOL_CLASS_OVERSIZE;
+}
+
+/* -------------------------------------------------------------------
+ * Lifecycle
+ * ------------------------------------------------------------------- */
+
+asx_status asx_pool_allocator_init(asx_pool_allocator *pool,
+                                   asx_resource_class cls,
+                                   const asx_allocator_hooks *backing)
+{
+    asx_runtime_hooks defaults;
+    uint32_t i;
+
+    if (pool == NULL || cls >= ASX_CLASS_COUNT) return ASX_E_INVALID_ARGUMENT;
+    if (backing != NULL
+        && (backing->malloc_fn == NULL || backing->free_fn == NULL)) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    if (backing != NULL) {
+        pool->backing = *backing;
+    } else {
+        /* The runtime's default allocator hooks */
+        (void)asx_runtime_hooks_init(&defaults);
+        pool->backing = defaults.allocator;
+    }
+    pool->reserve_limit = asx_pool_reserve_for_class(cls);
+    for (i = 0; i < ASX_POOL_CLASS_COUNT; i++) {
+        pool->stats[i].block_size = pool_block_size(i);
+    }
+    pool->initialized = 1;
+    return ASX_OK;
+}
+
+void asx_pool_allocator_destroy(asx_pool_allocator *pool)
+{
+    void *slab;
+    void *next;
+
+    if (pool == NULL || !pool->initialized) return;
+    for (slab = pool->slabs; slab != NULL; slab = next) {
+        next = ((asx_pool_slab_hdr *)slab)->next;
+        pool->backing.free_fn(pool->backing.ctx, slab);
+    }
+    pool->slabs = NULL;
+    pool->carve = NULL;
+    pool->carve_left = 0;
+    memset(pool->free_list, 0, sizeof(pool->free_list));
+    pool->initialized = 0;
+}
+
+/* -------------------------------------------------------------------
+ * Allocation
+ * ------------------------------------------------------------------- */
+
+/* Obtain a fresh slab big enough for one block of stride bytes. */
+static int pool_refill(asx_pool_allocator *pool, uint32_t stride)
+{
+    uint32_t left = pool->reserve_limit - pool->reserve_used;
+    uint32_t want = ASX_POOL_SLAB_BYTES;
+    asx_pool_slab_hdr *slab;
+
+    if (want > left) want = left;
+    if (want < (uint32_t)sizeof(asx_pool_slab_hdr) + stride) return 0;
+
+    slab = (asx_pool_slab_hdr *)pool->backing.malloc_fn(pool->backing.ctx,
+                                                        (size_t)want);
+    if (slab == NULL) return 0;
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->reserve_used += want;
+    pool->carve = (uint8_t *)slab + sizeof(asx_pool_slab_hdr);
+    pool->carve_left = want - (uint32_t)sizeof(asx_pool_slab_hdr);
+    return 1;
+}
+
+static void *pool_alloc(void *ctx, size_t size)
+{
+    asx_pool_allocator *pool = (asx_pool_allocator *)ctx;
+    asx_pool_class_stats *st;
+    asx_pool_block_hdr *hdr;
+    uint32_t cls;
+    uint32_t stride;
+    void *p;
+
+    if (pool == NULL || !pool->initialized) return NULL;
+
+    cls = asx_pool_class_for_size(size);
+    if (cls == ASX_POOL_CLASS_OVERSIZE) {
+        /* Charged to the same reserve as slabs, header included */
+        stride = pool->reserve_limit - pool->reserve_used;
+        if (stride < ASX_POOL_HDR || size > (size_t)(stride - ASX_POOL_HDR)) {
+            pool->oversize_failures++;
+            return NULL;
+        }
+        hdr = (asx_pool_block_hdr *)pool->backing.malloc_fn(
+            pool->backing.ctx, (size_t)ASX_POOL_HDR + size);
+        if (hdr == NULL) {
+            pool->oversize_failures++;
+            return NULL;
+        }
+        hdr->h.cls = ASX_POOL_CLASS_OVERSIZE;
+        hdr->h.size = (uint32_t)size;
+        pool->reserve_used += ASX_POOL_HDR + (uint32_t)size;
+        pool->oversize_in_use++;
+        return (uint8_t *)hdr + ASX_POOL_HDR;
+    }
+
+    st = &pool->stats[cls];
+    p = pool->free_list[cls];
+    if (p != NULL) {
+        pool->free_list[cls] = *(void **)p;
+        st->cached--;
+    } else {
+        stride = ASX_POOL_HDR + st->block_size;
+        if (pool->carve_left < stride && !pool_refill(pool, stride)) {
+            st->failures++;
+            return NULL;
+        }
+        hdr = (asx_pool_block_hdr *)(void *)pool->carve;
+        hdr->h.cls = cls;
+        hdr->h.size = 0;
+        pool->carve += stride;
+        pool->carve_left -= stride;
+        p = (uint8_t *)hdr + ASX_POOL_HDR;
+    }
+
+    st->in_use++;
+    st->allocs++;
+    if (st->in_use > st->peak_in_use) st->peak_in_use = st->in_use;
+    return p;
+}
+
+static void pool_free(void *ctx, void *ptr)
+{
+    asx_pool_allocator *pool = (asx_pool_allocator *)ctx;
+    asx_pool_block_hdr *hdr;
+    uint32_t cls;
+
+    if (pool == NULL || ptr == NULL) return;
+
+    hdr = pool_hdr_of(ptr);
+    cls = hdr->h.cls;
+    if (cls == ASX_POOL_CLASS_OVERSIZE) {
+        pool->reserve_used -= ASX_POOL_HDR + hdr->h.size;
+        pool->oversize_in_use--;
+        pool->backing.free_fn(pool->backing.ctx, hdr);
+        return;
+    }
+
+    *(void **)ptr = pool->free_list[cls];
+    pool->free_list[cls] = ptr;
+    pool->stats[cls].in_use--;
+    pool->stats[cls].cached++;
+}
+
+static void *pool_realloc(void *ctx, void *ptr, size_t size)
+{
+    asx_pool_block_hdr *hdr;
+    size_t old_size;
+    void *p;
+
+    if (ptr == NULL) return pool_alloc(ctx, size);
+    if (size == 0) {
+        pool_free(ctx, ptr);
+        return NULL;
+    }
+
+    hdr = pool_hdr_of(ptr);
+    if (hdr->h.cls == ASX_POOL_CLASS_OVERSIZE) {
+        old_size = (size_t)hdr->h.size;
+    } else {
+        old_size = (size_t)pool_block_size(hdr->h.cls);
+        if (size <= old_size) return ptr; /* still fits its class */
+    }
+
+    p = pool_alloc(ctx, size);
+    if (p == NULL) return NULL;
+    memcpy(p, ptr, old_size < size ? old_size : size);
+    pool_free(ctx, ptr);
+    return p;
+}
+
+asx_status asx_pool_allocator_bind(asx_pool_allocator *pool,
+                                   asx_allocator_hooks *out_hooks)
+{
+    if (pool == NULL || out_hooks == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (!pool->initialized) return ASX_E_INVALID_STATE;
+
+    out_hooks->ctx        = pool;
+    out_hooks->malloc_fn  = pool_alloc;
+    out_hooks->realloc_fn = pool_realloc;
+    out_hooks->free_fn    = pool_free;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Diagnostics
+ * ------------------------------------------------------------------- */
+
+asx_status asx_pool_class_stats_get(const asx_pool_allocator *pool,
+                                    uint32_t class_index,
+                                    asx_pool_class_stats *out)
+{
+    if (pool == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (class_index >= ASX_POOL_CLASS_COUNT) return ASX_E_INVALID_ARGUMENT;
+
+    *out = pool->stats[class_index];
+    return ASX_OK;
+}
+
+uint32_t asx_pool_reserve_remaining(const asx_pool_allocator *pool)
+{
+    if (pool == NULL || !pool->initialized) return 0;
+    return pool->reserve_limit - pool->reserve_used;
+}
@@ -197,6 +197,37 @@ asx_status asx_profile_get_descriptor_for_class(
     return ASX_OK;
 }
 
+/* -------------------------------------------------------------------
+ * Idle strategies
+ *
+ * {spin_ns, yield_count, park_timeout_ms} per profile. HFT spins long
+ * enough to cover typical inter-arrival gaps before giving up the
+ * core; EMBEDDED_ROUTER keeps the spin short and parks quickly so a
+ * small CPU is not burned; AUTOMOTIVE parks almost at once.
+ * ------------------------------------------------------------------- */
+
+static const asx_idle_strategy g_idle_strategies[ASX_PROFILE_ID_COUNT] = {
+    /* CORE */            {  2000u, 16u, 10u },
+    /* POSIX */           {  2000u, 16u, 10u },
+    /* WIN32 */           {  2000u, 16u, 10u },
+    /* FREESTANDING */    {  1000u,  0u,  0u },
+    /* EMBEDDED_ROUTER */ {  5000u,  8u,  1u },
+    /* HFT */             { 50000u, 64u,  1u },
+    /* AUTOMOTIVE */      {     0u,  4u,  5u },
+    /* PARALLEL */        {  2000u, 16u, 10u }
+};
+
+asx_status asx_profile_get_idle_strategy(asx_profile_id id,
+                                          asx_idle_strategy *out)
+{
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    if ((int)id < 0 || (int)id >= ASX_PROFILE_ID_COUNT) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    *out = g_idle_strategies[(int)id];
+    return ASX_OK;
+}
+
 /* -------------------------------------------------------------------
  * Resource class name lookup
  * ------------------------------------------------------------------- */
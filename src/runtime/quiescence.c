@@ -4,6 +4,12 @@
  * Minimal implementation for bd-ix8.8: region drain and quiescence
  * assertion. Drives region through Close → Drain → Finalize → Closed.
  *
+ * Region trees: draining a parent closes and cancels its whole subtree,
+ * then drains each child (recursively) before finalizing itself. The
+ * caller's poll budget is split across the children and the region's
+ * own tasks with asx_budget_meet, so one busy child cannot starve its
+ * siblings. Subtree counters make quiescence queries O(1).
+ *
  * Phase 3 will add obligation tracking, finalizer chains, and leak
  * detection (bd-2cw.1). Semantics from QUIESCENCE_FINALIZATION_INVARIANTS.md.
  *
@@ -29,25 +35,175 @@ asx_status asx_quiescence_check(asx_region_id id)
     st = asx_region_slot_lookup(id, &r);
     if (st != ASX_OK) return st;
 
-    /* Quiescent iff region is CLOSED and no live tasks remain */
+    /* Quiescent iff region is CLOSED and its live-task list is empty */
     if (r->state != ASX_REGION_CLOSED) {
         return ASX_E_QUIESCENCE_NOT_REACHED;
     }
-    if (r->task_count > 0) {
+    if (r->task_head != ASX_TASK_LINK_NONE) {
+        return ASX_E_QUIESCENCE_TASKS_LIVE;
+    }
+
+    return ASX_OK;
+}
+
+asx_status asx_quiescence_check_subtree(asx_region_id id)
+{
+    asx_region_slot *r;
+    asx_status st;
+
+    st = asx_region_slot_lookup(id, &r);
+    if (st != ASX_OK) return st;
+
+    if (r->subtree_regions > 0) {
+        return ASX_E_INCOMPLETE_CHILDREN;
+    }
+    if (r->subtree_tasks > 0) {
         return ASX_E_QUIESCENCE_TASKS_LIVE;
     }
 
     return ASX_OK;
 }
 
+/* -------------------------------------------------------------------
+ * Subtree close: every OPEN region under (and including) root moves
+ * to CLOSING so no new work can be admitted while the tree drains.
+ * ------------------------------------------------------------------- */
+
+static asx_status region_close_subtree(uint32_t root)
+{
+    uint32_t ri;
+    asx_status st;
+
+    for (ri = root; ri != ASX_REGION_LINK_NONE;
+         ri = asx_region_subtree_next(root, ri)) {
+        ASX_CHECKPOINT_WAIVER("kernel-quiescence: subtree walk bounded by "
+                              "ASX_MAX_REGIONS");
+        asx_region_slot *c = &g_regions[ri];
+
+        if (c->state != ASX_REGION_OPEN) continue;
+        asx_ghost_check_region_transition(asx_region_handle_at(ri),
+                                          ASX_REGION_OPEN, ASX_REGION_CLOSING);
+        st = asx_region_transition_check(ASX_REGION_OPEN, ASX_REGION_CLOSING);
+        if (st != ASX_OK) return st;
+        c->state = ASX_REGION_CLOSING;
+        ASX_SNAP_MARK_REGION(c);
+    }
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Child drain with budget split
+ *
+ * Each remaining party (child regions, plus the region's own tasks if
+ * any) receives an equal share of what is left, met with the parent
+ * budget so deadline, cost and priority constraints are inherited.
+ * Whatever a child does not spend flows on to later parties. Polls
+ * and cost a child consumes are charged back to the parent budget.
+ *
+ * Under ASX_SCHED_POLICY_FAIR children are visited in ascending
+ * charged cost (region vtime, then arena index) and a bounded cost
+ * quota is split between the parties like polls.
+ * ------------------------------------------------------------------- */
+
+/* Snapshot the linked children, ordered for the active policy. */
+static uint32_t region_drain_order(const asx_region_slot *r,
+                                   uint32_t order[ASX_MAX_REGIONS])
+{
+    uint32_t n = 0;
+    uint32_t ci;
+    uint32_t k;
+
+    for (ci = r->child_head; ci != ASX_REGION_LINK_NONE;
+         ci = g_regions[ci].sibling_next) {
+        ASX_CHECKPOINT_WAIVER("kernel-quiescence: child iteration bounded by "
+                              "ASX_MAX_REGIONS");
+        order[n++] = ci;
+    }
+    if (asx_scheduler_get_policy() != ASX_SCHED_POLICY_FAIR) return n;
+
+    /* Insertion sort on (vtime, index); n <= ASX_MAX_REGIONS */
+    for (k = 1; k < n; k++) {
+        ASX_CHECKPOINT_WAIVER("kernel-quiescence: sort bounded by "
+                              "ASX_MAX_REGIONS");
+        uint32_t v = order[k];
+        uint32_t j = k;
+
+        while (j > 0
+               && (g_regions[order[j - 1u]].vtime > g_regions[v].vtime
+                   || (g_regions[order[j - 1u]].vtime == g_regions[v].vtime
+                       && order[j - 1u] > v))) {
+            ASX_CHECKPOINT_WAIVER("kernel-quiescence: sort bounded by "
+                                  "ASX_MAX_REGIONS");
+            order[j] = order[j - 1u];
+            j--;
+        }
+        order[j] = v;
+    }
+    return n;
+}
+
+static asx_status region_drain_children(asx_region_slot *r, asx_budget *budget)
+{
+    uint32_t order[ASX_MAX_REGIONS];
+    uint32_t count;
+    uint32_t k;
+    uint32_t parties;
+    int split_cost;
+    asx_status st;
+
+    parties = r->child_count + (r->task_head != ASX_TASK_LINK_NONE ? 1u : 0u);
+    count = region_drain_order(r, order);
+    split_cost = asx_scheduler_get_policy() == ASX_SCHED_POLICY_FAIR;
+
+    for (k = 0; k < count; k++) {
+        ASX_CHECKPOINT_WAIVER("kernel-quiescence: child iteration bounded by "
+                              "ASX_MAX_REGIONS");
+        asx_budget share;
+        asx_budget slice;
+        uint32_t polls;
+        uint32_t granted;
+        uint64_t cost;
+        uint64_t granted_cost;
+
+        polls = asx_budget_polls(budget);
+        share = asx_budget_from_polls(polls / parties
+                                      + (polls % parties != 0u ? 1u : 0u));
+        cost = budget->cost_quota;
+        if (split_cost && cost != UINT64_MAX) {
+            share.cost_quota = cost / parties + (cost % parties != 0u ? 1u : 0u);
+        }
+        slice = asx_budget_meet(budget, &share);
+        granted = slice.poll_quota;
+        granted_cost = slice.cost_quota;
+
+        st = asx_region_drain(asx_region_handle_at(order[k]), &slice);
+
+        budget->poll_quota -= granted - slice.poll_quota;
+        if (cost != UINT64_MAX) {
+            budget->cost_quota -= granted_cost - slice.cost_quota;
+        }
+        if (parties > 1u) parties--;
+
+        if (st != ASX_OK && st != ASX_E_QUIESCENCE_TASKS_LIVE
+            && st != ASX_E_INCOMPLETE_CHILDREN) {
+            return st;
+        }
+    }
+    return ASX_OK;
+}
+
 /* -------------------------------------------------------------------
  * Region drain: scheduler + close protocol
  *
  * Drives the region through its full shutdown sequence:
- *   1. Close (Open → Closing)
- *   2. Run scheduler to completion
- *   3. Drain cleanup stack (Finalizing)
- *   4. Advance (Closing → Draining → Finalizing → Closed)
+ *   1. Close (Open → Closing) the region and its open descendants,
+ *      and cancel every live task in the subtree
+ *   2. Drain child regions (Closing → Draining while children remain)
+ *   3. Run scheduler to completion for the region's own tasks
+ *   4. Advance (Draining/Closing → Finalizing → Closed), draining the
+ *      cleanup stack, and detach from the parent
+ *
+ * Recursion depth is bounded by tree depth <= ASX_MAX_REGIONS.
  * ------------------------------------------------------------------- */
 
 asx_status asx_region_drain(asx_region_id id, asx_budget *budget)
@@ -60,39 +216,56 @@ asx_status asx_region_drain(asx_region_id id, asx_budget *budget)
     st = asx_region_slot_lookup(id, &r);
     if (st != ASX_OK) return st;
 
-    /* Step 1: Close the region if still open */
+    /* Step 1: Close the subtree if this region is still open */
     if (r->state == ASX_REGION_OPEN) {
-        asx_ghost_check_region_transition(id, ASX_REGION_OPEN, ASX_REGION_CLOSING);
-        st = asx_region_transition_check(ASX_REGION_OPEN, ASX_REGION_CLOSING);
+        st = region_close_subtree((uint32_t)(r - g_regions));
         if (st != ASX_OK) return st;
-        r->state = ASX_REGION_CLOSING;
 
-        /* Propagate PARENT cancel to all active tasks in this region.
+        /* Propagate PARENT cancel to all active tasks in the subtree.
          * Tasks observe cancellation via asx_checkpoint() and have
          * bounded cleanup before forced completion. (bd-2cw.3) */
         asx_cancel_propagate(id, ASX_CANCEL_PARENT);
     }
 
-    /* Step 2: Run scheduler to drain tasks */
-    if (r->task_count > 0) {
+    /* Step 2: Drain children (Closing → Draining) */
+    if (r->child_head != ASX_REGION_LINK_NONE) {
+        if (r->state == ASX_REGION_CLOSING) {
+            asx_ghost_check_region_transition(id, ASX_REGION_CLOSING,
+                                                   ASX_REGION_DRAINING);
+            st = asx_region_transition_check(ASX_REGION_CLOSING,
+                                             ASX_REGION_DRAINING);
+            if (st != ASX_OK) return st;
+            r->state = ASX_REGION_DRAINING;
+            ASX_SNAP_MARK_REGION(r);
+        }
+        st = region_drain_children(r, budget);
+        if (st != ASX_OK) return st;
+    }
+
+    /* Step 3: Run scheduler to drain own tasks */
+    if (r->task_head != ASX_TASK_LINK_NONE) {
         st = asx_scheduler_run(id, budget);
         if (st != ASX_OK && st != ASX_E_POLL_BUDGET_EXHAUSTED) {
             return st;
         }
-        if (r->task_count > 0) {
+        if (r->task_head != ASX_TASK_LINK_NONE) {
             return ASX_E_QUIESCENCE_TASKS_LIVE;
         }
     }
+    if (r->child_head != ASX_REGION_LINK_NONE) {
+        return ASX_E_INCOMPLETE_CHILDREN;
+    }
 
-    /* Step 3: Advance through closing protocol */
+    /* Step 4: Advance through closing protocol */
     if (r->state == ASX_REGION_CLOSING) {
-        /* No children (walking skeleton) — fast path: skip Draining */
+        /* No children — fast path: skip Draining */
         asx_ghost_check_region_transition(id, ASX_REGION_CLOSING,
                                                ASX_REGION_FINALIZING);
         st = asx_region_transition_check(ASX_REGION_CLOSING,
                                          ASX_REGION_FINALIZING);
         if (st != ASX_OK) return st;
         r->state = ASX_REGION_FINALIZING;
+        ASX_SNAP_MARK_REGION(r);
     }
 
     if (r->state == ASX_REGION_DRAINING) {
@@ -102,6 +275,7 @@ asx_status asx_region_drain(asx_region_id id, asx_budget *budget)
                                          ASX_REGION_FINALIZING);
         if (st != ASX_OK) return st;
         r->state = ASX_REGION_FINALIZING;
+        ASX_SNAP_MARK_REGION(r);
     }
 
     if (r->state == ASX_REGION_FINALIZING) {
@@ -117,6 +291,9 @@ asx_status asx_region_drain(asx_region_id id, asx_budget *budget)
                                          ASX_REGION_CLOSED);
         if (st != ASX_OK) return st;
         r->state = ASX_REGION_CLOSED;
+        ASX_SNAP_MARK_REGION(r);
+        asx_region_detach_closed(r);
+        asx_region_capture_release(r);
     }
 
     return ASX_OK;
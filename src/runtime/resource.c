@@ -97,11 +97,7 @@ asx_status asx_resource_region_capture_remaining(asx_region_id region,
     st = asx_region_slot_lookup(region, &r);
     if (st != ASX_OK) return st;
 
-    if (r->capture_used >= ASX_REGION_CAPTURE_ARENA_BYTES) {
-        *out_bytes = 0;
-    } else {
-        *out_bytes = ASX_REGION_CAPTURE_ARENA_BYTES - r->capture_used;
-    }
+    *out_bytes = asx_region_capture_headroom(r);
     return ASX_OK;
 }
 
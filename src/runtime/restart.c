@@ -0,0 +1,938 @@
+/*
+ * restart.c — warm restart: runtime state image save and restore
+ *
+ * Save walks the arenas of the current instance and writes every slot
+ * below each arena's extent, binding pointers through the registered
+ * table (restart.h). Region tree links are not written per slot: the
+ * linked regions are listed once in pre-order, and restore re-appends
+ * each to its parent, which rebuilds child order and the subtree
+ * counters. Region task lists and task counts are rebuilt the same
+ * way from the task records.
+ *
+ * Restore reads the image twice. The first pass only validates,
+ * recording what later records are checked against; the second resets
+ * the instance and applies. After applying, the state digest of the
+ * rebuilt arenas must match the digest saved with the image.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("restart: loops are bounded by the arena "
+ *   "sizes, the binding table, ASX_CLEANUP_STACK_CAPACITY, channel "
+ *   "capacity, or the image length; runs between scheduler runs, never "
+ *   "from the task poll hot path.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/restart.h>
+#include <asx/runtime/snapshot.h>
+#include <string.h>
+#include "runtime_internal.h"
+
+#define RESTART_FNV_BASIS 0xcbf29ce484222325ULL
+#define RESTART_FNV_PRIME 0x00000100000001B3ULL
+
+/* -------------------------------------------------------------------
+ * Bindings
+ * ------------------------------------------------------------------- */
+
+void asx_runtime_set_restart_bindings(const asx_restart_binding *table,
+                                      uint32_t count)
+{
+    g_rt->restart_bindings = count > 0 ? table : NULL;
+    g_rt->restart_binding_count = table != NULL ? count : 0;
+}
+
+static const asx_restart_binding *restart_binding(uint32_t id)
+{
+    uint32_t i;
+
+    if (id == 0) return NULL;
+    for (i = 0; i < g_rt->restart_binding_count; i++) {
+        if (g_rt->restart_bindings[i].id == id) {
+            return &g_rt->restart_bindings[i];
+        }
+    }
+    return NULL;
+}
+
+/* Binding id of a live task, 0 if none matches */
+static uint32_t restart_bind_task(const asx_task_slot *t,
+                                  const asx_task_cold *tc)
+{
+    const asx_restart_binding *b;
+    uint32_t i;
+
+    for (i = 0; i < g_rt->restart_binding_count; i++) {
+        b = &g_rt->restart_bindings[i];
+        if (b->id == 0 || b->poll_fn != t->poll_fn
+            || b->state_dtor != tc->captured_dtor) {
+            continue;
+        }
+        if (tc->captured_state != NULL || b->data == t->user_data) {
+            return b->id;
+        }
+    }
+    return 0;
+}
+
+static uint32_t restart_bind_cleanup(asx_cleanup_fn fn, void *data)
+{
+    const asx_restart_binding *b;
+    uint32_t i;
+
+    for (i = 0; i < g_rt->restart_binding_count; i++) {
+        b = &g_rt->restart_bindings[i];
+        if (b->id != 0 && b->cleanup_fn == fn && b->data == data) {
+            return b->id;
+        }
+    }
+    return 0;
+}
+
+static uint32_t restart_bind_data(void *data)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_rt->restart_binding_count; i++) {
+        if (g_rt->restart_bindings[i].id != 0
+            && g_rt->restart_bindings[i].data == data) {
+            return g_rt->restart_bindings[i].id;
+        }
+    }
+    return 0;
+}
+
+/* -------------------------------------------------------------------
+ * Writer
+ * ------------------------------------------------------------------- */
+
+/* Bounded output: bytes past cap are counted (and summed), not
+ * written, so a capacity-0 pass sizes the image. */
+typedef struct {
+    uint8_t   *buf;
+    uint32_t   cap;
+    uint32_t   pos;
+    uint64_t   sum;
+    asx_status st;   /* first binding failure */
+} restart_writer;
+
+static void restart_put(restart_writer *w, uint8_t b)
+{
+    if (w->pos < w->cap) w->buf[w->pos] = b;
+    w->pos++;
+    w->sum = (w->sum ^ b) * RESTART_FNV_PRIME;
+}
+
+static void restart_put_le64(restart_writer *w, uint64_t v)
+{
+    uint32_t i;
+
+    for (i = 0; i < 8u; i++) {
+        restart_put(w, (uint8_t)((v >> (8u * i)) & 0xFFu));
+    }
+}
+
+static void restart_put_varint(restart_writer *w, uint64_t v)
+{
+    while (v >= 0x80u) {
+        restart_put(w, (uint8_t)((v & 0x7Fu) | 0x80u));
+        v >>= 7;
+    }
+    restart_put(w, (uint8_t)v);
+}
+
+static void restart_put_binding(restart_writer *w, uint32_t id)
+{
+    if (id == 0 && w->st == ASX_OK) w->st = ASX_E_NOT_FOUND;
+    restart_put_varint(w, id);
+}
+
+static void restart_put_region(restart_writer *w, uint32_t idx)
+{
+    const asx_region_slot *r = &g_regions[idx];
+    uint32_t i;
+
+    restart_put(w, (uint8_t)r->state);
+    restart_put(w, (uint8_t)(r->poisoned != 0));
+    restart_put_varint(w, r->task_total);
+    restart_put_varint(w, r->vtime);
+    restart_put_varint(w, r->vclock);
+    restart_put(w, (uint8_t)(r->cleanup.drained != 0));
+    restart_put_varint(w, r->cleanup.count);
+    for (i = 0; i < r->cleanup.count; i++) {
+        if (r->cleanup.fns[i] == NULL) {
+            restart_put(w, 0); /* popped */
+        } else {
+            restart_put_binding(w, restart_bind_cleanup(r->cleanup.fns[i],
+                                                        r->cleanup.data[i]));
+        }
+    }
+}
+
+static void restart_put_task(restart_writer *w, uint32_t idx)
+{
+    const asx_task_slot *t = &g_tasks[idx];
+    const asx_task_cold *tc = &g_task_cold[idx];
+    const uint8_t *state = (const uint8_t *)tc->captured_state;
+    uint32_t size = state != NULL ? tc->captured_size : 0u;
+    uint32_t i;
+
+    restart_put(w, (uint8_t)t->state);
+    restart_put_varint(w, tc->region);
+    restart_put(w, t->priority);
+    restart_put(w, t->parked);
+    restart_put(w, t->cancel_pending);
+    /* A terminal task is never polled again: no entry point to bind */
+    if (t->state == ASX_TASK_COMPLETED) {
+        restart_put(w, 0);
+    } else {
+        restart_put_binding(w, restart_bind_task(t, tc));
+    }
+    restart_put_varint(w, t->wake_at);
+    restart_put_varint(w, t->deadline);
+    restart_put_varint(w, t->vtime);
+    restart_put(w, (uint8_t)tc->outcome.severity);
+    restart_put_varint(w, size);
+    for (i = 0; i < size; i++) {
+        restart_put(w, state[i]);
+    }
+    restart_put(w, (uint8_t)tc->cancel_phase);
+    restart_put(w, (uint8_t)tc->cancel_reason.kind);
+    restart_put_varint(w, tc->cancel_reason.origin_region);
+    restart_put_varint(w, tc->cancel_reason.origin_task);
+    restart_put_varint(w, tc->cancel_reason.timestamp);
+    restart_put(w, (uint8_t)(tc->cancel_reason.truncated != 0));
+    restart_put_varint(w, tc->cancel_epoch);
+    restart_put_varint(w, tc->cleanup_polls_remaining);
+    restart_put_varint(w, tc->waiter == ASX_TASK_LINK_NONE
+                              ? 0u : (uint64_t)tc->waiter + 1u);
+    restart_put(w, (uint8_t)(tc->has_outcome_override != 0));
+    restart_put(w, (uint8_t)tc->outcome_override.severity);
+    restart_put(w, (uint8_t)(tc->deadline_reported != 0));
+    restart_put_varint(w, tc->poll_cost);
+    restart_put(w, (uint8_t)(tc->cost_reported != 0));
+}
+
+static void restart_put_channel(restart_writer *w, const asx_channel_slot *c)
+{
+    uint32_t i;
+
+    restart_put(w, (uint8_t)c->state);
+    restart_put_varint(w, c->region);
+    restart_put_varint(w, c->capacity);
+    restart_put_varint(w, c->reserved);
+    restart_put_varint(w, c->next_token);
+    restart_put_varint(w, c->queue_len);
+    for (i = 0; i < c->queue_len; i++) {
+        restart_put_varint(w, c->queue[(c->queue_head + i) & c->queue_mask]);
+    }
+}
+
+static void restart_put_timer(restart_writer *w, const asx_timer_slot *s)
+{
+    restart_put_varint(w, s->deadline);
+    restart_put_varint(w, s->latest - s->deadline);
+    restart_put_varint(w, s->insertion_seq);
+    if (s->waker_data == NULL) {
+        restart_put(w, 0);
+    } else {
+        restart_put_binding(w, restart_bind_data(s->waker_data));
+    }
+}
+
+static uint32_t restart_channel_extent(void)
+{
+    uint32_t n = ASX_MAX_CHANNELS;
+
+    while (n > 0 && !g_rt->channels[n - 1u].alive
+           && g_rt->channels[n - 1u].generation == 0) {
+        n--;
+    }
+    return n;
+}
+
+static void restart_encode(restart_writer *w, uint64_t digest)
+{
+    const asx_timer_wheel *wheel = &g_rt->wheel;
+    uint32_t i;
+    uint32_t n;
+
+    restart_put(w, (uint8_t)(ASX_RESTART_MAGIC & 0xFFu));
+    restart_put(w, (uint8_t)((ASX_RESTART_MAGIC >> 8) & 0xFFu));
+    restart_put(w, (uint8_t)((ASX_RESTART_MAGIC >> 16) & 0xFFu));
+    restart_put(w, (uint8_t)((ASX_RESTART_MAGIC >> 24) & 0xFFu));
+    restart_put(w, (uint8_t)ASX_RESTART_VERSION);
+    restart_put_le64(w, digest);
+
+    restart_put_varint(w, g_region_count);
+    for (i = 0; i < g_region_count; i++) {
+        restart_put(w, (uint8_t)(g_regions[i].alive != 0));
+        restart_put_varint(w, g_regions[i].generation);
+        if (g_regions[i].alive) restart_put_region(w, i);
+    }
+
+    /* Linked regions in pre-order, children in open order */
+    n = 0;
+    for (i = 0; i < g_region_count; i++) {
+        if (g_regions[i].alive && g_regions[i].parent != ASX_REGION_LINK_NONE) {
+            n++;
+        }
+    }
+    restart_put_varint(w, n);
+    for (i = 0; i < g_region_count; i++) {
+        uint32_t j;
+
+        if (!g_regions[i].alive || g_regions[i].parent != ASX_REGION_LINK_NONE) {
+            continue;
+        }
+        for (j = asx_region_subtree_next(i, i); j != ASX_REGION_LINK_NONE;
+             j = asx_region_subtree_next(i, j)) {
+            restart_put_varint(w, j);
+            restart_put_varint(w, g_regions[j].parent);
+        }
+    }
+
+    restart_put_varint(w, g_task_count);
+    for (i = 0; i < g_task_count; i++) {
+        restart_put(w, (uint8_t)(g_tasks[i].alive != 0));
+        restart_put_varint(w, g_tasks[i].generation);
+        if (g_tasks[i].alive) restart_put_task(w, i);
+    }
+
+    restart_put_varint(w, g_obligation_count);
+    for (i = 0; i < g_obligation_count; i++) {
+        const asx_obligation_slot *o = &g_obligations[i];
+        restart_put(w, (uint8_t)(o->alive != 0));
+        restart_put_varint(w, o->generation);
+        if (o->alive) {
+            restart_put(w, (uint8_t)o->state);
+            restart_put_varint(w, o->region);
+        }
+    }
+
+    n = restart_channel_extent();
+    restart_put_varint(w, g_rt->channel_count);
+    restart_put_varint(w, n);
+    for (i = 0; i < n; i++) {
+        const asx_channel_slot *c = &g_rt->channels[i];
+        restart_put(w, (uint8_t)(c->alive != 0));
+        restart_put_varint(w, c->generation);
+        if (c->alive) restart_put_channel(w, c);
+    }
+
+    restart_put(w, (uint8_t)(g_rt->wheel_initialized != 0));
+    restart_put_varint(w, wheel->current_time);
+    restart_put_varint(w, wheel->max_duration_ns);
+    restart_put_varint(w, wheel->next_insertion);
+    n = g_rt->wheel_initialized ? wheel->slot_count : 0u;
+    restart_put_varint(w, n);
+    for (i = 0; i < n; i++) {
+        const asx_timer_slot *s = &wheel->slots[i];
+        restart_put(w, (uint8_t)(s->alive != 0));
+        restart_put_varint(w, s->generation);
+        if (s->alive) restart_put_timer(w, s);
+    }
+
+    restart_put_le64(w, w->sum);
+}
+
+asx_status asx_runtime_save(uint8_t *buf, uint32_t capacity,
+                            uint32_t *out_len)
+{
+    restart_writer w;
+    uint64_t digest;
+
+    if (buf == NULL || out_len == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    digest = asx_runtime_state_digest();
+
+    /* Size first so a short buffer (or a missing binding) leaves buf
+     * untouched */
+    memset(&w, 0, sizeof(w));
+    w.buf = buf;
+    w.sum = RESTART_FNV_BASIS;
+    restart_encode(&w, digest);
+    *out_len = w.pos;
+    if (w.st != ASX_OK) return w.st;
+    if (capacity < w.pos) return ASX_E_BUFFER_TOO_SMALL;
+
+    w.cap = capacity;
+    w.pos = 0;
+    w.sum = RESTART_FNV_BASIS;
+    restart_encode(&w, digest);
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Reader
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    const uint8_t *buf;
+    uint32_t       len;    /* excluding the checksum */
+    uint32_t       pos;
+} restart_reader;
+
+static int restart_get(restart_reader *r, uint8_t *b)
+{
+    if (r->pos >= r->len) return 0;
+    *b = r->buf[r->pos++];
+    return 1;
+}
+
+/* Byte no larger than max */
+static int restart_get_small(restart_reader *r, uint32_t max, uint32_t *out)
+{
+    uint8_t b;
+
+    if (!restart_get(r, &b) || b > max) return 0;
+    *out = b;
+    return 1;
+}
+
+static int restart_get_u64(restart_reader *r, uint64_t *out)
+{
+    uint64_t v = 0;
+    uint32_t shift = 0;
+    uint8_t b;
+
+    do {
+        if (shift > 63u || !restart_get(r, &b)) return 0;
+        if (shift == 63u && (b & 0x7Eu) != 0) return 0;
+        v |= (uint64_t)(b & 0x7Fu) << shift;
+        shift += 7u;
+    } while ((b & 0x80u) != 0);
+    *out = v;
+    return 1;
+}
+
+/* Varint no larger than max */
+static int restart_get_u32(restart_reader *r, uint32_t max, uint32_t *out)
+{
+    uint64_t v;
+
+    if (!restart_get_u64(r, &v) || v > max) return 0;
+    *out = (uint32_t)v;
+    return 1;
+}
+
+/* -------------------------------------------------------------------
+ * Restore
+ *
+ * restart_parse runs once with apply == 0 to validate, filling the
+ * check record, then with apply == 1 on a reset instance.
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t   region_extent;
+    uint8_t    region_alive[ASX_MAX_REGIONS];
+    uint8_t    region_state[ASX_MAX_REGIONS];
+    uint8_t    region_placed[ASX_MAX_REGIONS];
+    uint16_t   region_gen[ASX_MAX_REGIONS];
+    uint32_t   region_capture[ASX_MAX_REGIONS];
+    uint32_t   task_extent;
+    uint8_t    task_alive[ASX_MAX_TASKS];
+    uint32_t   waiter[ASX_MAX_TASKS];
+    asx_status st;   /* ASX_E_NOT_FOUND for an unknown binding */
+} restart_check;
+
+/* Binding id that must resolve (with the given entry point) */
+static int restart_get_binding(restart_reader *r, restart_check *c,
+                               int need_poll, int need_cleanup,
+                               const asx_restart_binding **out)
+{
+    uint32_t id;
+    const asx_restart_binding *b;
+
+    if (!restart_get_u32(r, UINT32_MAX, &id)) return 0;
+    *out = NULL;
+    if (id == 0) return 1;
+    b = restart_binding(id);
+    if (b == NULL || (need_poll && b->poll_fn == NULL)
+        || (need_cleanup && b->cleanup_fn == NULL)) {
+        c->st = ASX_E_NOT_FOUND;
+        return 0;
+    }
+    *out = b;
+    return 1;
+}
+
+/* Region handle naming a live region of the image */
+static int restart_get_region_id(restart_reader *r, const restart_check *c,
+                                 asx_region_id *out, uint32_t *out_slot)
+{
+    uint32_t slot;
+
+    if (!restart_get_u64(r, out)) return 0;
+    if (asx_handle_type_tag(*out) != ASX_TYPE_REGION) return 0;
+    slot = asx_handle_slot(*out);
+    if (slot >= c->region_extent || !c->region_alive[slot]
+        || c->region_gen[slot] != asx_handle_generation(*out)) {
+        return 0;
+    }
+    *out_slot = slot;
+    return 1;
+}
+
+static int restart_parse_region(restart_reader *r, restart_check *c,
+                                uint32_t idx, int apply)
+{
+    asx_region_slot *rs = &g_regions[idx];
+    const asx_restart_binding *b;
+    uint32_t state, poisoned, drained, count, task_total, i;
+    uint64_t vtime, vclock;
+
+    if (!restart_get_small(r, (uint32_t)ASX_REGION_CLOSED, &state)
+        || !restart_get_small(r, 1u, &poisoned)
+        || !restart_get_u32(r, UINT32_MAX, &task_total)
+        || !restart_get_u64(r, &vtime)
+        || !restart_get_u64(r, &vclock)
+        || !restart_get_small(r, 1u, &drained)
+        || !restart_get_u32(r, ASX_CLEANUP_STACK_CAPACITY, &count)) {
+        return 0;
+    }
+    c->region_state[idx] = (uint8_t)state;
+    if (apply) {
+        rs->state = (asx_region_state)state;
+        rs->poisoned = (int)poisoned;
+        rs->task_total = task_total;
+        rs->vtime = vtime;
+        rs->vclock = vclock;
+        rs->cleanup.drained = drained;
+        rs->cleanup.count = count;
+    }
+    for (i = 0; i < count; i++) {
+        if (!restart_get_binding(r, c, 0, 1, &b)) return 0;
+        if (apply && b != NULL) {
+            rs->cleanup.fns[i] = b->cleanup_fn;
+            rs->cleanup.data[i] = b->data;
+        }
+    }
+    return 1;
+}
+
+/* Region tree: each linked region follows its parent in pre-order */
+static int restart_parse_tree(restart_reader *r, restart_check *c, int apply)
+{
+    uint32_t child[ASX_MAX_REGIONS];
+    uint32_t parent[ASX_MAX_REGIONS];
+    uint32_t n, i, idx, pidx;
+    asx_region_slot *p;
+
+    if (!restart_get_u32(r, ASX_MAX_REGIONS, &n)) return 0;
+    for (i = 0; i < n; i++) {
+        if (!restart_get_u32(r, ASX_MAX_REGIONS - 1u, &child[i])
+            || !restart_get_u32(r, ASX_MAX_REGIONS - 1u, &parent[i])) {
+            return 0;
+        }
+    }
+
+    if (!apply) {
+        /* Linked regions are live and non-closed, listed once; a
+         * parent is either never listed (a root) or listed earlier */
+        memset(c->region_placed, 0, sizeof(c->region_placed));
+        for (i = 0; i < n; i++) {
+            idx = child[i];
+            if (idx >= c->region_extent || !c->region_alive[idx]
+                || c->region_placed[idx]
+                || c->region_state[idx] == (uint8_t)ASX_REGION_CLOSED) {
+                return 0;
+            }
+            c->region_placed[idx] = 1;
+        }
+        memset(c->region_placed, 0, sizeof(c->region_placed));
+        for (i = 0; i < n; i++) {
+            c->region_placed[child[i]] = 2; /* listed, not yet reached */
+        }
+        for (i = 0; i < n; i++) {
+            pidx = parent[i];
+            if (pidx >= c->region_extent || !c->region_alive[pidx]
+                || c->region_state[pidx] == (uint8_t)ASX_REGION_CLOSED
+                || c->region_placed[pidx] == 2) {
+                return 0;
+            }
+            c->region_placed[child[i]] = 1;
+        }
+        return 1;
+    }
+
+    for (i = 0; i < n; i++) {
+        idx = child[i];
+        p = &g_regions[parent[i]];
+        g_regions[idx].parent = parent[i];
+        g_regions[idx].sibling_prev = p->child_tail;
+        if (p->child_tail == ASX_REGION_LINK_NONE) {
+            p->child_head = idx;
+        } else {
+            g_regions[p->child_tail].sibling_next = idx;
+        }
+        p->child_tail = idx;
+        p->child_count++;
+        for (;;) {
+            p->subtree_regions++;
+            if (p->parent == ASX_REGION_LINK_NONE) break;
+            p = &g_regions[p->parent];
+        }
+    }
+    return 1;
+}
+
+static int restart_parse_task(restart_reader *r, restart_check *c,
+                              uint32_t idx, int apply)
+{
+    asx_task_slot *t = &g_tasks[idx];
+    asx_task_cold *tc = &g_task_cold[idx];
+    const asx_restart_binding *b;
+    asx_region_id region;
+    uint32_t rslot, state, priority, parked, cancel_pending, severity;
+    uint32_t size, aligned, phase, kind, truncated, epoch, polls, waiter;
+    uint32_t has_override, override_sev, deadline_reported, cost_reported;
+    uint64_t wake_at, deadline, vtime, origin_region, origin_task;
+    uint64_t timestamp, poll_cost;
+    const uint8_t *bytes;
+    void *captured = NULL;
+
+    if (!restart_get_small(r, (uint32_t)ASX_TASK_COMPLETED, &state)
+        || !restart_get_region_id(r, c, &region, &rslot)
+        || !restart_get_small(r, 0xFFu, &priority)
+        || !restart_get_small(r, 1u, &parked)
+        || !restart_get_small(r, 1u, &cancel_pending)
+        || !restart_get_binding(r, c, 1, 0, &b)
+        || !restart_get_u64(r, &wake_at)
+        || !restart_get_u64(r, &deadline)
+        || !restart_get_u64(r, &vtime)
+        || !restart_get_small(r, (uint32_t)ASX_OUTCOME_PANICKED, &severity)
+        || !restart_get_u32(r, ASX_REGION_CAPTURE_ARENA_BYTES, &size)
+        || size > r->len - r->pos) {
+        return 0;
+    }
+    bytes = r->buf + r->pos;
+    r->pos += size;
+    if (!restart_get_small(r, (uint32_t)ASX_CANCEL_PHASE_COMPLETED, &phase)
+        || !restart_get_small(r, (uint32_t)ASX_CANCEL_SHUTDOWN, &kind)
+        || !restart_get_u64(r, &origin_region)
+        || !restart_get_u64(r, &origin_task)
+        || !restart_get_u64(r, &timestamp)
+        || !restart_get_small(r, 1u, &truncated)
+        || !restart_get_u32(r, UINT32_MAX, &epoch)
+        || !restart_get_u32(r, UINT32_MAX, &polls)
+        || !restart_get_u32(r, ASX_MAX_TASKS, &waiter)
+        || !restart_get_small(r, 1u, &has_override)
+        || !restart_get_small(r, (uint32_t)ASX_OUTCOME_PANICKED, &override_sev)
+        || !restart_get_small(r, 1u, &deadline_reported)
+        || !restart_get_u64(r, &poll_cost)
+        || !restart_get_small(r, 1u, &cost_reported)) {
+        return 0;
+    }
+
+    if (!apply) {
+        /* A live task has an entry point and sits in a non-closed
+         * region whose capture quota covers its state */
+        if (state != (uint32_t)ASX_TASK_COMPLETED) {
+            if (b == NULL) return 0;
+            if (c->region_state[rslot] == (uint8_t)ASX_REGION_CLOSED) return 0;
+        } else if (size != 0) {
+            return 0;
+        }
+        aligned = (size + 7u) & ~7u;
+        if (aligned > ASX_REGION_CAPTURE_ARENA_BYTES - c->region_capture[rslot]) {
+            return 0;
+        }
+        c->region_capture[rslot] += aligned;
+        c->waiter[idx] = waiter;
+        return 1;
+    }
+
+    if (size > 0) {
+        captured = asx_region_capture_restore(&g_regions[rslot], size);
+        if (captured == NULL) {
+            c->st = ASX_E_RESOURCE_EXHAUSTED;
+            return 0;
+        }
+        memcpy(captured, bytes, size);
+    }
+    t->state = (asx_task_state)state;
+    t->priority = (uint8_t)priority;
+    t->parked = (uint8_t)parked;
+    t->cancel_pending = (uint8_t)cancel_pending;
+    t->poll_fn = b != NULL ? b->poll_fn : NULL;
+    t->user_data = captured != NULL ? captured : (b != NULL ? b->data : NULL);
+    t->wake_at = wake_at;
+    t->deadline = deadline;
+    t->vtime = vtime;
+    tc->region = region;
+    tc->outcome = asx_outcome_make((asx_outcome_severity)severity);
+    tc->captured_state = captured;
+    tc->captured_size = size;
+    tc->captured_dtor = captured != NULL && b != NULL ? b->state_dtor : NULL;
+    tc->cancel_phase = (asx_cancel_phase)phase;
+    tc->cancel_reason.kind = (asx_cancel_kind)kind;
+    tc->cancel_reason.origin_region = origin_region;
+    tc->cancel_reason.origin_task = origin_task;
+    tc->cancel_reason.timestamp = timestamp;
+    tc->cancel_reason.truncated = (int)truncated;
+    tc->cancel_epoch = epoch;
+    tc->cleanup_polls_remaining = polls;
+    tc->waiter = waiter == 0 ? ASX_TASK_LINK_NONE : waiter - 1u;
+    tc->has_outcome_override = (int)has_override;
+    tc->outcome_override = asx_outcome_make((asx_outcome_severity)override_sev);
+    tc->deadline_reported = (int)deadline_reported;
+    tc->poll_cost = poll_cost;
+    tc->cost_reported = (int)cost_reported;
+
+    if (t->state != ASX_TASK_COMPLETED) {
+        asx_region_task_link(&g_regions[rslot], idx);
+        g_regions[rslot].task_count++;
+    }
+    return 1;
+}
+
+static int restart_parse_channel(restart_reader *r, restart_check *c,
+                                 asx_channel_slot *ch, int apply)
+{
+    uint32_t state, capacity, reserved, next_token, len, i;
+    uint64_t region, v;
+
+    if (!restart_get_small(r, (uint32_t)ASX_CHANNEL_FULLY_CLOSED, &state)
+        || !restart_get_u64(r, &region)
+        || !restart_get_u32(r, ASX_CHANNEL_MAX_CAPACITY, &capacity)
+        || !restart_get_u32(r, ASX_CHANNEL_MAX_CAPACITY, &reserved)
+        || !restart_get_u32(r, UINT32_MAX, &next_token)
+        || !restart_get_u32(r, ASX_CHANNEL_MAX_CAPACITY, &len)
+        || capacity == 0 || len + reserved > capacity
+        || asx_handle_type_tag(region) != ASX_TYPE_REGION
+        || asx_handle_slot(region) >= ASX_MAX_REGIONS) {
+        return 0;
+    }
+    if (apply) {
+        if (asx_channel_storage_attach(ch, capacity) != ASX_OK) {
+            c->st = ASX_E_RESOURCE_EXHAUSTED;
+            return 0;
+        }
+        ch->state = (asx_channel_state)state;
+        ch->region = region;
+        ch->reserved = reserved;
+        ch->next_token = next_token;
+        ch->queue_len = len;
+    }
+    for (i = 0; i < len; i++) {
+        if (!restart_get_u64(r, &v)) return 0;
+        if (apply) ch->queue[i] = v;
+    }
+    return 1;
+}
+
+static int restart_parse_timer(restart_reader *r, restart_check *c,
+                               asx_timer_slot *s, int apply)
+{
+    const asx_restart_binding *b;
+    uint64_t deadline, slack, seq;
+
+    if (!restart_get_u64(r, &deadline)
+        || !restart_get_u64(r, &slack)
+        || !restart_get_u64(r, &seq)
+        || slack > UINT64_MAX - deadline
+        || !restart_get_binding(r, c, 0, 0, &b)) {
+        return 0;
+    }
+    if (apply) {
+        s->deadline = deadline;
+        s->latest = deadline + slack;
+        s->insertion_seq = seq;
+        s->waker_data = b != NULL ? b->data : NULL;
+    }
+    return 1;
+}
+
+/* Slot header: alive flag and generation */
+static int restart_get_slot(restart_reader *r, uint32_t *alive, uint16_t *gen)
+{
+    uint32_t g;
+
+    if (!restart_get_small(r, 1u, alive)
+        || !restart_get_u32(r, 0xFFFFu, &g)) {
+        return 0;
+    }
+    *gen = (uint16_t)g;
+    return 1;
+}
+
+static int restart_parse(restart_reader *r, restart_check *c, int apply)
+{
+    asx_timer_wheel *wheel = &g_rt->wheel;
+    uint32_t alive, n, i, ch_count, wheel_init;
+    uint64_t now, max_duration, next_insertion;
+    uint16_t gen;
+
+    r->pos = 13; /* magic, version, digest */
+
+    /* Regions */
+    if (!restart_get_u32(r, ASX_MAX_REGIONS, &n)) return 0;
+    c->region_extent = n;
+    for (i = 0; i < n; i++) {
+        if (!restart_get_slot(r, &alive, &gen)) return 0;
+        c->region_alive[i] = (uint8_t)alive;
+        c->region_gen[i] = gen;
+        if (apply) {
+            g_regions[i].alive = (int)alive;
+            g_regions[i].generation = gen;
+            ASX_SNAP_MARK(regions, i);
+        }
+        if (alive && !restart_parse_region(r, c, i, apply)) return 0;
+    }
+    if (apply) g_region_count = n;
+    if (!restart_parse_tree(r, c, apply)) return 0;
+
+    /* Tasks */
+    if (!restart_get_u32(r, ASX_MAX_TASKS, &n)) return 0;
+    c->task_extent = n;
+    for (i = 0; i < n; i++) {
+        if (!restart_get_slot(r, &alive, &gen)) return 0;
+        c->task_alive[i] = (uint8_t)alive;
+        if (!apply) c->waiter[i] = 0;
+        if (apply) {
+            g_tasks[i].alive = (uint8_t)alive;
+            g_tasks[i].generation = gen;
+            ASX_SNAP_MARK(tasks, i);
+        }
+        if (alive && !restart_parse_task(r, c, i, apply)) return 0;
+    }
+    if (apply) g_task_count = n;
+    for (i = 0; !apply && i < n; i++) {
+        if (c->waiter[i] != 0 && (c->waiter[i] > n
+                                  || !c->task_alive[c->waiter[i] - 1u])) {
+            return 0;
+        }
+    }
+
+    /* Obligations */
+    if (!restart_get_u32(r, ASX_MAX_OBLIGATIONS, &n)) return 0;
+    for (i = 0; i < n; i++) {
+        asx_obligation_slot *o = &g_obligations[i];
+        asx_region_id region;
+        uint32_t state, rslot;
+
+        if (!restart_get_slot(r, &alive, &gen)) return 0;
+        if (apply) {
+            o->alive = (int)alive;
+            o->generation = gen;
+            ASX_SNAP_MARK(obligations, i);
+        }
+        if (!alive) continue;
+        if (!restart_get_small(r, (uint32_t)ASX_OBLIGATION_LEAKED, &state)
+            || !restart_get_region_id(r, c, &region, &rslot)) {
+            return 0;
+        }
+        if (apply) {
+            o->state = (asx_obligation_state)state;
+            o->region = region;
+        }
+    }
+    if (apply) g_obligation_count = n;
+
+    /* Channels */
+    if (!restart_get_u32(r, UINT32_MAX, &ch_count)
+        || !restart_get_u32(r, ASX_MAX_CHANNELS, &n)) {
+        return 0;
+    }
+    if (apply) g_rt->channel_count = ch_count;
+    for (i = 0; i < n; i++) {
+        asx_channel_slot *ch = &g_rt->channels[i];
+
+        if (!restart_get_slot(r, &alive, &gen)) return 0;
+        if (apply) ch->generation = gen;
+        if (alive && !restart_parse_channel(r, c, ch, apply)) return 0;
+        /* Live only once its ring is attached */
+        if (apply) ch->alive = (int)alive;
+    }
+
+    /* Timers */
+    if (!restart_get_small(r, 1u, &wheel_init)
+        || !restart_get_u64(r, &now)
+        || !restart_get_u64(r, &max_duration)
+        || !restart_get_u64(r, &next_insertion)
+        || !restart_get_u32(r, wheel_init ? ASX_MAX_TIMERS : 0u, &n)) {
+        return 0;
+    }
+    if (apply && wheel_init) {
+        g_rt->wheel_initialized = 1;
+        wheel->current_time = now;
+        wheel->max_duration_ns = max_duration;
+        wheel->next_insertion = next_insertion;
+        wheel->slot_count = n;
+    }
+    for (i = 0; i < n; i++) {
+        asx_timer_slot *s = &wheel->slots[i];
+
+        if (!restart_get_slot(r, &alive, &gen)) return 0;
+        if (apply) {
+            s->alive = (int)alive;
+            s->generation = gen;
+            if (alive) wheel->active_count++;
+        }
+        if (alive && !restart_parse_timer(r, c, s, apply)) return 0;
+    }
+
+    return r->pos == r->len;
+}
+
+/* Everything restore writes, back to empty: the target of the apply
+ * pass and the state a failed apply leaves behind. */
+static void restart_clear(void)
+{
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_broadcast_reset();
+    asx_timer_wheel_init(&g_rt->wheel);
+    g_rt->wheel_initialized = 0;
+}
+
+asx_status asx_runtime_restore(const uint8_t *buf, uint32_t len)
+{
+    restart_reader r;
+    restart_check c;
+    uint64_t digest;
+    uint64_t sum;
+    uint32_t i;
+
+    if (buf == NULL || len < 21u) return ASX_E_INVALID_ARGUMENT;
+    if ((uint32_t)buf[0] != (ASX_RESTART_MAGIC & 0xFFu)
+        || (uint32_t)buf[1] != ((ASX_RESTART_MAGIC >> 8) & 0xFFu)
+        || (uint32_t)buf[2] != ((ASX_RESTART_MAGIC >> 16) & 0xFFu)
+        || (uint32_t)buf[3] != ((ASX_RESTART_MAGIC >> 24) & 0xFFu)
+        || (uint32_t)buf[4] != ASX_RESTART_VERSION) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    sum = RESTART_FNV_BASIS;
+    for (i = 0; i < len - 8u; i++) {
+        sum = (sum ^ buf[i]) * RESTART_FNV_PRIME;
+    }
+    digest = 0;
+    for (i = 0; i < 8u; i++) {
+        if (buf[len - 8u + i] != (uint8_t)((sum >> (8u * i)) & 0xFFu)) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        digest |= (uint64_t)buf[5u + i] << (8u * i);
+    }
+
+    r.buf = buf;
+    r.len = len - 8u;
+    memset(&c, 0, sizeof(c));
+    c.st = ASX_OK;
+    if (!restart_parse(&r, &c, 0)) {
+        return c.st != ASX_OK ? c.st : ASX_E_INVALID_ARGUMENT;
+    }
+
+    restart_clear();
+    if (!restart_parse(&r, &c, 1)) {
+        restart_clear();
+        return c.st != ASX_OK ? c.st : ASX_E_INVALID_ARGUMENT;
+    }
+    asx_channel_ready_rebuild();
+    if (asx_runtime_state_digest() != digest) {
+        restart_clear();
+        return ASX_E_REPLAY_MISMATCH;
+    }
+    return ASX_OK;
+}
@@ -1,8 +1,8 @@
 /*
  * runtime_internal.h — shared internal state for walking skeleton runtime
  *
- * NOT part of the public API. Used only by runtime .c translation units.
- * Phase 3 will replace static arenas with hook-backed dynamic allocation.
+ * NOT part of the public API. Used only by runtime .c translation units
+ * (and the channel and timer modules whose state the instance owns).
  *
  * SPDX-License-Identifier: MIT
  */
@@ -15,12 +15,41 @@
 #include <asx/core/outcome.h>
 #include <asx/core/cleanup.h>
 #include <asx/core/cancel.h>
+#include <asx/core/channel.h>
+#include <asx/core/broadcast.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/instance.h>
+#include <asx/runtime/trace.h>
+#include <asx/runtime/hindsight.h>
+#include <asx/runtime/wake.h>
+#include <asx/runtime/log_ring.h>
+#include <asx/runtime/restart.h>
+#include <asx/runtime/admission.h>
+#include <asx/runtime/hft_instrument.h>
+#include <asx/runtime/automotive_instrument.h>
+#include <asx/core/adaptive.h>
+#include <asx/time/timer_wheel.h>
 
 /* -------------------------------------------------------------------
  * Arena slot types (walking skeleton: fixed-size)
  * ------------------------------------------------------------------- */
 
+/* Terminator for the intrusive per-region task list. */
+#define ASX_TASK_LINK_NONE UINT32_MAX
+
+/* Terminator for region tree links (parent, child, sibling). */
+#define ASX_REGION_LINK_NONE UINT32_MAX
+
+/* Capture chunk header; the payload follows at ASX_CAPTURE_CHUNK_HDR. */
+typedef struct asx_capture_chunk {
+    struct asx_capture_chunk *next;    /* region list or pool free list */
+    uint32_t                  capacity; /* payload bytes */
+    uint32_t                  used;     /* bump offset into payload */
+} asx_capture_chunk;
+
+#define ASX_CAPTURE_CHUNK_HDR \
+    ((uint32_t)((sizeof(asx_capture_chunk) + 15u) & ~(size_t)15u))
+
 typedef struct {
     asx_region_state   state;
     uint32_t           task_count;     /* live (non-completed) tasks */
@@ -29,18 +58,51 @@ typedef struct {
     int                alive;          /* 1 if slot in use */
     int                poisoned;       /* 1 if region has been poisoned (containment) */
     asx_cleanup_stack  cleanup;        /* LIFO cleanup for finalization */
-    uint8_t            capture_arena[ASX_REGION_CAPTURE_ARENA_BYTES];
-    uint32_t           capture_used;
+    uint32_t           task_head;      /* first live task (arena index) */
+    uint32_t           task_tail;      /* last live task (arena index) */
+    /* Region tree: arena indices, ASX_REGION_LINK_NONE if absent.
+     * Only non-closed children are linked; a child unlinks itself
+     * when it reaches CLOSED. */
+    uint32_t           parent;
+    uint32_t           child_head;
+    uint32_t           child_tail;
+    uint32_t           sibling_next;
+    uint32_t           sibling_prev;
+    uint32_t           child_count;     /* linked (non-closed) children */
+    uint32_t           subtree_tasks;   /* live tasks in this subtree */
+    uint32_t           subtree_regions; /* non-closed strict descendants */
+    asx_capture_chunk *capture_head;   /* current chunk first */
+    uint32_t           capture_used;   /* bytes charged to the quota */
+    /* Fair scheduling (ASX_SCHED_POLICY_FAIR) */
+    uint64_t           vtime;          /* cost charged to this region */
+    uint64_t           vclock;         /* min task vtime last picked */
 } asx_region_slot;
 
+/* Task arena, split hot/cold into two parallel arrays indexed by the
+ * same arena index. asx_task_slot holds what the scheduler's per-round
+ * walks, the idle scans and the cancel sweep read for every live task,
+ * packed so a slot spans as few cache lines as possible. asx_task_cold
+ * holds what is touched only on spawn, cancel delivery, completion and
+ * the query APIs; reach it with ASX_TASK_COLD(t). */
 typedef struct {
     asx_task_state   state;
-    asx_region_id    region;
+    uint32_t         region_next;     /* intrusive region task list, */
+    uint32_t         region_prev;     /* ascending arena index */
+    uint16_t         generation;      /* increments on slot reclaim */
+    uint8_t          priority;        /* lower = tighter */
+    uint8_t          alive;
+    uint8_t          parked;          /* 1 if skipped until woken */
+    uint8_t          cancel_pending;  /* 1 if cancel signal delivered */
     asx_task_poll_fn poll_fn;
     void            *user_data;
+    asx_time         wake_at;         /* parked wake deadline, 0 = none */
+    asx_time         deadline;        /* 0 = none (asx_task_set_budget) */
+    uint64_t         vtime;           /* fair scheduling: weighted vtime */
+} asx_task_slot;
+
+typedef struct {
+    asx_region_id    region;
     asx_outcome      outcome;
-    uint16_t         generation;     /* increments on slot reclaim */
-    int              alive;
     void            *captured_state;
     uint32_t         captured_size;
     asx_task_state_dtor_fn captured_dtor;
@@ -49,8 +111,15 @@ typedef struct {
     asx_cancel_reason  cancel_reason;
     uint32_t           cancel_epoch;
     uint32_t           cleanup_polls_remaining;
-    int                cancel_pending;  /* 1 if cancel signal delivered */
-} asx_task_slot;
+    /* Wait/wake (asx_task_await, combinators) */
+    uint32_t           waiter;          /* task woken on completion */
+    int                has_outcome_override;
+    asx_outcome        outcome_override; /* used instead of OK on completion */
+    int                deadline_reported;
+    /* Fair scheduling: reported poll cost */
+    uint64_t           poll_cost;
+    int                cost_reported;
+} asx_task_cold;
 
 typedef struct {
     asx_obligation_state state;
@@ -60,17 +129,295 @@ typedef struct {
 } asx_obligation_slot;
 
 /* -------------------------------------------------------------------
- * Global arenas (defined in lifecycle.c)
+ * Module-private slot types held by the runtime instance
  * ------------------------------------------------------------------- */
 
-extern asx_region_slot      g_regions[ASX_MAX_REGIONS];
-extern uint32_t             g_region_count;
+/* Channel slot (mpsc.c) */
+typedef struct {
+    asx_channel_state state;
+    asx_region_id     region;
+    uint16_t          generation;
+    int               alive;
+
+    /* Bounded ring buffer: queue_mask + 1 entries (capacity rounded
+     * up to a power of two), from the channel reserve or the hook */
+    uint32_t          capacity;
+    uint64_t         *queue;
+    uint32_t          queue_mask;
+    int               queue_heap;   /* 1 if allocated through the hook */
+    uint32_t          queue_head;   /* next read position */
+    uint32_t          queue_len;    /* committed messages in queue */
+
+    /* Two-phase accounting */
+    uint32_t          reserved;     /* outstanding permits */
+    uint32_t          next_token;   /* monotonic permit token */
+
+    /* asx_channel_select */
+    asx_task_id       recv_waiter;  /* task parked in select, or
+                                       ASX_INVALID_ID */
+
+    /* Occupancy signal in overload (admission.c hysteresis) */
+    int               admit_engaged;
+} asx_channel_slot;
+
+/* Admission controller of one region (admission.c) */
+typedef struct {
+    int                  enabled;
+    uint16_t             generation;  /* of the region it was enabled on */
+    asx_admission_config config;
+    int                  engaged;     /* task signal in overload */
+    asx_task_id          waiter;      /* parked in asx_admission_wait */
+    asx_admission_stats  stats;
+} asx_admission_ctl;
+
+/* Broadcast slot and its subscriber cursors (broadcast.c). The ring
+ * holds sequences [tail, head); message n lives at values[n % capacity]
+ * and tail is the slowest live cursor (head with no subscribers). */
+typedef struct {
+    uint64_t  cursor;       /* next sequence to read */
+    uint64_t  missed;       /* shed past this cursor, not yet reported */
+    uint16_t  generation;
+    int       alive;
+} asx_broadcast_sub;
+
+typedef struct {
+    asx_region_id       region;
+    uint16_t            generation;
+    int                 alive;
+    int                 closed;        /* producer side closed */
+    uint32_t            capacity;
+    asx_overload_policy policy;
+    uint64_t            head;          /* sequence of the next send */
+    uint64_t            tail;          /* oldest retained sequence */
+    uint64_t            values[ASX_BROADCAST_MAX_CAPACITY];
+    asx_broadcast_sub   subs[ASX_BROADCAST_MAX_SUBSCRIBERS];
+    uint32_t            sub_count;     /* live subscribers */
+    asx_broadcast_stats stats;
+} asx_broadcast_slot;
+
+/* Timer slot and wheel (timer_wheel.c) */
+typedef struct {
+    asx_time  deadline;       /* earliest time this timer may fire */
+    asx_time  latest;         /* deadline + slack: latest it may fire */
+    void     *waker_data;     /* opaque callback data */
+    uint64_t  insertion_seq;  /* monotonic tie-break key */
+    uint16_t  generation;     /* for stale-handle detection */
+    int       alive;          /* 1 if slot is live (not cancelled/fired) */
+} asx_timer_slot;
+
+struct asx_timer_wheel {
+    asx_timer_slot slots[ASX_MAX_TIMERS];
+    uint32_t       slot_count;       /* high-water mark for slot allocation */
+    uint32_t       active_count;     /* number of alive timers */
+    uint64_t       next_insertion;   /* monotonic insertion sequence */
+    asx_time       current_time;     /* last advanced-to time */
+    uint64_t       max_duration_ns;  /* maximum allowed timer duration */
+};
+
+/* Scheduler records of the current run kept once the trace ring is
+ * full, so each run stays readable however long the trace grows. */
+#ifndef ASX_SCHED_SPILL_CAPACITY
+#define ASX_SCHED_SPILL_CAPACITY 256u
+#endif
+
+/* Filtered view over the trace ring (scheduler events, event records).
+ * count includes records past ASX_TRACE_CAPACITY; the first in_ring
+ * of them are in the ring. The cursor makes ascending index reads
+ * O(1) amortized. */
+typedef struct {
+    uint32_t base;          /* ring position where the view starts */
+    uint32_t count;         /* records emitted into the view */
+    uint32_t in_ring;       /* of which retained by the ring */
+    uint32_t cursor_index;  /* view index last resolved ... */
+    uint32_t cursor_pos;    /* ... and its ring position */
+} asx_trace_view;
+
+/* Per-arena change bitsets for incremental snapshots (snapshot.c) */
+#define ASX_SNAP_WORDS(n) (((uint32_t)(n) + 31u) / 32u)
+
+typedef struct {
+    uint32_t regions[ASX_SNAP_WORDS(ASX_MAX_REGIONS)];
+    uint32_t tasks[ASX_SNAP_WORDS(ASX_MAX_TASKS)];
+    uint32_t obligations[ASX_SNAP_WORDS(ASX_MAX_OBLIGATIONS)];
+} asx_snap_dirty;
+
+#define ASX_FAULT_MAX_ACTIVE 8u
+
+/* -------------------------------------------------------------------
+ * Runtime instance (asx_runtime)
+ *
+ * All per-runtime state: arenas, hooks, scheduler, channels, timers,
+ * trace and hindsight rings. Modules reach it through g_rt, the
+ * calling thread's current instance; their former file-scope names
+ * are kept as macros over g_rt so module code reads unchanged.
+ * HFT and automotive instrumentation and the adaptive evidence
+ * ledger live here too, so sharded instances record independently.
+ * Ghost monitors and the error ledger are per thread (not per
+ * instance). Still process-wide, and so to be configured from one
+ * thread before any shard starts: telemetry (telemetry.c), the
+ * affinity domain table (core/affinity.c), the router reject streak
+ * (vertical_adapter.c) and the single-threaded parallel skeleton
+ * (parallel.c).
+ * ------------------------------------------------------------------- */
+
+struct asx_runtime {
+    asx_resource_class  resource_class;
+    int                 heap_owned;      /* 0 for the default instance */
+    asx_allocator_hooks owner;           /* frees a heap instance */
+
+    /* lifecycle.c */
+    asx_region_slot     regions[ASX_MAX_REGIONS];
+    uint32_t            region_count;
+    asx_task_slot       tasks[ASX_MAX_TASKS];
+    asx_task_cold       task_cold[ASX_MAX_TASKS];
+    uint32_t            task_count;
+    asx_obligation_slot obligations[ASX_MAX_OBLIGATIONS];
+    uint32_t            obligation_count;
+    uint64_t            capture_reserve[ASX_CAPTURE_RESERVE_BYTES / 8u];
+    uint32_t            capture_reserve_used;
+    asx_capture_chunk  *capture_pool;
+
+    /* hooks.c */
+    asx_runtime_hooks   hooks;
+    int                 hooks_installed;
+    asx_fault_injection faults[ASX_FAULT_MAX_ACTIVE];
+    uint32_t            fault_count;
+    uint32_t            fault_clock_calls;
+    uint32_t            fault_entropy_calls;
+    uint32_t            fault_alloc_calls;
+
+    /* log_ring.c */
+    asx_log_ring       *log_ring;        /* async log pipeline, or NULL */
+
+    /* scheduler.c */
+    asx_trace_view      sched_view;
+    asx_trace_event     sched_spill[ASX_SCHED_SPILL_CAPACITY];
+    asx_sched_policy    sched_policy;
+    int                 deadline_monitor;
+    uint32_t            ready_heap[ASX_MAX_TASKS]; /* FAIR only */
+    uint32_t            ready_len;
+    uint32_t            ready_owner;     /* FAIR run holding the heap */
+    uint32_t            sched_run_serial;
+    uint32_t            sched_runnable_seq; /* bumped on spawn/unpark */
+    asx_idle_strategy   idle_strategy;
+    int                 idle_enabled;
+    asx_idle_stats      idle_stats;
+
+    /* mpsc.c */
+    asx_channel_slot    channels[ASX_MAX_CHANNELS];
+    uint32_t            channel_count;
+    /* Receive readiness by owning region slot: bit i set iff channel
+     * slot i belongs to that region and try_recv would not block */
+    uint32_t            channel_ready[ASX_MAX_REGIONS];
+    /* Ring storage reserve, managed as a buddy system: free blocks of
+     * 2^k messages are linked through their first word from
+     * channel_free[k] (offset + 1; 0 ends the list). One unused word
+     * when the reserve is configured out. */
+    uint64_t            channel_reserve[ASX_CHANNEL_RESERVE_SLOTS > 0u
+                                        ? ASX_CHANNEL_RESERVE_SLOTS : 1u];
+    uint32_t            channel_free[32];
+    int                 channel_reserve_ready;
+
+    /* broadcast.c */
+    asx_broadcast_slot  broadcasts[ASX_MAX_BROADCASTS];
+
+    /* admission.c, by region slot */
+    asx_admission_ctl   admission[ASX_MAX_REGIONS];
+
+    /* timer_wheel.c */
+    asx_timer_wheel     wheel;
+    int                 wheel_initialized;
+
+    /* trace.c */
+    asx_trace_event     trace_ring[ASX_TRACE_CAPACITY];
+    uint32_t            trace_count;
+    uint64_t            trace_digest;    /* FNV-1a over [0, trace_folded) */
+    uint32_t            trace_folded;
+    uint64_t            trace_cp[ASX_TRACE_CHECKPOINTS];
+    asx_trace_event     replay_ref[ASX_TRACE_CAPACITY];
+    uint64_t            replay_ref_cp[ASX_TRACE_CHECKPOINTS];
+    uint64_t            replay_ref_digest;
+    uint32_t            replay_ref_count;
+    int                 replay_loaded;
+
+    /* event.c */
+    asx_trace_view      event_view;
+    uint64_t            event_chain;     /* hash chain over the view ... */
+    uint32_t            event_chain_pos; /* ... up to this ring position */
+    uint32_t            event_chain_seq;
+
+    /* snapshot.c */
+    asx_snap_dirty      snap_delta;      /* changed since last update */
+    asx_snap_dirty      snap_pending;    /* not yet folded into digest */
+    uint64_t            snap_digest;     /* XOR of folded record hashes */
+    uint64_t            snap_region_hash[ASX_MAX_REGIONS];
+    uint64_t            snap_task_hash[ASX_MAX_TASKS];
+    uint64_t            snap_obligation_hash[ASX_MAX_OBLIGATIONS];
+    uint32_t            snap_epoch;      /* bumped per capture/update */
+
+    /* hindsight.c */
+    asx_hindsight_event hs_ring[ASX_HINDSIGHT_CAPACITY];
+    uint32_t            hs_write_index;
+    uint32_t            hs_total_count;
+    uint32_t            hs_next_sequence;
+    asx_hindsight_policy hs_policy;
+
+    /* wake.c */
+    asx_wake_handle    *wake_handles[ASX_MAX_WAKE_HANDLES];
+    uint32_t            wake_count;
+
+    /* restart.c */
+    const asx_restart_binding *restart_bindings; /* borrowed */
+    uint32_t            restart_binding_count;
+
+    /* hft_instrument.c (lazily initialised) */
+    asx_hft_histogram   hft_sched_hist;
+    asx_hft_jitter_tracker hft_sched_jitter;
+    asx_hft_histogram   hft_wake_hist;
+    int                 hft_initialized;
+
+    /* automotive_instrument.c (lazily initialised) */
+    asx_auto_deadline_tracker auto_deadline;
+    asx_auto_watchdog   auto_watchdog;
+    asx_auto_audit_ring auto_audit;
+    int                 auto_initialized;
+
+    /* core/adaptive.c */
+    asx_adaptive_policy adaptive_policy;
+    uint32_t            adaptive_decision_seq;
+    uint32_t            adaptive_fallback_count;
+    int                 adaptive_in_fallback;
+    asx_adaptive_ledger_entry adaptive_ledger[ASX_ADAPTIVE_LEDGER_DEPTH];
+    uint32_t            adaptive_ledger_write;  /* next write position */
+    uint32_t            adaptive_ledger_total;  /* total entries written */
+};
+
+/* Current instance of the calling thread (defined in instance.c) */
+extern ASX_THREAD_LOCAL asx_runtime *g_rt;
+
+/* Set non-zero defaults on a zeroed instance. */
+void asx_runtime_instance_defaults(asx_runtime *rt);
+
+/* Read the clock like asx_runtime_now_ns, but without advancing the
+ * fault-injection clock counter or logging a hindsight clock read.
+ * For reads that only pace the runtime (the scheduler idle wait), so
+ * they do not shift which read a clock fault fires on. */
+asx_status asx_runtime_clock_peek_ns(asx_time *out_now);
+
+/* -------------------------------------------------------------------
+ * Arenas of the current instance (owned by lifecycle.c)
+ * ------------------------------------------------------------------- */
 
-extern asx_task_slot        g_tasks[ASX_MAX_TASKS];
-extern uint32_t             g_task_count;
+#define g_regions          (g_rt->regions)
+#define g_region_count     (g_rt->region_count)
+#define g_tasks            (g_rt->tasks)
+#define g_task_cold        (g_rt->task_cold)
+#define g_task_count       (g_rt->task_count)
+#define g_obligations      (g_rt->obligations)
+#define g_obligation_count (g_rt->obligation_count)
 
-extern asx_obligation_slot  g_obligations[ASX_MAX_OBLIGATIONS];
-extern uint32_t             g_obligation_count;
+/* Cold half of the task slot t (a pointer into g_tasks). */
+#define ASX_TASK_COLD(t)   (&g_task_cold[(t) - g_tasks])
 
 /* -------------------------------------------------------------------
  * Shared lookup functions (generation-safe, used across TUs)
@@ -81,4 +428,187 @@ ASX_MUST_USE asx_status asx_task_slot_lookup(asx_task_id id, asx_task_slot **out
 ASX_MUST_USE asx_status asx_obligation_slot_lookup(asx_obligation_id id,
                                                    asx_obligation_slot **out);
 
+/* -------------------------------------------------------------------
+ * Region task list (live tasks only, ascending arena index)
+ *
+ * Propagation, scheduling and quiescence walk this list instead of
+ * scanning the whole task arena. asx_region_task_retire() unlinks a
+ * task that reached a terminal state, decrements task_count and wakes
+ * the task awaiting it; the retired slot keeps its region_next so an
+ * in-progress walk can continue from it.
+ * ------------------------------------------------------------------- */
+
+void asx_region_task_link(asx_region_slot *r, uint32_t task_idx);
+void asx_region_task_retire(asx_region_slot *r, uint32_t task_idx);
+
+/* -------------------------------------------------------------------
+ * Task parking
+ *
+ * A parked task is skipped by the scheduler until a task it awaits
+ * completes (asx_region_task_retire wakes the waiter), it is
+ * cancelled, or wake_at passes. If every live task in a region is
+ * parked the scheduler wakes them all for one round so waits on
+ * other regions or the clock still make progress.
+ *
+ * Wakes go through ASX_TASK_UNPARK, which also tells the FAIR ready
+ * heap (scheduler.c) that the runnable set has grown.
+ * ------------------------------------------------------------------- */
+
+void asx_task_park(asx_task_slot *t, uint32_t awaited_idx, asx_time wake_at);
+
+/* Complete a task that has never been polled with a CANCELLED outcome
+ * and retire it, without waking its waiter. Rolls back a group spawn
+ * that failed partway (combinator.c). */
+void asx_task_discard(uint32_t task_idx);
+
+#define ASX_TASK_UNPARK(t)                                               \
+    do {                                                                 \
+        (t)->parked = 0;                                                 \
+        g_rt->sched_runnable_seq++;                                      \
+    } while (0)
+
+/* -------------------------------------------------------------------
+ * Channel readiness and storage
+ *
+ * asx_channel_ready_rebuild() recomputes every channel's readiness
+ * bit from its slot, for code that writes channel slots directly
+ * (warm restart). Select registrations are not rebuilt; the parked
+ * task is re-polled by the idle-round wake.
+ *
+ * asx_channel_storage_attach() gives ch an empty ring for capacity
+ * messages, releasing the one it had. ASX_E_RESOURCE_EXHAUSTED if no
+ * storage is available; ch is then unchanged.
+ * ------------------------------------------------------------------- */
+
+void asx_channel_ready_rebuild(void);
+asx_status asx_channel_storage_attach(asx_channel_slot *ch,
+                                      uint32_t capacity);
+
+/* -------------------------------------------------------------------
+ * Admission control hooks
+ *
+ * Called only when the region's controller is enabled (spawn, reserve)
+ * or a signal is engaged (retire, channel drain), so regions without
+ * one pay a flag test. asx_admission_on_spawn / _on_reserve return
+ * ASX_OK to admit or the refusal status; spawn sheds first under
+ * SHED_OLDEST, reserve defers instead. _on_task_retire /
+ * _on_channel_drain re-check the signal after its load fell and
+ * release it below release_pct.
+ * ------------------------------------------------------------------- */
+
+asx_status asx_admission_on_spawn(asx_region_slot *r);
+asx_status asx_admission_on_reserve(asx_channel_slot *ch);
+void asx_admission_on_task_retire(asx_region_slot *r);
+void asx_admission_on_channel_drain(asx_channel_slot *ch);
+
+/* -------------------------------------------------------------------
+ * Region tree helpers
+ *
+ * asx_region_subtree_next() yields the pre-order successor of idx
+ * within the subtree rooted at root (ASX_REGION_LINK_NONE when done);
+ * children are visited in open order. asx_region_detach_closed()
+ * unlinks a region that just reached CLOSED from its parent and
+ * updates ancestor subtree counters.
+ * ------------------------------------------------------------------- */
+
+uint32_t asx_region_subtree_next(uint32_t root, uint32_t idx);
+void asx_region_detach_closed(asx_region_slot *r);
+asx_region_id asx_region_handle_at(uint32_t idx);
+
+/* -------------------------------------------------------------------
+ * Region capture chunks
+ *
+ * asx_region_capture_release() returns every chunk owned by the
+ * region to the global pool in O(chunks) and zeroes its quota usage.
+ * asx_region_capture_headroom() is the largest allocation the region
+ * could satisfy right now.
+ * ------------------------------------------------------------------- */
+
+void asx_region_capture_release(asx_region_slot *r);
+uint32_t asx_region_capture_headroom(const asx_region_slot *r);
+
+/* Allocate size bytes of captured state in r's arena for a task being
+ * restored from an image (restart.c). NULL if the quota or capture
+ * memory is exhausted. */
+void *asx_region_capture_restore(asx_region_slot *r, uint32_t size);
+
+/* Free every hook-allocated chunk left in the current instance's pool.
+ * Used when an instance is destroyed, after asx_runtime_reset(). */
+void asx_capture_pool_drain(void);
+
+/* -------------------------------------------------------------------
+ * Wake handles (wake.c)
+ *
+ * asx_wake_drain_region() drains every handle bound to the region in
+ * FIFO order (called by the scheduler at the start of each round).
+ * asx_wake_region_bound() / asx_wake_region_pending() let an idle wait
+ * watch the region's inboxes. asx_wake_registry_reset() unbinds all
+ * handles of the current instance.
+ * ------------------------------------------------------------------- */
+
+void asx_wake_drain_region(asx_region_id region);
+int asx_wake_region_bound(asx_region_id region);
+int asx_wake_region_pending(asx_region_id region);
+void asx_wake_registry_reset(void);
+
+/* -------------------------------------------------------------------
+ * Trace pipeline (trace.c; views in scheduler.c and event.c)
+ *
+ * asx_trace_record() is the single write path: it appends one record
+ * to the trace ring and bumps the count of each view the kind belongs
+ * to. Scheduler records the full ring drops are copied to the
+ * scheduler spill instead. asx_trace_view_find() resolves the
+ * index-th record of a view (NULL past the retained ring). The
+ * *_member predicates give the kinds each view holds.
+ * ------------------------------------------------------------------- */
+
+void asx_trace_record(asx_trace_event_kind kind, uint64_t entity_id,
+                      uint64_t aux, asx_status status);
+void asx_trace_view_restart(asx_trace_view *v);
+const asx_trace_event *asx_trace_view_find(asx_trace_view *v,
+                                           uint32_t index,
+                                           int (*member)(asx_trace_event_kind));
+int asx_sched_view_member(asx_trace_event_kind kind);
+int asx_event_view_member(asx_trace_event_kind kind);
+
+/* -------------------------------------------------------------------
+ * Snapshot change tracking (snapshot.c)
+ *
+ * Any write to a field an asx_runtime_snapshot record carries (state,
+ * task counts, poison flag, outcome, liveness) marks the slot with
+ * ASX_SNAP_MARK_*; asx_region_task_retire marks both the task and
+ * its region. A mark only sets bits; snapshot updates and the state
+ * digest read the slot later. asx_snapshot_tracking_reset() forgets
+ * all tracking (after asx_runtime_reset).
+ * ------------------------------------------------------------------- */
+
+#define ASX_SNAP_MARK(set, idx)                                          \
+    do {                                                                 \
+        uint32_t snap_i_ = (uint32_t)(idx);                              \
+        g_rt->snap_delta.set[snap_i_ >> 5] |= 1u << (snap_i_ & 31u);    \
+        g_rt->snap_pending.set[snap_i_ >> 5] |= 1u << (snap_i_ & 31u);  \
+    } while (0)
+
+#define ASX_SNAP_MARK_REGION(r)     ASX_SNAP_MARK(regions, (r) - g_regions)
+#define ASX_SNAP_MARK_TASK(t)       ASX_SNAP_MARK(tasks, (t) - g_tasks)
+#define ASX_SNAP_MARK_OBLIGATION(o) \
+    ASX_SNAP_MARK(obligations, (o) - g_obligations)
+
+void asx_snapshot_tracking_reset(void);
+
+/* -------------------------------------------------------------------
+ * Spin-wait hint
+ *
+ * ASX_CPU_RELAX() tells the core a busy-wait loop is spinning (x86
+ * pause, ARM yield); a no-op elsewhere.
+ * ------------------------------------------------------------------- */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ASX_CPU_RELAX() __asm__ __volatile__("pause")
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+#define ASX_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define ASX_CPU_RELAX() ((void)0)
+#endif
+
 #endif /* ASX_RUNTIME_INTERNAL_H */
@@ -2,12 +2,19 @@
  * scheduler.c — deterministic scheduler loop with event sequencing
  *
  * Round-robin scheduler that polls all non-completed tasks in arena
- * index order (deterministic tie-break). Emits a monotonic event
- * sequence for replay identity verification.
+ * index order (deterministic tie-break). Each round walks the region's
+ * live-task list, so cost is proportional to the region's own tasks
+ * rather than the whole task arena. Emits a monotonic event
+ * sequence (a view over the trace ring) for replay identity
+ * verification.
  *
  * Tie-break rule: tasks are polled in ascending arena index within
  * each round. This ordering is stable and deterministic for any
- * given input and seed.
+ * given input and seed. Other policies:
+ *   EDF   each round in (deadline, priority, arena index) order
+ *   FAIR  one task per round, the runnable task with the least
+ *         weighted virtual time (then arena index), taken from a
+ *         ready heap kept across rounds
  *
  * SPDX-License-Identifier: MIT
  */
@@ -17,69 +24,788 @@
 #include <asx/runtime/trace.h>
 #include <asx/core/transition.h>
 #include <asx/core/cancel.h>
+#include <asx/runtime/automotive_instrument.h>
+#include <asx/runtime/hft_instrument.h>
 #include "runtime_internal.h"
 
 /* -------------------------------------------------------------------
- * Event log (ring buffer for deterministic sequencing)
+ * Event log: the scheduler view over the trace ring
+ *
+ * Scheduler actions are recorded once, as trace records; the event
+ * log reads them back from the position of the current run. Once the
+ * ring is full the run's records land in the scheduler spill, so at
+ * least ASX_SCHED_SPILL_CAPACITY events of every run stay readable.
  * ------------------------------------------------------------------- */
 
-#define ASX_SCHED_EVENT_LOG_CAPACITY 256u
-
-static asx_scheduler_event g_event_log[ASX_SCHED_EVENT_LOG_CAPACITY];
-static uint32_t g_event_count = 0;
+#define g_sched_view (g_rt->sched_view)
 
-static void sched_emit(asx_scheduler_event_kind kind,
+static void sched_emit(asx_trace_event_kind kind,
                        asx_task_id tid,
                        uint32_t round)
 {
-    if (g_event_count < ASX_SCHED_EVENT_LOG_CAPACITY) {
-        asx_scheduler_event *e = &g_event_log[g_event_count];
-        e->kind = kind;
-        e->task_id = tid;
-        e->sequence = g_event_count;
-        e->round = round;
-    }
-    g_event_count++;
+    asx_trace_record(kind, (uint64_t)tid, round, ASX_OK);
 }
 
 uint32_t asx_scheduler_event_count(void)
 {
-    return g_event_count;
+    return g_sched_view.count;
 }
 
 int asx_scheduler_event_get(uint32_t index, asx_scheduler_event *out)
 {
+    const asx_trace_event *e;
+
     if (out == NULL) return 0;
-    if (index >= g_event_count) return 0;
-    if (index >= ASX_SCHED_EVENT_LOG_CAPACITY) return 0;
-    *out = g_event_log[index];
+    if (index < g_sched_view.in_ring) {
+        e = asx_trace_view_find(&g_sched_view, index, asx_sched_view_member);
+    } else if (index < g_sched_view.count
+               && index - g_sched_view.in_ring < ASX_SCHED_SPILL_CAPACITY) {
+        e = &g_rt->sched_spill[index - g_sched_view.in_ring];
+    } else {
+        e = NULL;
+    }
+    if (e == NULL) return 0;
+
+    switch (e->kind) {
+    case ASX_TRACE_SCHED_POLL:
+        out->kind = ASX_SCHED_EVENT_POLL;
+        break;
+    case ASX_TRACE_SCHED_COMPLETE:
+        out->kind = e->status == ASX_E_CANCELLED
+                    ? ASX_SCHED_EVENT_CANCEL_FORCED
+                    : ASX_SCHED_EVENT_COMPLETE;
+        break;
+    case ASX_TRACE_SCHED_BUDGET:
+        out->kind = ASX_SCHED_EVENT_BUDGET;
+        break;
+    case ASX_TRACE_SCHED_QUIESCENT:
+        out->kind = ASX_SCHED_EVENT_QUIESCENT;
+        break;
+    case ASX_TRACE_SCHED_ROUND:
+    case ASX_TRACE_REGION_OPEN:
+    case ASX_TRACE_REGION_CLOSE:
+    case ASX_TRACE_REGION_CLOSED:
+    case ASX_TRACE_TASK_SPAWN:
+    case ASX_TRACE_TASK_TRANSITION:
+    case ASX_TRACE_DRAIN_BEGIN:
+    case ASX_TRACE_DRAIN_END:
+    case ASX_TRACE_OBLIGATION_RESERVE:
+    case ASX_TRACE_OBLIGATION_COMMIT:
+    case ASX_TRACE_OBLIGATION_ABORT:
+    case ASX_TRACE_OBLIGATION_COMMIT_RANGE:
+    case ASX_TRACE_OBLIGATION_ABORT_RANGE:
+    case ASX_TRACE_CHANNEL_SEND:
+    case ASX_TRACE_CHANNEL_RECV:
+    case ASX_TRACE_TIMER_SET:
+    case ASX_TRACE_TIMER_FIRE:
+    case ASX_TRACE_TIMER_CANCEL:
+    default:
+        return 0; /* not in the scheduler view */
+    }
+    out->task_id = (asx_task_id)e->entity_id;
+    out->sequence = index;
+    out->round = (uint32_t)e->aux;
     return 1;
 }
 
 void asx_scheduler_event_reset(void)
 {
-    g_event_count = 0;
+    asx_trace_view_restart(&g_sched_view);
 }
 
 /* -------------------------------------------------------------------
  * Task captured-state release
  * ------------------------------------------------------------------- */
 
-static void asx_task_release_capture(asx_task_slot *task)
+static void asx_task_release_capture(asx_task_cold *tc)
+{
+    if (tc->captured_state == NULL) return;
+    if (tc->captured_dtor != NULL) {
+        tc->captured_dtor(tc->captured_state, tc->captured_size);
+    }
+    tc->captured_dtor = NULL;
+    tc->captured_state = NULL;
+    tc->captured_size = 0;
+}
+
+/* -------------------------------------------------------------------
+ * Task parking (wait/wake)
+ * ------------------------------------------------------------------- */
+
+void asx_task_park(asx_task_slot *t, uint32_t awaited_idx, asx_time wake_at)
+{
+    /* A delivered cancel must be observed (checkpoint) before parking */
+    if (t->state == ASX_TASK_CANCEL_REQUESTED) return;
+    if (awaited_idx != ASX_TASK_LINK_NONE) {
+        g_task_cold[awaited_idx].waiter = (uint32_t)(t - g_tasks);
+    }
+    t->parked = 1;
+    t->wake_at = wake_at;
+}
+
+void asx_task_discard(uint32_t task_idx)
+{
+    asx_task_slot *t = &g_tasks[task_idx];
+    asx_task_cold *tc = &g_task_cold[task_idx];
+    asx_task_id tid;
+
+    tid = asx_handle_pack(ASX_TYPE_TASK,
+                          (uint16_t)(1u << (unsigned)t->state),
+                          asx_handle_pack_index(t->generation,
+                                                (uint16_t)task_idx));
+    (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
+    t->state = ASX_TASK_COMPLETED;
+    t->parked = 0;
+    tc->waiter = ASX_TASK_LINK_NONE;
+    tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+    asx_task_release_capture(tc);
+    asx_region_task_retire(&g_regions[asx_handle_slot(tc->region)], task_idx);
+}
+
+asx_status asx_task_await(asx_task_id self, asx_task_id child)
+{
+    asx_task_slot *me;
+    asx_task_slot *c;
+    asx_status st;
+    uint32_t self_idx;
+    uint32_t waiter;
+
+    st = asx_task_slot_lookup(self, &me);
+    if (st != ASX_OK) return st;
+    st = asx_task_slot_lookup(child, &c);
+    if (st != ASX_OK) return st;
+    if (me == c) return ASX_E_INVALID_ARGUMENT;
+
+    if (asx_task_is_terminal(c->state)) return ASX_OK;
+
+    self_idx = (uint32_t)(me - g_tasks);
+    waiter = ASX_TASK_COLD(c)->waiter;
+    if (waiter != ASX_TASK_LINK_NONE && waiter != self_idx) {
+        return ASX_E_INVALID_STATE;
+    }
+
+    asx_task_park(me, (uint32_t)(c - g_tasks), 0);
+    return ASX_E_PENDING;
+}
+
+/* Parked task with an expired wake deadline becomes runnable. A clock
+ * read failure leaves it parked; the idle-round wake still applies. */
+static int asx_task_wake_due(const asx_task_slot *t)
+{
+    asx_time now;
+
+    if (t->wake_at == 0) return 0;
+    if (asx_runtime_now_ns(&now) != ASX_OK) return 0;
+    return now >= t->wake_at;
+}
+
+/* -------------------------------------------------------------------
+ * Scheduling policy and deadline monitor
+ * ------------------------------------------------------------------- */
+
+#define g_sched_policy     (g_rt->sched_policy)
+#define g_deadline_monitor (g_rt->deadline_monitor)
+
+asx_status asx_scheduler_set_policy(asx_sched_policy policy)
+{
+    switch (policy) {
+    case ASX_SCHED_POLICY_ARENA_ORDER:
+    case ASX_SCHED_POLICY_EDF:
+    case ASX_SCHED_POLICY_FAIR:
+        g_sched_policy = policy;
+        return ASX_OK;
+    }
+    return ASX_E_INVALID_ARGUMENT;
+}
+
+asx_sched_policy asx_scheduler_get_policy(void)
+{
+    return g_sched_policy;
+}
+
+void asx_scheduler_set_deadline_monitor(int enabled)
+{
+    g_deadline_monitor = enabled ? 1 : 0;
+}
+
+asx_status asx_task_set_budget(asx_task_id id, const asx_budget *budget)
+{
+    asx_task_slot *t;
+    asx_status st;
+
+    if (budget == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = asx_task_slot_lookup(id, &t);
+    if (st != ASX_OK) return st;
+    if (asx_task_is_terminal(t->state)) return ASX_E_INVALID_STATE;
+
+    t->deadline = budget->deadline;
+    t->priority = budget->priority;
+    ASX_TASK_COLD(t)->deadline_reported = 0;
+    return ASX_OK;
+}
+
+asx_status asx_task_report_cost(asx_task_id self, uint64_t cost)
+{
+    asx_task_slot *t;
+    asx_task_cold *tc;
+    asx_status st;
+
+    if (cost == 0) return ASX_E_INVALID_ARGUMENT;
+    st = asx_task_slot_lookup(self, &t);
+    if (st != ASX_OK) return st;
+    if (asx_task_is_terminal(t->state)) return ASX_E_INVALID_STATE;
+
+    tc = ASX_TASK_COLD(t);
+    tc->poll_cost = cost;
+    tc->cost_reported = 1;
+    return ASX_OK;
+}
+
+/* Report a task's deadline outcome once: a miss as soon as the clock
+ * passes the deadline, otherwise a hit (or late miss) on completion. */
+static void sched_deadline_check(const asx_task_slot *t, asx_task_cold *tc,
+                                 asx_task_id tid, int completed)
+{
+    asx_budget b;
+    asx_time now;
+
+    if (!g_deadline_monitor || t->deadline == 0 || tc->deadline_reported) {
+        return;
+    }
+    if (asx_runtime_now_ns(&now) != ASX_OK) return;
+
+    /* The tracker scores completion exactly at the deadline as a hit,
+     * so a running task is only reported once strictly late. */
+    b = asx_budget_infinite();
+    b.deadline = t->deadline;
+    if (completed
+        || (asx_budget_is_past_deadline(&b, now) && now != t->deadline)) {
+        asx_auto_record_deadline(t->deadline, now, (uint64_t)tid);
+        tc->deadline_reported = 1;
+    }
+}
+
+/* -------------------------------------------------------------------
+ * Ready heap (4-ary)
+ *
+ * EDF: min on (deadline, priority, arena index), rebuilt from the
+ * region's live-task list at the start of each round. A zero deadline
+ * sorts after every finite deadline; arena index is the final,
+ * deterministic tie-break. Each EDF run keeps its heap on its own
+ * stack, so a run nested in a poll cannot disturb it.
+ *
+ * FAIR: min on (vtime, arena index), kept across rounds in the
+ * instance's ready_heap (see the fair queueing section below).
+ * ------------------------------------------------------------------- */
+
+#define ASX_SCHED_HEAP_ARITY 4u
+
+#define g_ready_heap (g_rt->ready_heap)
+#define g_ready_len  (g_rt->ready_len)
+
+static int sched_before(uint32_t a, uint32_t b)
 {
-    if (task->captured_dtor != NULL && task->captured_state != NULL) {
-        task->captured_dtor(task->captured_state, task->captured_size);
+    const asx_task_slot *ta = &g_tasks[a];
+    const asx_task_slot *tb = &g_tasks[b];
+    asx_time da = ta->deadline == 0 ? UINT64_MAX : ta->deadline;
+    asx_time db = tb->deadline == 0 ? UINT64_MAX : tb->deadline;
+
+    /* FAIR keys the same heap on (vtime, arena index) */
+    if (g_sched_policy == ASX_SCHED_POLICY_FAIR) {
+        if (ta->vtime != tb->vtime) return ta->vtime < tb->vtime;
+        return a < b;
+    }
+    if (da != db) return da < db;
+    if (ta->priority != tb->priority) return ta->priority < tb->priority;
+    return a < b;
+}
+
+static void sched_heap_push(uint32_t *heap, uint32_t *len, uint32_t idx)
+{
+    uint32_t pos = (*len)++;
+
+    while (pos > 0) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: heap sift-up bounded by "
+                              "log4(ASX_MAX_TASKS)");
+        uint32_t parent = (pos - 1u) / ASX_SCHED_HEAP_ARITY;
+        if (!sched_before(idx, heap[parent])) break;
+        heap[pos] = heap[parent];
+        pos = parent;
+    }
+    heap[pos] = idx;
+}
+
+static uint32_t sched_heap_pop(uint32_t *heap, uint32_t *len)
+{
+    uint32_t top = heap[0];
+    uint32_t last = heap[--(*len)];
+    uint32_t pos = 0;
+
+    for (;;) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: heap sift-down bounded by "
+                              "log4(ASX_MAX_TASKS)");
+        uint32_t first = pos * ASX_SCHED_HEAP_ARITY + 1u;
+        uint32_t best = ASX_TASK_LINK_NONE;
+        uint32_t c;
+
+        for (c = first; c < first + ASX_SCHED_HEAP_ARITY && c < *len; c++) {
+            ASX_CHECKPOINT_WAIVER("kernel-scheduler: fixed heap arity");
+            if (best == ASX_TASK_LINK_NONE
+                || sched_before(heap[c], heap[best])) {
+                best = c;
+            }
+        }
+        if (best == ASX_TASK_LINK_NONE
+            || !sched_before(heap[best], last)) {
+            break;
+        }
+        heap[pos] = heap[best];
+        pos = best;
+    }
+    if (*len > 0) heap[pos] = last;
+    return top;
+}
+
+/* -------------------------------------------------------------------
+ * Fair queueing: cost charging and virtual-time selection
+ * ------------------------------------------------------------------- */
+
+static uint64_t sched_sat_add(uint64_t a, uint64_t b)
+{
+    return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+/* Charge one poll's cost to the task (weighted by priority), to its
+ * region and every ancestor, and to the scheduler budget. A cost the
+ * quota cannot cover spends the quota, so the next round reports
+ * exhaustion. */
+static void sched_charge(asx_region_slot *rslot, asx_task_slot *t,
+                         uint64_t cost, asx_budget *budget)
+{
+    uint64_t weight = (uint64_t)t->priority + 1u;
+    uint32_t ri;
+
+    if (cost == 0) cost = 1;
+    t->vtime = sched_sat_add(t->vtime,
+                             cost > UINT64_MAX / weight ? UINT64_MAX
+                                                        : cost * weight);
+    rslot->vtime = sched_sat_add(rslot->vtime, cost);
+    for (ri = rslot->parent; ri != ASX_REGION_LINK_NONE;
+         ri = g_regions[ri].parent) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: ancestor walk bounded by "
+                              "tree depth <= ASX_MAX_REGIONS");
+        g_regions[ri].vtime = sched_sat_add(g_regions[ri].vtime, cost);
+    }
+    if (!asx_budget_consume_cost(budget, cost)) {
+        budget->cost_quota = 0;
+    }
+}
+
+/* The FAIR ready heap holds the region's runnable tasks and survives
+ * across rounds: each round pops the least (vtime, arena index) and
+ * the task goes back in once charged, so a poll costs O(log n).
+ * Tasks found parked drop out. The heap is rebuilt from the live-task
+ * list only when the runnable set may have grown: a task was spawned
+ * or unparked (sched_runnable_seq moved), a dropped task's wake_at
+ * has passed, or a nested run took the heap (ready_owner). */
+typedef struct {
+    uint32_t serial;    /* this run's ready_owner token */
+    uint32_t seq;       /* sched_runnable_seq at the last rebuild */
+    asx_time wake_min;  /* earliest wake_at of a dropped task, 0 = none */
+} sched_fair_state;
+
+static void sched_fair_drop(sched_fair_state *fs, const asx_task_slot *t)
+{
+    if (t->wake_at != 0 && (fs->wake_min == 0 || t->wake_at < fs->wake_min)) {
+        fs->wake_min = t->wake_at;
+    }
+}
+
+static void sched_fair_rebuild(const asx_region_slot *rslot,
+                               sched_fair_state *fs)
+{
+    uint32_t i;
+
+    g_ready_len = 0;
+    g_rt->ready_owner = fs->serial;
+    fs->seq = g_rt->sched_runnable_seq;
+    fs->wake_min = 0;
+    for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+         i = g_tasks[i].region_next) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: fair heap rebuild bounded by "
+                              "region live tasks <= ASX_MAX_TASKS");
+        if (g_tasks[i].parked && !asx_task_wake_due(&g_tasks[i])) {
+            sched_fair_drop(fs, &g_tasks[i]);
+        } else {
+            sched_heap_push(g_ready_heap, &g_ready_len, i);
+        }
+    }
+}
+
+/* Runnable task with the least (vtime, arena index), or
+ * ASX_TASK_LINK_NONE if every live task is parked. */
+static uint32_t sched_fair_next(const asx_region_slot *rslot,
+                                sched_fair_state *fs)
+{
+    asx_time now;
+    uint32_t i;
+
+    if (g_rt->ready_owner != fs->serial
+        || fs->seq != g_rt->sched_runnable_seq
+        || (fs->wake_min != 0 && asx_runtime_now_ns(&now) == ASX_OK
+            && now >= fs->wake_min)) {
+        sched_fair_rebuild(rslot, fs);
+    }
+    while (g_ready_len > 0) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: each pop removes a heap "
+                              "entry; bounded by region live tasks");
+        i = sched_heap_pop(g_ready_heap, &g_ready_len);
+        if (asx_task_is_terminal(g_tasks[i].state)) continue;
+        if (g_tasks[i].parked && !asx_task_wake_due(&g_tasks[i])) {
+            sched_fair_drop(fs, &g_tasks[i]);
+            continue;
+        }
+        return i;
+    }
+    return ASX_TASK_LINK_NONE;
+}
+
+/* -------------------------------------------------------------------
+ * Scheduler: visit one task
+ *
+ * Applies cancel-phase handling, consumes a poll unit and polls the
+ * task at arena index i. Updates *active / *parked for the round.
+ * Returns 0 to continue, 1 if the poll budget ran out.
+ * ------------------------------------------------------------------- */
+
+static int sched_visit(asx_region_id region, asx_region_slot *rslot,
+                       uint32_t i, asx_budget *budget, uint32_t round,
+                       uint32_t *active, uint32_t *parked)
+{
+    asx_task_slot *t = &g_tasks[i];
+    asx_task_cold *tc = &g_task_cold[i];
+    asx_task_id tid;
+    asx_status poll_result;
+    asx_time t0 = 0;
+    asx_time t1 = 0;
+    int timed = 0;
+
+    if (asx_task_is_terminal(t->state)) return 0;
+
+    (*active)++;
+
+    /* Parked tasks are skipped until woken (no poll consumed) */
+    if (t->parked) {
+        if (!asx_task_wake_due(t)) {
+            (*parked)++;
+            return 0;
+        }
+        t->parked = 0;
+        t->wake_at = 0;
+    }
+
+    /* Build task handle for poll callback */
+    tid = asx_handle_pack(ASX_TYPE_TASK,
+                          (uint16_t)(1u << (unsigned)t->state),
+                          asx_handle_pack_index(
+                              t->generation, (uint16_t)i));
+
+    /* ----------------------------------------------------------
+     * Cancel-phase scheduler integration (bd-2cw.3)
+     *
+     * FINALIZING: task called asx_task_finalize() — cleanup is
+     * done. Complete without consuming a poll unit.
+     *
+     * CANCELLING + budget exhausted: force-complete with
+     * CANCELLED outcome. This ensures bounded cleanup.
+     * ---------------------------------------------------------- */
+    if (t->state == ASX_TASK_FINALIZING) {
+        (void)asx_ghost_check_task_transition(tid, t->state,
+                                              ASX_TASK_COMPLETED);
+        t->state = ASX_TASK_COMPLETED;
+        tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+        asx_task_release_capture(tc);
+        asx_region_task_retire(rslot, i);
+        (*active)--;
+        sched_emit(ASX_TRACE_SCHED_COMPLETE, tid, round);
+        return 0;
+    }
+
+    if (t->cancel_pending &&
+        (t->state == ASX_TASK_CANCELLING ||
+         t->state == ASX_TASK_CANCEL_REQUESTED) &&
+        tc->cleanup_polls_remaining == 0) {
+        /* Force-complete: cleanup budget exhausted. The task
+         * either never called checkpoint (CANCEL_REQUESTED)
+         * or ran out of cleanup polls (CANCELLING). */
+        if (t->state == ASX_TASK_CANCEL_REQUESTED) {
+            (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_CANCELLING);
+            t->state = ASX_TASK_CANCELLING;
+            tc->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
+        }
+        (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_FINALIZING);
+        t->state = ASX_TASK_FINALIZING;
+        tc->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
+        (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
+        t->state = ASX_TASK_COMPLETED;
+        tc->cancel_phase = ASX_CANCEL_PHASE_COMPLETED;
+        tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+        asx_task_release_capture(tc);
+        asx_region_task_retire(rslot, i);
+        (*active)--;
+        asx_trace_record(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round,
+                         ASX_E_CANCELLED);
+        return 0;
+    }
+
+    /* Consume one poll unit */
+    if (asx_budget_consume_poll(budget) == 0) {
+        sched_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, round);
+        return 1;
+    }
+
+    /* Transition Created → Running on first poll */
+    if (t->state == ASX_TASK_CREATED) {
+        t->state = ASX_TASK_RUNNING;
+        ASX_SNAP_MARK_TASK(t);
+    }
+
+    sched_deadline_check(t, tc, tid, 0);
+
+    /* Emit poll event */
+    sched_emit(ASX_TRACE_SCHED_POLL, tid, round);
+
+    /* Call the task's poll function. Under FAIR an unreported cost
+     * counts one poll in deterministic builds, so ordering never
+     * depends on the clock; otherwise the poll is bracketed with the
+     * clock and the delta is charged. */
+    if (g_sched_policy == ASX_SCHED_POLICY_FAIR) {
+        tc->cost_reported = 0;
+#if !ASX_DETERMINISTIC
+        timed = asx_runtime_now_ns(&t0) == ASX_OK;
+#endif
+    }
+    asx_error_ledger_bind_task(tid);
+    poll_result = t->poll_fn(t->user_data, tid);
+    asx_error_ledger_bind_task(ASX_INVALID_ID);
+    if (g_sched_policy == ASX_SCHED_POLICY_FAIR) {
+        rslot->vclock = t->vtime;
+        if (tc->cost_reported) {
+            sched_charge(rslot, t, tc->poll_cost, budget);
+        } else if (timed && asx_runtime_now_ns(&t1) == ASX_OK && t1 > t0) {
+            sched_charge(rslot, t, t1 - t0, budget);
+        } else {
+            sched_charge(rslot, t, 1, budget);
+        }
+    }
+
+    if (poll_result == ASX_OK) {
+        /* Task completed — set outcome based on cancel state */
+        (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
+        t->state = ASX_TASK_COMPLETED;
+        if (t->cancel_pending) {
+            tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+        } else if (tc->has_outcome_override) {
+            tc->outcome = tc->outcome_override;
+        } else {
+            tc->outcome = asx_outcome_make(ASX_OUTCOME_OK);
+        }
+        sched_deadline_check(t, tc, tid, 1);
+        asx_task_release_capture(tc);
+        asx_region_task_retire(rslot, i);
+        (*active)--;
+        sched_emit(ASX_TRACE_SCHED_COMPLETE, tid, round);
+    } else if (poll_result != ASX_E_PENDING) {
+        /* Task failed — mark as completed with error.
+         * If cancel was pending, outcome joins to CANCELLED
+         * since CANCELLED > ERR in the severity lattice. */
+        (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
+        t->state = ASX_TASK_COMPLETED;
+        if (t->cancel_pending) {
+            tc->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
+        } else {
+            tc->outcome = asx_outcome_make(ASX_OUTCOME_ERR);
+        }
+        sched_deadline_check(t, tc, tid, 1);
+        asx_task_release_capture(tc);
+        asx_region_task_retire(rslot, i);
+        (*active)--;
+        sched_emit(ASX_TRACE_SCHED_COMPLETE, tid, round);
+
+        /* Apply fault containment policy (bd-hwb.15).
+         * In POISON_REGION mode this poisons the region,
+         * blocking further spawn/close. The scheduler
+         * continues draining existing tasks. */
+        {
+            asx_status fc_ = asx_region_contain_fault(region, poll_result);
+            (void)fc_;
+        }
+    } else if (t->cancel_pending) {
+        /* PENDING + cancel active: decrement cleanup budget.
+         * The scheduler is the sole budget enforcer — each
+         * poll of a cancel-phase task consumes one unit. */
+        if (tc->cleanup_polls_remaining > 0) {
+            tc->cleanup_polls_remaining--;
+        }
+    }
+    /* ASX_E_PENDING without cancel: task not ready, continue */
+    return 0;
+}
+
+/* -------------------------------------------------------------------
+ * Idle strategy
+ * ------------------------------------------------------------------- */
+
+#define g_idle_strategy (g_rt->idle_strategy)
+#define g_idle_enabled  (g_rt->idle_enabled)
+#define g_idle_stats    (g_rt->idle_stats)
+
+void asx_scheduler_set_idle_strategy(const asx_idle_strategy *strategy)
+{
+    if (strategy == NULL) {
+        g_idle_enabled = 0;
+        return;
+    }
+    g_idle_strategy = *strategy;
+    g_idle_enabled = 1;
+}
+
+asx_status asx_scheduler_idle_stats(asx_idle_stats *out)
+{
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    *out = g_idle_stats;
+    return ASX_OK;
+}
+
+void asx_scheduler_idle_stats_reset(void)
+{
+    uint32_t i;
+
+    g_idle_stats.waits = 0;
+    for (i = 0; i < ASX_IDLE_WAKE_COUNT; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded by ASX_IDLE_WAKE_COUNT");
+        g_idle_stats.wakes[i] = 0;
+    }
+}
+
+/* Earliest wake deadline among the region's parked tasks, or 0. */
+static asx_time sched_idle_deadline(const asx_region_slot *rslot)
+{
+    asx_time earliest = 0;
+    uint32_t i;
+
+    for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+         i = g_tasks[i].region_next) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: deadline scan bounded by "
+                              "region live tasks <= ASX_MAX_TASKS");
+        if (g_tasks[i].wake_at != 0
+            && (earliest == 0 || g_tasks[i].wake_at < earliest)) {
+            earliest = g_tasks[i].wake_at;
+        }
+    }
+    return earliest;
+}
+
+static int sched_idle_due(asx_time deadline, asx_time *now)
+{
+    if (asx_runtime_clock_peek_ns(now) != ASX_OK) return 0;
+    return deadline != 0 && *now >= deadline;
+}
+
+/* Wait out an idle round: spin, then yield, then park (see
+ * asx_idle_strategy). The park timeout is cut to the earliest wake
+ * deadline or the instance timer wheel's next batch, rounded up to
+ * whole milliseconds. Any phase ends early once a wake handle bound
+ * to the region has pending submissions. Clock reads here peek, so
+ * the wait does not consume fault-injection clock ticks. */
+static void sched_idle_wait(asx_region_id region,
+                            const asx_region_slot *rslot, uint32_t round)
+{
+    const asx_idle_strategy *s = &g_idle_strategy;
+    const asx_runtime_hooks *hooks = asx_runtime_get_hooks();
+    asx_idle_wake woke = ASX_IDLE_WAKE_TIMEOUT;
+    asx_time deadline = sched_idle_deadline(rslot);
+    asx_time start;
+    asx_time now;
+    uint64_t n;
+    uint64_t wait_ms;
+    uint32_t ready = 0;
+    uint32_t timeout_ms;
+    int reactor = hooks != NULL
+               && (hooks->reactor.wait_fn != NULL
+                   || hooks->reactor.ghost_wait_fn != NULL);
+    int wake = asx_wake_region_bound(region);
+
+    if (deadline == 0 && !reactor && !wake) return;
+    if (asx_runtime_clock_peek_ns(&start) != ASX_OK) return;
+    g_idle_stats.waits++;
+    now = start;
+
+    /* Spin: each iteration takes at least a nanosecond, so spin_ns
+     * also bounds the loop when the clock does not advance. */
+    for (n = 0; n < s->spin_ns; n++) {
+        ASX_CHECKPOINT_WAIVER("kernel-scheduler: idle spin bounded by "
+                              "strategy spin_ns");
+        if ((deadline != 0 && now >= deadline)
+            || (wake && asx_wake_region_pending(region))) {
+            woke = ASX_IDLE_WAKE_SPIN;
+            goto done;
+        }
+        if (now - start >= s->spin_ns) break;
+        ASX_CPU_RELAX();
+        if (asx_runtime_clock_peek_ns(&now) != ASX_OK) break;
+    }
+
+    if (reactor) {
+        /* Yield: zero-timeout reactor polls give the OS the core */
+        for (n = 0; n < s->yield_count; n++) {
+            ASX_CHECKPOINT_WAIVER("kernel-scheduler: idle yield bounded by "
+                                  "strategy yield_count");
+            if (asx_runtime_reactor_wait(0, &ready, round) != ASX_OK) break;
+            if (ready > 0 || sched_idle_due(deadline, &now)
+                || (wake && asx_wake_region_pending(region))) {
+                woke = ASX_IDLE_WAKE_YIELD;
+                goto done;
+            }
+        }
+
+        /* Park: one bounded reactor wait */
+        if (s->park_timeout_ms > 0) {
+            timeout_ms = s->park_timeout_ms;
+            if (deadline != 0 && asx_runtime_clock_peek_ns(&now) == ASX_OK) {
+                wait_ms = now >= deadline
+                        ? 0 : (deadline - now + 999999u) / 1000000u;
+                if (wait_ms < timeout_ms) timeout_ms = (uint32_t)wait_ms;
+            }
+            /* Wake no later than the instance wheel's next batch */
+            if (g_rt->wheel_initialized
+                && asx_runtime_clock_peek_ns(&now) == ASX_OK) {
+                timeout_ms = asx_timer_wait_ms(&g_rt->wheel, now, timeout_ms);
+            }
+            if (asx_runtime_reactor_wait(timeout_ms, &ready, round) == ASX_OK
+                && (ready > 0 || sched_idle_due(deadline, &now)
+                    || (wake && asx_wake_region_pending(region)))) {
+                woke = ASX_IDLE_WAKE_PARK;
+            }
+        }
+    }
+
+done:
+    g_idle_stats.wakes[woke]++;
+    if (deadline != 0 && asx_runtime_clock_peek_ns(&now) == ASX_OK
+        && now >= deadline) {
+        asx_hft_record_wake_latency(now - deadline);
     }
-    task->captured_dtor = NULL;
-    task->captured_state = NULL;
-    task->captured_size = 0;
 }
 
 /* -------------------------------------------------------------------
  * Scheduler: run all tasks in a region until completion or budget
  *
- * Ordering invariant: tasks are polled in ascending arena index
- * within each round. This produces a deterministic event stream
+ * Ordering invariant: under ASX_SCHED_POLICY_ARENA_ORDER tasks are
+ * polled in ascending arena index within each round; under
+ * ASX_SCHED_POLICY_EDF in (deadline, priority, arena index) order;
+ * under ASX_SCHED_POLICY_FAIR one task per round in (virtual time,
+ * arena index) order. In every case the event stream is deterministic
  * for any given input and seed combination.
  * ------------------------------------------------------------------- */
 
@@ -87,7 +813,11 @@ asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
 {
     asx_region_slot *rslot;
     asx_status st;
+    sched_fair_state fair;
+    uint32_t edf_heap[ASX_MAX_TASKS];
+    uint32_t edf_len;
     uint32_t active;
+    uint32_t parked;
     uint32_t round;
     uint32_t i;
 
@@ -96,166 +826,110 @@ asx_status asx_scheduler_run(asx_region_id region, asx_budget *budget)
     st = asx_region_slot_lookup(region, &rslot);
     if (st != ASX_OK) return st;
 
+    /* A fresh owner token makes the first FAIR round build the heap */
+    fair.serial = ++g_rt->sched_run_serial;
+    fair.seq = 0;
+    fair.wake_min = 0;
+
     /* Reset event log for this scheduler invocation */
     asx_scheduler_event_reset();
 
-    /* Scheduler loop: round-robin poll until all tasks complete */
+    /* Scheduler loop: one pass over the live tasks per round */
     for (round = 0; ; round++) {
         ASX_CHECKPOINT_WAIVER("kernel-scheduler: this IS the scheduler event loop; "
                               "budget exhaustion provides bounded termination");
         /* Check budget exhaustion */
         if (asx_budget_is_exhausted(budget)) {
-            sched_emit(ASX_SCHED_EVENT_BUDGET, ASX_INVALID_ID, round);
-            asx_trace_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, round);
+            sched_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, round);
             return ASX_E_POLL_BUDGET_EXHAUSTED;
         }
 
+        /* External submissions enter at round boundaries, FIFO */
+        if (g_rt->wake_count > 0) asx_wake_drain_region(region);
+        /* Bounded log drain step, when no drainer thread owns the ring */
+        if (g_rt->log_ring != NULL && g_rt->log_ring->drain_per_round > 0) {
+            (void)asx_log_ring_drain(g_rt->log_ring,
+                                     g_rt->log_ring->drain_per_round);
+        }
+
         active = 0;
+        parked = 0;
 
-        for (i = 0; i < g_task_count; i++) {
-            ASX_CHECKPOINT_WAIVER("kernel-scheduler: inner poll loop bounded by "
-                                  "g_task_count <= ASX_MAX_TASKS arena capacity");
-            asx_task_slot *t = &g_tasks[i];
-            asx_task_id tid;
-            asx_status poll_result;
-
-            if (!t->alive) continue;
-            if (t->region != region) continue;
-            if (asx_task_is_terminal(t->state)) continue;
-
-            active++;
-
-            /* Build task handle for poll callback */
-            tid = asx_handle_pack(ASX_TYPE_TASK,
-                                  (uint16_t)(1u << (unsigned)t->state),
-                                  asx_handle_pack_index(
-                                      t->generation, (uint16_t)i));
-
-            /* ----------------------------------------------------------
-             * Cancel-phase scheduler integration (bd-2cw.3)
-             *
-             * FINALIZING: task called asx_task_finalize() — cleanup is
-             * done. Complete without consuming a poll unit.
-             *
-             * CANCELLING + budget exhausted: force-complete with
-             * CANCELLED outcome. This ensures bounded cleanup.
-             * ---------------------------------------------------------- */
-            if (t->state == ASX_TASK_FINALIZING) {
-                (void)asx_ghost_check_task_transition(tid, t->state,
-                                                      ASX_TASK_COMPLETED);
-                t->state = ASX_TASK_COMPLETED;
-                t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                asx_task_release_capture(t);
-                rslot->task_count--;
-                active--;
-                sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
-                asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
-                continue;
+        if (g_sched_policy == ASX_SCHED_POLICY_EDF) {
+            /* Snapshot the live list into this run's heap; tasks
+             * spawned during the round are picked up by the next one. */
+            edf_len = 0;
+            for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+                 i = g_tasks[i].region_next) {
+                ASX_CHECKPOINT_WAIVER("kernel-scheduler: heap build bounded by "
+                                      "region live tasks <= ASX_MAX_TASKS");
+                sched_heap_push(edf_heap, &edf_len, i);
             }
-
-            if (t->cancel_pending &&
-                (t->state == ASX_TASK_CANCELLING ||
-                 t->state == ASX_TASK_CANCEL_REQUESTED) &&
-                t->cleanup_polls_remaining == 0) {
-                /* Force-complete: cleanup budget exhausted. The task
-                 * either never called checkpoint (CANCEL_REQUESTED)
-                 * or ran out of cleanup polls (CANCELLING). */
-                if (t->state == ASX_TASK_CANCEL_REQUESTED) {
-                    (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_CANCELLING);
-                    t->state = ASX_TASK_CANCELLING;
-                    t->cancel_phase = ASX_CANCEL_PHASE_CANCELLING;
+            while (edf_len > 0) {
+                ASX_CHECKPOINT_WAIVER("kernel-scheduler: drains the ready heap, "
+                                      "bounded by region live tasks");
+                if (sched_visit(region, rslot,
+                                sched_heap_pop(edf_heap, &edf_len), budget,
+                                round, &active, &parked)) {
+                    return ASX_E_POLL_BUDGET_EXHAUSTED;
                 }
-                (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_FINALIZING);
-                t->state = ASX_TASK_FINALIZING;
-                t->cancel_phase = ASX_CANCEL_PHASE_FINALIZING;
-                (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
-                t->state = ASX_TASK_COMPLETED;
-                t->cancel_phase = ASX_CANCEL_PHASE_COMPLETED;
-                t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                asx_task_release_capture(t);
-                rslot->task_count--;
-                active--;
-                sched_emit(ASX_SCHED_EVENT_CANCEL_FORCED, tid, round);
-                asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
-                continue;
             }
+            active = rslot->task_count;
+        } else if (g_sched_policy == ASX_SCHED_POLICY_FAIR) {
+            uint32_t pick = sched_fair_next(rslot, &fair);
 
-            /* Consume one poll unit */
-            if (asx_budget_consume_poll(budget) == 0) {
-                sched_emit(ASX_SCHED_EVENT_BUDGET, ASX_INVALID_ID, round);
-                asx_trace_emit(ASX_TRACE_SCHED_BUDGET, ASX_INVALID_ID, round);
-                return ASX_E_POLL_BUDGET_EXHAUSTED;
-            }
-
-            /* Transition Created → Running on first poll */
-            if (t->state == ASX_TASK_CREATED) {
-                t->state = ASX_TASK_RUNNING;
-            }
-
-            /* Emit poll event */
-            sched_emit(ASX_SCHED_EVENT_POLL, tid, round);
-            asx_trace_emit(ASX_TRACE_SCHED_POLL, (uint64_t)tid, round);
-
-            /* Call the task's poll function */
-            asx_error_ledger_bind_task(tid);
-            poll_result = t->poll_fn(t->user_data, tid);
-            asx_error_ledger_bind_task(ASX_INVALID_ID);
-
-            if (poll_result == ASX_OK) {
-                /* Task completed — set outcome based on cancel state */
-                (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
-                t->state = ASX_TASK_COMPLETED;
-                if (t->cancel_pending) {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                } else {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_OK);
-                }
-                asx_task_release_capture(t);
-                rslot->task_count--;
-                active--;
-                sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
-                asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
-            } else if (poll_result != ASX_E_PENDING) {
-                /* Task failed — mark as completed with error.
-                 * If cancel was pending, outcome joins to CANCELLED
-                 * since CANCELLED > ERR in the severity lattice. */
-                (void)asx_ghost_check_task_transition(tid, t->state, ASX_TASK_COMPLETED);
-                t->state = ASX_TASK_COMPLETED;
-                if (t->cancel_pending) {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_CANCELLED);
-                } else {
-                    t->outcome = asx_outcome_make(ASX_OUTCOME_ERR);
+            if (pick != ASX_TASK_LINK_NONE) {
+                if (sched_visit(region, rslot, pick, budget, round,
+                                &active, &parked)) {
+                    return ASX_E_POLL_BUDGET_EXHAUSTED;
                 }
-                asx_task_release_capture(t);
-                rslot->task_count--;
-                active--;
-                sched_emit(ASX_SCHED_EVENT_COMPLETE, tid, round);
-                asx_trace_emit(ASX_TRACE_SCHED_COMPLETE, (uint64_t)tid, round);
-
-                /* Apply fault containment policy (bd-hwb.15).
-                 * In POISON_REGION mode this poisons the region,
-                 * blocking further spawn/close. The scheduler
-                 * continues draining existing tasks. */
-                {
-                    asx_status fc_ = asx_region_contain_fault(region, poll_result);
-                    (void)fc_;
+                /* Back into the heap unless it finished or parked */
+                if (!asx_task_is_terminal(g_tasks[pick].state)) {
+                    if (g_tasks[pick].parked) {
+                        sched_fair_drop(&fair, &g_tasks[pick]);
+                    } else {
+                        sched_heap_push(g_ready_heap, &g_ready_len, pick);
+                    }
                 }
-            } else if (t->cancel_pending) {
-                /* PENDING + cancel active: decrement cleanup budget.
-                 * The scheduler is the sole budget enforcer — each
-                 * poll of a cancel-phase task consumes one unit. */
-                if (t->cleanup_polls_remaining > 0) {
-                    t->cleanup_polls_remaining--;
+                parked = 0;
+            } else {
+                parked = rslot->task_count;
+            }
+            active = rslot->task_count;
+        } else {
+            /* Walk the region's live-task list. The successor is read
+             * after the body: a retired slot keeps its region_next, and
+             * tasks spawned during this round are appended and polled
+             * in it. */
+            for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+                 i = g_tasks[i].region_next) {
+                ASX_CHECKPOINT_WAIVER("kernel-scheduler: inner poll loop bounded by "
+                                      "region live tasks <= ASX_MAX_TASKS");
+                if (sched_visit(region, rslot, i, budget, round,
+                                &active, &parked)) {
+                    return ASX_E_POLL_BUDGET_EXHAUSTED;
                 }
             }
-            /* ASX_E_PENDING without cancel: task not ready, continue */
         }
 
         /* No active tasks left — quiescent */
         if (active == 0) {
-            sched_emit(ASX_SCHED_EVENT_QUIESCENT, ASX_INVALID_ID, round);
-            asx_trace_emit(ASX_TRACE_SCHED_QUIESCENT, ASX_INVALID_ID, round);
+            sched_emit(ASX_TRACE_SCHED_QUIESCENT, ASX_INVALID_ID, round);
             return ASX_OK;
         }
+
+        /* Idle round: every live task is parked, so nothing in this
+         * region can wake them. Wake all so waits on other regions or
+         * the clock re-evaluate; the poll budget still bounds the loop.
+         * An idle strategy first waits for a wake deadline or I/O. */
+        if (parked == active) {
+            if (g_idle_enabled) sched_idle_wait(region, rslot, round);
+            for (i = rslot->task_head; i != ASX_TASK_LINK_NONE;
+                 i = g_tasks[i].region_next) {
+                ASX_CHECKPOINT_WAIVER("kernel-scheduler: idle wake bounded by "
+                                      "region live tasks <= ASX_MAX_TASKS");
+                ASX_TASK_UNPARK(&g_tasks[i]);
+            }
+        }
     }
 }
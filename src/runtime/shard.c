@@ -0,0 +1,421 @@
+/*
+ * shard.c — shard-per-core deployment with cross-shard SPSC rings
+ *
+ * Each shard owns one asx_runtime instance and is only ever stepped by
+ * one thread at a time, so everything inside a shard runs through the
+ * ordinary single-threaded kernel. The only memory shared between
+ * shards is the ring array and the done/stop flags, published with
+ * acquire/release ordering.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("shard driver: loops are bounded by "
+ *   "ASX_MAX_SHARDS, except the step loops, which end when every shard "
+ *   "is done; each step runs one budgeted asx_scheduler_run slice; and "
+ *   "the root drain loop, which stops on any slice that polls nothing.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/core/affinity.h>
+#include <asx/runtime/shard.h>
+#include <string.h>
+
+/* -------------------------------------------------------------------
+ * Publication primitives
+ * ------------------------------------------------------------------- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SHARD_LOAD_ACQ(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SHARD_STORE_REL(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+/* Volatile-only fallback: sufficient for inline mode and for strongly
+ * ordered targets; threaded shards need the builtins above. */
+#define SHARD_LOAD_ACQ(p)     (*(p))
+#define SHARD_STORE_REL(p, v) (*(p) = (v))
+#endif
+
+#define SHARD_RING_MASK (ASX_SHARD_RING_CAPACITY - 1u)
+
+#define SHARD_FNV_OFFSET 14695981039346656037ULL
+#define SHARD_FNV_PRIME  1099511628211ULL
+
+/* -------------------------------------------------------------------
+ * Configuration and lifecycle
+ * ------------------------------------------------------------------- */
+
+void asx_shard_config_init(asx_shard_config *cfg)
+{
+    if (cfg == NULL) return;
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->shard_count = 1;
+    cfg->resource_class = ASX_CLASS_R2;
+    cfg->poll_quantum = ASX_SHARD_DEFAULT_QUANTUM;
+}
+
+asx_status asx_shard_group_init(asx_shard_group *group,
+                                const asx_shard_config *cfg)
+{
+    asx_status st;
+    uint32_t i;
+
+    if (group == NULL || cfg == NULL || cfg->setup_fn == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (cfg->shard_count == 0 || cfg->shard_count > ASX_MAX_SHARDS
+        || cfg->poll_quantum == 0) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (cfg->threads.start_fn != NULL && cfg->threads.join_fn == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    memset(group, 0, sizeof(*group));
+    group->config = *cfg;
+    for (i = 0; i < cfg->shard_count; i++) {
+        asx_shard *s = &group->shards[i];
+
+        s->group = group;
+        s->index = i;
+        s->root = ASX_INVALID_ID;
+        s->status = ASX_OK;
+        st = asx_runtime_create(cfg->hooks, cfg->resource_class, &s->rt);
+        if (st != ASX_OK) {
+            asx_shard_group_destroy(group);
+            return st;
+        }
+    }
+    group->initialized = 1;
+    return ASX_OK;
+}
+
+void asx_shard_group_destroy(asx_shard_group *group)
+{
+    uint32_t i;
+
+    if (group == NULL) return;
+    for (i = 0; i < ASX_MAX_SHARDS; i++) {
+        if (group->shards[i].rt != NULL) {
+            asx_runtime_destroy(group->shards[i].rt);
+            group->shards[i].rt = NULL;
+        }
+    }
+    group->initialized = 0;
+}
+
+void asx_shard_group_stop(asx_shard_group *group)
+{
+    if (group == NULL) return;
+    SHARD_STORE_REL(&group->stop, 1);
+}
+
+/* -------------------------------------------------------------------
+ * Shard stepping
+ * ------------------------------------------------------------------- */
+
+/* Drain the root region, record the trace digest and publish done.
+ * The drain runs in poll_quantum slices until the root is CLOSED,
+ * spending at most poll_budget polls (unbounded when 0); it stops
+ * early only on a hard error or a slice that polls nothing.
+ * Runs with the shard's instance current. */
+static void shard_finish(asx_shard *s, asx_status st)
+{
+    const asx_shard_config *cfg = &s->group->config;
+    asx_budget drain;
+    asx_status dst;
+    uint32_t spent = 0;
+    uint32_t slice;
+
+    if (s->root != ASX_INVALID_ID) {
+        for (;;) {
+            slice = cfg->poll_quantum;
+            if (cfg->poll_budget != 0 && cfg->poll_budget - spent < slice) {
+                slice = cfg->poll_budget - spent;
+            }
+            drain = asx_budget_from_polls(slice);
+            dst = asx_region_drain(s->root, &drain);
+            if (dst != ASX_E_QUIESCENCE_TASKS_LIVE
+                && dst != ASX_E_INCOMPLETE_CHILDREN) {
+                break;
+            }
+            if (drain.poll_quota == slice) break;   /* no progress */
+            spent += slice - drain.poll_quota;
+            if (cfg->poll_budget != 0 && spent >= cfg->poll_budget) break;
+        }
+        if (st == ASX_OK && dst != ASX_OK) st = dst;
+    }
+    s->status = st;
+    s->digest = asx_trace_digest();
+    SHARD_STORE_REL(&s->done, 1);
+}
+
+/* Run one quantum of shard s on the calling thread. */
+static void shard_step(asx_shard *s)
+{
+    const asx_shard_config *cfg = &s->group->config;
+    asx_runtime *prev;
+    asx_budget budget;
+    asx_status st;
+    uint32_t slice = cfg->poll_quantum;
+
+    prev = asx_runtime_enter(s->rt);
+    asx_affinity_set_domain(s->index + 1u);
+
+    if (s->root == ASX_INVALID_ID) {
+        st = asx_region_open(&s->root);
+        if (st != ASX_OK) {
+            s->root = ASX_INVALID_ID;
+        } else {
+            st = cfg->setup_fn(cfg->setup_arg, s->index, s->root);
+        }
+        if (st != ASX_OK) {
+            shard_finish(s, st);
+            goto out;
+        }
+    }
+
+    if (SHARD_LOAD_ACQ(&s->group->stop)) {
+        shard_finish(s, ASX_E_CANCELLED);
+        goto out;
+    }
+    if (cfg->poll_budget != 0) {
+        if (s->polls >= cfg->poll_budget) {
+            shard_finish(s, ASX_E_POLL_BUDGET_EXHAUSTED);
+            goto out;
+        }
+        if (cfg->poll_budget - s->polls < slice) {
+            slice = cfg->poll_budget - s->polls;
+        }
+    }
+
+    budget = asx_budget_from_polls(slice);
+    st = asx_scheduler_run(s->root, &budget);
+    s->polls += slice - budget.poll_quota;
+    if (st != ASX_E_POLL_BUDGET_EXHAUSTED) shard_finish(s, st);
+
+out:
+    asx_affinity_set_domain(ASX_AFFINITY_DOMAIN_ANY);
+    (void)asx_runtime_enter(prev);
+}
+
+static void shard_thread_main(void *arg)
+{
+    asx_shard *s = (asx_shard *)arg;
+
+    while (!s->done) {
+        shard_step(s);
+    }
+}
+
+/* Inline mode: round-robin one quantum per shard on this thread. */
+static void shard_run_inline(asx_shard_group *group)
+{
+    uint32_t n = group->config.shard_count;
+    uint32_t live = n;
+    uint32_t i;
+
+    while (live > 0) {
+        live = 0;
+        for (i = 0; i < n; i++) {
+            if (group->shards[i].done) continue;
+            shard_step(&group->shards[i]);
+            if (!group->shards[i].done) live++;
+        }
+    }
+}
+
+asx_status asx_shard_group_run(asx_shard_group *group)
+{
+    const asx_shard_thread_hooks *th;
+    asx_status start_st = ASX_OK;
+    asx_status jst;
+    uint32_t started = 0;
+    uint32_t i;
+
+    if (group == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (!group->initialized || group->ran) return ASX_E_INVALID_STATE;
+    group->ran = 1;
+
+    th = &group->config.threads;
+    if (th->start_fn == NULL) {
+        shard_run_inline(group);
+    } else {
+        for (i = 0; i < group->config.shard_count; i++) {
+            start_st = th->start_fn(th->ctx, group->config.first_cpu + i,
+                                    shard_thread_main, &group->shards[i],
+                                    &group->shards[i].thread);
+            if (start_st != ASX_OK) break;
+            started++;
+        }
+        if (start_st != ASX_OK) {
+            asx_shard_group_stop(group);
+            /* Unstarted shards never opened a region; mark them done so
+             * peers see them as disconnected. */
+            for (i = started; i < group->config.shard_count; i++) {
+                group->shards[i].status = start_st;
+                SHARD_STORE_REL(&group->shards[i].done, 1);
+            }
+        }
+        for (i = 0; i < started; i++) {
+            jst = th->join_fn(th->ctx, group->shards[i].thread);
+            if (jst != ASX_OK && start_st == ASX_OK) start_st = jst;
+            group->shards[i].thread = NULL;
+        }
+        if (start_st != ASX_OK) return start_st;
+    }
+
+    for (i = 0; i < group->config.shard_count; i++) {
+        if (group->shards[i].status != ASX_OK) return group->shards[i].status;
+    }
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Queries
+ * ------------------------------------------------------------------- */
+
+uint32_t asx_shard_self(const asx_shard_group *group)
+{
+    asx_runtime *cur = asx_runtime_current();
+    uint32_t i;
+
+    if (group == NULL || !group->initialized) return ASX_SHARD_NONE;
+    for (i = 0; i < group->config.shard_count; i++) {
+        if (group->shards[i].rt == cur) return i;
+    }
+    return ASX_SHARD_NONE;
+}
+
+asx_runtime *asx_shard_runtime(const asx_shard_group *group, uint32_t shard)
+{
+    if (group == NULL || !group->initialized
+        || shard >= group->config.shard_count) {
+        return NULL;
+    }
+    return group->shards[shard].rt;
+}
+
+asx_status asx_shard_stats_get(const asx_shard_group *group, uint32_t shard,
+                               asx_shard_stats *out)
+{
+    const asx_shard *s;
+
+    if (group == NULL || out == NULL || shard >= group->config.shard_count) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    s = &group->shards[shard];
+    out->status = s->status;
+    out->polls = s->polls;
+    out->trace_digest = s->digest;
+    out->sent = s->sent;
+    out->received = s->received;
+    return ASX_OK;
+}
+
+uint64_t asx_shard_group_digest(const asx_shard_group *group)
+{
+    uint64_t h = SHARD_FNV_OFFSET;
+    uint32_t i;
+    uint32_t b;
+
+    if (group == NULL) return h;
+    for (i = 0; i < group->config.shard_count; i++) {
+        for (b = 0; b < 8u; b++) {
+            h ^= (group->shards[i].digest >> (b * 8u)) & 0xFFu;
+            h *= SHARD_FNV_PRIME;
+        }
+    }
+    return h;
+}
+
+/* -------------------------------------------------------------------
+ * Cross-shard messaging
+ * ------------------------------------------------------------------- */
+
+asx_status asx_shard_try_reserve(asx_shard_group *group, uint32_t to,
+                                 asx_shard_permit *out)
+{
+    asx_shard_ring *ring;
+    uint32_t self;
+    uint32_t head;
+
+    if (group == NULL || out == NULL || !group->initialized
+        || to >= group->config.shard_count) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    self = asx_shard_self(group);
+    if (self == ASX_SHARD_NONE) return ASX_E_INVALID_STATE;
+    if (self == to) return ASX_E_INVALID_ARGUMENT;
+    if (SHARD_LOAD_ACQ(&group->shards[to].done)) return ASX_E_DISCONNECTED;
+
+    ring = &group->rings[self][to];
+    head = SHARD_LOAD_ACQ(&ring->head);
+    if (ring->tail + ring->reserved - head >= ASX_SHARD_RING_CAPACITY) {
+        return ASX_E_CHANNEL_FULL;
+    }
+
+    ring->reserved++;
+    out->group = group;
+    out->from = self;
+    out->to = to;
+    out->token = ++ring->next_token;
+    out->consumed = 0;
+    return ASX_OK;
+}
+
+asx_status asx_shard_permit_send(asx_shard_permit *permit, uint64_t value)
+{
+    asx_shard_ring *ring;
+    uint32_t tail;
+
+    if (permit == NULL || permit->group == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (permit->consumed) return ASX_E_INVALID_STATE;
+
+    ring = &permit->group->rings[permit->from][permit->to];
+    tail = ring->tail;
+    ring->slots[tail & SHARD_RING_MASK] = value;
+    ring->reserved--;
+    SHARD_STORE_REL(&ring->tail, tail + 1u);
+    permit->group->shards[permit->from].sent++;
+    permit->consumed = 1;
+    asx_trace_emit(ASX_TRACE_CHANNEL_SEND, (uint64_t)permit->to, value);
+    return ASX_OK;
+}
+
+void asx_shard_permit_abort(asx_shard_permit *permit)
+{
+    if (permit == NULL || permit->group == NULL || permit->consumed) return;
+    permit->group->rings[permit->from][permit->to].reserved--;
+    permit->consumed = 1;
+}
+
+asx_status asx_shard_try_recv(asx_shard_group *group, uint32_t from,
+                              uint64_t *out_value)
+{
+    asx_shard_ring *ring;
+    uint32_t self;
+    uint32_t head;
+
+    if (group == NULL || out_value == NULL || !group->initialized
+        || from >= group->config.shard_count) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    self = asx_shard_self(group);
+    if (self == ASX_SHARD_NONE) return ASX_E_INVALID_STATE;
+    if (self == from) return ASX_E_INVALID_ARGUMENT;
+
+    ring = &group->rings[from][self];
+    head = ring->head;
+    if (head == SHARD_LOAD_ACQ(&ring->tail)) {
+        if (!SHARD_LOAD_ACQ(&group->shards[from].done)) {
+            return ASX_E_WOULD_BLOCK;
+        }
+        /* The sender's last commits happen before done is published. */
+        if (head == SHARD_LOAD_ACQ(&ring->tail)) return ASX_E_DISCONNECTED;
+    }
+
+    *out_value = ring->slots[head & SHARD_RING_MASK];
+    SHARD_STORE_REL(&ring->head, head + 1u);
+    group->shards[self].received++;
+    asx_trace_emit(ASX_TRACE_CHANNEL_RECV, (uint64_t)from, *out_value);
+    return ASX_OK;
+}
@@ -0,0 +1,873 @@
+/*
+ * snapshot.c — runtime state snapshots with change tracking
+ *
+ * Writers mark a slot with ASX_SNAP_MARK_* when a field its snapshot
+ * record carries changes (runtime_internal.h). A mark sets the slot's
+ * bit in two sets: snap_delta, consumed by asx_runtime_snapshot_update
+ * to patch the last snapshot taken on the instance, and snap_pending,
+ * consumed by the state digest. The digest is the XOR of one hash per
+ * live record, so a changed slot is folded in by XOR-ing its previous
+ * hash out and its current one in. Both cost O(changed slots).
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("snapshot: loops are bounded by "
+ *   "ASX_MAX_REGIONS/TASKS/OBLIGATIONS, their bitset word counts, or "
+ *   "the encoded buffer length; observability only, never called "
+ *   "from the task poll hot path.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/snapshot.h>
+#include <asx/runtime/event.h>
+#include <asx/core/transition.h>
+#include <string.h>
+#include "runtime_internal.h"
+
+#define g_snap_delta   (g_rt->snap_delta)
+#define g_snap_pending (g_rt->snap_pending)
+#define g_snap_digest  (g_rt->snap_digest)
+#define g_snap_epoch   (g_rt->snap_epoch)
+
+#define SNAP_HASH_BASIS 0x517cc1b727220a95ULL
+
+/* -------------------------------------------------------------------
+ * Records
+ * ------------------------------------------------------------------- */
+
+/* Handle as issued by open/spawn/reserve: state mask of the initial
+ * state, so records match the caller's handles. */
+static uint64_t snap_handle(uint16_t type, unsigned initial_state,
+                            uint16_t generation, uint32_t slot)
+{
+    return asx_handle_pack(type, (uint16_t)(1u << initial_state),
+                           asx_handle_pack_index(generation,
+                                                 (uint16_t)slot));
+}
+
+static asx_region_id snap_region_ref(asx_region_id id)
+{
+    if (id == ASX_INVALID_ID) return ASX_INVALID_ID;
+    return snap_handle(ASX_TYPE_REGION, (unsigned)ASX_REGION_OPEN,
+                       asx_handle_generation(id), asx_handle_slot(id));
+}
+
+static asx_status snap_outcome_status(const asx_task_slot *t,
+                                      const asx_task_cold *tc)
+{
+    if (!asx_task_is_terminal(t->state)) return ASX_E_TASK_NOT_COMPLETED;
+    switch (tc->outcome.severity) {
+    case ASX_OUTCOME_OK:        return ASX_OK;
+    case ASX_OUTCOME_CANCELLED: return ASX_E_CANCELLED;
+    case ASX_OUTCOME_ERR:
+    case ASX_OUTCOME_PANICKED:
+    default:                    return ASX_E_INVALID_STATE;
+    }
+}
+
+static void snap_read_region(uint32_t idx, asx_snapshot_region *out)
+{
+    const asx_region_slot *r = &g_regions[idx];
+
+    out->id = snap_handle(ASX_TYPE_REGION, (unsigned)ASX_REGION_OPEN,
+                          r->generation, idx);
+    out->state = r->state;
+    out->task_count = r->task_count;
+    out->task_total = r->task_total;
+    out->poisoned = r->poisoned;
+}
+
+static void snap_read_task(uint32_t idx, asx_snapshot_task *out)
+{
+    const asx_task_slot *t = &g_tasks[idx];
+    const asx_task_cold *tc = &g_task_cold[idx];
+
+    out->id = snap_handle(ASX_TYPE_TASK, (unsigned)ASX_TASK_CREATED,
+                          t->generation, idx);
+    out->state = t->state;
+    out->region = snap_region_ref(tc->region);
+    out->outcome_status = snap_outcome_status(t, tc);
+}
+
+static void snap_read_obligation(uint32_t idx, asx_snapshot_obligation *out)
+{
+    const asx_obligation_slot *o = &g_obligations[idx];
+
+    out->id = snap_handle(ASX_TYPE_OBLIGATION,
+                          (unsigned)ASX_OBLIGATION_RESERVED,
+                          o->generation, idx);
+    out->state = o->state;
+    out->region = snap_region_ref(o->region);
+}
+
+/* -------------------------------------------------------------------
+ * Record hashes
+ * ------------------------------------------------------------------- */
+
+static uint64_t snap_fnv1a_mix(uint64_t hash, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t i;
+
+    for (i = 0; i < len; i++) {
+        hash ^= (uint64_t)p[i];
+        hash *= 0x00000100000001B3ULL;
+    }
+    return hash;
+}
+
+static uint64_t snap_mix_u32(uint64_t hash, uint32_t v)
+{
+    return snap_fnv1a_mix(hash, &v, sizeof(v));
+}
+
+static uint64_t snap_hash_region(const asx_snapshot_region *r)
+{
+    uint64_t h = snap_fnv1a_mix(SNAP_HASH_BASIS, &r->id, sizeof(r->id));
+
+    h = snap_mix_u32(h, (uint32_t)r->state);
+    h = snap_mix_u32(h, r->task_count);
+    h = snap_mix_u32(h, r->task_total);
+    return snap_mix_u32(h, (uint32_t)r->poisoned);
+}
+
+static uint64_t snap_hash_task(const asx_snapshot_task *t)
+{
+    uint64_t h = snap_fnv1a_mix(SNAP_HASH_BASIS, &t->id, sizeof(t->id));
+
+    h = snap_mix_u32(h, (uint32_t)t->state);
+    h = snap_fnv1a_mix(h, &t->region, sizeof(t->region));
+    return snap_mix_u32(h, (uint32_t)t->outcome_status);
+}
+
+static uint64_t snap_hash_obligation(const asx_snapshot_obligation *o)
+{
+    uint64_t h = snap_fnv1a_mix(SNAP_HASH_BASIS, &o->id, sizeof(o->id));
+
+    h = snap_mix_u32(h, (uint32_t)o->state);
+    return snap_fnv1a_mix(h, &o->region, sizeof(o->region));
+}
+
+/* Current hash of a slot's record; 0 for a dead slot */
+static uint64_t snap_slot_hash_region(uint32_t idx)
+{
+    asx_snapshot_region rec;
+
+    if (!g_regions[idx].alive) return 0;
+    snap_read_region(idx, &rec);
+    return snap_hash_region(&rec);
+}
+
+static uint64_t snap_slot_hash_task(uint32_t idx)
+{
+    asx_snapshot_task rec;
+
+    if (!g_tasks[idx].alive) return 0;
+    snap_read_task(idx, &rec);
+    return snap_hash_task(&rec);
+}
+
+static uint64_t snap_slot_hash_obligation(uint32_t idx)
+{
+    asx_snapshot_obligation rec;
+
+    if (!g_obligations[idx].alive) return 0;
+    snap_read_obligation(idx, &rec);
+    return snap_hash_obligation(&rec);
+}
+
+/* -------------------------------------------------------------------
+ * Change tracking
+ * ------------------------------------------------------------------- */
+
+static uint32_t snap_lowest_bit(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(v);
+#else
+    uint32_t n = 0;
+    while ((v & 1u) == 0) {
+        v >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+void asx_snapshot_tracking_reset(void)
+{
+    memset(&g_snap_delta, 0, sizeof(g_snap_delta));
+    memset(&g_snap_pending, 0, sizeof(g_snap_pending));
+    memset(g_rt->snap_region_hash, 0, sizeof(g_rt->snap_region_hash));
+    memset(g_rt->snap_task_hash, 0, sizeof(g_rt->snap_task_hash));
+    memset(g_rt->snap_obligation_hash, 0,
+           sizeof(g_rt->snap_obligation_hash));
+    g_snap_digest = 0;
+    /* Snapshots taken before the reset no longer describe the arenas */
+    g_snap_epoch++;
+}
+
+/* Fold the marked slots of one arena into the digest and clear them */
+static void snap_fold(uint32_t *set, uint32_t words, uint64_t *hashes,
+                      uint64_t (*slot_hash)(uint32_t))
+{
+    uint32_t w;
+    uint32_t bits;
+    uint32_t idx;
+    uint64_t h;
+
+    for (w = 0; w < words; w++) {
+        bits = set[w];
+        set[w] = 0;
+        while (bits != 0) {
+            idx = w * 32u + snap_lowest_bit(bits);
+            h = slot_hash(idx);
+            g_snap_digest ^= hashes[idx] ^ h;
+            hashes[idx] = h;
+            bits &= bits - 1u;
+        }
+    }
+}
+
+uint64_t asx_runtime_state_digest(void)
+{
+    snap_fold(g_snap_pending.regions, ASX_SNAP_WORDS(ASX_MAX_REGIONS),
+              g_rt->snap_region_hash, snap_slot_hash_region);
+    snap_fold(g_snap_pending.tasks, ASX_SNAP_WORDS(ASX_MAX_TASKS),
+              g_rt->snap_task_hash, snap_slot_hash_task);
+    snap_fold(g_snap_pending.obligations,
+              ASX_SNAP_WORDS(ASX_MAX_OBLIGATIONS),
+              g_rt->snap_obligation_hash, snap_slot_hash_obligation);
+    return g_snap_digest;
+}
+
+uint64_t asx_runtime_snapshot_hash(const asx_runtime_snapshot *snap)
+{
+    uint64_t h = 0;
+    uint32_t i;
+
+    if (snap == NULL) return 0;
+    for (i = 0; i < snap->region_count; i++) {
+        h ^= snap_hash_region(&snap->regions[i]);
+    }
+    for (i = 0; i < snap->task_count; i++) {
+        h ^= snap_hash_task(&snap->tasks[i]);
+    }
+    for (i = 0; i < snap->obligation_count; i++) {
+        h ^= snap_hash_obligation(&snap->obligations[i]);
+    }
+    return h;
+}
+
+/* -------------------------------------------------------------------
+ * Capture and update
+ * ------------------------------------------------------------------- */
+
+void asx_runtime_snapshot_init(asx_runtime_snapshot *snap)
+{
+    if (snap == NULL) return;
+    memset(snap, 0, sizeof(*snap));
+}
+
+/* Stamp snap as the instance's latest snapshot */
+static void snap_finish(asx_runtime_snapshot *snap)
+{
+    snap->event_hash = asx_event_hash_chain();
+    snap->digest = asx_runtime_state_digest();
+    snap->owner = g_rt;
+    g_snap_epoch++;
+    if (g_snap_epoch == 0) g_snap_epoch = 1;
+    snap->epoch = g_snap_epoch;
+}
+
+asx_status asx_runtime_snapshot_capture(asx_runtime_snapshot *snap)
+{
+    uint32_t i;
+
+    if (snap == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    snap->region_count = 0;
+    for (i = 0; i < g_region_count; i++) {
+        if (!g_regions[i].alive) continue;
+        snap_read_region(i, &snap->regions[snap->region_count++]);
+    }
+    snap->task_count = 0;
+    for (i = 0; i < g_task_count; i++) {
+        if (!g_tasks[i].alive) continue;
+        snap_read_task(i, &snap->tasks[snap->task_count++]);
+    }
+    snap->obligation_count = 0;
+    for (i = 0; i < g_obligation_count; i++) {
+        if (!g_obligations[i].alive) continue;
+        snap_read_obligation(i, &snap->obligations[snap->obligation_count++]);
+    }
+
+    memset(&g_snap_delta, 0, sizeof(g_snap_delta));
+    snap_finish(snap);
+    return ASX_OK;
+}
+
+/* Index of slot's record in records ordered by slot (the id is each
+ * record type's first member); *found tells whether it is there. */
+static uint32_t snap_seek(const void *records, uint32_t count, size_t size,
+                          uint32_t slot, int *found)
+{
+    const unsigned char *base = (const unsigned char *)records;
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    uint32_t mid;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2u;
+        if (asx_handle_slot(*(const uint64_t *)(const void *)
+                            (base + mid * size)) < slot) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    *found = lo < count
+             && asx_handle_slot(*(const uint64_t *)(const void *)
+                                (base + lo * size)) == slot;
+    return lo;
+}
+
+/* Replace or insert slot's record (rec), or remove it (rec == NULL) */
+static void snap_patch(void *records, uint32_t *count, size_t size,
+                       uint32_t slot, const void *rec)
+{
+    unsigned char *base = (unsigned char *)records;
+    int found;
+    uint32_t at = snap_seek(records, *count, size, slot, &found);
+
+    if (rec == NULL) {
+        if (!found) return;
+        memmove(base + at * size, base + (at + 1u) * size,
+                (*count - at - 1u) * size);
+        (*count)--;
+        return;
+    }
+    if (!found) {
+        memmove(base + (at + 1u) * size, base + at * size,
+                (*count - at) * size);
+        (*count)++;
+    }
+    memcpy(base + at * size, rec, size);
+}
+
+/* Next marked slot of a set at or after *w, clearing it; 0 if none */
+static int snap_take(uint32_t *set, uint32_t words, uint32_t *w,
+                     uint32_t *idx)
+{
+    uint32_t b;
+
+    for (; *w < words; (*w)++) {
+        if (set[*w] != 0) {
+            b = snap_lowest_bit(set[*w]);
+            set[*w] &= set[*w] - 1u;
+            *idx = *w * 32u + b;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+asx_status asx_runtime_snapshot_update(asx_runtime_snapshot *snap,
+                                       uint32_t *out_changed)
+{
+    asx_snapshot_region region;
+    asx_snapshot_task task;
+    asx_snapshot_obligation obligation;
+    uint32_t changed = 0;
+    uint32_t w;
+    uint32_t idx;
+    asx_status st;
+
+    if (snap == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    if (snap->owner != g_rt || snap->epoch == 0
+        || snap->epoch != g_snap_epoch) {
+        st = asx_runtime_snapshot_capture(snap);
+        if (out_changed != NULL) *out_changed = ASX_SNAPSHOT_FULL;
+        return st;
+    }
+
+    w = 0;
+    while (snap_take(g_snap_delta.regions, ASX_SNAP_WORDS(ASX_MAX_REGIONS),
+                     &w, &idx)) {
+        if (g_regions[idx].alive) snap_read_region(idx, &region);
+        snap_patch(snap->regions, &snap->region_count, sizeof(region), idx,
+                   g_regions[idx].alive ? &region : NULL);
+        changed++;
+    }
+    w = 0;
+    while (snap_take(g_snap_delta.tasks, ASX_SNAP_WORDS(ASX_MAX_TASKS),
+                     &w, &idx)) {
+        if (g_tasks[idx].alive) snap_read_task(idx, &task);
+        snap_patch(snap->tasks, &snap->task_count, sizeof(task), idx,
+                   g_tasks[idx].alive ? &task : NULL);
+        changed++;
+    }
+    w = 0;
+    while (snap_take(g_snap_delta.obligations,
+                     ASX_SNAP_WORDS(ASX_MAX_OBLIGATIONS), &w, &idx)) {
+        if (g_obligations[idx].alive) snap_read_obligation(idx, &obligation);
+        snap_patch(snap->obligations, &snap->obligation_count,
+                   sizeof(obligation), idx,
+                   g_obligations[idx].alive ? &obligation : NULL);
+        changed++;
+    }
+
+    snap_finish(snap);
+    if (out_changed != NULL) *out_changed = changed;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Comparison and JSON
+ * ------------------------------------------------------------------- */
+
+asx_status asx_runtime_snapshot_eq(const asx_runtime_snapshot *a,
+                                   const asx_runtime_snapshot *b)
+{
+    uint32_t i;
+
+    if (a == NULL || b == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (a->region_count != b->region_count
+        || a->task_count != b->task_count
+        || a->obligation_count != b->obligation_count
+        || a->event_hash != b->event_hash) {
+        return ASX_E_EQUIVALENCE_MISMATCH;
+    }
+    for (i = 0; i < a->region_count; i++) {
+        const asx_snapshot_region *x = &a->regions[i];
+        const asx_snapshot_region *y = &b->regions[i];
+        if (x->id != y->id || x->state != y->state
+            || x->task_count != y->task_count
+            || x->task_total != y->task_total
+            || x->poisoned != y->poisoned) {
+            return ASX_E_EQUIVALENCE_MISMATCH;
+        }
+    }
+    for (i = 0; i < a->task_count; i++) {
+        const asx_snapshot_task *x = &a->tasks[i];
+        const asx_snapshot_task *y = &b->tasks[i];
+        if (x->id != y->id || x->state != y->state
+            || x->region != y->region
+            || x->outcome_status != y->outcome_status) {
+            return ASX_E_EQUIVALENCE_MISMATCH;
+        }
+    }
+    for (i = 0; i < a->obligation_count; i++) {
+        const asx_snapshot_obligation *x = &a->obligations[i];
+        const asx_snapshot_obligation *y = &b->obligations[i];
+        if (x->id != y->id || x->state != y->state
+            || x->region != y->region) {
+            return ASX_E_EQUIVALENCE_MISMATCH;
+        }
+    }
+    return ASX_OK;
+}
+
+asx_status asx_runtime_snapshot_to_json(const asx_runtime_snapshot *snap,
+                                        asx_codec_buffer *out)
+{
+    asx_status st;
+    uint32_t i;
+    int first;
+
+    if (snap == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    st = asx_codec_buffer_append_cstr(out, "{\"regions\":[");
+    for (i = 0; st == ASX_OK && i < snap->region_count; i++) {
+        const asx_snapshot_region *r = &snap->regions[i];
+        first = 1;
+        if (i > 0) st = asx_codec_buffer_append_char(out, ',');
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '{');
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "id", r->id);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "state",
+                                                   (uint64_t)r->state);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "task_count",
+                                                   r->task_count);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "task_total",
+                                                   r->task_total);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "poisoned",
+                                                   (uint64_t)r->poisoned);
+        }
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '}');
+    }
+
+    if (st == ASX_OK) st = asx_codec_buffer_append_cstr(out, "],\"tasks\":[");
+    for (i = 0; st == ASX_OK && i < snap->task_count; i++) {
+        const asx_snapshot_task *t = &snap->tasks[i];
+        first = 1;
+        if (i > 0) st = asx_codec_buffer_append_char(out, ',');
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '{');
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "id", t->id);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "state",
+                                                   (uint64_t)t->state);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "region",
+                                                   t->region);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(
+                out, &first, "outcome_status", (uint64_t)t->outcome_status);
+        }
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '}');
+    }
+
+    if (st == ASX_OK) {
+        st = asx_codec_buffer_append_cstr(out, "],\"obligations\":[");
+    }
+    for (i = 0; st == ASX_OK && i < snap->obligation_count; i++) {
+        const asx_snapshot_obligation *o = &snap->obligations[i];
+        first = 1;
+        if (i > 0) st = asx_codec_buffer_append_char(out, ',');
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '{');
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "id", o->id);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "state",
+                                                   (uint64_t)o->state);
+        }
+        if (st == ASX_OK) {
+            st = asx_codec_buffer_append_u64_field(out, &first, "region",
+                                                   o->region);
+        }
+        if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '}');
+    }
+
+    if (st == ASX_OK) st = asx_codec_buffer_append_char(out, ']');
+    first = 0;
+    if (st == ASX_OK) {
+        st = asx_codec_buffer_append_u64_field(out, &first, "event_hash",
+                                               snap->event_hash);
+    }
+    if (st == ASX_OK) {
+        st = asx_codec_buffer_append_u64_field(out, &first, "digest",
+                                               snap->digest);
+    }
+    if (st == ASX_OK) st = asx_codec_buffer_append_char(out, '}');
+    return st;
+}
+
+/* -------------------------------------------------------------------
+ * Binary encoding
+ * ------------------------------------------------------------------- */
+
+/* Bounded output: bytes past cap are counted, not written, so a
+ * capacity-0 pass sizes the encoding. */
+typedef struct {
+    uint8_t *buf;
+    uint32_t cap;
+    uint32_t pos;
+} snap_writer;
+
+static void snap_put(snap_writer *w, uint8_t b)
+{
+    if (w->pos < w->cap) w->buf[w->pos] = b;
+    w->pos++;
+}
+
+static void snap_put_le64(snap_writer *w, uint64_t v)
+{
+    uint32_t i;
+
+    for (i = 0; i < 8u; i++) {
+        snap_put(w, (uint8_t)((v >> (8u * i)) & 0xFFu));
+    }
+}
+
+static void snap_put_varint(snap_writer *w, uint64_t v)
+{
+    while (v >= 0x80u) {
+        snap_put(w, (uint8_t)((v & 0x7Fu) | 0x80u));
+        v >>= 7;
+    }
+    snap_put(w, (uint8_t)v);
+}
+
+/* Record id as slot delta and generation */
+static void snap_put_id(snap_writer *w, uint64_t id, uint32_t *prev_slot)
+{
+    uint32_t slot = asx_handle_slot(id);
+
+    snap_put_varint(w, slot - *prev_slot);
+    snap_put_varint(w, asx_handle_generation(id));
+    *prev_slot = slot;
+}
+
+static void snap_put_region_ref(snap_writer *w, asx_region_id id)
+{
+    if (id == ASX_INVALID_ID) {
+        snap_put(w, 0);
+        snap_put(w, 0);
+        return;
+    }
+    snap_put_varint(w, (uint64_t)asx_handle_slot(id) + 1u);
+    snap_put_varint(w, asx_handle_generation(id));
+}
+
+static void snap_encode(snap_writer *w, const asx_runtime_snapshot *snap)
+{
+    uint32_t prev;
+    uint32_t i;
+
+    snap_put(w, (uint8_t)(ASX_SNAPSHOT_BINARY_MAGIC & 0xFFu));
+    snap_put(w, (uint8_t)((ASX_SNAPSHOT_BINARY_MAGIC >> 8) & 0xFFu));
+    snap_put(w, (uint8_t)((ASX_SNAPSHOT_BINARY_MAGIC >> 16) & 0xFFu));
+    snap_put(w, (uint8_t)((ASX_SNAPSHOT_BINARY_MAGIC >> 24) & 0xFFu));
+    snap_put(w, (uint8_t)ASX_SNAPSHOT_BINARY_VERSION);
+    snap_put_le64(w, snap->digest);
+    snap_put_le64(w, snap->event_hash);
+
+    snap_put_varint(w, snap->region_count);
+    prev = 0;
+    for (i = 0; i < snap->region_count; i++) {
+        const asx_snapshot_region *r = &snap->regions[i];
+        snap_put_id(w, r->id, &prev);
+        snap_put(w, (uint8_t)r->state);
+        snap_put_varint(w, r->task_count);
+        snap_put_varint(w, r->task_total);
+        snap_put(w, (uint8_t)(r->poisoned != 0));
+    }
+
+    snap_put_varint(w, snap->task_count);
+    prev = 0;
+    for (i = 0; i < snap->task_count; i++) {
+        const asx_snapshot_task *t = &snap->tasks[i];
+        snap_put_id(w, t->id, &prev);
+        snap_put(w, (uint8_t)t->state);
+        snap_put_region_ref(w, t->region);
+        snap_put_varint(w, (uint32_t)t->outcome_status);
+    }
+
+    snap_put_varint(w, snap->obligation_count);
+    prev = 0;
+    for (i = 0; i < snap->obligation_count; i++) {
+        const asx_snapshot_obligation *o = &snap->obligations[i];
+        snap_put_id(w, o->id, &prev);
+        snap_put(w, (uint8_t)o->state);
+        snap_put_region_ref(w, o->region);
+    }
+}
+
+asx_status asx_runtime_snapshot_encode(const asx_runtime_snapshot *snap,
+                                       uint8_t *buf, uint32_t capacity,
+                                       uint32_t *out_len)
+{
+    snap_writer w;
+
+    if (snap == NULL || buf == NULL || out_len == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+
+    /* Size first so a short buffer is left untouched */
+    w.buf = buf;
+    w.cap = 0;
+    w.pos = 0;
+    snap_encode(&w, snap);
+    *out_len = w.pos;
+    if (capacity < w.pos) return ASX_E_BUFFER_TOO_SMALL;
+
+    w.cap = capacity;
+    w.pos = 0;
+    snap_encode(&w, snap);
+    return ASX_OK;
+}
+
+typedef struct {
+    const uint8_t *buf;
+    uint32_t len;
+    uint32_t pos;
+} snap_reader;
+
+static int snap_get(snap_reader *r, uint8_t *b)
+{
+    if (r->pos >= r->len) return 0;
+    *b = r->buf[r->pos++];
+    return 1;
+}
+
+static uint64_t snap_get_le64(snap_reader *r)
+{
+    uint64_t v = 0;
+    uint32_t i;
+
+    for (i = 0; i < 8u; i++) {
+        v |= (uint64_t)r->buf[r->pos + i] << (8u * i);
+    }
+    r->pos += 8u;
+    return v;
+}
+
+/* Varint no larger than max */
+static int snap_get_varint(snap_reader *r, uint64_t max, uint32_t *out)
+{
+    uint64_t v = 0;
+    uint32_t shift = 0;
+    uint8_t b;
+
+    do {
+        if (shift > 35u || !snap_get(r, &b)) return 0;
+        v |= (uint64_t)(b & 0x7Fu) << shift;
+        shift += 7u;
+    } while ((b & 0x80u) != 0);
+    if (v > max) return 0;
+    *out = (uint32_t)v;
+    return 1;
+}
+
+static int snap_get_state(snap_reader *r, uint32_t count, uint32_t *out)
+{
+    uint8_t b;
+
+    if (!snap_get(r, &b) || b >= count) return 0;
+    *out = b;
+    return 1;
+}
+
+/* Record id: slots strictly ascending after the first record */
+static int snap_get_id(snap_reader *r, uint16_t type, unsigned initial_state,
+                       uint32_t max_slots, uint32_t i, uint32_t *prev_slot,
+                       uint64_t *out)
+{
+    uint32_t delta;
+    uint32_t gen;
+
+    if (!snap_get_varint(r, max_slots, &delta)) return 0;
+    if (i > 0 && delta == 0) return 0;
+    if (*prev_slot + delta >= max_slots) return 0;
+    if (!snap_get_varint(r, 0xFFFFu, &gen)) return 0;
+    *prev_slot += delta;
+    *out = snap_handle(type, initial_state, (uint16_t)gen, *prev_slot);
+    return 1;
+}
+
+static int snap_get_region_ref(snap_reader *r, asx_region_id *out)
+{
+    uint32_t slot1;
+    uint32_t gen;
+
+    if (!snap_get_varint(r, ASX_MAX_REGIONS, &slot1)) return 0;
+    if (!snap_get_varint(r, 0xFFFFu, &gen)) return 0;
+    if (slot1 == 0) {
+        *out = ASX_INVALID_ID;
+        return gen == 0;
+    }
+    *out = snap_handle(ASX_TYPE_REGION, (unsigned)ASX_REGION_OPEN,
+                       (uint16_t)gen, slot1 - 1u);
+    return 1;
+}
+
+static int snap_decode(snap_reader *r, asx_runtime_snapshot *snap)
+{
+    uint32_t prev;
+    uint32_t i;
+    uint32_t v;
+    uint8_t b;
+
+    if (r->len < ASX_SNAPSHOT_BINARY_HEADER) return 0;
+    if ((uint32_t)r->buf[0] != (ASX_SNAPSHOT_BINARY_MAGIC & 0xFFu)
+        || (uint32_t)r->buf[1] != ((ASX_SNAPSHOT_BINARY_MAGIC >> 8) & 0xFFu)
+        || (uint32_t)r->buf[2] != ((ASX_SNAPSHOT_BINARY_MAGIC >> 16) & 0xFFu)
+        || (uint32_t)r->buf[3] != ((ASX_SNAPSHOT_BINARY_MAGIC >> 24) & 0xFFu)
+        || (uint32_t)r->buf[4] != ASX_SNAPSHOT_BINARY_VERSION) {
+        return 0;
+    }
+    r->pos = 5;
+    snap->digest = snap_get_le64(r);
+    snap->event_hash = snap_get_le64(r);
+
+    if (!snap_get_varint(r, ASX_SNAPSHOT_MAX_REGIONS, &snap->region_count)) {
+        return 0;
+    }
+    prev = 0;
+    for (i = 0; i < snap->region_count; i++) {
+        asx_snapshot_region *rg = &snap->regions[i];
+        if (!snap_get_id(r, ASX_TYPE_REGION, (unsigned)ASX_REGION_OPEN,
+                         ASX_MAX_REGIONS, i, &prev, &rg->id)
+            || !snap_get_state(r, (uint32_t)ASX_REGION_CLOSED + 1u, &v)) {
+            return 0;
+        }
+        rg->state = (asx_region_state)v;
+        if (!snap_get_varint(r, 0xFFFFFFFFu, &rg->task_count)
+            || !snap_get_varint(r, 0xFFFFFFFFu, &rg->task_total)
+            || !snap_get(r, &b) || b > 1u) {
+            return 0;
+        }
+        rg->poisoned = (int)b;
+    }
+
+    if (!snap_get_varint(r, ASX_SNAPSHOT_MAX_TASKS, &snap->task_count)) {
+        return 0;
+    }
+    prev = 0;
+    for (i = 0; i < snap->task_count; i++) {
+        asx_snapshot_task *t = &snap->tasks[i];
+        if (!snap_get_id(r, ASX_TYPE_TASK, (unsigned)ASX_TASK_CREATED,
+                         ASX_MAX_TASKS, i, &prev, &t->id)
+            || !snap_get_state(r, (uint32_t)ASX_TASK_COMPLETED + 1u, &v)) {
+            return 0;
+        }
+        t->state = (asx_task_state)v;
+        if (!snap_get_region_ref(r, &t->region)
+            || !snap_get_varint(r, 0xFFFFFFFFu, &v)) {
+            return 0;
+        }
+        t->outcome_status = (asx_status)v;
+    }
+
+    if (!snap_get_varint(r, ASX_SNAPSHOT_MAX_OBLIGATIONS,
+                         &snap->obligation_count)) {
+        return 0;
+    }
+    prev = 0;
+    for (i = 0; i < snap->obligation_count; i++) {
+        asx_snapshot_obligation *o = &snap->obligations[i];
+        if (!snap_get_id(r, ASX_TYPE_OBLIGATION,
+                         (unsigned)ASX_OBLIGATION_RESERVED,
+                         ASX_MAX_OBLIGATIONS, i, &prev, &o->id)
+            || !snap_get_state(r, (uint32_t)ASX_OBLIGATION_LEAKED + 1u, &v)) {
+            return 0;
+        }
+        o->state = (asx_obligation_state)v;
+        if (!snap_get_region_ref(r, &o->region)) return 0;
+    }
+
+    return r->pos == r->len
+           && asx_runtime_snapshot_hash(snap) == snap->digest;
+}
+
+asx_status asx_runtime_snapshot_decode(const uint8_t *buf, uint32_t len,
+                                       asx_runtime_snapshot *snap)
+{
+    snap_reader r;
+
+    if (buf == NULL || snap == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    asx_runtime_snapshot_init(snap);
+    r.buf = buf;
+    r.len = len;
+    r.pos = 0;
+    if (!snap_decode(&r, snap)) {
+        asx_runtime_snapshot_init(snap);
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    return ASX_OK;
+}
@@ -16,6 +16,9 @@
 
 /* -------------------------------------------------------------------
  * State
+ *
+ * Process-wide, not per runtime instance: set the tier and reset the
+ * digest from one thread, and emit from one thread at a time.
  * ------------------------------------------------------------------- */
 
 static asx_telemetry_tier g_tier = ASX_TELEMETRY_FORENSIC;
@@ -66,6 +69,8 @@ int asx_telemetry_retains(asx_telemetry_tier tier,
     case ASX_TRACE_REGION_CLOSED:
     case ASX_TRACE_TASK_SPAWN:
     case ASX_TRACE_TASK_TRANSITION:
+    case ASX_TRACE_DRAIN_BEGIN:
+    case ASX_TRACE_DRAIN_END:
     case ASX_TRACE_SCHED_COMPLETE:
     case ASX_TRACE_SCHED_QUIESCENT:
     case ASX_TRACE_SCHED_BUDGET:
@@ -76,6 +81,8 @@ int asx_telemetry_retains(asx_telemetry_tier tier,
     case ASX_TRACE_OBLIGATION_RESERVE:
     case ASX_TRACE_OBLIGATION_COMMIT:
     case ASX_TRACE_OBLIGATION_ABORT:
+    case ASX_TRACE_OBLIGATION_COMMIT_RANGE:
+    case ASX_TRACE_OBLIGATION_ABORT_RANGE:
     case ASX_TRACE_CHANNEL_SEND:
     case ASX_TRACE_CHANNEL_RECV:
     case ASX_TRACE_TIMER_SET:
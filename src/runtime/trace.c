@@ -5,6 +5,10 @@
  * Provides FNV-1a digest for deterministic identity, replay comparison
  * against reference sequences, and JSON snapshot export.
  *
+ * asx_trace_record is the runtime's single emission path. The
+ * scheduler event log and the event record log are views that filter
+ * the ring by kind; a record is written once and only counted per view.
+ *
  * ASX_CHECKPOINT_WAIVER_FILE("trace-and-snapshot: all loops are bounded by "
  *   "ASX_TRACE_CAPACITY, ASX_MAX_REGIONS/TASKS/OBLIGATIONS, or integer "
  *   "conversion limits. Snapshot/export functions are observability-only, "
@@ -16,6 +20,7 @@
 #include <asx/asx.h>
 #include <asx/portable.h>
 #include <asx/runtime/trace.h>
+#include <asx/runtime/event.h>
 #include <string.h>
 #include "runtime_internal.h"
 
@@ -23,21 +28,88 @@
  * Trace ring buffer
  * ------------------------------------------------------------------- */
 
-static asx_trace_event g_trace_ring[ASX_TRACE_CAPACITY];
-static uint32_t g_trace_count;
+#define g_trace_ring   (g_rt->trace_ring)
+#define g_trace_count  (g_rt->trace_count)
+#define g_trace_digest (g_rt->trace_digest)
+#define g_trace_folded (g_rt->trace_folded)
+#define g_trace_cp     (g_rt->trace_cp)
+
+#define TRACE_DIGEST_BASIS 0x517cc1b727220a95ULL /* FNV-1a offset basis */
+
+/* View membership by kind: one table load per record, no hashing */
+#define TRACE_VIEW_SCHED 0x1u
+#define TRACE_VIEW_EVENT 0x2u
+#define TRACE_VIEW_KINDS 0x23u  /* through ASX_TRACE_OBLIGATION_ABORT */
+
+static const uint8_t trace_view_mask[TRACE_VIEW_KINDS] = {
+    [ASX_TRACE_SCHED_POLL]          = TRACE_VIEW_SCHED | TRACE_VIEW_EVENT,
+    [ASX_TRACE_SCHED_COMPLETE]      = TRACE_VIEW_SCHED | TRACE_VIEW_EVENT,
+    [ASX_TRACE_SCHED_BUDGET]        = TRACE_VIEW_SCHED | TRACE_VIEW_EVENT,
+    [ASX_TRACE_SCHED_QUIESCENT]     = TRACE_VIEW_SCHED | TRACE_VIEW_EVENT,
+    [ASX_TRACE_REGION_OPEN]         = TRACE_VIEW_EVENT,
+    [ASX_TRACE_REGION_CLOSE]        = TRACE_VIEW_EVENT,
+    [ASX_TRACE_TASK_SPAWN]          = TRACE_VIEW_EVENT,
+    [ASX_TRACE_DRAIN_BEGIN]         = TRACE_VIEW_EVENT,
+    [ASX_TRACE_DRAIN_END]           = TRACE_VIEW_EVENT,
+    [ASX_TRACE_OBLIGATION_RESERVE]  = TRACE_VIEW_EVENT,
+    [ASX_TRACE_OBLIGATION_COMMIT]   = TRACE_VIEW_EVENT,
+    [ASX_TRACE_OBLIGATION_ABORT]    = TRACE_VIEW_EVENT
+};
+
+static uint32_t trace_views(asx_trace_event_kind kind)
+{
+    uint32_t k = (uint32_t)kind;
 
-void asx_trace_emit(asx_trace_event_kind kind,
-                     uint64_t entity_id,
-                     uint64_t aux)
+    return k < TRACE_VIEW_KINDS ? trace_view_mask[k] : 0u;
+}
+
+int asx_sched_view_member(asx_trace_event_kind kind)
 {
-    if (g_trace_count < ASX_TRACE_CAPACITY) {
-        asx_trace_event *e = &g_trace_ring[g_trace_count];
-        e->sequence  = g_trace_count;
+    return (trace_views(kind) & TRACE_VIEW_SCHED) != 0;
+}
+
+int asx_event_view_member(asx_trace_event_kind kind)
+{
+    return (trace_views(kind) & TRACE_VIEW_EVENT) != 0;
+}
+
+void asx_trace_record(asx_trace_event_kind kind,
+                      uint64_t entity_id,
+                      uint64_t aux,
+                      asx_status status)
+{
+    asx_runtime *rt = g_rt;
+    uint32_t n = rt->trace_count;
+    uint32_t views = trace_views(kind);
+
+    asx_trace_event *e = NULL;
+
+    if (n < ASX_TRACE_CAPACITY) {
+        e = &rt->trace_ring[n];
+        rt->sched_view.in_ring += views & TRACE_VIEW_SCHED;
+        rt->event_view.in_ring += (views & TRACE_VIEW_EVENT) >> 1;
+    } else if ((views & TRACE_VIEW_SCHED) != 0) {
+        /* The ring is full: keep the run's scheduler records aside */
+        uint32_t k = rt->sched_view.count - rt->sched_view.in_ring;
+        if (k < ASX_SCHED_SPILL_CAPACITY) e = &rt->sched_spill[k];
+    }
+    if (e != NULL) {
+        e->sequence  = n;
         e->kind      = kind;
         e->entity_id = entity_id;
         e->aux       = aux;
+        e->status    = status;
     }
-    g_trace_count++;
+    rt->trace_count = n + 1u;
+    rt->sched_view.count += views & TRACE_VIEW_SCHED;
+    rt->event_view.count += (views & TRACE_VIEW_EVENT) >> 1;
+}
+
+void asx_trace_emit(asx_trace_event_kind kind,
+                     uint64_t entity_id,
+                     uint64_t aux)
+{
+    asx_trace_record(kind, entity_id, aux, ASX_OK);
 }
 
 uint32_t asx_trace_event_count(void)
@@ -57,6 +129,55 @@ int asx_trace_event_get(uint32_t index, asx_trace_event *out)
 void asx_trace_reset(void)
 {
     g_trace_count = 0;
+    g_trace_folded = 0;
+    asx_scheduler_event_reset();
+    asx_event_log_reset();
+}
+
+/* -------------------------------------------------------------------
+ * Views
+ * ------------------------------------------------------------------- */
+
+void asx_trace_view_restart(asx_trace_view *v)
+{
+    v->base = g_trace_count;
+    v->count = 0;
+    v->in_ring = 0;
+    v->cursor_index = 0;
+    v->cursor_pos = v->base;
+}
+
+const asx_trace_event *asx_trace_view_find(asx_trace_view *v,
+                                           uint32_t index,
+                                           int (*member)(asx_trace_event_kind))
+{
+    uint32_t retained;
+    uint32_t i;
+    uint32_t pos;
+
+    if (index >= v->count) return NULL;
+    retained = g_trace_count < ASX_TRACE_CAPACITY
+               ? g_trace_count
+               : ASX_TRACE_CAPACITY;
+
+    /* Resume from the cursor on ascending reads */
+    if (index >= v->cursor_index) {
+        i = v->cursor_index;
+        pos = v->cursor_pos;
+    } else {
+        i = 0;
+        pos = v->base;
+    }
+    for (; pos < retained; pos++) {
+        if (!member(g_trace_ring[pos].kind)) continue;
+        if (i == index) {
+            v->cursor_index = i;
+            v->cursor_pos = pos;
+            return &g_trace_ring[pos];
+        }
+        i++;
+    }
+    return NULL;
 }
 
 /* -------------------------------------------------------------------
@@ -75,9 +196,36 @@ static uint64_t fnv1a_mix(uint64_t hash, const void *data, uint32_t len)
     return hash;
 }
 
+static uint64_t trace_digest_mix(uint64_t hash, const asx_trace_event *e)
+{
+    uint32_t k = (uint32_t)e->kind;
+
+    hash = fnv1a_mix(hash, &e->sequence, sizeof(e->sequence));
+    hash = fnv1a_mix(hash, &k, sizeof(k));
+    hash = fnv1a_mix(hash, &e->entity_id, sizeof(e->entity_id));
+    hash = fnv1a_mix(hash, &e->aux, sizeof(e->aux));
+    return hash;
+}
+
+/* Mix events [from, to) into hash, recording a checkpoint after each
+ * full interval. */
+static uint64_t trace_fold(const asx_trace_event *events, uint32_t from,
+                           uint32_t to, uint64_t hash, uint64_t *cp)
+{
+    uint32_t i;
+
+    for (i = from; i < to; i++) {
+        hash = trace_digest_mix(hash, &events[i]);
+        if ((i + 1u) % ASX_TRACE_CHECKPOINT_INTERVAL == 0) {
+            cp[(i + 1u) / ASX_TRACE_CHECKPOINT_INTERVAL - 1u] = hash;
+        }
+    }
+    return hash;
+}
+
 uint64_t asx_trace_digest(void)
 {
-    uint64_t hash = 0x517cc1b727220a95ULL; /* FNV-1a offset basis */
+    uint64_t hash;
     uint32_t count;
     uint32_t i;
 
@@ -85,25 +233,75 @@ uint64_t asx_trace_digest(void)
             ? g_trace_count
             : ASX_TRACE_CAPACITY;
 
-    for (i = 0; i < count; i++) {
-        asx_trace_event *e = &g_trace_ring[i];
-        uint32_t k = (uint32_t)e->kind;
-        hash = fnv1a_mix(hash, &e->sequence, sizeof(e->sequence));
-        hash = fnv1a_mix(hash, &k, sizeof(k));
-        hash = fnv1a_mix(hash, &e->entity_id, sizeof(e->entity_id));
-        hash = fnv1a_mix(hash, &e->aux, sizeof(e->aux));
+    /* Roll forward from the last fold */
+    if (g_trace_folded == 0 || g_trace_folded > count) {
+        hash = TRACE_DIGEST_BASIS;
+        i = 0;
+    } else {
+        hash = g_trace_digest;
+        i = g_trace_folded;
     }
+    hash = trace_fold(g_trace_ring, i, count, hash, g_trace_cp);
+    g_trace_digest = hash;
+    g_trace_folded = count;
 
     return hash;
 }
 
+uint32_t asx_trace_checkpoint_count(void)
+{
+    (void)asx_trace_digest();
+    return g_trace_folded / ASX_TRACE_CHECKPOINT_INTERVAL;
+}
+
+int asx_trace_checkpoint_get(uint32_t index, uint64_t *out)
+{
+    if (out == NULL) return 0;
+    if (index >= asx_trace_checkpoint_count()) return 0;
+    *out = g_trace_cp[index];
+    return 1;
+}
+
+/* First checkpoint index where a and b differ, or n if none. Checkpoints
+ * are prefix digests, so once two differ all later ones do. */
+static uint32_t trace_cp_bisect(const uint64_t *a, const uint64_t *b,
+                                uint32_t n)
+{
+    uint32_t lo = 0;
+    uint32_t hi = n;
+    uint32_t mid;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2u;
+        if (a[mid] == b[mid]) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static asx_replay_result_kind trace_event_diff(const asx_trace_event *actual,
+                                               const asx_trace_event *expected)
+{
+    if (actual->kind != expected->kind) return ASX_REPLAY_KIND_MISMATCH;
+    if (actual->entity_id != expected->entity_id) {
+        return ASX_REPLAY_ENTITY_MISMATCH;
+    }
+    if (actual->aux != expected->aux) return ASX_REPLAY_AUX_MISMATCH;
+    return ASX_REPLAY_MATCH;
+}
+
 /* -------------------------------------------------------------------
  * Replay verification
  * ------------------------------------------------------------------- */
 
-static asx_trace_event g_replay_ref[ASX_TRACE_CAPACITY];
-static uint32_t g_replay_ref_count;
-static int      g_replay_loaded;
+#define g_replay_ref        (g_rt->replay_ref)
+#define g_replay_ref_cp     (g_rt->replay_ref_cp)
+#define g_replay_ref_digest (g_rt->replay_ref_digest)
+#define g_replay_ref_count  (g_rt->replay_ref_count)
+#define g_replay_loaded     (g_rt->replay_loaded)
 
 asx_status asx_replay_load_reference(const asx_trace_event *events,
                                       uint32_t count)
@@ -118,6 +316,9 @@ asx_status asx_replay_load_reference(const asx_trace_event *events,
     if (copy_count > 0) {
         memcpy(g_replay_ref, events, copy_count * sizeof(asx_trace_event));
     }
+    /* Digest and checkpoints once, here, rather than per verify */
+    g_replay_ref_digest = trace_fold(g_replay_ref, 0, copy_count,
+                                     TRACE_DIGEST_BASIS, g_replay_ref_cp);
     g_replay_ref_count = count;
     g_replay_loaded = 1;
     return ASX_OK;
@@ -132,6 +333,7 @@ void asx_replay_clear_reference(void)
 asx_replay_result asx_replay_verify(void)
 {
     asx_replay_result result;
+    asx_replay_result_kind kind;
     uint32_t check_count;
     uint32_t i;
     uint64_t expected_digest;
@@ -153,54 +355,25 @@ asx_replay_result asx_replay_verify(void)
         return result;
     }
 
-    /* Element-by-element comparison */
+    /* Skip the agreeing prefix by checkpoint, then compare elements */
     check_count = g_trace_count < ASX_TRACE_CAPACITY
                   ? g_trace_count
                   : ASX_TRACE_CAPACITY;
-
-    for (i = 0; i < check_count; i++) {
-        asx_trace_event *actual = &g_trace_ring[i];
-        asx_trace_event *expected = &g_replay_ref[i];
-
-        if (actual->kind != expected->kind) {
-            result.result = ASX_REPLAY_KIND_MISMATCH;
-            result.divergence_index = i;
-            return result;
-        }
-        if (actual->entity_id != expected->entity_id) {
-            result.result = ASX_REPLAY_ENTITY_MISMATCH;
-            result.divergence_index = i;
-            return result;
-        }
-        if (actual->aux != expected->aux) {
-            result.result = ASX_REPLAY_AUX_MISMATCH;
+    actual_digest = asx_trace_digest();
+    expected_digest = g_replay_ref_digest;
+
+    i = trace_cp_bisect(g_trace_cp, g_replay_ref_cp,
+                        check_count / ASX_TRACE_CHECKPOINT_INTERVAL)
+        * ASX_TRACE_CHECKPOINT_INTERVAL;
+    for (; i < check_count; i++) {
+        kind = trace_event_diff(&g_trace_ring[i], &g_replay_ref[i]);
+        if (kind != ASX_REPLAY_MATCH) {
+            result.result = kind;
             result.divergence_index = i;
             return result;
         }
     }
 
-    /* Compute and compare digests */
-    actual_digest = asx_trace_digest();
-
-    /* Compute expected digest from reference */
-    {
-        uint64_t hash = 0x517cc1b727220a95ULL;
-        uint32_t ref_count = g_replay_ref_count < ASX_TRACE_CAPACITY
-                             ? g_replay_ref_count
-                             : ASX_TRACE_CAPACITY;
-        for (i = 0; i < ref_count; i++) {
-            uint32_t k = (uint32_t)g_replay_ref[i].kind;
-            hash = fnv1a_mix(hash, &g_replay_ref[i].sequence,
-                             sizeof(g_replay_ref[i].sequence));
-            hash = fnv1a_mix(hash, &k, sizeof(k));
-            hash = fnv1a_mix(hash, &g_replay_ref[i].entity_id,
-                             sizeof(g_replay_ref[i].entity_id));
-            hash = fnv1a_mix(hash, &g_replay_ref[i].aux,
-                             sizeof(g_replay_ref[i].aux));
-        }
-        expected_digest = hash;
-    }
-
     result.expected_digest = expected_digest;
     result.actual_digest = actual_digest;
 
@@ -362,9 +535,13 @@ const char *asx_trace_event_kind_str(asx_trace_event_kind kind)
     case ASX_TRACE_REGION_CLOSED:      return "region_closed";
     case ASX_TRACE_TASK_SPAWN:         return "task_spawn";
     case ASX_TRACE_TASK_TRANSITION:    return "task_transition";
+    case ASX_TRACE_DRAIN_BEGIN:        return "drain_begin";
+    case ASX_TRACE_DRAIN_END:          return "drain_end";
     case ASX_TRACE_OBLIGATION_RESERVE: return "obligation_reserve";
     case ASX_TRACE_OBLIGATION_COMMIT:  return "obligation_commit";
     case ASX_TRACE_OBLIGATION_ABORT:   return "obligation_abort";
+    case ASX_TRACE_OBLIGATION_COMMIT_RANGE: return "obligation_commit_range";
+    case ASX_TRACE_OBLIGATION_ABORT_RANGE:  return "obligation_abort_range";
     case ASX_TRACE_CHANNEL_SEND:       return "channel_send";
     case ASX_TRACE_CHANNEL_RECV:       return "channel_recv";
     case ASX_TRACE_TIMER_SET:          return "timer_set";
@@ -421,11 +598,222 @@ static uint64_t read_le64(const uint8_t *p)
          | ((uint64_t)read_le32(p + 4) << 32);
 }
 
+/* -------------------------------------------------------------------
+ * v2 compact event encoding
+ *
+ * Per event: a tag byte (kind in bits 0-5, TRACE_V2_KIND_ESC followed
+ * by a varint kind for larger kinds; TRACE_V2_SEQ if a varint sequence
+ * follows, otherwise the sequence is the previous one plus one;
+ * TRACE_V2_STATUS if a varint status follows the sequence), a
+ * reference byte (entity code in the low nibble, aux code in the high
+ * nibble), then the literals those codes call for, entity first.
+ *
+ * A code below TRACE_V2_MTF names a slot of a small move-to-front
+ * table of recent values. TRACE_V2_XOR is a varint of the value XOR
+ * the table front (handles of one type differ only in low bits) and
+ * TRACE_V2_RAW a plain varint; literals of 0x80 and up are pushed to
+ * the front. The table and the expected sequence restart at every
+ * checkpoint interval, so readers can seek to any interval.
+ * ------------------------------------------------------------------- */
+
+#define TRACE_V2_MTF      8u
+#define TRACE_V2_XOR      8u
+#define TRACE_V2_RAW      9u
+#define TRACE_V2_KIND_ESC 0x3Fu
+#define TRACE_V2_SEQ      0x40u
+#define TRACE_V2_STATUS   0x80u
+#define TRACE_V2_PUSH_MIN 0x80u
+
+typedef struct {
+    uint64_t mtf[TRACE_V2_MTF];
+    uint32_t next_seq;
+} trace_v2_ctx;
+
+static void trace_v2_ctx_reset(trace_v2_ctx *c, uint32_t index)
+{
+    memset(c->mtf, 0, sizeof(c->mtf));
+    c->next_seq = index;
+}
+
+/* Move slot to the front; slot TRACE_V2_MTF pushes v and drops the
+ * last entry. */
+static void trace_v2_promote(trace_v2_ctx *c, uint32_t slot, uint64_t v)
+{
+    if (slot >= TRACE_V2_MTF) slot = TRACE_V2_MTF - 1u;
+    while (slot > 0) {
+        c->mtf[slot] = c->mtf[slot - 1u];
+        slot--;
+    }
+    c->mtf[0] = v;
+}
+
+static uint32_t trace_varint_len(uint64_t v)
+{
+    uint32_t n = 1;
+
+    while (v >= 0x80u) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/* Code for v against the table, updating it; *lit receives the
+ * literal to write for TRACE_V2_XOR / TRACE_V2_RAW. */
+static uint32_t trace_v2_code(trace_v2_ctx *c, uint64_t v, uint64_t *lit)
+{
+    uint64_t x;
+    uint32_t i;
+
+    for (i = 0; i < TRACE_V2_MTF; i++) {
+        if (c->mtf[i] == v) {
+            trace_v2_promote(c, i, v);
+            return i;
+        }
+    }
+    x = v ^ c->mtf[0];
+    if (v >= TRACE_V2_PUSH_MIN) trace_v2_promote(c, TRACE_V2_MTF, v);
+    if (trace_varint_len(x) < trace_varint_len(v)) {
+        *lit = x;
+        return TRACE_V2_XOR;
+    }
+    *lit = v;
+    return TRACE_V2_RAW;
+}
+
+/* Bounded output: bytes past cap are counted, not written, so a
+ * capacity-0 pass sizes the encoding. */
+typedef struct {
+    uint8_t *buf;
+    uint32_t cap;
+    uint32_t pos;
+} trace_writer;
+
+static void trace_put(trace_writer *w, uint8_t b)
+{
+    if (w->pos < w->cap) w->buf[w->pos] = b;
+    w->pos++;
+}
+
+static void trace_put_le(trace_writer *w, uint64_t v, uint32_t bytes)
+{
+    uint32_t i;
+
+    for (i = 0; i < bytes; i++) {
+        trace_put(w, (uint8_t)((v >> (8u * i)) & 0xFFu));
+    }
+}
+
+static void trace_put_varint(trace_writer *w, uint64_t v)
+{
+    while (v >= 0x80u) {
+        trace_put(w, (uint8_t)((v & 0x7Fu) | 0x80u));
+        v >>= 7;
+    }
+    trace_put(w, (uint8_t)v);
+}
+
+static void trace_v2_put_event(trace_writer *w, trace_v2_ctx *c,
+                               const asx_trace_event *e)
+{
+    uint32_t kind = (uint32_t)e->kind;
+    uint64_t elit = 0;
+    uint64_t alit = 0;
+    uint32_t ecode;
+    uint32_t acode;
+    uint8_t tag;
+
+    ecode = trace_v2_code(c, e->entity_id, &elit);
+    acode = trace_v2_code(c, e->aux, &alit);
+
+    tag = (uint8_t)(kind < TRACE_V2_KIND_ESC ? kind : TRACE_V2_KIND_ESC);
+    if (e->sequence != c->next_seq) tag = (uint8_t)(tag | TRACE_V2_SEQ);
+    if (e->status != ASX_OK) tag = (uint8_t)(tag | TRACE_V2_STATUS);
+    trace_put(w, tag);
+    if (kind >= TRACE_V2_KIND_ESC) trace_put_varint(w, kind);
+    if (e->sequence != c->next_seq) trace_put_varint(w, e->sequence);
+    if (e->status != ASX_OK) trace_put_varint(w, (uint32_t)e->status);
+    trace_put(w, (uint8_t)(ecode | (acode << 4)));
+    if (ecode >= TRACE_V2_XOR) trace_put_varint(w, elit);
+    if (acode >= TRACE_V2_XOR) trace_put_varint(w, alit);
+    c->next_seq = e->sequence + 1u;
+}
+
+/* Write the v2 layout of the first count ring events. */
+static void trace_v2_encode(trace_writer *w, uint32_t count, uint64_t digest)
+{
+    uint32_t off[ASX_TRACE_CHECKPOINTS];
+    uint32_t ncp = count / ASX_TRACE_CHECKPOINT_INTERVAL;
+    uint32_t stream;
+    uint32_t end;
+    uint32_t i;
+    trace_v2_ctx c;
+
+    trace_put_le(w, ASX_TRACE_BINARY_MAGIC, 4);
+    trace_put_le(w, ASX_TRACE_BINARY_VERSION_V2, 4);
+    trace_put_le(w, count, 4);
+    trace_put_le(w, ASX_TRACE_CHECKPOINT_INTERVAL, 4);
+    trace_put_le(w, digest, 8);
+
+    /* Events after the table; the table is filled in once the
+     * interval offsets are known */
+    stream = ASX_TRACE_BINARY_HEADER + ncp * ASX_TRACE_BINARY_V2_CHECKPOINT;
+    w->pos = stream;
+    for (i = 0; i < count; i++) {
+        if (i % ASX_TRACE_CHECKPOINT_INTERVAL == 0) {
+            trace_v2_ctx_reset(&c, i);
+        }
+        trace_v2_put_event(w, &c, &g_trace_ring[i]);
+        if ((i + 1u) % ASX_TRACE_CHECKPOINT_INTERVAL == 0) {
+            off[(i + 1u) / ASX_TRACE_CHECKPOINT_INTERVAL - 1u] = w->pos - stream;
+        }
+    }
+
+    end = w->pos;
+    w->pos = ASX_TRACE_BINARY_HEADER;
+    for (i = 0; i < ncp; i++) {
+        trace_put_le(w, g_trace_cp[i], 8);
+        trace_put_le(w, off[i], 4);
+    }
+    w->pos = end;
+}
+
+asx_status asx_trace_export_binary_v2(uint8_t *buf,
+                                       uint32_t capacity,
+                                       uint32_t *out_len)
+{
+    trace_writer w;
+    uint32_t count;
+    uint64_t digest;
+
+    if (buf == NULL || out_len == NULL) return ASX_E_INVALID_ARGUMENT;
+
+    count = g_trace_count < ASX_TRACE_CAPACITY
+            ? g_trace_count
+            : ASX_TRACE_CAPACITY;
+    digest = asx_trace_digest(); /* also brings g_trace_cp up to date */
+
+    /* Size first so a short buffer is left untouched */
+    w.buf = buf;
+    w.cap = 0;
+    w.pos = 0;
+    trace_v2_encode(&w, count, digest);
+    *out_len = w.pos;
+    if (capacity < w.pos) return ASX_E_BUFFER_TOO_SMALL;
+
+    w.cap = capacity;
+    w.pos = 0;
+    trace_v2_encode(&w, count, digest);
+    return ASX_OK;
+}
+
 asx_status asx_trace_export_binary(uint8_t *buf,
                                     uint32_t capacity,
                                     uint32_t *out_len)
 {
     uint32_t count;
+    uint32_t ncp;
+    uint32_t nstatus = 0;
     uint32_t needed;
     uint64_t digest;
     uint32_t i;
@@ -437,7 +825,17 @@ asx_status asx_trace_export_binary(uint8_t *buf,
             ? g_trace_count
             : ASX_TRACE_CAPACITY;
 
-    needed = ASX_TRACE_BINARY_HEADER + count * ASX_TRACE_BINARY_EVENT;
+    for (i = 0; i < count; i++) {
+        if (g_trace_ring[i].status != ASX_OK) nstatus++;
+    }
+
+    ncp = count / ASX_TRACE_CHECKPOINT_INTERVAL;
+    needed = ASX_TRACE_BINARY_HEADER + count * ASX_TRACE_BINARY_EVENT
+           + ncp * ASX_TRACE_BINARY_CHECKPOINT;
+    if (nstatus > 0) {
+        needed += ASX_TRACE_BINARY_STATUS_HEADER
+                + nstatus * ASX_TRACE_BINARY_STATUS;
+    }
     if (capacity < needed) {
         *out_len = needed;
         return ASX_E_BUFFER_TOO_SMALL;
@@ -449,7 +847,7 @@ asx_status asx_trace_export_binary(uint8_t *buf,
     write_le32(buf + 0, ASX_TRACE_BINARY_MAGIC);
     write_le32(buf + 4, ASX_TRACE_BINARY_VERSION);
     write_le32(buf + 8, count);
-    write_le32(buf + 12, 0);  /* reserved */
+    write_le32(buf + 12, ASX_TRACE_CHECKPOINT_INTERVAL);
     write_le64(buf + 16, digest);
 
     /* Write events */
@@ -463,67 +861,312 @@ asx_status asx_trace_export_binary(uint8_t *buf,
         p += ASX_TRACE_BINARY_EVENT;
     }
 
+    /* Write checkpoints */
+    for (i = 0; i < ncp; i++) {
+        write_le64(p, g_trace_cp[i]);
+        p += ASX_TRACE_BINARY_CHECKPOINT;
+    }
+
+    /* Write the status section, only when a record is not ASX_OK */
+    if (nstatus > 0) {
+        write_le32(p + 0, ASX_TRACE_BINARY_STATUS_MAGIC);
+        write_le32(p + 4, nstatus);
+        p += ASX_TRACE_BINARY_STATUS_HEADER;
+        for (i = 0; i < count; i++) {
+            if (g_trace_ring[i].status == ASX_OK) continue;
+            write_le32(p + 0, i);
+            write_le32(p + 4, (uint32_t)g_trace_ring[i].status);
+            p += ASX_TRACE_BINARY_STATUS;
+        }
+    }
+
     *out_len = needed;
     return ASX_OK;
 }
 
-asx_status asx_trace_import_binary(const uint8_t *buf, uint32_t len)
-{
-    uint32_t magic;
+/* -------------------------------------------------------------------
+ * Reader over either wire version
+ *
+ * v1: header | events (fixed 24 bytes) | checkpoints (digest)
+ *     [| statuses (index, status), ascending]
+ * v2: header | checkpoints (digest, interval offset) | event stream
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    const uint8_t *buf;
+    uint32_t len;
     uint32_t version;
     uint32_t count;
-    uint64_t stored_digest;
+    uint32_t interval;
+    uint32_t table;   /* checkpoint table offset */
+    uint32_t stream;  /* first event offset */
+    uint32_t pos;     /* next event offset */
+    uint32_t index;   /* next event index */
+    uint32_t statuses; /* v1 status entries offset, 0 if none */
+    uint32_t nstatus;
+    uint32_t status_next; /* next v1 status entry to match */
+    trace_v2_ctx ctx;
+} trace_reader;
+
+/* Validate an exported buffer's header and fixed-size sections. */
+static asx_status trace_reader_open(trace_reader *r, const uint8_t *buf,
+                                    uint32_t len)
+{
+    uint32_t ncp;
     uint32_t needed;
     uint32_t i;
-    const uint8_t *p;
-    asx_trace_event events[ASX_TRACE_CAPACITY];
-    uint64_t computed_digest;
-    uint64_t hash;
+    uint32_t at;
 
     if (buf == NULL) return ASX_E_INVALID_ARGUMENT;
     if (len < ASX_TRACE_BINARY_HEADER) return ASX_E_INVALID_ARGUMENT;
+    if (read_le32(buf + 0) != ASX_TRACE_BINARY_MAGIC) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    r->buf = buf;
+    r->len = len;
+    r->version = read_le32(buf + 4);
+    r->count = read_le32(buf + 8);
+    r->interval = read_le32(buf + 12);
+    if (r->count > ASX_TRACE_CAPACITY) return ASX_E_INVALID_ARGUMENT;
+    ncp = r->interval != 0 ? r->count / r->interval : 0;
+
+    if (r->version == ASX_TRACE_BINARY_VERSION) {
+        r->stream = ASX_TRACE_BINARY_HEADER;
+        r->table = r->stream + r->count * ASX_TRACE_BINARY_EVENT;
+        needed = r->table + ncp * ASX_TRACE_BINARY_CHECKPOINT;
+    } else if (r->version == ASX_TRACE_BINARY_VERSION_V2) {
+        r->table = ASX_TRACE_BINARY_HEADER;
+        r->stream = r->table + ncp * ASX_TRACE_BINARY_V2_CHECKPOINT;
+        needed = r->stream;
+    } else {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (len < needed) return ASX_E_INVALID_ARGUMENT;
 
-    magic   = read_le32(buf + 0);
-    version = read_le32(buf + 4);
-    count   = read_le32(buf + 8);
-    stored_digest = read_le64(buf + 16);
+    /* Optional v1 status section: indices ascending, within count */
+    r->statuses = 0;
+    r->nstatus = 0;
+    r->status_next = 0;
+    if (r->version == ASX_TRACE_BINARY_VERSION
+        && len - needed >= ASX_TRACE_BINARY_STATUS_HEADER
+        && read_le32(buf + needed) == ASX_TRACE_BINARY_STATUS_MAGIC) {
+        r->nstatus = read_le32(buf + needed + 4);
+        r->statuses = needed + ASX_TRACE_BINARY_STATUS_HEADER;
+        if (r->nstatus > r->count
+            || (len - r->statuses) / ASX_TRACE_BINARY_STATUS < r->nstatus) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        for (i = 0; i < r->nstatus; i++) {
+            at = read_le32(buf + r->statuses + i * ASX_TRACE_BINARY_STATUS);
+            if (at >= r->count
+                || (i > 0 && at <= read_le32(buf + r->statuses
+                          + (i - 1u) * ASX_TRACE_BINARY_STATUS))) {
+                return ASX_E_INVALID_ARGUMENT;
+            }
+        }
+    }
 
-    if (magic != ASX_TRACE_BINARY_MAGIC) return ASX_E_INVALID_ARGUMENT;
-    if (version != ASX_TRACE_BINARY_VERSION) return ASX_E_INVALID_ARGUMENT;
-    if (count > ASX_TRACE_CAPACITY) return ASX_E_INVALID_ARGUMENT;
+    r->pos = r->stream;
+    r->index = 0;
+    return ASX_OK;
+}
 
-    needed = ASX_TRACE_BINARY_HEADER + count * ASX_TRACE_BINARY_EVENT;
-    if (len < needed) return ASX_E_INVALID_ARGUMENT;
+static uint64_t trace_reader_checkpoint(const trace_reader *r, uint32_t j)
+{
+    uint32_t size = r->version == ASX_TRACE_BINARY_VERSION
+                    ? ASX_TRACE_BINARY_CHECKPOINT
+                    : ASX_TRACE_BINARY_V2_CHECKPOINT;
 
-    /* Decode events */
-    p = buf + ASX_TRACE_BINARY_HEADER;
-    for (i = 0; i < count; i++) {
-        events[i].sequence  = read_le32(p + 0);
-        events[i].kind      = (asx_trace_event_kind)read_le32(p + 4);
-        events[i].entity_id = read_le64(p + 8);
-        events[i].aux       = read_le64(p + 16);
-        p += ASX_TRACE_BINARY_EVENT;
+    return read_le64(r->buf + r->table + j * size);
+}
+
+/* Stream offset of interval j (j >= 1) stored in a v2 table */
+static uint32_t trace_reader_offset(const trace_reader *r, uint32_t j)
+{
+    return read_le32(r->buf + r->table
+                     + (j - 1u) * ASX_TRACE_BINARY_V2_CHECKPOINT + 8u);
+}
+
+/* Position the reader at the first event of interval j. */
+static asx_status trace_reader_seek(trace_reader *r, uint32_t j)
+{
+    uint32_t off = 0;
+
+    if (j > 0) {
+        off = r->version == ASX_TRACE_BINARY_VERSION
+              ? j * r->interval * ASX_TRACE_BINARY_EVENT
+              : trace_reader_offset(r, j);
     }
+    if (off > r->len - r->stream) return ASX_E_INVALID_ARGUMENT;
+    r->pos = r->stream + off;
+    r->index = j * r->interval;
+    r->status_next = 0;
+    return ASX_OK;
+}
 
-    /* Verify digest of decoded events matches stored digest */
-    hash = 0x517cc1b727220a95ULL;
-    for (i = 0; i < count; i++) {
-        uint32_t k = (uint32_t)events[i].kind;
-        hash = fnv1a_mix(hash, &events[i].sequence, sizeof(events[i].sequence));
-        hash = fnv1a_mix(hash, &k, sizeof(k));
-        hash = fnv1a_mix(hash, &events[i].entity_id, sizeof(events[i].entity_id));
-        hash = fnv1a_mix(hash, &events[i].aux, sizeof(events[i].aux));
+static asx_status trace_get(trace_reader *r, uint8_t *b)
+{
+    if (r->pos >= r->len) return ASX_E_INVALID_ARGUMENT;
+    *b = r->buf[r->pos++];
+    return ASX_OK;
+}
+
+static asx_status trace_get_varint(trace_reader *r, uint64_t *v)
+{
+    uint32_t shift = 0;
+    uint8_t b;
+
+    *v = 0;
+    do {
+        if (shift > 63u || trace_get(r, &b) != ASX_OK) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+        *v |= (uint64_t)(b & 0x7Fu) << shift;
+        shift += 7u;
+    } while ((b & 0x80u) != 0);
+    return ASX_OK;
+}
+
+static asx_status trace_get_varint32(trace_reader *r, uint32_t *v)
+{
+    uint64_t w;
+
+    if (trace_get_varint(r, &w) != ASX_OK || w > 0xFFFFFFFFu) {
+        return ASX_E_INVALID_ARGUMENT;
     }
-    computed_digest = hash;
+    *v = (uint32_t)w;
+    return ASX_OK;
+}
+
+static asx_status trace_v2_value(trace_reader *r, uint32_t code, uint64_t *v)
+{
+    uint64_t lit;
 
-    if (computed_digest != stored_digest) return ASX_E_INVALID_ARGUMENT;
+    if (code < TRACE_V2_MTF) {
+        *v = r->ctx.mtf[code];
+        trace_v2_promote(&r->ctx, code, *v);
+        return ASX_OK;
+    }
+    if (code > TRACE_V2_RAW) return ASX_E_INVALID_ARGUMENT;
+    if (trace_get_varint(r, &lit) != ASX_OK) return ASX_E_INVALID_ARGUMENT;
+    *v = code == TRACE_V2_XOR ? lit ^ r->ctx.mtf[0] : lit;
+    if (*v >= TRACE_V2_PUSH_MIN) trace_v2_promote(&r->ctx, TRACE_V2_MTF, *v);
+    return ASX_OK;
+}
+
+static asx_status trace_v2_get_event(trace_reader *r, asx_trace_event *out)
+{
+    uint32_t kind;
+    uint32_t status;
+    uint8_t tag;
+    uint8_t ref;
+
+    if (trace_get(r, &tag) != ASX_OK) return ASX_E_INVALID_ARGUMENT;
+    kind = tag & TRACE_V2_KIND_ESC;
+    if (kind == TRACE_V2_KIND_ESC
+        && trace_get_varint32(r, &kind) != ASX_OK) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    out->sequence = r->ctx.next_seq;
+    if ((tag & TRACE_V2_SEQ) != 0
+        && trace_get_varint32(r, &out->sequence) != ASX_OK) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    status = (uint32_t)ASX_OK;
+    if ((tag & TRACE_V2_STATUS) != 0
+        && trace_get_varint32(r, &status) != ASX_OK) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (trace_get(r, &ref) != ASX_OK
+        || trace_v2_value(r, ref & 0x0Fu, &out->entity_id) != ASX_OK
+        || trace_v2_value(r, (uint32_t)ref >> 4, &out->aux) != ASX_OK) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    out->kind = (asx_trace_event_kind)kind;
+    out->status = (asx_status)status;
+    r->ctx.next_seq = out->sequence + 1u;
+    return ASX_OK;
+}
+
+/* Decode the next event. */
+static asx_status trace_reader_next(trace_reader *r, asx_trace_event *out)
+{
+    const uint8_t *p;
+
+    if (r->index >= r->count) return ASX_E_INVALID_ARGUMENT;
+    if (r->version == ASX_TRACE_BINARY_VERSION) {
+        p = r->buf + r->pos;
+        out->sequence  = read_le32(p + 0);
+        out->kind      = (asx_trace_event_kind)read_le32(p + 4);
+        out->entity_id = read_le64(p + 8);
+        out->aux       = read_le64(p + 16);
+        out->status    = ASX_OK;
+        r->pos += ASX_TRACE_BINARY_EVENT;
+        while (r->status_next < r->nstatus) {
+            p = r->buf + r->statuses
+              + r->status_next * ASX_TRACE_BINARY_STATUS;
+            if (read_le32(p) > r->index) break;
+            if (read_le32(p) == r->index) {
+                out->status = (asx_status)read_le32(p + 4);
+            }
+            r->status_next++;
+        }
+    } else {
+        if (r->index == 0
+            || (r->interval != 0 && r->index % r->interval == 0)) {
+            trace_v2_ctx_reset(&r->ctx, r->index);
+        }
+        if (trace_v2_get_event(r, out) != ASX_OK) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+    r->index++;
+    return ASX_OK;
+}
+
+asx_status asx_trace_import_binary(const uint8_t *buf, uint32_t len)
+{
+    trace_reader r;
+    uint32_t i;
+    uint32_t j;
+    asx_trace_event events[ASX_TRACE_CAPACITY];
+    uint64_t cp[ASX_TRACE_CHECKPOINTS];
+    uint64_t computed_digest;
+    asx_status st;
+
+    st = trace_reader_open(&r, buf, len);
+    if (st != ASX_OK) return st;
+
+    /* Decode events, checking v2 interval offsets on the way */
+    for (i = 0; i < r.count; i++) {
+        st = trace_reader_next(&r, &events[i]);
+        if (st != ASX_OK) return st;
+        j = r.interval != 0 ? (i + 1u) / r.interval : 0;
+        if (r.version == ASX_TRACE_BINARY_VERSION_V2 && j > 0
+            && (i + 1u) % r.interval == 0
+            && trace_reader_offset(&r, j) != r.pos - r.stream) {
+            return ASX_E_INVALID_ARGUMENT;
+        }
+    }
+
+    /* Verify digest (and checkpoints, at our interval) of decoded
+     * events against the stored ones */
+    computed_digest = trace_fold(events, 0, r.count, TRACE_DIGEST_BASIS, cp);
+    if (computed_digest != read_le64(buf + 16)) return ASX_E_INVALID_ARGUMENT;
+    if (r.interval == ASX_TRACE_CHECKPOINT_INTERVAL) {
+        for (i = 0; i < r.count / r.interval; i++) {
+            if (trace_reader_checkpoint(&r, i) != cp[i]) {
+                return ASX_E_INVALID_ARGUMENT;
+            }
+        }
+    }
 
     /* Load as replay reference for continuity verification.
      * The trace ring is NOT overwritten — callers that need to
      * compare a replayed trace against the imported reference
      * should emit fresh events into the ring and then call
      * asx_replay_verify() or asx_trace_continuity_check(). */
-    return asx_replay_load_reference(events, count);
+    return asx_replay_load_reference(events, r.count);
 }
 
 asx_status asx_trace_continuity_check(const uint8_t *buf, uint32_t len)
@@ -575,3 +1218,71 @@ asx_status asx_trace_continuity_check(const uint8_t *buf, uint32_t len)
 
     return ASX_OK;
 }
+
+asx_status asx_trace_binary_bisect(const uint8_t *expected,
+                                   uint32_t expected_len,
+                                   const uint8_t *actual,
+                                   uint32_t actual_len,
+                                   asx_replay_result *out)
+{
+    trace_reader er;
+    trace_reader ar;
+    uint32_t common;
+    uint32_t lo, hi, mid;
+    uint32_t i;
+    asx_trace_event e, a;
+    asx_replay_result_kind kind;
+    asx_status st;
+
+    if (out == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = trace_reader_open(&er, expected, expected_len);
+    if (st != ASX_OK) return st;
+    st = trace_reader_open(&ar, actual, actual_len);
+    if (st != ASX_OK) return st;
+
+    memset(out, 0, sizeof(*out));
+    out->expected_digest = read_le64(expected + 16);
+    out->actual_digest = read_le64(actual + 16);
+    common = er.count < ar.count ? er.count : ar.count;
+
+    /* Bisect the shared checkpoints for the first differing interval,
+     * then seek both readers to it */
+    lo = 0;
+    if (er.interval != 0 && er.interval == ar.interval) {
+        hi = common / er.interval;
+        while (lo < hi) {
+            mid = lo + (hi - lo) / 2u;
+            if (trace_reader_checkpoint(&er, mid)
+                == trace_reader_checkpoint(&ar, mid)) {
+                lo = mid + 1u;
+            } else {
+                hi = mid;
+            }
+        }
+        st = trace_reader_seek(&er, lo);
+        if (st == ASX_OK) st = trace_reader_seek(&ar, lo);
+        if (st != ASX_OK) return st;
+    }
+
+    for (i = er.index; i < common; i++) {
+        st = trace_reader_next(&er, &e);
+        if (st == ASX_OK) st = trace_reader_next(&ar, &a);
+        if (st != ASX_OK) return st;
+        kind = trace_event_diff(&a, &e);
+        if (kind != ASX_REPLAY_MATCH) {
+            out->result = kind;
+            out->divergence_index = i;
+            return ASX_OK;
+        }
+    }
+
+    if (er.count != ar.count) {
+        out->result = ASX_REPLAY_LENGTH_MISMATCH;
+        out->divergence_index = common;
+    } else if (out->expected_digest != out->actual_digest) {
+        out->result = ASX_REPLAY_DIGEST_MISMATCH;
+    } else {
+        out->result = ASX_REPLAY_MATCH;
+    }
+    return ASX_OK;
+}
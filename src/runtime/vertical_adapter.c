@@ -43,6 +43,8 @@ static uint64_t compute_decision_digest(const asx_overload_decision *d)
 
 /* -------------------------------------------------------------------
  * Internal: router reject streak (module-level state)
+ *
+ * Process-wide, not per runtime instance: route from one thread.
  * ------------------------------------------------------------------- */
 
 static uint32_t g_router_reject_streak = 0;
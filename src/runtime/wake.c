@@ -0,0 +1,301 @@
+/*
+ * wake.c — cross-thread wake handles for external producers
+ *
+ * The inbox is a Treiber stack: producers push with a CAS on the head,
+ * the consumer takes the whole stack with one exchange and reverses it
+ * into submission order before appending it to the backlog. The
+ * pending flag coalesces signals: a producer signals only when it
+ * flips pending from 0 to 1. The consumer drains the signal first,
+ * then clears pending, then takes the stack. A producer whose flip
+ * lands before the clear has its node taken by this take; one whose
+ * flip lands after it signals again, and that signal is not drained
+ * until the next take. So no wakeup is lost, at the cost of an
+ * occasional spurious one.
+ *
+ * ASX_CHECKPOINT_WAIVER_FILE("wake inbox: CAS retry loops are lock-free "
+ *   "and bounded by concurrent producers; list walks are bounded by the "
+ *   "nodes submitted; registry scans by ASX_MAX_WAKE_HANDLES.")
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/runtime/wake.h>
+#include <asx/runtime/hindsight.h>
+#include <string.h>
+#include "runtime_internal.h"
+
+/* -------------------------------------------------------------------
+ * Inbox primitives
+ * ------------------------------------------------------------------- */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WAKE_LOAD(p)      __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define WAKE_CAS(p, e, v) __atomic_compare_exchange_n((p), (e), (v), 0, \
+                              __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define WAKE_INC(p)       ((void)__atomic_add_fetch((p), 1u, __ATOMIC_RELAXED))
+#else
+/* Volatile-only fallback: producers must then run on the scheduler
+ * thread (or be serialized with it externally). */
+#define WAKE_LOAD(p)      (*(p))
+#define WAKE_CAS(p, e, v) (*(p) == *(e) ? (*(p) = (v), 1) : (*(e) = *(p), 0))
+#define WAKE_INC(p)       ((void)(*(p) += 1u))
+#endif
+
+static uint32_t wake_flag_xchg(volatile uint32_t *p, uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_exchange_n(p, v, __ATOMIC_SEQ_CST);
+#else
+    uint32_t old = *p;
+
+    *p = v;
+    return old;
+#endif
+}
+
+static asx_wake_node *wake_inbox_take(asx_wake_node *volatile *p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_exchange_n(p, (asx_wake_node *)NULL, __ATOMIC_SEQ_CST);
+#else
+    asx_wake_node *old = *p;
+
+    *p = NULL;
+    return old;
+#endif
+}
+
+#define g_wake_handles (g_rt->wake_handles)
+#define g_wake_count   (g_rt->wake_count)
+
+/* -------------------------------------------------------------------
+ * Handle lifecycle
+ * ------------------------------------------------------------------- */
+
+asx_status asx_wake_handle_init(asx_wake_handle *h, asx_region_id region,
+                                asx_wake_drain_fn drain_fn, void *drain_ctx,
+                                const asx_wake_signal *signal)
+{
+    asx_region_slot *rslot;
+    asx_status st;
+    uint32_t i;
+
+    if (h == NULL || drain_fn == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = asx_region_slot_lookup(region, &rslot);
+    if (st != ASX_OK) return st;
+    for (i = 0; i < g_wake_count; i++) {
+        if (g_wake_handles[i] == h) return ASX_E_INVALID_STATE;
+    }
+    if (g_wake_count >= ASX_MAX_WAKE_HANDLES) return ASX_E_RESOURCE_EXHAUSTED;
+
+    memset(h, 0, sizeof(*h));
+    h->rt = g_rt;
+    h->region = region;
+    h->drain_fn = drain_fn;
+    h->drain_ctx = drain_ctx;
+    if (signal != NULL) h->signal = *signal;
+    g_wake_handles[g_wake_count++] = h;
+    return ASX_OK;
+}
+
+void asx_wake_handle_destroy(asx_wake_handle *h)
+{
+    asx_runtime *prev;
+    uint32_t i;
+
+    if (h == NULL || h->rt == NULL) return;
+    prev = asx_runtime_enter(h->rt);
+    for (i = 0; i < g_wake_count; i++) {
+        if (g_wake_handles[i] == h) {
+            g_wake_handles[i] = g_wake_handles[--g_wake_count];
+            g_wake_handles[g_wake_count] = NULL;
+            break;
+        }
+    }
+    g_rt = prev;
+    h->rt = NULL;
+    h->inbox = NULL;
+    h->backlog_head = NULL;
+    h->backlog_tail = NULL;
+}
+
+/* -------------------------------------------------------------------
+ * Producer side
+ * ------------------------------------------------------------------- */
+
+asx_status asx_wake_submit(asx_wake_handle *h, asx_wake_node *node)
+{
+    asx_wake_node *head;
+
+    if (h == NULL || node == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (h->rt == NULL) return ASX_E_INVALID_STATE;
+
+    head = WAKE_LOAD(&h->inbox);
+    do {
+        node->next = head;
+    } while (!WAKE_CAS(&h->inbox, &head, node));
+
+    if (wake_flag_xchg(&h->pending, 1u) == 0u) {
+        WAKE_INC(&h->signals);
+        if (h->signal.signal_fn != NULL) h->signal.signal_fn(h->signal.ctx);
+    }
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Consumer side
+ * ------------------------------------------------------------------- */
+
+/* Move the inbox onto the backlog tail in submission order. */
+static void wake_take(asx_wake_handle *h)
+{
+    asx_wake_node *stack;
+    asx_wake_node *fifo = NULL;
+    asx_wake_node *tail;
+    asx_wake_node *next;
+
+    /* Order matters: a signal drained after pending is cleared could
+     * belong to a producer that will not signal again */
+    if (h->signal.clear_fn != NULL) h->signal.clear_fn(h->signal.ctx);
+    (void)wake_flag_xchg(&h->pending, 0u);
+    stack = wake_inbox_take(&h->inbox);
+    if (stack == NULL) return;
+
+    tail = stack;
+    while (stack != NULL) {
+        next = stack->next;
+        stack->next = fifo;
+        fifo = stack;
+        stack = next;
+    }
+    if (h->backlog_tail != NULL) {
+        h->backlog_tail->next = fifo;
+    } else {
+        h->backlog_head = fifo;
+    }
+    h->backlog_tail = tail;
+}
+
+/* Drain with the handle's instance already current. */
+static asx_status wake_drain_current(asx_wake_handle *h, uint32_t *out_count)
+{
+    asx_wake_node *node;
+    asx_status st = ASX_OK;
+    uint32_t count = 0;
+
+    wake_take(h);
+    while ((node = h->backlog_head) != NULL) {
+        h->backlog_head = node->next;
+        if (h->backlog_head == NULL) h->backlog_tail = NULL;
+        node->next = NULL;
+        st = h->drain_fn(h->drain_ctx, node);
+        if (st != ASX_OK) {
+            /* Not accepted: put it back at the front */
+            node->next = h->backlog_head;
+            h->backlog_head = node;
+            if (h->backlog_tail == NULL) h->backlog_tail = node;
+            h->stalls++;
+            break;
+        }
+        count++;
+    }
+
+    if (count > 0) {
+        h->drains++;
+        h->delivered += count;
+        asx_hindsight_log(ASX_ND_WAKE_DRAIN, (uint64_t)h->region, count);
+    }
+    if (out_count != NULL) *out_count = count;
+    if (st == ASX_E_CHANNEL_FULL || st == ASX_E_WOULD_BLOCK) st = ASX_OK;
+    return st;
+}
+
+asx_status asx_wake_drain(asx_wake_handle *h, uint32_t *out_count)
+{
+    asx_runtime *prev;
+    asx_status st;
+
+    if (out_count != NULL) *out_count = 0;
+    if (h == NULL) return ASX_E_INVALID_ARGUMENT;
+    if (h->rt == NULL) return ASX_E_INVALID_STATE;
+
+    prev = asx_runtime_enter(h->rt);
+    st = wake_drain_current(h, out_count);
+    g_rt = prev;
+    return st;
+}
+
+asx_status asx_wake_drain_to_channel(void *ctx, asx_wake_node *node)
+{
+    asx_send_permit permit;
+    asx_status st;
+
+    if (ctx == NULL || node == NULL) return ASX_E_INVALID_ARGUMENT;
+    st = asx_channel_try_reserve(*(const asx_channel_id *)ctx, &permit);
+    if (st != ASX_OK) return st;
+    return asx_send_permit_send(&permit, node->value);
+}
+
+asx_status asx_wake_stats_get(const asx_wake_handle *h, asx_wake_stats *out)
+{
+    if (h == NULL || out == NULL) return ASX_E_INVALID_ARGUMENT;
+    out->signals = h->signals;
+    out->drains = h->drains;
+    out->stalls = h->stalls;
+    out->delivered = h->delivered;
+    return ASX_OK;
+}
+
+/* -------------------------------------------------------------------
+ * Scheduler integration (runtime_internal.h)
+ * ------------------------------------------------------------------- */
+
+void asx_wake_drain_region(asx_region_id region)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_wake_count; i++) {
+        asx_wake_handle *h = g_wake_handles[i];
+
+        if (h->region != region) continue;
+        if (h->backlog_head == NULL && WAKE_LOAD(&h->inbox) == NULL) continue;
+        /* Drain fn errors stay with the handle's stall counter; the
+         * scheduler keeps running the region. */
+        if (wake_drain_current(h, NULL) != ASX_OK) continue;
+    }
+}
+
+int asx_wake_region_bound(asx_region_id region)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_wake_count; i++) {
+        if (g_wake_handles[i]->region == region) return 1;
+    }
+    return 0;
+}
+
+int asx_wake_region_pending(asx_region_id region)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_wake_count; i++) {
+        if (g_wake_handles[i]->region == region
+            && WAKE_LOAD(&g_wake_handles[i]->inbox) != NULL) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void asx_wake_registry_reset(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_wake_count; i++) {
+        g_wake_handles[i]->rt = NULL;
+        g_wake_handles[i] = NULL;
+    }
+    g_wake_count = 0;
+}
@@ -3,7 +3,9 @@
  *
  * Walking-skeleton implementation using a flat arena of timer slots.
  * Provides deterministic tie-break ordering (deadline ASC, insertion_seq ASC)
- * and O(1) cancel via generation-validated handles.
+ * and O(1) cancel via generation-validated handles. Slack is stored as
+ * each slot's latest firing time; the next batch is due at the
+ * minimum latest over live timers.
  *
  * Phase 5 will upgrade to a hierarchical 4-level wheel with occupied
  * bitmaps for O(1) skip optimization. The flat approach is correct and
@@ -15,38 +17,14 @@
 #include <asx/time/timer_wheel.h>
 #include <asx/asx_config.h>
 #include <string.h>
+#include "../runtime/runtime_internal.h"
 
 /* -------------------------------------------------------------------
- * Timer slot (internal)
+ * Per-instance wheel (slot and wheel types in runtime_internal.h)
  * ------------------------------------------------------------------- */
 
-typedef struct {
-    asx_time  deadline;       /* when this timer fires */
-    void     *waker_data;     /* opaque callback data */
-    uint64_t  insertion_seq;  /* monotonic tie-break key */
-    uint16_t  generation;     /* for stale-handle detection */
-    int       alive;          /* 1 if slot is live (not cancelled/fired) */
-} asx_timer_slot;
-
-/* -------------------------------------------------------------------
- * Timer wheel structure
- * ------------------------------------------------------------------- */
-
-struct asx_timer_wheel {
-    asx_timer_slot slots[ASX_MAX_TIMERS];
-    uint32_t       slot_count;       /* high-water mark for slot allocation */
-    uint32_t       active_count;     /* number of alive timers */
-    uint64_t       next_insertion;   /* monotonic insertion sequence */
-    asx_time       current_time;     /* last advanced-to time */
-    uint64_t       max_duration_ns;  /* maximum allowed timer duration */
-};
-
-/* -------------------------------------------------------------------
- * Global singleton instance
- * ------------------------------------------------------------------- */
-
-static asx_timer_wheel g_wheel;
-static int g_wheel_initialized = 0;
+#define g_wheel             (g_rt->wheel)
+#define g_wheel_initialized (g_rt->wheel_initialized)
 
 asx_timer_wheel *asx_timer_wheel_global(void)
 {
@@ -68,6 +46,7 @@ void asx_timer_wheel_init(asx_timer_wheel *wheel)
 
     for (i = 0; i < ASX_MAX_TIMERS; i++) {
         wheel->slots[i].deadline = 0;
+        wheel->slots[i].latest = 0;
         wheel->slots[i].waker_data = NULL;
         wheel->slots[i].insertion_seq = 0;
         wheel->slots[i].generation = 0;
@@ -93,6 +72,16 @@ asx_status asx_timer_register(asx_timer_wheel *wheel,
                                asx_time deadline,
                                void *waker_data,
                                asx_timer_handle *out_handle)
+{
+    return asx_timer_register_slack(wheel, deadline, 0, waker_data,
+                                    out_handle);
+}
+
+asx_status asx_timer_register_slack(asx_timer_wheel *wheel,
+                                     asx_time deadline,
+                                     uint64_t slack_ns,
+                                     void *waker_data,
+                                     asx_timer_handle *out_handle)
 {
     uint32_t idx;
     uint64_t delta;
@@ -129,6 +118,8 @@ asx_status asx_timer_register(asx_timer_wheel *wheel,
     }
 
     wheel->slots[idx].deadline = deadline;
+    wheel->slots[idx].latest = slack_ns > UINT64_MAX - deadline
+                             ? UINT64_MAX : deadline + slack_ns;
     wheel->slots[idx].waker_data = waker_data;
     wheel->slots[idx].insertion_seq = wheel->next_insertion++;
     wheel->slots[idx].generation++;
@@ -142,6 +133,41 @@ asx_status asx_timer_register(asx_timer_wheel *wheel,
     return ASX_OK;
 }
 
+/* -------------------------------------------------------------------
+ * Slack batching
+ * ------------------------------------------------------------------- */
+
+int asx_timer_next_expiry(const asx_timer_wheel *wheel, asx_time *out_time)
+{
+    uint32_t i;
+    int found = 0;
+    asx_time next = 0;
+
+    if (wheel == NULL || out_time == NULL) return 0;
+    for (i = 0; i < wheel->slot_count; i++) {
+        ASX_CHECKPOINT_WAIVER("bounded: slot_count <= ASX_MAX_TIMERS");
+        if (!wheel->slots[i].alive) continue;
+        if (!found || wheel->slots[i].latest < next) {
+            next = wheel->slots[i].latest;
+            found = 1;
+        }
+    }
+    if (found) *out_time = next;
+    return found;
+}
+
+uint32_t asx_timer_wait_ms(const asx_timer_wheel *wheel, asx_time now,
+                           uint32_t max_ms)
+{
+    asx_time next;
+    uint64_t ms;
+
+    if (!asx_timer_next_expiry(wheel, &next)) return max_ms;
+    if (next <= now) return 0;
+    ms = (next - now + 999999u) / 1000000u;
+    return ms < max_ms ? (uint32_t)ms : max_ms;
+}
+
 /* -------------------------------------------------------------------
  * Timer cancellation — O(1)
  * ------------------------------------------------------------------- */
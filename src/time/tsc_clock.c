@@ -0,0 +1,150 @@
+/*
+ * tsc_clock.c — calibrated cycle-counter clock hook
+ *
+ * Portable conversion and resync logic; the platform adapter supplies
+ * the counter and reference reads. 64x64 products are formed from
+ * 32-bit limbs so the conversion needs no 128-bit type.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/time/tsc_clock.h>
+#include <string.h>
+
+/* Rate re-derivation needs (delta_ns << ASX_TSC_SHIFT) to fit */
+#define TSC_MAX_RATE_NS   ((uint64_t)1 << 31)
+#define TSC_CALIB_SPIN_MAX 100000000u
+
+/* (a * m) >> 32, modulo 2^64 */
+static uint64_t tsc_mul_shift(uint64_t a, uint64_t m)
+{
+    uint64_t ah = a >> 32, al = a & 0xFFFFFFFFu;
+    uint64_t mh = m >> 32, ml = m & 0xFFFFFFFFu;
+
+    return ((ah * mh) << 32) + ah * ml + al * mh + ((al * ml) >> 32);
+}
+
+static void tsc_enter_fallback(asx_tsc_clock *clk, asx_time now)
+{
+    clk->fallback = 1;
+    clk->mult = 0;
+    clk->resync_cycles = 0;
+    clk->base_ns = now;
+    clk->last_ns = now;
+}
+
+asx_status asx_tsc_clock_init(asx_tsc_clock *clk, const asx_tsc_source *src,
+                              uint64_t calibration_ns, uint64_t resync_ns)
+{
+    asx_time r0, r1;
+    uint64_t c0, c1;
+    uint32_t spins;
+
+    if (clk == NULL || src == NULL || src->read_ref == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (src->invariant && src->read_counter == NULL) {
+        return ASX_E_INVALID_ARGUMENT;
+    }
+    if (calibration_ns == 0) calibration_ns = ASX_TSC_DEFAULT_CALIBRATION_NS;
+    if (calibration_ns >= TSC_MAX_RATE_NS) calibration_ns = TSC_MAX_RATE_NS - 1u;
+    if (resync_ns == 0) resync_ns = ASX_TSC_DEFAULT_RESYNC_NS;
+    if (resync_ns >= TSC_MAX_RATE_NS) resync_ns = TSC_MAX_RATE_NS - 1u;
+
+    memset(clk, 0, sizeof(*clk));
+    clk->src = *src;
+    clk->resync_ns = resync_ns;
+
+    r0 = src->read_ref(src->ctx);
+    if (!src->invariant) {
+        tsc_enter_fallback(clk, r0);
+        return ASX_OK;
+    }
+
+    /* Sample the counter across a reference window */
+    c0 = src->read_counter(src->ctx);
+    r1 = r0;
+    for (spins = 0; spins < TSC_CALIB_SPIN_MAX; spins++) {
+        ASX_CHECKPOINT_WAIVER("bounded: calibration spin <= TSC_CALIB_SPIN_MAX");
+        r1 = src->read_ref(src->ctx);
+        if (r1 >= r0 && r1 - r0 >= calibration_ns) break;
+    }
+    c1 = src->read_counter(src->ctx);
+    if (r1 <= r0 || r1 - r0 >= TSC_MAX_RATE_NS || c1 <= c0) {
+        tsc_enter_fallback(clk, r1);
+        return ASX_OK;
+    }
+
+    clk->mult = ((r1 - r0) << ASX_TSC_SHIFT) / (c1 - c0);
+    if (clk->mult == 0) {
+        tsc_enter_fallback(clk, r1);
+        return ASX_OK;
+    }
+    clk->resync_cycles = (resync_ns << ASX_TSC_SHIFT) / clk->mult;
+    clk->base_cycles = c1;
+    clk->base_ns = r1;
+    clk->last_ns = r1;
+    return ASX_OK;
+}
+
+/* Re-derive the rate over the interval since the last base and rebase
+ * on a fresh reference reading. */
+static asx_time tsc_resync(asx_tsc_clock *clk, uint64_t cycles)
+{
+    asx_time ref = clk->src.read_ref(clk->src.ctx);
+    uint64_t dc = cycles - clk->base_cycles;
+    uint64_t mult;
+
+    if (ref > clk->base_ns && ref - clk->base_ns < TSC_MAX_RATE_NS
+        && cycles > clk->base_cycles) {
+        mult = ((ref - clk->base_ns) << ASX_TSC_SHIFT) / dc;
+        if (mult != 0) {
+            clk->mult = mult;
+            clk->resync_cycles = (clk->resync_ns << ASX_TSC_SHIFT) / mult;
+        }
+    }
+    clk->base_cycles = cycles;
+    clk->base_ns = ref;
+    clk->resyncs++;
+    return ref;
+}
+
+asx_time asx_tsc_clock_now(asx_tsc_clock *clk)
+{
+    asx_time t;
+    uint64_t cycles;
+    uint64_t dc;
+
+    if (clk == NULL) return 0;
+    if (clk->fallback) {
+        t = clk->src.read_ref(clk->src.ctx);
+    } else {
+        cycles = clk->src.read_counter(clk->src.ctx);
+        dc = cycles - clk->base_cycles;
+        if (dc >= clk->resync_cycles) {
+            t = tsc_resync(clk, cycles);
+        } else {
+            t = clk->base_ns + tsc_mul_shift(dc, clk->mult);
+        }
+    }
+    if (t < clk->last_ns) t = clk->last_ns;
+    clk->last_ns = t;
+    return t;
+}
+
+int asx_tsc_clock_is_fallback(const asx_tsc_clock *clk)
+{
+    return clk == NULL || clk->fallback;
+}
+
+static asx_time tsc_hook_now(void *ctx)
+{
+    return asx_tsc_clock_now((asx_tsc_clock *)ctx);
+}
+
+void asx_tsc_clock_hooks(asx_tsc_clock *clk, asx_clock_hooks *out)
+{
+    if (clk == NULL || out == NULL) return;
+    out->ctx = clk;
+    out->now_ns_fn = tsc_hook_now;
+}
@@ -1,9 +1,10 @@
 /*
  * bench_runtime.c — performance benchmark suite for asx runtime (bd-1md.6)
  *
- * Microbenchmarks for scheduler, timer wheel, channel, and quiescence
- * paths. Emits p50/p95/p99/p99.9/p99.99 plus jitter and deadline-miss
- * metrics in machine-readable JSON for CI gates and trend tracking.
+ * Microbenchmarks for scheduler, cancellation, timer wheel, channel,
+ * and quiescence paths. Emits p50/p95/p99/p99.9/p99.99 plus jitter
+ * and deadline-miss metrics in machine-readable JSON for CI gates and
+ * trend tracking.
  *
  * Build:  make bench
  * Run:    build/bench/bench_runtime [--json]
@@ -846,6 +847,92 @@ static bench_adaptive_report bench_adaptive_metrics(void)
     return rpt;
 }
 
+/* -------------------------------------------------------------------
+ * BENCH 14: Scheduler — parked-task scan
+ *
+ * Measures: rounds over a full region where every task but one is
+ * parked awaiting it. Each round walks the live list and skips the
+ * parked tasks, so the cost is the per-slot scan of the task arena.
+ * ------------------------------------------------------------------- */
+
+static asx_status await_poll(void *user_data, asx_task_id self)
+{
+    return asx_task_await(self, *(const asx_task_id *)user_data);
+}
+
+static bench_stats bench_scheduler_parked_scan(void)
+{
+    bench_samples s;
+    uint32_t iter;
+
+    bench_samples_init(&s);
+
+    for (iter = 0; iter < 1000; iter++) {
+        asx_region_id rid;
+        asx_task_id lead;
+        asx_task_id tid;
+        asx_budget budget;
+        uint64_t t0, t1;
+        uint32_t t_i;
+        countdown_ctx lead_ctx;
+
+        asx_runtime_reset();
+        (void)asx_region_open(&rid);
+
+        lead_ctx.remaining = 64;
+        (void)asx_task_spawn(rid, countdown_poll, &lead_ctx, &lead);
+        for (t_i = 1; t_i < ASX_MAX_TASKS; t_i++) {
+            (void)asx_task_spawn(rid, await_poll, &lead, &tid);
+        }
+
+        budget = asx_budget_from_polls(ASX_MAX_TASKS * 2u);
+
+        t0 = bench_now_ns();
+        (void)asx_scheduler_run(rid, &budget);
+        t1 = bench_now_ns();
+
+        bench_samples_add(&s, t1 - t0);
+    }
+
+    return bench_compute_stats(&s);
+}
+
+/* -------------------------------------------------------------------
+ * BENCH 15: Cancellation — region-wide sweep
+ *
+ * Measures: asx_cancel_propagate over a region holding ASX_MAX_TASKS
+ * live tasks (the cancel sweep over the task arena).
+ * ------------------------------------------------------------------- */
+
+static bench_stats bench_cancel_sweep(void)
+{
+    bench_samples s;
+    uint32_t iter;
+
+    bench_samples_init(&s);
+
+    for (iter = 0; iter < 2000; iter++) {
+        asx_region_id rid;
+        asx_task_id tid;
+        uint64_t t0, t1;
+        uint32_t t_i;
+
+        asx_runtime_reset();
+        (void)asx_region_open(&rid);
+        for (t_i = 0; t_i < ASX_MAX_TASKS; t_i++) {
+            (void)asx_task_spawn(rid, noop_poll, NULL, &tid);
+        }
+
+        t0 = bench_now_ns();
+        (void)asx_cancel_propagate(rid, ASX_CANCEL_USER);
+        t1 = bench_now_ns();
+
+        bench_samples_add(&s, t1 - t0);
+    }
+
+    return bench_compute_stats(&s);
+}
+
 /* -------------------------------------------------------------------
  * Main — run all benchmarks and emit JSON report
  * ------------------------------------------------------------------- */
@@ -915,6 +1002,17 @@ int main(int argc, char **argv)
     if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
     bench_print_stats_json("scheduler_multi_round", &st, 0);
 
+    if (!json_only) fprintf(stderr, "  scheduler_parked_scan... ");
+    st = bench_scheduler_parked_scan();
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
+    bench_print_stats_json("scheduler_parked_scan", &st, 0);
+
+    /* Cancellation benchmark */
+    if (!json_only) fprintf(stderr, "  cancel_sweep... ");
+    st = bench_cancel_sweep();
+    if (!json_only) fprintf(stderr, "done (p50=%" PRIu64 "ns)\n", st.p50);
+    bench_print_stats_json("cancel_sweep", &st, 0);
+
     /* Timer benchmarks */
     if (!json_only) fprintf(stderr, "  timer_register... ");
     st = bench_timer_register();
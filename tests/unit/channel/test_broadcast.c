@@ -0,0 +1,272 @@
+/*
+ * test_broadcast.c — single-producer broadcast channel
+ *
+ * Tests that every subscriber reads each message once through its own
+ * cursor, that a full ring follows the overload policy (REJECT,
+ * BACKPRESSURE, SHED_OLDEST) and never drops silently, that close
+ * drains before disconnecting, and that handles are validated.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/core/broadcast.h>
+#include <asx/runtime/runtime.h>
+#include "test_harness.h"
+
+#define CH_IGNORE(expr) \
+    do { volatile asx_status _ch_ign = (expr); (void)_ch_ign; } while (0)
+
+static asx_region_id g_rid;
+
+static void setup(void)
+{
+    asx_runtime_reset();
+    asx_broadcast_reset();
+    CH_IGNORE(asx_region_open(&g_rid));
+}
+
+static void policy_full(asx_overload_policy *pol, asx_overload_mode mode,
+                        uint32_t shed_max)
+{
+    asx_overload_policy_init(pol);
+    pol->mode = mode;
+    pol->threshold_pct = 100u;
+    pol->shed_max = shed_max;
+}
+
+/* -------------------------------------------------------------------
+ * Fan-out
+ * ------------------------------------------------------------------- */
+
+TEST(broadcast_fans_out_to_each_subscriber)
+{
+    asx_broadcast_id bc;
+    asx_subscriber_id a, b;
+    uint64_t value, missed;
+    uint32_t pending;
+    uint64_t i;
+
+    setup();
+    ASSERT_EQ(asx_broadcast_create(g_rid, 8, NULL, &bc), ASX_OK);
+
+    /* No subscriber: nobody to deliver to */
+    ASSERT_EQ(asx_broadcast_send(bc, 1u), ASX_E_DISCONNECTED);
+
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &a), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bc, 10u), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &b), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bc, 20u), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bc, 30u), ASX_OK);
+
+    /* b joined after the first message */
+    ASSERT_EQ(asx_broadcast_lag(a, &pending, NULL), ASX_OK);
+    ASSERT_EQ(pending, (uint32_t)3);
+    ASSERT_EQ(asx_broadcast_lag(b, &pending, NULL), ASX_OK);
+    ASSERT_EQ(pending, (uint32_t)2);
+
+    for (i = 1; i <= 3u; i++) {
+        ASSERT_EQ(asx_broadcast_try_recv(a, &value, &missed), ASX_OK);
+        ASSERT_EQ(value, i * 10u);
+        ASSERT_EQ(missed, (uint64_t)0);
+    }
+    ASSERT_EQ(asx_broadcast_try_recv(a, &value, NULL), ASX_E_WOULD_BLOCK);
+
+    ASSERT_EQ(asx_broadcast_try_recv(b, &value, NULL), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)20);
+    ASSERT_EQ(asx_broadcast_try_recv(b, &value, NULL), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)30);
+    ASSERT_EQ(asx_broadcast_try_recv(b, &value, NULL), ASX_E_WOULD_BLOCK);
+}
+
+/* -------------------------------------------------------------------
+ * Overload policy
+ * ------------------------------------------------------------------- */
+
+TEST(broadcast_reject_and_backpressure_on_slowest)
+{
+    asx_overload_policy pol;
+    asx_broadcast_id rej, bp;
+    asx_subscriber_id fast, slow, sub;
+    asx_broadcast_stats stats;
+    uint64_t value;
+    uint32_t i;
+
+    setup();
+    ASSERT_EQ(asx_broadcast_create(g_rid, 4, NULL, &rej), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(rej, &fast), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(rej, &slow), ASX_OK);
+
+    /* The fast reader keeping up does not free the ring */
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_broadcast_send(rej, i), ASX_OK);
+        ASSERT_EQ(asx_broadcast_try_recv(fast, &value, NULL), ASX_OK);
+    }
+    ASSERT_EQ(asx_broadcast_send(rej, 99u), ASX_E_ADMISSION_CLOSED);
+    ASSERT_EQ(asx_broadcast_try_recv(slow, &value, NULL), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)0);
+    ASSERT_EQ(asx_broadcast_send(rej, 4u), ASX_OK);
+
+    ASSERT_EQ(asx_broadcast_get_stats(rej, &stats), ASX_OK);
+    ASSERT_EQ(stats.sent, (uint64_t)5);
+    ASSERT_EQ(stats.rejected, (uint64_t)1);
+    ASSERT_EQ(stats.max_lag, (uint32_t)4);
+
+    policy_full(&pol, ASX_OVERLOAD_BACKPRESSURE, 1u);
+    ASSERT_EQ(asx_broadcast_create(g_rid, 2, &pol, &bp), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(bp, &sub), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bp, 1u), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bp, 2u), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bp, 3u), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(asx_broadcast_send(bp, 3u), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(asx_broadcast_try_recv(sub, &value, NULL), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bp, 3u), ASX_OK);
+
+    ASSERT_EQ(asx_broadcast_get_stats(bp, &stats), ASX_OK);
+    ASSERT_EQ(stats.sent, (uint64_t)3);
+    ASSERT_EQ(stats.deferred, (uint64_t)2);
+    ASSERT_EQ(stats.rejected, (uint64_t)0);
+}
+
+TEST(broadcast_shed_oldest_reports_missed)
+{
+    asx_overload_policy pol;
+    asx_broadcast_id bc;
+    asx_subscriber_id fast, slow;
+    asx_broadcast_stats stats;
+    uint64_t value, missed;
+    uint32_t pending, i;
+
+    setup();
+    policy_full(&pol, ASX_OVERLOAD_SHED_OLDEST, 2u);
+    ASSERT_EQ(asx_broadcast_create(g_rid, 4, &pol, &bc), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &fast), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &slow), ASX_OK);
+
+    /* 0..3 fill the ring; 4 sheds 0,1; 5 fits; 6 sheds 2,3 */
+    for (i = 0; i < 7u; i++) {
+        ASSERT_EQ(asx_broadcast_send(bc, i), ASX_OK);
+        if (i == 1u) {
+            ASSERT_EQ(asx_broadcast_try_recv(fast, &value, NULL), ASX_OK);
+            ASSERT_EQ(asx_broadcast_try_recv(fast, &value, NULL), ASX_OK);
+        }
+    }
+
+    ASSERT_EQ(asx_broadcast_lag(slow, &pending, &missed), ASX_OK);
+    ASSERT_EQ(pending, (uint32_t)3);
+    ASSERT_EQ(missed, (uint64_t)4);
+    ASSERT_EQ(asx_broadcast_lag(fast, &pending, &missed), ASX_OK);
+    ASSERT_EQ(missed, (uint64_t)2);
+
+    /* try_recv reports the gap once, then resets it */
+    ASSERT_EQ(asx_broadcast_try_recv(slow, &value, &missed), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)4);
+    ASSERT_EQ(missed, (uint64_t)4);
+    ASSERT_EQ(asx_broadcast_try_recv(slow, &value, &missed), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)5);
+    ASSERT_EQ(missed, (uint64_t)0);
+
+    ASSERT_EQ(asx_broadcast_try_recv(fast, &value, &missed), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)4);
+    ASSERT_EQ(missed, (uint64_t)2);
+
+    ASSERT_EQ(asx_broadcast_get_stats(bc, &stats), ASX_OK);
+    ASSERT_EQ(stats.sent, (uint64_t)7);
+    ASSERT_EQ(stats.shed, (uint64_t)4);
+}
+
+/* -------------------------------------------------------------------
+ * Close
+ * ------------------------------------------------------------------- */
+
+TEST(broadcast_close_drains_then_disconnects)
+{
+    asx_broadcast_id bc;
+    asx_subscriber_id sub, late;
+    uint64_t value;
+
+    setup();
+    ASSERT_EQ(asx_broadcast_create(g_rid, 4, NULL, &bc), ASX_OK);
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &sub), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bc, 5u), ASX_OK);
+    ASSERT_EQ(asx_broadcast_close(bc), ASX_OK);
+
+    ASSERT_EQ(asx_broadcast_close(bc), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_broadcast_send(bc, 6u), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &late), ASX_E_INVALID_STATE);
+
+    ASSERT_EQ(asx_broadcast_try_recv(sub, &value, NULL), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)5);
+    ASSERT_EQ(asx_broadcast_try_recv(sub, &value, NULL), ASX_E_DISCONNECTED);
+}
+
+/* -------------------------------------------------------------------
+ * Handles and limits
+ * ------------------------------------------------------------------- */
+
+TEST(broadcast_validates_handles_and_limits)
+{
+    asx_overload_policy pol;
+    asx_broadcast_id bc, other;
+    asx_subscriber_id subs[ASX_BROADCAST_MAX_SUBSCRIBERS], extra;
+    uint64_t value;
+    uint32_t i;
+
+    setup();
+    ASSERT_EQ(asx_broadcast_create(g_rid, 0, NULL, &bc),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_broadcast_create(g_rid, ASX_BROADCAST_MAX_CAPACITY + 1u,
+                                   NULL, &bc), ASX_E_INVALID_ARGUMENT);
+    policy_full(&pol, ASX_OVERLOAD_REJECT, 1u);
+    pol.threshold_pct = 0u;
+    ASSERT_EQ(asx_broadcast_create(g_rid, 4, &pol, &bc),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_broadcast_create(ASX_INVALID_ID, 4, NULL, &bc),
+              ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_broadcast_create(g_rid, 4, NULL, &bc), ASX_OK);
+    ASSERT_EQ(asx_broadcast_create(g_rid, 4, NULL, &other), ASX_OK);
+    for (i = 0; i < ASX_BROADCAST_MAX_SUBSCRIBERS; i++) {
+        ASSERT_EQ(asx_broadcast_subscribe(bc, &subs[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &extra),
+              ASX_E_RESOURCE_EXHAUSTED);
+    /* Subscriber tables are per broadcast */
+    ASSERT_EQ(asx_broadcast_subscribe(other, &extra), ASX_OK);
+
+    /* Unsubscribe frees the slot and stales the handle */
+    ASSERT_EQ(asx_broadcast_unsubscribe(subs[3]), ASX_OK);
+    ASSERT_EQ(asx_broadcast_try_recv(subs[3], &value, NULL),
+              ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_broadcast_subscribe(bc, &extra), ASX_OK);
+    ASSERT_NE(extra, subs[3]);
+    ASSERT_EQ(asx_broadcast_try_recv(subs[3], &value, NULL),
+              ASX_E_STALE_HANDLE);
+
+    /* Handle types are not interchangeable */
+    ASSERT_EQ(asx_broadcast_send((asx_broadcast_id)extra, 1u),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_broadcast_try_recv((asx_subscriber_id)bc, &value, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_broadcast_send(g_rid, 1u), ASX_E_INVALID_ARGUMENT);
+
+    /* Reset stales every outstanding handle */
+    asx_broadcast_reset();
+    ASSERT_EQ(asx_broadcast_send(bc, 1u), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_broadcast_create(g_rid, 4, NULL, &other), ASX_OK);
+    ASSERT_EQ(asx_broadcast_send(bc, 1u), ASX_E_STALE_HANDLE);
+}
+
+int main(void)
+{
+    fprintf(stderr, "=== test_broadcast ===\n");
+
+    RUN_TEST(broadcast_fans_out_to_each_subscriber);
+    RUN_TEST(broadcast_reject_and_backpressure_on_slowest);
+    RUN_TEST(broadcast_shed_oldest_reports_missed);
+    RUN_TEST(broadcast_close_drains_then_disconnects);
+    RUN_TEST(broadcast_validates_handles_and_limits);
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -286,8 +286,12 @@ TEST(max_capacity_channel_fill_and_drain)
     uint64_t val;
     uint32_t i;
     uint32_t qlen;
+    asx_runtime_hooks hooks;
 
     reset_all();
+    /* Beyond the static reserve the ring comes from the allocator hook */
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
     ASSERT_EQ(asx_region_open(&rid), ASX_OK);
     ASSERT_EQ(asx_channel_create(rid, ASX_CHANNEL_MAX_CAPACITY, &cid), ASX_OK);
 
@@ -0,0 +1,241 @@
+/*
+ * test_channel_select.c — multi-channel select over readiness bitmaps
+ *
+ * Tests that asx_channel_select picks the lowest ready channel slot
+ * whatever the order of ids, reports disconnects, spans channels of
+ * several regions, parks the task on the whole set when nothing is
+ * ready and is woken by the first send, and rejects bad arguments.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/core/channel.h>
+#include <asx/runtime/runtime.h>
+#include "test_harness.h"
+
+#define CH_IGNORE(expr) \
+    do { volatile asx_status _ch_ign = (expr); (void)_ch_ign; } while (0)
+
+static asx_region_id g_rid;
+
+static void setup(void)
+{
+    asx_runtime_reset();
+    asx_channel_reset();
+    CH_IGNORE(asx_region_open(&g_rid));
+}
+
+static asx_status send_value(asx_channel_id ch, uint64_t value)
+{
+    asx_send_permit permit;
+    asx_status st = asx_channel_try_reserve(ch, &permit);
+    if (st != ASX_OK) return st;
+    return asx_send_permit_send(&permit, value);
+}
+
+/* -------------------------------------------------------------------
+ * Non-parking select
+ * ------------------------------------------------------------------- */
+
+TEST(select_picks_lowest_ready_slot)
+{
+    asx_channel_id ch[4], ids[4];
+    uint32_t i, index;
+    uint64_t value;
+
+    setup();
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_channel_create(g_rid, 4, &ch[i]), ASX_OK);
+    }
+    for (i = 0; i < 4u; i++) {
+        ids[i] = ch[3u - i];
+    }
+    ASSERT_EQ(send_value(ch[3], 30u), ASX_OK);
+    ASSERT_EQ(send_value(ch[1], 10u), ASX_OK);
+
+    /* ids lists slots 3,2,1,0: slot 1 wins, at position 2 */
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ids, 4u, &index, &value),
+              ASX_OK);
+    ASSERT_EQ(index, (uint32_t)2);
+    ASSERT_EQ(value, (uint64_t)10);
+
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ids, 4u, &index, &value),
+              ASX_OK);
+    ASSERT_EQ(index, (uint32_t)0);
+    ASSERT_EQ(value, (uint64_t)30);
+
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ids, 4u, &index, &value),
+              ASX_E_WOULD_BLOCK);
+}
+
+TEST(select_reports_disconnect)
+{
+    asx_channel_id ch[2];
+    uint32_t index;
+    uint64_t value;
+
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch[0]), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch[1]), ASX_OK);
+    ASSERT_EQ(asx_channel_close_sender(ch[1]), ASX_OK);
+
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ch, 2u, &index, &value),
+              ASX_E_DISCONNECTED);
+    ASSERT_EQ(index, (uint32_t)1);
+
+    /* Data still queued is delivered before the disconnect */
+    ASSERT_EQ(send_value(ch[0], 7u), ASX_OK);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ch, 2u, &index, &value),
+              ASX_OK);
+    ASSERT_EQ(index, (uint32_t)0);
+    ASSERT_EQ(value, (uint64_t)7);
+
+    /* A closed receiver is never ready */
+    ASSERT_EQ(asx_channel_close_receiver(ch[0]), ASX_OK);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ch, 1u, &index, &value),
+              ASX_E_WOULD_BLOCK);
+}
+
+TEST(select_spans_regions)
+{
+    asx_region_id other;
+    asx_channel_id ch[16];
+    uint32_t i, index;
+    uint64_t value;
+
+    setup();
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    for (i = 0; i < ASX_CHANNEL_SELECT_MAX; i++) {
+        ASSERT_EQ(asx_channel_create((i % 2u) ? other : g_rid, 2, &ch[i]),
+                  ASX_OK);
+    }
+    ASSERT_EQ(send_value(ch[15], 150u), ASX_OK);
+    ASSERT_EQ(send_value(ch[12], 120u), ASX_OK);
+
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ch, 16u, &index, &value),
+              ASX_OK);
+    ASSERT_EQ(index, (uint32_t)12);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ch, 16u, &index, &value),
+              ASX_OK);
+    ASSERT_EQ(index, (uint32_t)15);
+    ASSERT_EQ(value, (uint64_t)150);
+
+    /* A subset ignores readiness outside it */
+    ASSERT_EQ(send_value(ch[3], 30u), ASX_OK);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, &ch[4], 8u, &index, &value),
+              ASX_E_WOULD_BLOCK);
+}
+
+/* -------------------------------------------------------------------
+ * Parking select
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    asx_channel_id ids[3];
+    uint32_t       polls;
+    uint32_t       index;
+    uint64_t       value;
+} selector_state;
+
+typedef struct {
+    asx_channel_id ch;
+    int            yields;
+} producer_state;
+
+static asx_status poll_selector(void *data, asx_task_id self)
+{
+    selector_state *s = (selector_state *)data;
+    s->polls++;
+    return asx_channel_select(self, s->ids, 3u, &s->index, &s->value);
+}
+
+static asx_status poll_producer(void *data, asx_task_id self)
+{
+    producer_state *p = (producer_state *)data;
+    (void)self;
+    if (p->yields > 0) {
+        p->yields--;
+        return ASX_E_PENDING;
+    }
+    return send_value(p->ch, 99u);
+}
+
+TEST(select_parks_until_a_send)
+{
+    selector_state sel;
+    producer_state prod;
+    asx_task_id st_id, pt_id;
+    asx_task_state ts;
+    asx_budget budget;
+    uint32_t i;
+
+    setup();
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_channel_create(g_rid, 4, &sel.ids[i]), ASX_OK);
+    }
+    sel.polls = 0;
+    prod.ch = sel.ids[2];
+    prod.yields = 6;
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_selector, &sel, &st_id), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_producer, &prod, &pt_id), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(g_rid, &budget), ASX_OK);
+
+    /* Parked while the producer yields; one poll after the send */
+    ASSERT_EQ(sel.polls, (uint32_t)2);
+    ASSERT_EQ(sel.index, (uint32_t)2);
+    ASSERT_EQ(sel.value, (uint64_t)99);
+    ASSERT_EQ(asx_task_get_state(st_id, &ts), ASX_OK);
+    ASSERT_EQ(ts, ASX_TASK_COMPLETED);
+}
+
+TEST(select_rejects_bad_arguments)
+{
+    asx_channel_id ch[ASX_CHANNEL_SELECT_MAX + 1u];
+    asx_channel_id one;
+    selector_state sel;
+    asx_task_id t1, t2;
+    uint32_t index;
+    uint64_t value;
+
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &one), ASX_OK);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, NULL, 1u, &index, &value),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, &one, 0u, &index, &value),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, &one, 1u, NULL, &value),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ch,
+                                 ASX_CHANNEL_SELECT_MAX + 1u, &index, &value),
+              ASX_E_INVALID_ARGUMENT);
+    ch[0] = ASX_INVALID_ID;
+    ASSERT_EQ(asx_channel_select(ASX_INVALID_ID, ch, 1u, &index, &value),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* A second task cannot wait on a channel another task waits on */
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_selector, &sel, &t1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_selector, &sel, &t2), ASX_OK);
+    ASSERT_EQ(asx_channel_select(t1, &one, 1u, &index, &value),
+              ASX_E_PENDING);
+    ASSERT_EQ(asx_channel_select(t2, &one, 1u, &index, &value),
+              ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_select(t1, &one, 1u, &index, &value),
+              ASX_E_PENDING);
+}
+
+int main(void)
+{
+    fprintf(stderr, "=== test_channel_select ===\n");
+
+    RUN_TEST(select_picks_lowest_ready_slot);
+    RUN_TEST(select_reports_disconnect);
+    RUN_TEST(select_spans_regions);
+    RUN_TEST(select_parks_until_a_send);
+    RUN_TEST(select_rejects_bad_arguments);
+
+    TEST_REPORT();
+    return test_failures;
+}
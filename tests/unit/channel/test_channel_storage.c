@@ -0,0 +1,241 @@
+/*
+ * test_channel_storage.c — per-channel ring storage and capacity change
+ *
+ * Tests that channels beyond the old fixed 64-entry queue work with
+ * non-power-of-two capacities, that ring storage comes from the shared
+ * reserve and merges back when released, that capacity changes keep
+ * queued messages in order and require quiescence, and that rings
+ * beyond the reserve come from the allocator hook.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <asx/asx.h>
+#include <asx/core/channel.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/instance.h>
+#include "test_harness.h"
+
+#define CH_IGNORE(expr) \
+    do { volatile asx_status _ch_ign = (expr); (void)_ch_ign; } while (0)
+
+static asx_region_id g_rid;
+
+static void setup(void)
+{
+    asx_runtime_reset();
+    asx_channel_reset();
+    CH_IGNORE(asx_region_open(&g_rid));
+}
+
+static asx_status send_value(asx_channel_id ch, uint64_t value)
+{
+    asx_send_permit permit;
+    asx_status st = asx_channel_try_reserve(ch, &permit);
+    if (st != ASX_OK) return st;
+    return asx_send_permit_send(&permit, value);
+}
+
+/* -------------------------------------------------------------------
+ * Sizing
+ * ------------------------------------------------------------------- */
+
+TEST(capacity_beyond_old_limit_is_exact)
+{
+    asx_runtime *rt;
+    asx_runtime *prev;
+    asx_region_id rid;
+    asx_channel_id ch;
+    uint64_t value;
+    uint32_t i;
+
+    /* Beyond the static reserve the ring comes from the allocator
+     * hook, which a created instance has installed */
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &rt), ASX_OK);
+    prev = asx_runtime_enter(rt);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 1000, &ch), ASX_OK);
+
+    /* Storage rounds up to 1024, the bound stays at 1000 */
+    for (i = 0; i < 1000u; i++) {
+        ASSERT_EQ(send_value(ch, i), ASX_OK);
+    }
+    ASSERT_EQ(send_value(ch, 1000u), ASX_E_CHANNEL_FULL);
+
+    /* Wrap the ring several times */
+    for (i = 0; i < 3000u; i++) {
+        ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+        ASSERT_EQ(value, (uint64_t)i);
+        ASSERT_EQ(send_value(ch, i + 1000u), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)3000);
+
+    (void)asx_runtime_enter(prev);
+    asx_runtime_destroy(rt);
+}
+
+TEST(small_channels_share_the_reserve)
+{
+    asx_channel_id ch[ASX_MAX_CHANNELS];
+    asx_channel_id big;
+    uint32_t i;
+
+    setup();
+    /* 15 small rings leave most of the reserve free */
+    for (i = 0; i + 1u < ASX_MAX_CHANNELS; i++) {
+        ASSERT_EQ(asx_channel_create(g_rid, 3, &ch[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_RESERVE_SLOTS / 2u,
+                                 &big), ASX_OK);
+    ASSERT_EQ(send_value(big, 1u), ASX_OK);
+    ASSERT_EQ(send_value(ch[14], 2u), ASX_OK);
+}
+
+TEST(released_storage_merges)
+{
+    asx_channel_id a, b, c;
+    uint32_t cap;
+
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 1, &a), ASX_OK);
+    for (cap = 2; cap <= ASX_CHANNEL_RESERVE_SLOTS / 2u; cap *= 2u) {
+        ASSERT_EQ(asx_channel_set_capacity(a, cap), ASX_OK);
+    }
+    ASSERT_EQ(asx_channel_set_capacity(a, 1), ASX_OK);
+    ASSERT_EQ(asx_channel_set_capacity(a, ASX_CHANNEL_RESERVE_SLOTS / 2u),
+              ASX_OK);
+
+    /* Every block freed by the churn merged back into the other half */
+    ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_RESERVE_SLOTS / 2u, &b),
+              ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 1, &c), ASX_E_RESOURCE_EXHAUSTED);
+
+    /* A failed resize leaves the channel as it was */
+    ASSERT_EQ(send_value(a, 7u), ASX_OK);
+    ASSERT_EQ(asx_channel_set_capacity(a, 1), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(send_value(a, 8u), ASX_OK);
+}
+
+/* -------------------------------------------------------------------
+ * Capacity change
+ * ------------------------------------------------------------------- */
+
+TEST(set_capacity_keeps_queued_order)
+{
+    asx_channel_id ch;
+    uint64_t value;
+    uint32_t i, len;
+
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch), ASX_OK);
+
+    /* Leave the queue wrapped: positions 2,3,0 */
+    for (i = 0; i < 2u; i++) {
+        ASSERT_EQ(send_value(ch, 0u), ASX_OK);
+        ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    }
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(send_value(ch, 10u + i), ASX_OK);
+    }
+
+    ASSERT_EQ(asx_channel_set_capacity(ch, 100), ASX_OK);
+    for (i = 3; i < 100u; i++) {
+        ASSERT_EQ(send_value(ch, 10u + i), ASX_OK);
+    }
+    ASSERT_EQ(send_value(ch, 0u), ASX_E_CHANNEL_FULL);
+    for (i = 0; i < 97u; i++) {
+        ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+        ASSERT_EQ(value, (uint64_t)(10u + i));
+    }
+
+    /* Shrink to exactly the queued length, same storage size class */
+    ASSERT_EQ(asx_channel_set_capacity(ch, 3), ASX_OK);
+    ASSERT_EQ(asx_channel_queue_len(ch, &len), ASX_OK);
+    ASSERT_EQ(len, (uint32_t)3);
+    ASSERT_EQ(send_value(ch, 0u), ASX_E_CHANNEL_FULL);
+    for (i = 97; i < 100u; i++) {
+        ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+        ASSERT_EQ(value, (uint64_t)(10u + i));
+    }
+}
+
+TEST(set_capacity_requires_quiescence)
+{
+    asx_channel_id ch;
+    asx_send_permit permit;
+
+    setup();
+    ASSERT_EQ(asx_channel_create(g_rid, 8, &ch), ASX_OK);
+    ASSERT_EQ(asx_channel_set_capacity(ch, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_set_capacity(ch, ASX_CHANNEL_MAX_CAPACITY + 1u),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_channel_set_capacity(ASX_INVALID_ID, 8),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* Outstanding permit */
+    ASSERT_EQ(asx_channel_try_reserve(ch, &permit), ASX_OK);
+    ASSERT_EQ(asx_channel_set_capacity(ch, 16), ASX_E_INVALID_STATE);
+    asx_send_permit_abort(&permit);
+
+    /* More queued than the new capacity */
+    ASSERT_EQ(send_value(ch, 1u), ASX_OK);
+    ASSERT_EQ(send_value(ch, 2u), ASX_OK);
+    ASSERT_EQ(asx_channel_set_capacity(ch, 1), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_channel_set_capacity(ch, 2), ASX_OK);
+}
+
+/* -------------------------------------------------------------------
+ * Allocator hook
+ * ------------------------------------------------------------------- */
+
+TEST(rings_beyond_reserve_use_the_hook)
+{
+    asx_runtime *rt;
+    asx_region_id rid;
+    asx_channel_id ch[3];
+    asx_send_permit permit;
+    uint64_t value;
+    uint32_t i;
+
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &rt), ASX_OK);
+    ASSERT_EQ(asx_rt_region_open(rt, &rid), ASX_OK);
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_rt_channel_create(rt, rid,
+                                        ASX_CHANNEL_RESERVE_SLOTS / 2u,
+                                        &ch[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_rt_channel_set_capacity(rt, ch[0],
+                                          ASX_CHANNEL_MAX_CAPACITY),
+              ASX_OK);
+
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_rt_channel_try_reserve(rt, ch[2], &permit), ASX_OK);
+        ASSERT_EQ(asx_rt_send_permit_send(rt, &permit, i), ASX_OK);
+    }
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(asx_rt_channel_try_recv(rt, ch[2], &value), ASX_OK);
+        ASSERT_EQ(value, (uint64_t)i);
+    }
+
+    /* Hook rings are returned on reset and on destroy */
+    asx_rt_channel_reset(rt);
+    ASSERT_EQ(asx_rt_channel_create(rt, rid, ASX_CHANNEL_MAX_CAPACITY,
+                                    &ch[0]), ASX_OK);
+    asx_runtime_destroy(rt);
+}
+
+int main(void)
+{
+    fprintf(stderr, "=== test_channel_storage ===\n");
+
+    RUN_TEST(capacity_beyond_old_limit_is_exact);
+    RUN_TEST(small_channels_share_the_reserve);
+    RUN_TEST(released_storage_merges);
+    RUN_TEST(set_capacity_keeps_queued_order);
+    RUN_TEST(set_capacity_requires_quiescence);
+    RUN_TEST(rings_beyond_reserve_use_the_hook);
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -64,7 +64,11 @@ TEST(create_over_max_capacity)
 TEST(create_max_capacity)
 {
     asx_channel_id ch;
+    asx_runtime_hooks hooks;
     setup();
+    /* Beyond the static reserve the ring comes from the allocator hook */
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
     ASSERT_EQ(asx_channel_create(g_rid, ASX_CHANNEL_MAX_CAPACITY, &ch), ASX_OK);
 }
 
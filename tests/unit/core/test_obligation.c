@@ -7,6 +7,8 @@
 #include "test_harness.h"
 #include <asx/asx.h>
 #include <asx/runtime/runtime.h>
+#include <asx/runtime/trace.h>
+#include <asx/core/ghost.h>
 
 /* ---- Reserve / commit / abort ---- */
 
@@ -166,6 +168,120 @@ TEST(obligation_multiple_in_region) {
     ASSERT_EQ(state, ASX_OBLIGATION_ABORTED);
 }
 
+/* ---- Batch resolution ---- */
+
+TEST(obligation_commit_many_resolves_in_index_order) {
+    asx_region_id rid;
+    asx_obligation_id o[4], batch[3];
+    asx_obligation_state state;
+    asx_trace_event ev;
+    uint32_t i, before;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_obligation_reserve(rid, &o[i]), ASX_OK);
+    }
+
+    /* Caller order does not matter */
+    batch[0] = o[3];
+    batch[1] = o[0];
+    batch[2] = o[2];
+    before = asx_trace_event_count();
+    ASSERT_EQ(asx_obligation_commit_many(batch, 3u), ASX_OK);
+
+    ASSERT_EQ(asx_trace_event_count(), before + 1u);
+    ASSERT_TRUE(asx_trace_event_get(before, &ev));
+    ASSERT_EQ(ev.kind, ASX_TRACE_OBLIGATION_COMMIT_RANGE);
+    ASSERT_EQ(ev.entity_id, o[0]);
+    ASSERT_EQ(ev.aux, (uint64_t)3 | ((uint64_t)3 << 32));
+
+    ASSERT_EQ(asx_obligation_get_state(o[1], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_RESERVED);
+    ASSERT_EQ(asx_obligation_get_state(o[2], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_COMMITTED);
+
+    ASSERT_EQ(asx_obligation_abort_many(&o[1], 1u), ASX_OK);
+    ASSERT_EQ(asx_obligation_get_state(o[1], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_ABORTED);
+    ASSERT_EQ(asx_ghost_violation_count(), (uint32_t)0);
+    ASSERT_EQ(asx_ghost_check_obligation_leaks(rid), (uint32_t)0);
+}
+
+TEST(obligation_batch_is_all_or_nothing) {
+    asx_region_id rid;
+    asx_obligation_id o[3], batch[3];
+    asx_obligation_state state;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &o[0]), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &o[1]), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rid, &o[2]), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit(o[2]), ASX_OK);
+
+    /* Already resolved */
+    ASSERT_EQ(asx_obligation_abort_many(o, 3u), ASX_E_INVALID_TRANSITION);
+    ASSERT_EQ(asx_obligation_get_state(o[0], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_RESERVED);
+
+    /* Listed twice */
+    batch[0] = o[0];
+    batch[1] = o[1];
+    batch[2] = o[0];
+    ASSERT_EQ(asx_obligation_commit_many(batch, 3u), ASX_E_INVALID_TRANSITION);
+    ASSERT_EQ(asx_obligation_get_state(o[1], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_RESERVED);
+
+    batch[2] = ASX_INVALID_ID;
+    ASSERT_EQ(asx_obligation_commit_many(batch, 3u), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_obligation_commit_many(NULL, 1u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_obligation_commit_many(NULL, 0u), ASX_OK);
+}
+
+TEST(region_abort_obligations_scopes_to_region) {
+    asx_region_id ra, rb;
+    asx_obligation_id a1, a2, a3, b1;
+    asx_obligation_state state;
+    asx_trace_event ev;
+    uint32_t aborted, before;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(ra, &a1), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(rb, &b1), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(ra, &a2), ASX_OK);
+    ASSERT_EQ(asx_obligation_reserve(ra, &a3), ASX_OK);
+    ASSERT_EQ(asx_obligation_commit(a2), ASX_OK);
+
+    before = asx_trace_event_count();
+    ASSERT_EQ(asx_region_abort_obligations(ra, &aborted), ASX_OK);
+    ASSERT_EQ(aborted, (uint32_t)2);
+    ASSERT_EQ(asx_trace_event_count(), before + 1u);
+    ASSERT_TRUE(asx_trace_event_get(before, &ev));
+    ASSERT_EQ(ev.kind, ASX_TRACE_OBLIGATION_ABORT_RANGE);
+    ASSERT_EQ(ev.entity_id, a1);
+
+    ASSERT_EQ(asx_obligation_get_state(a1, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_ABORTED);
+    ASSERT_EQ(asx_obligation_get_state(a2, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_COMMITTED);
+    ASSERT_EQ(asx_obligation_get_state(b1, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_OBLIGATION_RESERVED);
+    ASSERT_EQ(asx_ghost_violation_count(), (uint32_t)0);
+
+    /* Nothing left: no record */
+    before = asx_trace_event_count();
+    ASSERT_EQ(asx_region_abort_obligations(ra, &aborted), ASX_OK);
+    ASSERT_EQ(aborted, (uint32_t)0);
+    ASSERT_EQ(asx_trace_event_count(), before);
+    ASSERT_EQ(asx_region_abort_obligations(ASX_INVALID_ID, NULL),
+              ASX_E_NOT_FOUND);
+}
+
 int main(void) {
     fprintf(stderr, "=== test_obligation ===\n");
     RUN_TEST(obligation_reserve_and_get_state);
@@ -180,6 +296,9 @@ int main(void) {
     RUN_TEST(obligation_reserve_rejected_after_close);
     RUN_TEST(obligation_handle_type_tag);
     RUN_TEST(obligation_multiple_in_region);
+    RUN_TEST(obligation_commit_many_resolves_in_index_order);
+    RUN_TEST(obligation_batch_is_all_or_nothing);
+    RUN_TEST(region_abort_obligations_scopes_to_region);
     TEST_REPORT();
     return test_failures;
 }
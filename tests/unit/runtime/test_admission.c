@@ -0,0 +1,491 @@
+/*
+ * test_admission.c — closed-loop admission control on spawn and reserve
+ *
+ * Tests that regions without a controller are unaffected, that each
+ * overload mode is applied on spawn and on channel reserve, that the
+ * release threshold keeps a signal engaged until load has fallen
+ * below it, that a backpressured task parked in asx_admission_wait is
+ * woken on release, and that decisions reach the adaptive ledger of
+ * the instance that took them.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/admission.h>
+#include <asx/runtime/instance.h>
+#include <asx/core/adaptive.h>
+#include <asx/core/channel.h>
+
+#define SCHED_RUN_IGNORE(rid, bud) \
+    do { asx_status s_ = asx_scheduler_run((rid), (bud)); (void)s_; } while (0)
+
+#define IGNORE(expr) \
+    do { asx_status s_ = (expr); (void)s_; } while (0)
+
+static asx_region_id g_rid;
+
+static void setup(void)
+{
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_adaptive_reset();
+    IGNORE(asx_region_open(&g_rid));
+}
+
+static void config(asx_admission_config *cfg, asx_overload_mode mode,
+                   uint32_t threshold, uint32_t release, uint32_t shed_max,
+                   uint32_t task_capacity)
+{
+    asx_admission_config_init(cfg);
+    cfg->policy.mode          = mode;
+    cfg->policy.threshold_pct = threshold;
+    cfg->policy.shed_max      = shed_max;
+    cfg->release_pct          = release;
+    cfg->task_capacity        = task_capacity;
+}
+
+/* Completes once *data is nonzero */
+static asx_status poll_until_set(void *data, asx_task_id self)
+{
+    (void)self;
+    return *(int *)data ? ASX_OK : ASX_E_PENDING;
+}
+
+static void run_polls(uint32_t polls)
+{
+    asx_budget budget = asx_budget_from_polls(polls);
+    SCHED_RUN_IGNORE(g_rid, &budget);
+}
+
+static asx_status send_value(asx_channel_id ch, uint64_t value)
+{
+    asx_send_permit permit;
+    asx_status st = asx_channel_try_reserve(ch, &permit);
+    if (st != ASX_OK) return st;
+    return asx_send_permit_send(&permit, value);
+}
+
+/* -------------------------------------------------------------------
+ * Defaults and misuse
+ * ------------------------------------------------------------------- */
+
+TEST(no_controller_is_unaffected)
+{
+    asx_admission_stats stats;
+    asx_task_id tid;
+    int done = 0;
+    uint32_t i;
+
+    setup();
+    for (i = 0; i < 32u; i++) {
+        ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &tid),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_admission_disable(g_rid), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_admission_wait(tid, g_rid), ASX_OK);
+    ASSERT_EQ(asx_adaptive_ledger_count(), (uint32_t)0);
+}
+
+TEST(config_is_validated)
+{
+    asx_admission_config cfg;
+
+    setup();
+    asx_admission_config_init(&cfg);
+    ASSERT_TRUE(cfg.release_pct > 0);
+    ASSERT_TRUE(cfg.release_pct <= cfg.policy.threshold_pct);
+    ASSERT_EQ(cfg.task_capacity, (uint32_t)ASX_MAX_TASKS);
+    ASSERT_EQ(asx_admission_enable(g_rid, NULL), ASX_OK);
+
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 60, 0, 8);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_E_INVALID_ARGUMENT);
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 0, 0, 8);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_E_INVALID_ARGUMENT);
+    config(&cfg, ASX_OVERLOAD_REJECT, 101, 50, 0, 8);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_E_INVALID_ARGUMENT);
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 40, 0, 0);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_E_INVALID_ARGUMENT);
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 40, 0, 8);
+    ASSERT_EQ(asx_admission_enable(ASX_INVALID_ID, &cfg), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_admission_get_stats(g_rid, NULL), ASX_E_INVALID_ARGUMENT);
+
+    ASSERT_EQ(asx_admission_disable(g_rid), ASX_OK);
+    ASSERT_EQ(asx_admission_disable(g_rid), ASX_E_INVALID_STATE);
+}
+
+/* -------------------------------------------------------------------
+ * Spawn
+ * ------------------------------------------------------------------- */
+
+TEST(spawn_reject_holds_until_release)
+{
+    asx_admission_config cfg;
+    asx_admission_stats stats;
+    asx_task_id tid[5];
+    asx_task_id extra;
+    int done[5] = {0, 0, 0, 0, 0};
+    uint32_t i;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 30, 0, 10);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+
+    for (i = 0; i < 5u; i++) {
+        ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done[i], &tid[i]),
+                  ASX_OK);
+    }
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done[0], &extra),
+              ASX_E_ADMISSION_CLOSED);
+
+    /* 4 and 3 live tasks are below threshold but not below release */
+    done[0] = 1;
+    run_polls(10);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done[0], &extra),
+              ASX_E_ADMISSION_CLOSED);
+    done[1] = 1;
+    run_polls(10);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done[0], &extra),
+              ASX_E_ADMISSION_CLOSED);
+
+    /* 2 live tasks: 20% < 30% releases */
+    done[2] = 1;
+    run_polls(10);
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.engaged, 0);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done[0], &extra),
+              ASX_OK);
+
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.admitted, (uint64_t)6);
+    ASSERT_EQ(stats.rejected, (uint64_t)3);
+    ASSERT_EQ(stats.engagements, (uint32_t)1);
+    /* Three refusals plus the release */
+    ASSERT_EQ(asx_adaptive_ledger_count(), (uint32_t)4);
+}
+
+TEST(spawn_decisions_reach_the_ledger)
+{
+    asx_admission_config cfg;
+    asx_adaptive_ledger_entry entry;
+    asx_task_id tid;
+    int done = 0;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 25, 0, 2);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &tid),
+              ASX_E_ADMISSION_CLOSED);
+
+    ASSERT_EQ(asx_adaptive_ledger_count(), (uint32_t)1);
+    ASSERT_TRUE(asx_adaptive_ledger_get(0, &entry));
+    ASSERT_STR_EQ(entry.surface, "admission");
+    ASSERT_EQ(entry.decision.selected,
+              (asx_adaptive_action)ASX_ADMISSION_ACTION_REJECT);
+    ASSERT_EQ(entry.evidence_count, (uint8_t)3);
+    ASSERT_STR_EQ(entry.evidence[0].label, "load_pct");
+    ASSERT_EQ(entry.evidence[0].value_fp32, (uint32_t)0x80000000u);
+}
+
+TEST(decisions_log_to_the_instance_ledger)
+{
+    asx_admission_config cfg;
+    asx_runtime *rt;
+    asx_runtime *prev;
+    asx_region_id rid;
+    asx_task_id tid;
+    int done = 0;
+
+    setup();
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &rt), ASX_OK);
+    prev = asx_runtime_enter(rt);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 25, 0, 2);
+    ASSERT_EQ(asx_admission_enable(rid, &cfg), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_until_set, &done, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_until_set, &done, &tid),
+              ASX_E_ADMISSION_CLOSED);
+    ASSERT_EQ(asx_adaptive_ledger_count(), (uint32_t)1);
+    (void)asx_runtime_enter(prev);
+
+    /* The default instance's ledger saw none of it */
+    ASSERT_EQ(asx_adaptive_ledger_count(), (uint32_t)0);
+    asx_runtime_destroy(rt);
+}
+
+TEST(spawn_shed_cancels_oldest)
+{
+    asx_admission_config cfg;
+    asx_admission_stats stats;
+    asx_task_id tid[4];
+    asx_task_id extra;
+    asx_task_state state;
+    int done = 0;
+    uint32_t i;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_SHED_OLDEST, 75, 50, 1, 4);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &tid[i]),
+                  ASX_OK);
+    }
+
+    /* The fourth spawn saw 75% and shed the first task */
+    ASSERT_EQ(asx_task_get_state(tid[0], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_CANCEL_REQUESTED);
+    ASSERT_EQ(asx_task_get_state(tid[1], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_CREATED);
+
+    /* Still engaged: the next shed skips the task already cancelling */
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &extra),
+              ASX_OK);
+    ASSERT_EQ(asx_task_get_state(tid[1], &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_CANCEL_REQUESTED);
+
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.shed, (uint64_t)2);
+    ASSERT_EQ(stats.admitted, (uint64_t)5);
+    ASSERT_EQ(stats.rejected, (uint64_t)0);
+}
+
+TEST(spawn_shed_not_taken_for_failing_spawn)
+{
+    asx_admission_config cfg;
+    asx_admission_stats stats;
+    asx_task_id first, tid;
+    asx_task_state state;
+    int done = 0;
+    uint32_t i;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_SHED_OLDEST, 100, 90, 1, ASX_MAX_TASKS);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &first), ASX_OK);
+    for (i = 1; i < ASX_MAX_TASKS; i++) {
+        ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &tid),
+                  ASX_OK);
+    }
+
+    /* The arena is full: the spawn fails before any task is shed */
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &done, &tid),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_task_get_state(first, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_CREATED);
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.shed, (uint64_t)0);
+    ASSERT_EQ(stats.admitted, (uint64_t)ASX_MAX_TASKS);
+    ASSERT_EQ(stats.engagements, (uint32_t)0);
+}
+
+/* -------------------------------------------------------------------
+ * Backpressure and wait
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    int          worker_done;
+    int          spawned;
+    int          deferred;
+    asx_task_id  child;
+} spawner_state;
+
+static asx_status poll_spawner(void *data, asx_task_id self)
+{
+    spawner_state *s = (spawner_state *)data;
+    asx_status st;
+
+    st = asx_task_spawn(g_rid, poll_until_set, &s->worker_done, &s->child);
+    if (st == ASX_E_WOULD_BLOCK) {
+        s->deferred++;
+        /* Either parked until release, or already released: retry
+         * on the next poll */
+        st = asx_admission_wait(self, g_rid);
+        (void)st;
+        return ASX_E_PENDING;
+    }
+    if (st != ASX_OK) {
+        return st;
+    }
+    s->spawned = 1;
+    return ASX_OK;
+}
+
+TEST(backpressure_wait_wakes_on_release)
+{
+    asx_admission_config cfg;
+    asx_admission_stats stats;
+    spawner_state s = {0, 0, 0, ASX_INVALID_ID};
+    asx_task_id spawner, worker;
+    asx_task_state state;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_BACKPRESSURE, 50, 30, 0, 4);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_spawner, &s, &spawner), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &s.worker_done,
+                             &worker), ASX_OK);
+
+    /* The spawner sees 2/4 live, is deferred and parks */
+    run_polls(20);
+    ASSERT_EQ(s.deferred, 1);
+    ASSERT_EQ(s.spawned, 0);
+    ASSERT_EQ(asx_admission_wait(worker, g_rid), ASX_E_INVALID_STATE);
+
+    /* The worker finishing drops load to 25% < 30% and wakes it */
+    s.worker_done = 1;
+    run_polls(20);
+    ASSERT_EQ(s.deferred, 1);
+    ASSERT_EQ(s.spawned, 1);
+    ASSERT_EQ(asx_task_get_state(spawner, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_COMPLETED);
+
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.deferred, (uint64_t)1);
+    ASSERT_EQ(stats.engaged, 0);
+}
+
+TEST(disable_wakes_the_waiter)
+{
+    asx_admission_config cfg;
+    spawner_state s = {0, 0, 0, ASX_INVALID_ID};
+    asx_task_id spawner, worker;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_BACKPRESSURE, 50, 30, 0, 4);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_spawner, &s, &spawner), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(g_rid, poll_until_set, &s.worker_done,
+                             &worker), ASX_OK);
+    run_polls(20);
+    ASSERT_EQ(s.deferred, 1);
+
+    ASSERT_EQ(asx_admission_disable(g_rid), ASX_OK);
+    run_polls(20);
+    ASSERT_EQ(s.spawned, 1);
+}
+
+/* -------------------------------------------------------------------
+ * Channel reserve
+ * ------------------------------------------------------------------- */
+
+TEST(reserve_reject_holds_until_release)
+{
+    asx_admission_config cfg;
+    asx_admission_stats stats;
+    asx_channel_id ch;
+    uint64_t value;
+    uint32_t i;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 25, 0, 64);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 8, &ch), ASX_OK);
+
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(send_value(ch, i), ASX_OK);
+    }
+    ASSERT_EQ(send_value(ch, 4u), ASX_E_ADMISSION_CLOSED);
+
+    /* 3/8 and 2/8 are not below 25% */
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(send_value(ch, 4u), ASX_E_ADMISSION_CLOSED);
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.engaged, 1);
+
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.engaged, 0);
+    ASSERT_EQ(send_value(ch, 4u), ASX_OK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)3);
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)4);
+    ASSERT_EQ(stats.rejected, (uint64_t)2);
+}
+
+TEST(reserve_shed_defers_without_dropping)
+{
+    asx_admission_config cfg;
+    asx_admission_stats stats;
+    asx_adaptive_ledger_entry entry;
+    asx_channel_id ch;
+    uint64_t value;
+    uint32_t i, len;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_SHED_OLDEST, 75, 50, 1, 64);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+    ASSERT_EQ(asx_channel_create(g_rid, 4, &ch), ASX_OK);
+
+    for (i = 0; i < 3u; i++) {
+        ASSERT_EQ(send_value(ch, i), ASX_OK);
+    }
+    /* Committed messages are never shed: the reserve is deferred */
+    ASSERT_EQ(send_value(ch, 3u), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(asx_channel_queue_len(ch, &len), ASX_OK);
+    ASSERT_EQ(len, (uint32_t)3);
+    ASSERT_TRUE(asx_adaptive_ledger_get(0, &entry));
+    ASSERT_EQ(entry.decision.selected,
+              (asx_adaptive_action)ASX_ADMISSION_ACTION_BACKPRESSURE);
+
+    /* 2/4 is not below 50%; 1/4 releases */
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(send_value(ch, 3u), ASX_E_WOULD_BLOCK);
+    ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+    ASSERT_EQ(send_value(ch, 3u), ASX_OK);
+    for (i = 2; i < 4u; i++) {
+        ASSERT_EQ(asx_channel_try_recv(ch, &value), ASX_OK);
+        ASSERT_EQ(value, (uint64_t)i);
+    }
+
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_OK);
+    ASSERT_EQ(stats.shed, (uint64_t)0);
+    ASSERT_EQ(stats.deferred, (uint64_t)2);
+    ASSERT_EQ(stats.admitted, (uint64_t)4);
+    ASSERT_EQ(stats.engaged, 0);
+}
+
+TEST(controller_does_not_outlive_region)
+{
+    asx_admission_config cfg;
+    asx_admission_stats stats;
+    asx_region_id other;
+
+    setup();
+    config(&cfg, ASX_OVERLOAD_REJECT, 50, 25, 0, 2);
+    ASSERT_EQ(asx_admission_enable(g_rid, &cfg), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_admission_get_stats(other, &stats), ASX_E_INVALID_STATE);
+
+    asx_runtime_reset();
+    IGNORE(asx_region_open(&g_rid));
+    ASSERT_EQ(asx_admission_get_stats(g_rid, &stats), ASX_E_INVALID_STATE);
+}
+
+int main(void)
+{
+    fprintf(stderr, "=== test_admission ===\n");
+
+    RUN_TEST(no_controller_is_unaffected);
+    RUN_TEST(config_is_validated);
+    RUN_TEST(spawn_reject_holds_until_release);
+    RUN_TEST(spawn_decisions_reach_the_ledger);
+    RUN_TEST(decisions_log_to_the_instance_ledger);
+    RUN_TEST(spawn_shed_cancels_oldest);
+    RUN_TEST(spawn_shed_not_taken_for_failing_spawn);
+    RUN_TEST(backpressure_wait_wakes_on_release);
+    RUN_TEST(disable_wakes_the_waiter);
+    RUN_TEST(reserve_reject_holds_until_release);
+    RUN_TEST(reserve_shed_defers_without_dropping);
+    RUN_TEST(controller_does_not_outlive_region);
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -404,8 +404,8 @@ TEST(auto_deadline_miss_003_cancel_forced_event) {
     SCHED_RUN_IGNORE(rid, &budget);
 
     /* Use SHUTDOWN (50-poll cleanup budget) so the CANCEL_FORCED event
-     * falls within the 256-entry scheduler event log. DEADLINE's 500-poll
-     * cleanup budget would overflow the log before the event is recorded. */
+     * falls within the trace ring the scheduler event log reads from.
+     * DEADLINE's 500-poll cleanup budget would overflow it first. */
     ASSERT_EQ(asx_task_cancel(tid, ASX_CANCEL_SHUTDOWN), ASX_OK);
     ASSERT_EQ(asx_checkpoint(tid, &cr), ASX_OK);
 
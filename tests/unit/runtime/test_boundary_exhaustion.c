@@ -517,6 +517,54 @@ TEST(capture_arena_independent_per_region)
     ASSERT_EQ(r2_remaining, (uint32_t)ASX_REGION_CAPTURE_ARENA_BYTES);
 }
 
+TEST(capture_arena_drain_returns_chunks_to_pool)
+{
+    asx_region_id r1, r2;
+    asx_task_id tid;
+    void *first;
+    void *state;
+    asx_budget budget;
+    uint32_t remaining;
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&r1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn_captured(r1, poll_ok, 64u, NULL, &tid, &first),
+              ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(r1, &budget), ASX_OK);
+
+    /* The drained region's chunk is reused by the next region */
+    ASSERT_EQ(asx_region_open(&r2), ASX_OK);
+    ASSERT_EQ(asx_task_spawn_captured(r2, poll_ok, 64u, NULL, &tid, &state),
+              ASX_OK);
+    ASSERT_TRUE(state == first);
+
+    ASSERT_EQ(asx_resource_region_capture_remaining(r2, &remaining), ASX_OK);
+    ASSERT_EQ(remaining, (uint32_t)(ASX_REGION_CAPTURE_ARENA_BYTES - 64u));
+}
+
+TEST(capture_arena_rollback_releases_new_chunk)
+{
+    asx_region_id rid;
+    asx_task_id tid;
+    void *state;
+    uint32_t i;
+    uint32_t before, after;
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < ASX_MAX_TASKS; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_pending, NULL, &tid), ASX_OK);
+    }
+
+    /* Spawn fails after the capture allocation; quota is restored */
+    ASSERT_EQ(asx_resource_region_capture_remaining(rid, &before), ASX_OK);
+    ASSERT_EQ(asx_task_spawn_captured(rid, poll_ok, 128u, NULL, &tid, &state),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_resource_region_capture_remaining(rid, &after), ASX_OK);
+    ASSERT_EQ(after, before);
+}
+
 /* ====================================================================
  * Obligation edge cases at exhaustion
  * ==================================================================== */
@@ -861,6 +909,8 @@ int main(void)
     RUN_TEST(capture_arena_multi_task_boundary);
     RUN_TEST(capture_arena_exact_boundary_allocation);
     RUN_TEST(capture_arena_independent_per_region);
+    RUN_TEST(capture_arena_drain_returns_chunks_to_pool);
+    RUN_TEST(capture_arena_rollback_releases_new_chunk);
 
     /* Obligation edge cases */
     RUN_TEST(obligation_exhaust_then_commit_no_free_slots);
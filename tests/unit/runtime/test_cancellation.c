@@ -683,6 +683,47 @@ TEST(cancel_phase_null_output_rejected) {
     ASSERT_EQ(asx_task_get_cancel_phase(tid, NULL), ASX_E_INVALID_ARGUMENT);
 }
 
+/* -------------------------------------------------------------------
+ * Test: propagation is region-indexed (interleaved regions)
+ * ------------------------------------------------------------------- */
+
+TEST(cancel_propagation_region_indexed_interleaved) {
+    asx_region_id ra, rb;
+    asx_task_id ta1, tb1, ta2, tb2;
+    asx_task_state s;
+    asx_scheduler_event ev;
+    asx_budget budget;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&ra), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rb), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(ra, poll_checkpoint_then_complete, NULL, &ta1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_pending, NULL, &tb1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(ra, poll_checkpoint_then_complete, NULL, &ta2), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rb, poll_pending, NULL, &tb2), ASX_OK);
+
+    ASSERT_EQ(asx_cancel_propagate(ra, ASX_CANCEL_SHUTDOWN), (uint32_t)2);
+
+    /* Region B untouched */
+    ASSERT_EQ(asx_task_get_state(tb1, &s), ASX_OK);
+    ASSERT_EQ((int)s, (int)ASX_TASK_CREATED);
+    ASSERT_EQ(asx_task_get_state(tb2, &s), ASX_OK);
+    ASSERT_EQ((int)s, (int)ASX_TASK_CREATED);
+
+    /* Region A drains in arena order: ta1 before ta2 */
+    budget = asx_budget_from_polls(10);
+    ASSERT_EQ(asx_scheduler_run(ra, &budget), ASX_OK);
+    ASSERT_TRUE(asx_scheduler_event_get(0, &ev));
+    ASSERT_EQ(asx_handle_slot(ev.task_id), asx_handle_slot(ta1));
+    ASSERT_TRUE(asx_scheduler_event_get(2, &ev));
+    ASSERT_EQ(asx_handle_slot(ev.task_id), asx_handle_slot(ta2));
+
+    /* Completed tasks left the list; a second sweep finds nothing */
+    ASSERT_EQ(asx_cancel_propagate(ra, ASX_CANCEL_SHUTDOWN), (uint32_t)0);
+    ASSERT_EQ(asx_cancel_propagate(rb, ASX_CANCEL_SHUTDOWN), (uint32_t)2);
+}
+
 /* -------------------------------------------------------------------
  * Main
  * ------------------------------------------------------------------- */
@@ -712,6 +753,7 @@ int main(void) {
     RUN_TEST(cleanup_budget_tighter_for_severe_cancels);
     RUN_TEST(checkpoint_null_result_rejected);
     RUN_TEST(cancel_phase_null_output_rejected);
+    RUN_TEST(cancel_propagation_region_indexed_interleaved);
 
     TEST_REPORT();
     return test_failures;
@@ -0,0 +1,496 @@
+/*
+ * test_combinator.c — join/race/select/timeout/retry combinator tests
+ *
+ * Tests: outcome aggregation, loser cancellation with origin
+ * attribution, wake-on-completion (no re-polling while parked),
+ * clock-driven timeout, retry attempts, cancel forwarding, and queries
+ * refused once the region's capture arena is released.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/combinator.h>
+#include <asx/runtime/admission.h>
+#include "../../../src/runtime/runtime_internal.h"
+
+/* ---- Test poll functions ---- */
+
+/* Yields N times then completes. Counter in user_data. */
+static asx_status poll_yield_n(void *data, asx_task_id self) {
+    int *counter = (int *)data;
+    (void)self;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+/* Fails immediately */
+static asx_status poll_fail(void *data, asx_task_id self) {
+    (void)data; (void)self;
+    return ASX_E_INVALID_STATE;
+}
+
+/* Fails while the counter is positive, then succeeds */
+static asx_status poll_fail_n(void *data, asx_task_id self) {
+    int *counter = (int *)data;
+    (void)self;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_INVALID_STATE;
+    }
+    return ASX_OK;
+}
+
+/* Counts its polls in *data and completes */
+static asx_status poll_count(void *data, asx_task_id self) {
+    (void)self;
+    (*(int *)data)++;
+    return ASX_OK;
+}
+
+/* Pending until it observes cancellation */
+static asx_status poll_until_cancelled(void *data, asx_task_id self) {
+    asx_checkpoint_result cr;
+    (void)data;
+    if (asx_checkpoint(self, &cr) == ASX_OK && cr.cancelled) {
+        return ASX_OK;
+    }
+    return ASX_E_PENDING;
+}
+
+/* Logical clock advanced by a ticking task */
+static asx_time g_clock_ns;
+
+static asx_time test_clock(void *ctx) {
+    (void)ctx;
+    return g_clock_ns;
+}
+
+static asx_status poll_tick_until_cancelled(void *data, asx_task_id self) {
+    g_clock_ns += 10u;
+    return poll_until_cancelled(data, self);
+}
+
+static void install_test_clock(void) {
+    asx_runtime_hooks hooks;
+    asx_runtime_hooks_init(&hooks);
+    hooks.clock.now_ns_fn = test_clock;
+    hooks.clock.logical_now_ns_fn = test_clock;
+    (void)asx_runtime_set_hooks(&hooks);
+    g_clock_ns = 0;
+}
+
+/* Task handles carry a state mask; compare slot identity only */
+static int same_task(asx_task_id a, asx_task_id b) {
+    return asx_handle_slot(a) == asx_handle_slot(b)
+        && asx_handle_generation(a) == asx_handle_generation(b);
+}
+
+static uint32_t count_polls_of(asx_task_id tid) {
+    uint32_t i, n = 0;
+    asx_scheduler_event ev;
+    for (i = 0; i < asx_scheduler_event_count(); i++) {
+        if (asx_scheduler_event_get(i, &ev) && ev.kind == ASX_SCHED_EVENT_POLL
+            && same_task(ev.task_id, tid)) {
+            n++;
+        }
+    }
+    return n;
+}
+
+/* ---- Tests ---- */
+
+TEST(join_waits_for_all_children) {
+    asx_region_id rid;
+    asx_task_id jid;
+    asx_task_spec specs[3];
+    int c0 = 0, c1 = 4, c2 = 1;
+    asx_outcome out;
+    asx_budget budget;
+    uint32_t n;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    specs[0].poll_fn = poll_yield_n; specs[0].user_data = &c0;
+    specs[1].poll_fn = poll_yield_n; specs[1].user_data = &c1;
+    specs[2].poll_fn = poll_yield_n; specs[2].user_data = &c2;
+    ASSERT_EQ(asx_join_spawn(rid, specs, 3, &jid), ASX_OK);
+    ASSERT_EQ(asx_combinator_child_count(jid, &n), ASX_OK);
+    ASSERT_EQ(n, (uint32_t)3);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_get_outcome(jid, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_OK);
+
+    /* Parked between completions: one initial poll plus one per wake */
+    ASSERT_TRUE(count_polls_of(jid) <= (uint32_t)4);
+}
+
+TEST(queries_refused_after_region_close) {
+    asx_region_id rid, other;
+    asx_task_id jid, wid;
+    asx_task_spec specs[2];
+    int c0 = 0, c1 = 1;
+    asx_budget budget;
+    uint32_t n;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    specs[0].poll_fn = poll_yield_n; specs[0].user_data = &c0;
+    specs[1].poll_fn = poll_yield_n; specs[1].user_data = &c1;
+    ASSERT_EQ(asx_race_spawn(rid, specs, 2, &jid), ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_combinator_child_count(jid, &n), ASX_OK);
+
+    /* Closing returns the state chunk to the pool for reuse */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_race_spawn(other, specs, 2, &wid), ASX_OK);
+
+    ASSERT_EQ(asx_combinator_child_count(jid, &n), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_combinator_child(jid, 0, &wid), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_combinator_winner(jid, &n), ASX_E_INVALID_STATE);
+}
+
+TEST(join_outcome_is_lattice_join) {
+    asx_region_id rid;
+    asx_task_id jid;
+    asx_task_spec specs[2];
+    int c0 = 1;
+    asx_outcome out;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    specs[0].poll_fn = poll_yield_n; specs[0].user_data = &c0;
+    specs[1].poll_fn = poll_fail;    specs[1].user_data = NULL;
+    ASSERT_EQ(asx_join_spawn(rid, specs, 2, &jid), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_get_outcome(jid, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_ERR);
+}
+
+TEST(race_cancels_losers_with_origin) {
+    asx_region_id rid;
+    asx_task_id race, loser;
+    asx_task_spec specs[2];
+    int fast = 1;
+    asx_outcome out;
+    asx_budget budget;
+    asx_task_slot *ls;
+    uint32_t winner;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    specs[0].poll_fn = poll_until_cancelled; specs[0].user_data = NULL;
+    specs[1].poll_fn = poll_yield_n;         specs[1].user_data = &fast;
+    ASSERT_EQ(asx_race_spawn(rid, specs, 2, &race), ASX_OK);
+    ASSERT_EQ(asx_combinator_winner(race, &winner), ASX_E_NOT_FOUND);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    ASSERT_EQ(asx_combinator_winner(race, &winner), ASX_OK);
+    ASSERT_EQ(winner, (uint32_t)1);
+    ASSERT_EQ(asx_task_get_outcome(race, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_OK);
+
+    ASSERT_EQ(asx_combinator_child(race, 0, &loser), ASX_OK);
+    ASSERT_EQ(asx_task_get_outcome(loser, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_CANCELLED);
+    ASSERT_EQ(asx_task_slot_lookup(loser, &ls), ASX_OK);
+    ASSERT_EQ(ASX_TASK_COLD(ls)->cancel_reason.kind, ASX_CANCEL_RACE_LOST);
+    ASSERT_TRUE(same_task(ASX_TASK_COLD(ls)->cancel_reason.origin_task, race));
+    ASSERT_EQ(ASX_TASK_COLD(ls)->cancel_reason.origin_region, rid);
+}
+
+TEST(select_skips_failed_children) {
+    asx_region_id rid;
+    asx_task_id sel;
+    asx_task_spec specs[3];
+    int slow = 2;
+    asx_outcome out;
+    asx_budget budget;
+    uint32_t winner;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    specs[0].poll_fn = poll_fail;            specs[0].user_data = NULL;
+    specs[1].poll_fn = poll_yield_n;         specs[1].user_data = &slow;
+    specs[2].poll_fn = poll_until_cancelled; specs[2].user_data = NULL;
+    ASSERT_EQ(asx_select_spawn(rid, specs, 3, &sel), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_combinator_winner(sel, &winner), ASX_OK);
+    ASSERT_EQ(winner, (uint32_t)1);
+    ASSERT_EQ(asx_task_get_outcome(sel, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_OK);
+}
+
+TEST(select_all_failed_has_no_winner) {
+    asx_region_id rid;
+    asx_task_id sel;
+    asx_task_spec specs[2];
+    asx_outcome out;
+    asx_budget budget;
+    uint32_t winner;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    specs[0].poll_fn = poll_fail; specs[0].user_data = NULL;
+    specs[1].poll_fn = poll_fail; specs[1].user_data = NULL;
+    ASSERT_EQ(asx_select_spawn(rid, specs, 2, &sel), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_combinator_winner(sel, &winner), ASX_E_NOT_FOUND);
+    ASSERT_EQ(asx_task_get_outcome(sel, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_ERR);
+}
+
+TEST(timeout_cancels_child_at_deadline) {
+    asx_region_id rid;
+    asx_task_id tmo, child;
+    asx_task_spec spec;
+    asx_outcome out;
+    asx_budget budget;
+    asx_task_slot *cs;
+
+    asx_runtime_reset();
+    install_test_clock();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    spec.poll_fn = poll_tick_until_cancelled;
+    spec.user_data = NULL;
+    ASSERT_EQ(asx_timeout_spawn(rid, &spec, 50u, &tmo), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_get_outcome(tmo, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_CANCELLED);
+
+    ASSERT_EQ(asx_combinator_child(tmo, 0, &child), ASX_OK);
+    ASSERT_EQ(asx_task_slot_lookup(child, &cs), ASX_OK);
+    ASSERT_EQ(ASX_TASK_COLD(cs)->cancel_reason.kind, ASX_CANCEL_TIMEOUT);
+    ASSERT_TRUE(same_task(ASX_TASK_COLD(cs)->cancel_reason.origin_task, tmo));
+    ASSERT_TRUE(g_clock_ns >= 50u);
+    ASSERT_TRUE(g_clock_ns <= 70u);
+}
+
+TEST(timeout_passes_through_early_completion) {
+    asx_region_id rid;
+    asx_task_id tmo;
+    asx_task_spec spec;
+    int n = 2;
+    asx_outcome out;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    install_test_clock();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    spec.poll_fn = poll_yield_n;
+    spec.user_data = &n;
+    ASSERT_EQ(asx_timeout_spawn(rid, &spec, 1000u, &tmo), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_get_outcome(tmo, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_OK);
+}
+
+TEST(retry_respawns_until_success) {
+    asx_region_id rid;
+    asx_task_id rt;
+    asx_task_spec spec;
+    int failures = 2;
+    asx_outcome out;
+    asx_budget budget;
+    uint32_t n;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    spec.poll_fn = poll_fail_n;
+    spec.user_data = &failures;
+    ASSERT_EQ(asx_retry_spawn(rid, &spec, 3, &rt), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_combinator_child_count(rt, &n), ASX_OK);
+    ASSERT_EQ(n, (uint32_t)3);
+    ASSERT_EQ(asx_task_get_outcome(rt, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_OK);
+}
+
+TEST(retry_gives_up_after_max_attempts) {
+    asx_region_id rid;
+    asx_task_id rt;
+    asx_task_spec spec;
+    int failures = 5;
+    asx_outcome out;
+    asx_budget budget;
+    uint32_t n;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    spec.poll_fn = poll_fail_n;
+    spec.user_data = &failures;
+    ASSERT_EQ(asx_retry_spawn(rid, &spec, 2, &rt), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_combinator_child_count(rt, &n), ASX_OK);
+    ASSERT_EQ(n, (uint32_t)2);
+    ASSERT_EQ(asx_task_get_outcome(rt, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_ERR);
+    ASSERT_EQ(asx_retry_spawn(rid, &spec, 0, &rt), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(combinator_cancel_forwards_to_children) {
+    asx_region_id rid;
+    asx_task_id jid, child;
+    asx_task_spec specs[2];
+    asx_outcome out;
+    asx_budget budget;
+    asx_task_slot *cs;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    specs[0].poll_fn = poll_until_cancelled; specs[0].user_data = NULL;
+    specs[1].poll_fn = poll_until_cancelled; specs[1].user_data = NULL;
+    ASSERT_EQ(asx_join_spawn(rid, specs, 2, &jid), ASX_OK);
+
+    budget = asx_budget_from_polls(3);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(asx_task_cancel(jid, ASX_CANCEL_USER), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_task_get_outcome(jid, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_CANCELLED);
+
+    ASSERT_EQ(asx_combinator_child(jid, 1, &child), ASX_OK);
+    ASSERT_EQ(asx_task_slot_lookup(child, &cs), ASX_OK);
+    ASSERT_TRUE(same_task(ASX_TASK_COLD(cs)->cancel_reason.origin_task, jid));
+    ASSERT_EQ(asx_task_get_outcome(child, &out), ASX_OK);
+    ASSERT_EQ(out.severity, ASX_OUTCOME_CANCELLED);
+}
+
+TEST(combinator_spawn_is_all_or_nothing) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_task_spec specs[2];
+    int zero = 0;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    specs[0].poll_fn = poll_yield_n; specs[0].user_data = &zero;
+    specs[1].poll_fn = NULL;         specs[1].user_data = NULL;
+    ASSERT_EQ(asx_join_spawn(rid, specs, 2, &tid), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_join_spawn(rid, specs, 0, &tid), ASX_E_INVALID_ARGUMENT);
+
+    for (i = 0; i < ASX_MAX_TASKS - 2u; i++) {
+        ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &zero, &tid), ASX_OK);
+    }
+    specs[1].poll_fn = poll_yield_n;
+    ASSERT_EQ(asx_join_spawn(rid, specs, 2, &tid), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_combinator_child_count(tid, &i), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(combinator_spawn_rolls_back_on_refused_child) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_task_spec specs[3];
+    asx_admission_config cfg;
+    asx_budget budget;
+    int polls = 0;
+    uint32_t i;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    /* Capacity 4 at a 50% threshold: the combinator and its first
+     * child are admitted, the second child is rejected */
+    asx_admission_config_init(&cfg);
+    cfg.policy.mode = ASX_OVERLOAD_REJECT;
+    cfg.policy.threshold_pct = 50;
+    cfg.release_pct = 40;
+    cfg.task_capacity = 4;
+    ASSERT_EQ(asx_admission_enable(rid, &cfg), ASX_OK);
+
+    for (i = 0; i < 3u; i++) {
+        specs[i].poll_fn = poll_count;
+        specs[i].user_data = &polls;
+    }
+    ASSERT_EQ(asx_join_spawn(rid, specs, 3, &tid), ASX_E_ADMISSION_CLOSED);
+    ASSERT_EQ(g_regions[asx_handle_slot(rid)].task_count, (uint32_t)0);
+
+    /* Nothing is left to run or to wait on */
+    budget = asx_budget_from_polls(50);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(polls, 0);
+
+    /* The region admits a fitting group afterwards */
+    ASSERT_EQ(asx_join_spawn(rid, specs, 1, &tid), ASX_OK);
+    budget = asx_budget_from_polls(50);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(polls, 1);
+}
+
+TEST(task_await_parks_until_child_completes) {
+    asx_region_id rid;
+    asx_task_id a, b;
+    int n = 3;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_until_cancelled, NULL, &a), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &n, &b), ASX_OK);
+
+    ASSERT_EQ(asx_task_await(a, a), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_await(a, b), ASX_E_PENDING);
+    ASSERT_EQ(asx_task_await(b, a), ASX_E_PENDING);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_combinator ===\n");
+
+    RUN_TEST(join_waits_for_all_children);
+    RUN_TEST(queries_refused_after_region_close);
+    RUN_TEST(join_outcome_is_lattice_join);
+    RUN_TEST(race_cancels_losers_with_origin);
+    RUN_TEST(select_skips_failed_children);
+    RUN_TEST(select_all_failed_has_no_winner);
+    RUN_TEST(timeout_cancels_child_at_deadline);
+    RUN_TEST(timeout_passes_through_early_completion);
+    RUN_TEST(retry_respawns_until_success);
+    RUN_TEST(retry_gives_up_after_max_attempts);
+    RUN_TEST(combinator_cancel_forwards_to_children);
+    RUN_TEST(combinator_spawn_is_all_or_nothing);
+    RUN_TEST(combinator_spawn_rolls_back_on_refused_child);
+    RUN_TEST(task_await_parks_until_child_completes);
+
+    TEST_REPORT();
+    return test_failures;
+}
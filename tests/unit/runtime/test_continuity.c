@@ -9,6 +9,9 @@
  *   4. Re-run identical scenario
  *   5. Verify deterministic match via replay verification
  *
+ * Also covers the checkpoint table, checkpoint bisection, the compact
+ * v2 encoding, reading v1 buffers and per-record status.
+ *
  * SPDX-License-Identifier: MIT
  */
 
@@ -17,6 +20,7 @@
 #include <asx/runtime/runtime.h>
 #include <asx/runtime/trace.h>
 #include <string.h>
+#include "../../../src/runtime/runtime_internal.h"
 
 /* -------------------------------------------------------------------
  * Helpers
@@ -30,9 +34,24 @@ static void reset_all(void)
     asx_replay_clear_reference();
 }
 
-/* Max binary buffer: header + 1024 events * 24 bytes each */
-#define BUF_SIZE (24u + 1024u * 24u)
+/* Max binary buffer: header + 1024 events at the v2 worst case
+ * + 16 checkpoints * 12 bytes each (covers v1 as well) */
+#define BUF_SIZE (ASX_TRACE_BINARY_HEADER \
+                  + ASX_TRACE_CAPACITY * ASX_TRACE_BINARY_EVENT_MAX \
+                  + ASX_TRACE_CHECKPOINTS * ASX_TRACE_BINARY_V2_CHECKPOINT)
 static uint8_t g_buf[BUF_SIZE];
+static uint8_t g_buf2[BUF_SIZE];
+
+/* n synthetic events; event `bad` (if < n) gets a different aux */
+static void emit_synthetic(uint32_t n, uint32_t bad)
+{
+    uint32_t i;
+    for (i = 0; i < n; i++) {
+        asx_trace_emit(i % 3u == 0 ? ASX_TRACE_SCHED_POLL
+                                   : ASX_TRACE_SCHED_COMPLETE,
+                       (uint64_t)(i % 17u), i == bad ? 0xBADu : (uint64_t)i);
+    }
+}
 
 /* -------------------------------------------------------------------
  * Binary format tests
@@ -443,6 +462,299 @@ TEST(empty_trace_export_import_roundtrip)
     asx_replay_clear_reference();
 }
 
+/* -------------------------------------------------------------------
+ * Checkpoint digests and bisection
+ * ------------------------------------------------------------------- */
+
+TEST(export_writes_checkpoint_table)
+{
+    uint32_t out_len = 0;
+    uint32_t table;
+    uint64_t cp, stored;
+    uint32_t i, b;
+
+    reset_all();
+    emit_synthetic(200, 200);
+    ASSERT_EQ(asx_trace_checkpoint_count(), (uint32_t)3);
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &out_len), ASX_OK);
+    table = ASX_TRACE_BINARY_HEADER + 200u * ASX_TRACE_BINARY_EVENT;
+    ASSERT_EQ(out_len, table + 3u * ASX_TRACE_BINARY_CHECKPOINT);
+    ASSERT_EQ(g_buf[12], (uint8_t)ASX_TRACE_CHECKPOINT_INTERVAL);
+
+    for (i = 0; i < 3u; i++) {
+        ASSERT_TRUE(asx_trace_checkpoint_get(i, &cp));
+        stored = 0;
+        for (b = 0; b < 8u; b++) {
+            stored |= (uint64_t)g_buf[table + i * 8u + b] << (8u * b);
+        }
+        ASSERT_EQ(stored, cp);
+    }
+    ASSERT_FALSE(asx_trace_checkpoint_get(3, &cp));
+
+    /* A corrupted checkpoint is rejected on import */
+    g_buf[table + 9u] ^= 0x01u;
+    ASSERT_EQ(asx_trace_import_binary(g_buf, out_len),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(replay_verify_skips_matching_checkpoints)
+{
+    asx_trace_event ref[500];
+    asx_replay_result rr;
+    uint32_t i;
+
+    reset_all();
+    emit_synthetic(500, 500);
+    for (i = 0; i < 500u; i++) {
+        ASSERT_TRUE(asx_trace_event_get(i, &ref[i]));
+    }
+    ASSERT_EQ(asx_replay_load_reference(ref, 500), ASX_OK);
+
+    asx_trace_reset();
+    emit_synthetic(500, 321);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_AUX_MISMATCH);
+    ASSERT_EQ(rr.divergence_index, (uint32_t)321);
+
+    asx_trace_reset();
+    emit_synthetic(500, 500);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+    asx_replay_clear_reference();
+}
+
+TEST(binary_bisect_finds_first_divergence)
+{
+    uint32_t len_a = 0, len_b = 0;
+    asx_replay_result rr;
+
+    reset_all();
+    emit_synthetic(1000, 1000);
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf, BUF_SIZE, &len_a), ASX_OK);
+
+    /* Identical archives */
+    ASSERT_EQ(asx_trace_binary_bisect(g_buf, len_a, g_buf, len_a, &rr),
+              ASX_OK);
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+
+    /* One differing event deep in the trace */
+    asx_trace_reset();
+    emit_synthetic(1000, 700);
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf2, BUF_SIZE, &len_b), ASX_OK);
+    ASSERT_EQ(asx_trace_binary_bisect(g_buf, len_a, g_buf2, len_b, &rr),
+              ASX_OK);
+    ASSERT_EQ(rr.result, ASX_REPLAY_AUX_MISMATCH);
+    ASSERT_EQ(rr.divergence_index, (uint32_t)700);
+    ASSERT_TRUE(rr.expected_digest != rr.actual_digest);
+
+    /* A truncated run diverges by length at its end */
+    asx_trace_reset();
+    emit_synthetic(650, 650);
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf2, BUF_SIZE, &len_b), ASX_OK);
+    ASSERT_EQ(asx_trace_binary_bisect(g_buf, len_a, g_buf2, len_b, &rr),
+              ASX_OK);
+    ASSERT_EQ(rr.result, ASX_REPLAY_LENGTH_MISMATCH);
+    ASSERT_EQ(rr.divergence_index, (uint32_t)650);
+
+    /* v1 archives without a table (interval 0) are scanned linearly */
+    ASSERT_EQ(asx_trace_export_binary(g_buf2, BUF_SIZE, &len_b), ASX_OK);
+    g_buf2[12] = 0;
+    ASSERT_EQ(asx_trace_binary_bisect(g_buf, len_a, g_buf2, len_b, &rr),
+              ASX_OK);
+    ASSERT_EQ(rr.result, ASX_REPLAY_LENGTH_MISMATCH);
+
+    ASSERT_EQ(asx_trace_binary_bisect(NULL, 0, g_buf2, len_b, &rr),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_trace_binary_bisect(g_buf, len_a, g_buf2, 30, &rr),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+/* -------------------------------------------------------------------
+ * v2 compact encoding and the v1 default
+ * ------------------------------------------------------------------- */
+
+static asx_status poll_yield_n(void *data, asx_task_id self)
+{
+    int *counter = (int *)data;
+    (void)self;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+TEST(v2_scheduler_trace_is_compact)
+{
+    static int counters[8];
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_replay_result rr;
+    uint32_t out_len = 0;
+    uint32_t count, ncp, stream;
+    uint32_t i;
+
+    reset_all();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 8u; i++) {
+        counters[i] = (int)(10u + i * 3u);
+        ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &counters[i], &tid),
+                  ASX_OK);
+    }
+    budget = asx_budget_from_polls(1000);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    count = asx_trace_event_count();
+    ASSERT_TRUE(count > 128u);
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf, BUF_SIZE, &out_len), ASX_OK);
+    ASSERT_EQ(g_buf[4], (uint8_t)ASX_TRACE_BINARY_VERSION_V2);
+
+    /* Target: 4-6 bytes per event including the checkpoint table */
+    ncp = count / ASX_TRACE_CHECKPOINT_INTERVAL;
+    stream = ASX_TRACE_BINARY_HEADER + ncp * ASX_TRACE_BINARY_V2_CHECKPOINT;
+    ASSERT_TRUE(out_len - ASX_TRACE_BINARY_HEADER <= count * 6u);
+    ASSERT_TRUE(out_len - stream <= count * 4u);
+
+    /* Decodes back to the same events and digest */
+    ASSERT_EQ(asx_trace_import_binary(g_buf, out_len), ASX_OK);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+    asx_replay_clear_reference();
+
+    /* Short buffers are reported with the exact size needed */
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf2, out_len - 1u, &count),
+              ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(count, out_len);
+}
+
+TEST(v2_roundtrips_wide_values)
+{
+    uint32_t out_len = 0;
+    asx_replay_result rr;
+    uint64_t v;
+    uint32_t i;
+
+    reset_all();
+    v = 0x9E3779B97F4A7C15ULL;
+    for (i = 0; i < 300u; i++) {
+        v ^= v << 13;
+        v ^= v >> 7;
+        v ^= v << 17;
+        /* Mix repeated, XOR-close, raw and escaped-kind values */
+        asx_trace_emit(i % 11u == 0 ? (asx_trace_event_kind)0x7Fu
+                                    : ASX_TRACE_CHANNEL_SEND,
+                       i % 4u == 0 ? v : 0x0002000000010000ULL + i % 5u,
+                       i % 3u == 0 ? (v >> 3) : (uint64_t)i);
+    }
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf, BUF_SIZE, &out_len), ASX_OK);
+    ASSERT_EQ(asx_trace_import_binary(g_buf, out_len), ASX_OK);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+    asx_replay_clear_reference();
+
+    /* A truncated stream or a bad interval offset is rejected */
+    ASSERT_EQ(asx_trace_import_binary(g_buf, out_len - 1u),
+              ASX_E_INVALID_ARGUMENT);
+    g_buf[ASX_TRACE_BINARY_HEADER + 8u] ^= 0x01u;
+    ASSERT_EQ(asx_trace_import_binary(g_buf, out_len),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(v1_is_the_default_output)
+{
+    uint32_t len_v1 = 0, len_v2 = 0;
+    asx_replay_result rr;
+
+    reset_all();
+    emit_synthetic(700, 700);
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &len_v1), ASX_OK);
+    ASSERT_EQ(g_buf[4], (uint8_t)ASX_TRACE_BINARY_VERSION);
+    ASSERT_EQ(len_v1, ASX_TRACE_BINARY_HEADER
+                      + 700u * ASX_TRACE_BINARY_EVENT
+                      + (700u / ASX_TRACE_CHECKPOINT_INTERVAL)
+                        * ASX_TRACE_BINARY_CHECKPOINT);
+    ASSERT_EQ(asx_trace_import_binary(g_buf, len_v1), ASX_OK);
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+    asx_replay_clear_reference();
+    ASSERT_EQ(asx_trace_continuity_check(g_buf, len_v1), ASX_OK);
+
+    /* Bisection works across versions */
+    asx_trace_reset();
+    emit_synthetic(700, 450);
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf2, BUF_SIZE, &len_v2), ASX_OK);
+    ASSERT_TRUE(len_v2 < len_v1 / 4u);
+    ASSERT_EQ(asx_trace_binary_bisect(g_buf, len_v1, g_buf2, len_v2, &rr),
+              ASX_OK);
+    ASSERT_EQ(rr.result, ASX_REPLAY_AUX_MISMATCH);
+    ASSERT_EQ(rr.divergence_index, (uint32_t)450);
+}
+
+/* Event 5 and 70 of 100 are forced completions */
+static void emit_with_status(void)
+{
+    uint32_t i;
+    for (i = 0; i < 100u; i++) {
+        asx_trace_record(ASX_TRACE_SCHED_COMPLETE, (uint64_t)(i % 7u),
+                         (uint64_t)i,
+                         i == 5u || i == 70u ? ASX_E_CANCELLED : ASX_OK);
+    }
+}
+
+static void check_imported_status(void)
+{
+    uint32_t i;
+    for (i = 0; i < 100u; i++) {
+        ASSERT_EQ(g_rt->replay_ref[i].status,
+                  i == 5u || i == 70u ? ASX_E_CANCELLED : ASX_OK);
+    }
+}
+
+TEST(export_carries_record_status)
+{
+    uint32_t len_v1 = 0, len_v2 = 0, len_ok = 0;
+    uint32_t table;
+    asx_replay_result rr;
+
+    reset_all();
+    emit_with_status();
+
+    /* v1: status section after the checkpoint table */
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &len_v1), ASX_OK);
+    table = ASX_TRACE_BINARY_HEADER + 100u * ASX_TRACE_BINARY_EVENT
+          + 1u * ASX_TRACE_BINARY_CHECKPOINT;
+    ASSERT_EQ(len_v1, table + ASX_TRACE_BINARY_STATUS_HEADER
+                      + 2u * ASX_TRACE_BINARY_STATUS);
+    ASSERT_EQ(asx_trace_import_binary(g_buf, len_v1), ASX_OK);
+    check_imported_status();
+    asx_replay_clear_reference();
+
+    /* Readers that stop at the table still see a valid buffer */
+    ASSERT_EQ(asx_trace_import_binary(g_buf, table), ASX_OK);
+    ASSERT_EQ(g_rt->replay_ref[5].status, ASX_OK);
+    asx_replay_clear_reference();
+
+    /* v2: status inline */
+    ASSERT_EQ(asx_trace_export_binary_v2(g_buf2, BUF_SIZE, &len_v2), ASX_OK);
+    ASSERT_EQ(asx_trace_import_binary(g_buf2, len_v2), ASX_OK);
+    check_imported_status();
+    rr = asx_replay_verify();
+    ASSERT_EQ(rr.result, ASX_REPLAY_MATCH);
+    asx_replay_clear_reference();
+
+    /* A status entry out of order is rejected */
+    g_buf[table + ASX_TRACE_BINARY_STATUS_HEADER] = 80u;
+    ASSERT_EQ(asx_trace_import_binary(g_buf, len_v1),
+              ASX_E_INVALID_ARGUMENT);
+
+    /* All-OK traces carry no status section */
+    asx_trace_reset();
+    emit_synthetic(100, 100);
+    ASSERT_EQ(asx_trace_export_binary(g_buf, BUF_SIZE, &len_ok), ASX_OK);
+    ASSERT_EQ(len_ok, table);
+}
+
 /* -------------------------------------------------------------------
  * Status string coverage
  * ------------------------------------------------------------------- */
@@ -494,6 +806,17 @@ int main(void)
     /* Edge cases */
     RUN_TEST(empty_trace_export_import_roundtrip);
 
+    /* Checkpoints and bisection */
+    RUN_TEST(export_writes_checkpoint_table);
+    RUN_TEST(replay_verify_skips_matching_checkpoints);
+    RUN_TEST(binary_bisect_finds_first_divergence);
+
+    /* v2 encoding and v1 compatibility */
+    RUN_TEST(v2_scheduler_trace_is_compact);
+    RUN_TEST(v2_roundtrips_wide_values);
+    RUN_TEST(v1_is_the_default_output);
+    RUN_TEST(export_carries_record_status);
+
     /* Status string coverage */
     RUN_TEST(new_error_codes_have_strings);
 
@@ -0,0 +1,284 @@
+/*
+ * test_event_pipeline.c — single-store event pipeline
+ *
+ * Tests that the scheduler event log and the event record log are
+ * views over the trace ring: each action is recorded once, the views
+ * agree with the trace on order, forced completions survive the
+ * projection, the rolling digests match a from-scratch fold, and all
+ * views stop retaining at ASX_TRACE_CAPACITY.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/trace.h>
+#include <asx/runtime/event.h>
+#include <asx/codec/codec.h>
+#include <string.h>
+
+#define SCHED_RUN_IGNORE(rid, bud) \
+    do { asx_status s_ = asx_scheduler_run((rid), (bud)); (void)s_; } while (0)
+
+static asx_status poll_yield_n(void *data, asx_task_id self) {
+    int *counter = (int *)data;
+    (void)self;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+static asx_status poll_stubborn(void *data, asx_task_id self) {
+    asx_checkpoint_result cr;
+    asx_status st;
+    (void)data;
+    st = asx_checkpoint(self, &cr);
+    (void)st;
+    return ASX_E_PENDING;
+}
+
+/* Region with two tasks yielding once and twice, run to quiescence */
+static void run_two_tasks(asx_region_id *rid) {
+    static int c0, c1;
+    asx_task_id t0, t1;
+    asx_budget budget;
+
+    c0 = 1;
+    c1 = 2;
+    if (asx_region_open(rid) != ASX_OK) return;
+    if (asx_task_spawn(*rid, poll_yield_n, &c0, &t0) != ASX_OK) return;
+    if (asx_task_spawn(*rid, poll_yield_n, &c1, &t1) != ASX_OK) return;
+    budget = asx_budget_from_polls(100);
+    SCHED_RUN_IGNORE(*rid, &budget);
+}
+
+TEST(sched_view_reads_trace_records) {
+    asx_region_id rid;
+    asx_scheduler_event ev;
+    asx_trace_event te;
+    uint32_t i, j, n;
+
+    asx_runtime_reset();
+    run_two_tasks(&rid);
+
+    n = asx_scheduler_event_count();
+    ASSERT_EQ(n, (uint32_t)8); /* 5 polls, 2 completes, quiescent */
+
+    /* Each scheduler event is the next scheduler-kind trace record */
+    j = 0;
+    for (i = 0; i < n; i++) {
+        ASSERT_TRUE(asx_scheduler_event_get(i, &ev));
+        ASSERT_EQ(ev.sequence, i);
+        do {
+            ASSERT_TRUE(asx_trace_event_get(j++, &te));
+        } while (te.kind > ASX_TRACE_SCHED_QUIESCENT);
+        ASSERT_EQ((uint32_t)ev.kind, (uint32_t)te.kind);
+        ASSERT_EQ((uint64_t)ev.task_id, te.entity_id);
+        ASSERT_EQ((uint64_t)ev.round, te.aux);
+    }
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
+    ASSERT_FALSE(asx_scheduler_event_get(n, &ev));
+}
+
+TEST(sched_view_restarts_per_run_trace_spans) {
+    asx_region_id rid;
+    asx_scheduler_event ev;
+    asx_budget budget;
+    uint32_t trace_after_first;
+
+    asx_runtime_reset();
+    run_two_tasks(&rid);
+    trace_after_first = asx_trace_event_count();
+
+    /* A second run on the drained region sees only its own events */
+    budget = asx_budget_from_polls(10);
+    SCHED_RUN_IGNORE(rid, &budget);
+    ASSERT_EQ(asx_scheduler_event_count(), (uint32_t)1);
+    ASSERT_TRUE(asx_scheduler_event_get(0, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
+    ASSERT_EQ(ev.sequence, (uint32_t)0);
+    ASSERT_EQ(asx_trace_event_count(), trace_after_first + 1u);
+
+    /* Random access behind the cursor still resolves */
+    ASSERT_TRUE(asx_scheduler_event_get(0, &ev));
+    ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
+}
+
+TEST(forced_completion_projects_to_cancel_forced) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_checkpoint_result cr;
+    asx_scheduler_event ev;
+    asx_trace_event te;
+    uint32_t i;
+    int found = 0;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_stubborn, NULL, &tid), ASX_OK);
+    budget = asx_budget_from_polls(1);
+    SCHED_RUN_IGNORE(rid, &budget);
+    ASSERT_EQ(asx_task_cancel(tid, ASX_CANCEL_SHUTDOWN), ASX_OK);
+    ASSERT_EQ(asx_checkpoint(tid, &cr), ASX_OK);
+    budget = asx_budget_from_polls(200);
+    SCHED_RUN_IGNORE(rid, &budget);
+
+    for (i = 0; i < asx_scheduler_event_count(); i++) {
+        ASSERT_TRUE(asx_scheduler_event_get(i, &ev));
+        if (ev.kind == ASX_SCHED_EVENT_CANCEL_FORCED) found = 1;
+    }
+    ASSERT_TRUE(found);
+
+    /* The trace keeps the canonical kind; the status marks the force */
+    found = 0;
+    for (i = 0; asx_trace_event_get(i, &te); i++) {
+        if (te.kind == ASX_TRACE_SCHED_COMPLETE) {
+            ASSERT_EQ(te.status, ASX_E_CANCELLED);
+            found = 1;
+        }
+    }
+    ASSERT_TRUE(found);
+}
+
+TEST(event_view_shares_the_ring) {
+    asx_region_id rid;
+    asx_event_record rec;
+    uint32_t trace_before;
+    uint32_t seq;
+
+    asx_runtime_reset();
+    run_two_tasks(&rid);
+
+    /* open, 2 spawns, 8 scheduler events */
+    ASSERT_EQ(asx_event_log_count(), (uint32_t)11);
+    ASSERT_TRUE(asx_event_log_get(0, &rec));
+    ASSERT_EQ(rec.kind, ASX_EVENT_REGION_OPEN);
+    ASSERT_TRUE(asx_event_log_get(1, &rec));
+    ASSERT_EQ(rec.kind, ASX_EVENT_TASK_SPAWN);
+    ASSERT_EQ(rec.parent_id, (uint64_t)rid);
+    ASSERT_TRUE(asx_event_log_get(3, &rec));
+    ASSERT_EQ(rec.kind, ASX_EVENT_TASK_POLL);
+    ASSERT_EQ(rec.status, ASX_OK);
+
+    /* An emitted event is one trace record */
+    trace_before = asx_trace_event_count();
+    seq = asx_event_emit(ASX_EVENT_DRAIN_BEGIN, 7u, 9u, ASX_E_INVALID_STATE);
+    ASSERT_EQ(seq, (uint32_t)11);
+    ASSERT_EQ(asx_trace_event_count(), trace_before + 1u);
+    ASSERT_TRUE(asx_event_log_get(seq, &rec));
+    ASSERT_EQ(rec.kind, ASX_EVENT_DRAIN_BEGIN);
+    ASSERT_EQ(rec.entity_id, (uint64_t)7u);
+    ASSERT_EQ(rec.parent_id, (uint64_t)9u);
+    ASSERT_EQ(rec.status, ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_event_emit(ASX_EVENT_KIND_COUNT, 0, 0, ASX_OK),
+              ASX_EVENT_SEQ_INVALID);
+
+    /* Reset restarts the view without clearing the trace */
+    asx_event_log_reset();
+    ASSERT_EQ(asx_event_log_count(), (uint32_t)0);
+    ASSERT_EQ(asx_trace_event_count(), trace_before + 1u);
+}
+
+TEST(rolling_digests_match_full_fold) {
+    asx_region_id rid;
+    uint64_t trace_rolled, chain_rolled;
+    uint64_t trace_full, chain_full;
+
+    /* Read the digests between runs so they fold incrementally */
+    asx_runtime_reset();
+    run_two_tasks(&rid);
+    (void)asx_trace_digest();
+    (void)asx_event_hash_chain();
+    run_two_tasks(&rid);
+    trace_rolled = asx_trace_digest();
+    chain_rolled = asx_event_hash_chain();
+    ASSERT_EQ(asx_trace_digest(), trace_rolled);
+
+    /* Same work, digests read only once at the end */
+    asx_runtime_reset();
+    run_two_tasks(&rid);
+    run_two_tasks(&rid);
+    trace_full = asx_trace_digest();
+    chain_full = asx_event_hash_chain();
+
+    ASSERT_EQ(trace_rolled, trace_full);
+    ASSERT_EQ(chain_rolled, chain_full);
+    ASSERT_NE(chain_full, (uint64_t)0x517cc1b727220a95ULL);
+}
+
+TEST(views_share_the_trace_capacity) {
+    asx_scheduler_event ev;
+    asx_event_record rec;
+    uint32_t i;
+
+    asx_runtime_reset();
+    asx_scheduler_event_reset();
+    for (i = 0; i < ASX_TRACE_CAPACITY + 10u; i++) {
+        asx_trace_emit(ASX_TRACE_SCHED_POLL, i, 0);
+    }
+
+    ASSERT_EQ(asx_scheduler_event_count(), ASX_TRACE_CAPACITY + 10u);
+    ASSERT_EQ(asx_event_log_count(), ASX_TRACE_CAPACITY + 10u);
+    ASSERT_TRUE(asx_scheduler_event_get(ASX_TRACE_CAPACITY - 1u, &ev));
+    ASSERT_EQ((uint64_t)ev.task_id, (uint64_t)(ASX_TRACE_CAPACITY - 1u));
+    ASSERT_FALSE(asx_event_log_get(ASX_TRACE_CAPACITY, &rec));
+
+    /* Scheduler records the full ring dropped are kept in the spill */
+    ASSERT_TRUE(asx_scheduler_event_get(ASX_TRACE_CAPACITY + 9u, &ev));
+    ASSERT_EQ((uint64_t)ev.task_id, (uint64_t)(ASX_TRACE_CAPACITY + 9u));
+    ASSERT_EQ(ev.sequence, ASX_TRACE_CAPACITY + 9u);
+    ASSERT_FALSE(asx_scheduler_event_get(ASX_TRACE_CAPACITY + 10u, &ev));
+}
+
+TEST(event_replay_verify_and_json) {
+    asx_region_id rid;
+    asx_event_record expected[16];
+    asx_replay_divergence div;
+    asx_codec_buffer buf;
+    uint32_t n, i;
+
+    asx_runtime_reset();
+    run_two_tasks(&rid);
+    n = asx_event_log_count();
+    ASSERT_TRUE(n <= 16u);
+    for (i = 0; i < n; i++) {
+        ASSERT_TRUE(asx_event_log_get(i, &expected[i]));
+    }
+    ASSERT_EQ(asx_event_replay_verify(expected, n, &div), ASX_OK);
+    ASSERT_EQ(div.diverged, 0);
+
+    expected[4].entity_id ^= 1u;
+    ASSERT_EQ(asx_event_replay_verify(expected, n, &div),
+              ASX_E_EQUIVALENCE_MISMATCH);
+    ASSERT_EQ(div.first_divergence_index, (uint32_t)4);
+    ASSERT_EQ(asx_event_replay_verify(expected, n - 1u, &div),
+              ASX_E_EQUIVALENCE_MISMATCH);
+    ASSERT_EQ(div.count_mismatch, 0); /* index 4 diverges first */
+
+    asx_codec_buffer_init(&buf);
+    ASSERT_EQ(asx_event_log_to_json(&buf), ASX_OK);
+    ASSERT_TRUE(buf.len > 2u);
+    ASSERT_EQ(buf.data[0], '[');
+    ASSERT_TRUE(strstr(buf.data, "\"kind\":\"region_open\"") != NULL);
+    asx_codec_buffer_reset(&buf);
+    ASSERT_EQ(asx_event_log_to_json(NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_event_pipeline ===\n");
+
+    RUN_TEST(sched_view_reads_trace_records);
+    RUN_TEST(sched_view_restarts_per_run_trace_spans);
+    RUN_TEST(forced_completion_projects_to_cancel_forced);
+    RUN_TEST(event_view_shares_the_ring);
+    RUN_TEST(rolling_digests_match_full_fold);
+    RUN_TEST(views_share_the_trace_capacity);
+    RUN_TEST(event_replay_verify_and_json);
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -0,0 +1,223 @@
+/*
+ * test_instance.c — runtime instance (asx_runtime) tests
+ *
+ * Tests: isolation of arenas, scheduler, channels and hooks between
+ * instances, per-instance instrumentation, asx_runtime_enter nesting,
+ * context-taking variants, and create/destroy argument handling.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/instance.h>
+#include <asx/runtime/hft_instrument.h>
+#include <asx/runtime/automotive_instrument.h>
+#include <string.h>
+
+static int g_polls;
+
+static asx_status poll_count_then_complete(void *data, asx_task_id self) {
+    (void)data; (void)self;
+    g_polls++;
+    return ASX_OK;
+}
+
+/* Spawns a sibling through the global API, which must land in the
+ * instance the scheduler is running. */
+static asx_status poll_spawn_sibling(void *data, asx_task_id self) {
+    asx_region_id region = *(asx_region_id *)data;
+    asx_task_id child;
+    (void)self;
+    g_polls++;
+    if (asx_task_spawn(region, poll_count_then_complete, NULL, &child)
+        != ASX_OK) {
+        return ASX_E_INVALID_STATE;
+    }
+    return ASX_OK;
+}
+
+TEST(instance_arenas_are_isolated) {
+    asx_runtime *a;
+    asx_runtime *b;
+    asx_region_id ra, rb;
+    asx_task_id ta, tb;
+    asx_task_state state;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R1, &a), ASX_OK);
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R3, &b), ASX_OK);
+    ASSERT_EQ(asx_runtime_resource_class(a), ASX_CLASS_R1);
+    ASSERT_EQ(asx_runtime_resource_class(b), ASX_CLASS_R3);
+
+    /* Fresh instances hand out the same first slots */
+    ASSERT_EQ(asx_rt_region_open(a, &ra), ASX_OK);
+    ASSERT_EQ(asx_rt_region_open(b, &rb), ASX_OK);
+    ASSERT_EQ(ra, rb);
+    ASSERT_EQ(asx_rt_task_spawn(a, ra, poll_count_then_complete, NULL, &ta),
+              ASX_OK);
+    ASSERT_EQ(asx_rt_task_spawn(b, rb, poll_count_then_complete, NULL, &tb),
+              ASX_OK);
+
+    g_polls = 0;
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_rt_scheduler_run(a, ra, &budget), ASX_OK);
+    ASSERT_EQ(g_polls, 1);
+    ASSERT_EQ(asx_rt_task_get_state(a, ta, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_COMPLETED);
+    ASSERT_EQ(asx_rt_task_get_state(b, tb, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_CREATED);
+
+    /* The default instance saw none of it */
+    ASSERT_EQ(asx_region_get_state(ra, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_TRUE(asx_quiescence_check(ra) != ASX_OK);
+    ASSERT_TRUE(asx_runtime_current() == asx_runtime_default());
+
+    asx_runtime_destroy(a);
+    asx_runtime_destroy(b);
+}
+
+TEST(instance_poll_fn_uses_running_instance) {
+    asx_runtime *rt;
+    asx_region_id region;
+    asx_task_id tid;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &rt), ASX_OK);
+    ASSERT_EQ(asx_rt_region_open(rt, &region), ASX_OK);
+    ASSERT_EQ(asx_rt_task_spawn(rt, region, poll_spawn_sibling, &region, &tid),
+              ASX_OK);
+
+    g_polls = 0;
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_rt_scheduler_run(rt, region, &budget), ASX_OK);
+    ASSERT_EQ(g_polls, 2);
+    ASSERT_EQ(asx_rt_region_drain(rt, region, &budget), ASX_OK);
+    ASSERT_TRUE(asx_rt_scheduler_event_count(rt) > 0);
+    ASSERT_TRUE(asx_rt_trace_event_count(rt) > 0);
+    ASSERT_TRUE(asx_runtime_current() == asx_runtime_default());
+    asx_runtime_destroy(rt);
+}
+
+TEST(instance_channels_and_hooks_are_isolated) {
+    asx_runtime *rt;
+    asx_region_id region;
+    asx_channel_id ch;
+    asx_send_permit permit;
+    asx_fault_injection fault;
+    uint32_t len;
+    uint64_t value;
+    void *p;
+
+    asx_runtime_reset();
+    (void)asx_fault_clear();
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &rt), ASX_OK);
+    ASSERT_EQ(asx_rt_region_open(rt, &region), ASX_OK);
+    ASSERT_EQ(asx_rt_channel_create(rt, region, 4, &ch), ASX_OK);
+    ASSERT_EQ(asx_rt_channel_try_reserve(rt, ch, &permit), ASX_OK);
+    ASSERT_EQ(asx_rt_send_permit_send(rt, &permit, 42), ASX_OK);
+    ASSERT_EQ(asx_rt_channel_queue_len(rt, ch, &len), ASX_OK);
+    ASSERT_EQ(len, (uint32_t)1);
+    ASSERT_TRUE(asx_channel_queue_len(ch, &len) != ASX_OK);
+
+    /* Faults and seal apply only to the instance they were set on */
+    memset(&fault, 0, sizeof(fault));
+    fault.kind = ASX_FAULT_ALLOC_FAIL;
+    fault.trigger_count = 1;
+    {
+        asx_runtime *prev = asx_runtime_enter(rt);
+        ASSERT_EQ(asx_fault_inject(&fault), ASX_OK);
+        ASSERT_EQ(asx_fault_injection_count(), (uint32_t)1);
+        ASSERT_TRUE(asx_runtime_enter(prev) == rt);
+    }
+    ASSERT_EQ(asx_fault_injection_count(), (uint32_t)0);
+    ASSERT_EQ(asx_rt_alloc(rt, 16, &p), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_rt_seal_allocator(rt), ASX_OK);
+    ASSERT_EQ(asx_rt_alloc(rt, 16, &p), ASX_E_ALLOCATOR_SEALED);
+
+    ASSERT_EQ(asx_rt_channel_try_recv(rt, ch, &value), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)42);
+    asx_runtime_destroy(rt);
+}
+
+TEST(instance_enter_nests_and_destroy_restores_default) {
+    asx_runtime *a;
+    asx_runtime *b;
+
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &a), ASX_OK);
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &b), ASX_OK);
+
+    ASSERT_TRUE(asx_runtime_enter(a) == asx_runtime_default());
+    ASSERT_TRUE(asx_runtime_enter(b) == a);
+    ASSERT_TRUE(asx_runtime_current() == b);
+    ASSERT_TRUE(asx_rt_timer_wheel(a) != asx_timer_wheel_global());
+    ASSERT_TRUE(asx_runtime_enter(a) == b);
+
+    /* Destroying the current instance falls back to the default */
+    asx_runtime_destroy(a);
+    ASSERT_TRUE(asx_runtime_current() == asx_runtime_default());
+    ASSERT_TRUE(asx_runtime_enter(NULL) == asx_runtime_default());
+    asx_runtime_destroy(b);
+
+    /* The default instance is never destroyed */
+    asx_runtime_destroy(asx_runtime_default());
+    asx_runtime_destroy(NULL);
+    ASSERT_TRUE(asx_runtime_current() == asx_runtime_default());
+}
+
+TEST(instance_instrumentation_is_per_instance) {
+    asx_runtime *a;
+    asx_runtime *prev;
+
+    asx_hft_instrument_reset();
+    asx_auto_instrument_reset();
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &a), ASX_OK);
+
+    prev = asx_runtime_enter(a);
+    ASSERT_EQ(asx_hft_wake_histogram()->total, 0u);
+    asx_hft_record_wake_latency(1000u);
+    asx_hft_record_poll_latency(2000u);
+    asx_auto_record_deadline(100u, 50u, 1u);
+    ASSERT_EQ(asx_hft_wake_histogram()->total, 1u);
+    ASSERT_EQ(asx_hft_sched_histogram()->total, 1u);
+    ASSERT_EQ(asx_auto_deadline_global()->total_deadlines, 1u);
+    (void)asx_runtime_enter(prev);
+
+    /* The default instance's metrics are untouched */
+    ASSERT_EQ(asx_hft_wake_histogram()->total, 0u);
+    ASSERT_EQ(asx_hft_sched_histogram()->total, 0u);
+    ASSERT_EQ(asx_auto_deadline_global()->total_deadlines, 0u);
+
+    asx_runtime_destroy(a);
+}
+
+TEST(instance_create_rejects_bad_arguments) {
+    asx_runtime *rt;
+    asx_runtime_hooks hooks;
+
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_COUNT, &rt),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.allocator.malloc_fn = NULL;
+    ASSERT_EQ(asx_runtime_create(&hooks, ASX_CLASS_R2, &rt),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_TRUE(rt == NULL);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_instance ===\n");
+
+    RUN_TEST(instance_arenas_are_isolated);
+    RUN_TEST(instance_poll_fn_uses_running_instance);
+    RUN_TEST(instance_channels_and_hooks_are_isolated);
+    RUN_TEST(instance_enter_nests_and_destroy_restores_default);
+    RUN_TEST(instance_instrumentation_is_per_instance);
+    RUN_TEST(instance_create_rejects_bad_arguments);
+
+    TEST_REPORT();
+    return test_failures;
+}
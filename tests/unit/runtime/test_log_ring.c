@@ -0,0 +1,294 @@
+/*
+ * test_log_ring.c — asynchronous bounded log pipeline
+ *
+ * Tests: FIFO delivery on drain, overflow rejection with a drop
+ * report, truncation accounting, asx_runtime_log_write routing through
+ * an attached ring, the scheduler drain step, argument handling, and
+ * (POSIX profile) producer pthreads against the drainer thread.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/log_ring.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SINK_MAX 1024u
+
+typedef struct {
+    int  level;
+    char msg[ASX_LOG_RECORD_BYTES];
+} sink_entry;
+
+static sink_entry g_sink[SINK_MAX];
+static uint32_t g_sink_count;
+static asx_log_ring g_ring;
+
+static void record_sink(void *ctx, int level, const char *message) {
+    (void)ctx;
+    if (g_sink_count >= SINK_MAX) return;
+    g_sink[g_sink_count].level = level;
+    (void)snprintf(g_sink[g_sink_count].msg, sizeof(g_sink[0].msg), "%s",
+                   message);
+    g_sink_count++;
+}
+
+static asx_status ring_setup(void) {
+    asx_log_hooks sink;
+
+    g_sink_count = 0;
+    sink.ctx = NULL;
+    sink.write_fn = record_sink;
+    return asx_log_ring_init(&g_ring, &sink);
+}
+
+TEST(log_ring_drains_fifo) {
+    asx_log_ring_stats st;
+    char msg[32];
+    uint32_t i;
+
+    ASSERT_EQ(ring_setup(), ASX_OK);
+    for (i = 0; i < 100u; i++) {
+        (void)snprintf(msg, sizeof(msg), "m%u", (unsigned)i);
+        ASSERT_EQ(asx_log_ring_push(&g_ring, (int)(i % 4u), msg), ASX_OK);
+    }
+    ASSERT_EQ(g_sink_count, (uint32_t)0);
+
+    /* Bounded drain, then the rest */
+    ASSERT_EQ(asx_log_ring_drain(&g_ring, 30), (uint32_t)30);
+    ASSERT_EQ(asx_log_ring_drain(&g_ring, 0), (uint32_t)70);
+    ASSERT_EQ(g_sink_count, (uint32_t)100);
+    for (i = 0; i < 100u; i++) {
+        (void)snprintf(msg, sizeof(msg), "m%u", (unsigned)i);
+        ASSERT_TRUE(strcmp(g_sink[i].msg, msg) == 0);
+        ASSERT_EQ(g_sink[i].level, (int)(i % 4u));
+    }
+    ASSERT_EQ(asx_log_ring_stats_get(&g_ring, &st), ASX_OK);
+    ASSERT_EQ(st.written, (uint32_t)100);
+    ASSERT_EQ(st.pending, (uint32_t)0);
+    ASSERT_EQ(st.dropped, (uint32_t)0);
+}
+
+TEST(log_ring_overflow_reports_drops) {
+    asx_log_ring_stats st;
+    uint32_t i;
+
+    ASSERT_EQ(ring_setup(), ASX_OK);
+    for (i = 0; i < ASX_LOG_RING_CAPACITY; i++) {
+        ASSERT_EQ(asx_log_ring_push(&g_ring, 1, "fill"), ASX_OK);
+    }
+    for (i = 0; i < 5u; i++) {
+        ASSERT_EQ(asx_log_ring_push(&g_ring, 1, "lost"),
+                  ASX_E_RESOURCE_EXHAUSTED);
+    }
+    ASSERT_EQ(asx_log_ring_stats_get(&g_ring, &st), ASX_OK);
+    ASSERT_EQ(st.dropped, (uint32_t)5);
+    ASSERT_EQ(st.pending, ASX_LOG_RING_CAPACITY);
+
+    /* Ring records first, then one report of the drops */
+    ASSERT_EQ(asx_log_ring_drain(&g_ring, 0), ASX_LOG_RING_CAPACITY);
+    ASSERT_EQ(g_sink_count, ASX_LOG_RING_CAPACITY + 1u);
+    ASSERT_EQ(g_sink[ASX_LOG_RING_CAPACITY].level, ASX_LOG_RING_DROP_LEVEL);
+    ASSERT_TRUE(strstr(g_sink[ASX_LOG_RING_CAPACITY].msg, "5") != NULL);
+
+    /* Reported once; the freed ring accepts again */
+    ASSERT_EQ(asx_log_ring_drain(&g_ring, 0), (uint32_t)0);
+    ASSERT_EQ(g_sink_count, ASX_LOG_RING_CAPACITY + 1u);
+    ASSERT_EQ(asx_log_ring_push(&g_ring, 1, "again"), ASX_OK);
+}
+
+TEST(log_ring_truncates_long_messages) {
+    asx_log_ring_stats st;
+    char big[ASX_LOG_RECORD_BYTES * 2u];
+
+    ASSERT_EQ(ring_setup(), ASX_OK);
+    memset(big, 'x', sizeof(big) - 1u);
+    big[sizeof(big) - 1u] = '\0';
+    ASSERT_EQ(asx_log_ring_push(&g_ring, 0, big), ASX_OK);
+    ASSERT_EQ(asx_log_ring_push(&g_ring, 0, NULL), ASX_OK);
+    ASSERT_EQ(asx_log_ring_drain(&g_ring, 0), (uint32_t)2);
+    ASSERT_EQ((uint32_t)strlen(g_sink[0].msg), ASX_LOG_RECORD_BYTES - 1u);
+    ASSERT_EQ((uint32_t)strlen(g_sink[1].msg), (uint32_t)0);
+    ASSERT_EQ(asx_log_ring_stats_get(&g_ring, &st), ASX_OK);
+    ASSERT_EQ(st.truncated, (uint32_t)1);
+}
+
+TEST(log_ring_routes_runtime_log_write) {
+    asx_runtime_hooks hooks;
+
+    ASSERT_EQ(ring_setup(), ASX_OK);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.log.ctx = NULL;
+    hooks.log.write_fn = record_sink;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+
+    asx_runtime_set_log_ring(&g_ring, 0);
+    ASSERT_TRUE(asx_runtime_get_log_ring() == &g_ring);
+    ASSERT_EQ(asx_runtime_log_write(3, "queued"), ASX_OK);
+    ASSERT_EQ(g_sink_count, (uint32_t)0);
+    ASSERT_EQ(asx_log_ring_drain(&g_ring, 0), (uint32_t)1);
+    ASSERT_EQ(g_sink_count, (uint32_t)1);
+    ASSERT_TRUE(strcmp(g_sink[0].msg, "queued") == 0);
+
+    /* Detached: synchronous again */
+    asx_runtime_set_log_ring(NULL, 0);
+    ASSERT_TRUE(asx_runtime_get_log_ring() == NULL);
+    ASSERT_EQ(asx_runtime_log_write(3, "direct"), ASX_OK);
+    ASSERT_EQ(g_sink_count, (uint32_t)2);
+}
+
+static asx_status poll_logger(void *data, asx_task_id self) {
+    uint32_t *polls = (uint32_t *)data;
+    (void)self;
+    if (asx_runtime_log_write(1, "tick") != ASX_OK) return ASX_E_INVALID_STATE;
+    if (++(*polls) < 4u) return ASX_E_PENDING;
+    return ASX_OK;
+}
+
+TEST(log_ring_scheduler_drain_step) {
+    asx_runtime_hooks hooks;
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_log_ring_stats st;
+    uint32_t polls = 0;
+
+    asx_runtime_reset();
+    ASSERT_EQ(ring_setup(), ASX_OK);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.log.write_fn = record_sink;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    asx_runtime_set_log_ring(&g_ring, 8);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_logger, &polls, &tid), ASX_OK);
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(polls, (uint32_t)4);
+
+    /* Each round drains what earlier rounds logged; the last poll's
+     * record waits for the next drain. */
+    ASSERT_EQ(g_sink_count, (uint32_t)3);
+    ASSERT_EQ(asx_log_ring_stats_get(&g_ring, &st), ASX_OK);
+    ASSERT_EQ(st.pending, (uint32_t)1);
+    ASSERT_EQ(asx_log_ring_drain(&g_ring, 0), (uint32_t)1);
+    ASSERT_EQ(g_sink_count, (uint32_t)4);
+
+    asx_runtime_set_log_ring(NULL, 0);
+}
+
+TEST(log_ring_rejects_bad_args) {
+    asx_log_hooks sink;
+    asx_log_ring_stats st;
+
+    sink.ctx = NULL;
+    sink.write_fn = NULL;
+    ASSERT_EQ(asx_log_ring_init(NULL, &sink), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_log_ring_init(&g_ring, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_log_ring_init(&g_ring, &sink), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_log_ring_push(NULL, 0, "x"), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_log_ring_drain(NULL, 0), (uint32_t)0);
+    ASSERT_EQ(asx_log_ring_stats_get(NULL, &st), ASX_E_INVALID_ARGUMENT);
+}
+
+#if defined(ASX_PROFILE_POSIX)
+#include <pthread.h>
+
+#define PRODUCERS 4u
+#define PER_PRODUCER 2000u
+
+static void *produce(void *arg) {
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    char msg[32];
+    uint32_t i;
+
+    for (i = 0; i < PER_PRODUCER; i++) {
+        (void)snprintf(msg, sizeof(msg), "%u:%u", (unsigned)id, (unsigned)i);
+        if (asx_log_ring_push(&g_ring, 0, msg) != ASX_OK) {
+            /* full: counted as dropped, reported by the drainer */
+        }
+    }
+    return NULL;
+}
+
+static uint32_t g_total_seen;
+static uint32_t g_next[PRODUCERS];
+static uint32_t g_order_errors;
+static uint32_t g_drop_reported;
+
+static void check_sink(void *ctx, int level, const char *message) {
+    unsigned id, seq;
+    (void)ctx;
+
+    if (level == ASX_LOG_RING_DROP_LEVEL) {
+        unsigned long n;
+        if (sscanf(message, "asx: %lu", &n) == 1) {
+            g_drop_reported += (uint32_t)n;
+        }
+        return;
+    }
+    g_total_seen++;
+    if (sscanf(message, "%u:%u", &id, &seq) != 2 || id >= PRODUCERS
+        || seq < g_next[id]) {
+        g_order_errors++;
+        return;
+    }
+    g_next[id] = seq + 1u;
+}
+
+TEST(log_ring_posix_producers_and_drainer) {
+    asx_log_hooks sink;
+    asx_posix_log_drainer drainer;
+    asx_log_ring_stats st;
+    pthread_t threads[PRODUCERS];
+    uint32_t i;
+
+    memset(g_next, 0, sizeof(g_next));
+    g_total_seen = 0;
+    g_order_errors = 0;
+    g_drop_reported = 0;
+    sink.ctx = NULL;
+    sink.write_fn = check_sink;
+    ASSERT_EQ(asx_log_ring_init(&g_ring, &sink), ASX_OK);
+    ASSERT_EQ(asx_posix_log_drainer_start(&drainer, &g_ring, 0),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_posix_log_drainer_start(&drainer, &g_ring, 200), ASX_OK);
+
+    for (i = 0; i < PRODUCERS; i++) {
+        ASSERT_EQ(pthread_create(&threads[i], NULL, produce,
+                                 (void *)(uintptr_t)i), 0);
+    }
+    for (i = 0; i < PRODUCERS; i++) {
+        ASSERT_EQ(pthread_join(threads[i], NULL), 0);
+    }
+    asx_posix_log_drainer_stop(&drainer);
+
+    /* Every record is either delivered in per-producer order or
+     * reported as dropped. */
+    ASSERT_EQ(asx_log_ring_stats_get(&g_ring, &st), ASX_OK);
+    ASSERT_EQ(g_order_errors, (uint32_t)0);
+    ASSERT_EQ(st.pending, (uint32_t)0);
+    ASSERT_EQ(g_total_seen, st.written);
+    ASSERT_EQ(g_drop_reported, st.dropped);
+    ASSERT_EQ(st.written + st.dropped, PRODUCERS * PER_PRODUCER);
+}
+#endif
+
+int main(void) {
+    fprintf(stderr, "=== test_log_ring ===\n");
+
+    RUN_TEST(log_ring_drains_fifo);
+    RUN_TEST(log_ring_overflow_reports_drops);
+    RUN_TEST(log_ring_truncates_long_messages);
+    RUN_TEST(log_ring_routes_runtime_log_write);
+    RUN_TEST(log_ring_scheduler_drain_step);
+    RUN_TEST(log_ring_rejects_bad_args);
+#if defined(ASX_PROFILE_POSIX)
+    RUN_TEST(log_ring_posix_producers_and_drainer);
+#endif
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -0,0 +1,206 @@
+/*
+ * test_pool_alloc.c — size-class pool allocator tests
+ *
+ * Tests: class mapping, O(1) reuse through free lists, per-class
+ * occupancy counters, reserve bound, oversize accounting, realloc,
+ * and interaction with allocator seal and ALLOC_FAIL injection when
+ * installed through asx_runtime_set_hooks.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/pool_alloc.h>
+#include <string.h>
+
+static int install_pool(asx_pool_allocator *pool, asx_resource_class cls)
+{
+    asx_runtime_hooks hooks;
+
+    (void)asx_fault_clear();
+    return asx_runtime_hooks_init(&hooks) == ASX_OK
+        && asx_pool_allocator_init(pool, cls, NULL) == ASX_OK
+        && asx_pool_allocator_bind(pool, &hooks.allocator) == ASX_OK
+        && asx_runtime_set_hooks(&hooks) == ASX_OK;
+}
+
+TEST(pool_class_mapping) {
+    ASSERT_EQ(asx_pool_class_for_size(0), (uint32_t)0);
+    ASSERT_EQ(asx_pool_class_for_size(16), (uint32_t)0);
+    ASSERT_EQ(asx_pool_class_for_size(17), (uint32_t)1);
+    ASSERT_EQ(asx_pool_class_for_size(100), (uint32_t)3);
+    ASSERT_EQ(asx_pool_class_for_size(ASX_POOL_MAX_BLOCK),
+              ASX_POOL_CLASS_COUNT - 1u);
+    ASSERT_EQ(asx_pool_class_for_size(ASX_POOL_MAX_BLOCK + 1u),
+              ASX_POOL_CLASS_OVERSIZE);
+}
+
+TEST(pool_free_then_alloc_reuses_block) {
+    asx_pool_allocator pool;
+    asx_pool_class_stats st;
+    void *a;
+    void *b;
+
+    ASSERT_TRUE(install_pool(&pool, ASX_CLASS_R1));
+    ASSERT_EQ(asx_runtime_alloc(40, &a), ASX_OK);
+    ASSERT_EQ(asx_pool_class_stats_get(&pool, 2, &st), ASX_OK);
+    ASSERT_EQ(st.block_size, (uint32_t)64);
+    ASSERT_EQ(st.in_use, (uint32_t)1);
+
+    ASSERT_EQ(asx_runtime_free(a), ASX_OK);
+    ASSERT_EQ(asx_pool_class_stats_get(&pool, 2, &st), ASX_OK);
+    ASSERT_EQ(st.in_use, (uint32_t)0);
+    ASSERT_EQ(st.cached, (uint32_t)1);
+
+    /* Same class comes back from the free list */
+    ASSERT_EQ(asx_runtime_alloc(60, &b), ASX_OK);
+    ASSERT_TRUE(a == b);
+    ASSERT_EQ(asx_pool_class_stats_get(&pool, 2, &st), ASX_OK);
+    ASSERT_EQ(st.cached, (uint32_t)0);
+    ASSERT_EQ(st.allocs, (uint64_t)2);
+    ASSERT_EQ(st.peak_in_use, (uint32_t)1);
+
+    ASSERT_EQ(asx_runtime_free(b), ASX_OK);
+    asx_pool_allocator_destroy(&pool);
+}
+
+TEST(pool_reserve_is_bounded) {
+    asx_pool_allocator pool;
+    asx_pool_class_stats st;
+    void *p;
+    uint32_t n = 0;
+
+    ASSERT_TRUE(install_pool(&pool, ASX_CLASS_R1));
+    while (asx_runtime_alloc(ASX_POOL_MAX_BLOCK, &p) == ASX_OK) {
+        n++;
+        ASSERT_TRUE(n <= asx_pool_reserve_for_class(ASX_CLASS_R1)
+                         / ASX_POOL_MAX_BLOCK);
+    }
+    ASSERT_TRUE(n > 0);
+    ASSERT_EQ(asx_pool_class_stats_get(&pool, ASX_POOL_CLASS_COUNT - 1u, &st),
+              ASX_OK);
+    ASSERT_EQ(st.in_use, n);
+    ASSERT_EQ(st.failures, (uint64_t)1);
+
+    /* Freed blocks are still served once the reserve is spent */
+    ASSERT_EQ(asx_runtime_free(p), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc(ASX_POOL_MAX_BLOCK, &p), ASX_OK);
+    asx_pool_allocator_destroy(&pool);
+}
+
+TEST(pool_oversize_is_charged_to_the_reserve) {
+    asx_pool_allocator pool;
+    void *p;
+    void *q;
+    uint32_t before;
+
+    ASSERT_TRUE(install_pool(&pool, ASX_CLASS_R1));
+    before = asx_pool_reserve_remaining(&pool);
+    ASSERT_EQ(asx_runtime_alloc(ASX_POOL_MAX_BLOCK * 4u, &p), ASX_OK);
+    memset(p, 0xA5, ASX_POOL_MAX_BLOCK * 4u);
+    ASSERT_TRUE(asx_pool_reserve_remaining(&pool)
+                <= before - ASX_POOL_MAX_BLOCK * 4u);
+
+    /* Larger than what is left: refused, not passed through */
+    ASSERT_EQ(asx_runtime_alloc((size_t)before, &q),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(pool.oversize_failures, (uint32_t)1);
+
+    /* Freeing returns the bytes */
+    ASSERT_EQ(asx_runtime_free(p), ASX_OK);
+    ASSERT_EQ(asx_pool_reserve_remaining(&pool), before);
+    ASSERT_EQ(asx_runtime_alloc((size_t)before / 2u, &q), ASX_OK);
+    ASSERT_EQ(asx_runtime_free(q), ASX_OK);
+    asx_pool_allocator_destroy(&pool);
+}
+
+TEST(pool_realloc_preserves_contents) {
+    asx_pool_allocator pool;
+    void *p;
+    void *q;
+    uint8_t *bytes;
+
+    ASSERT_TRUE(install_pool(&pool, ASX_CLASS_R2));
+    ASSERT_EQ(asx_runtime_alloc(24, &p), ASX_OK);
+    memset(p, 0x5A, 24);
+
+    /* Grows within the 32-byte class in place */
+    ASSERT_EQ(asx_runtime_realloc(p, 32, &q), ASX_OK);
+    ASSERT_TRUE(p == q);
+
+    /* Moves to a larger class, then to an oversize block */
+    ASSERT_EQ(asx_runtime_realloc(q, 500, &p), ASX_OK);
+    ASSERT_EQ(asx_runtime_realloc(p, ASX_POOL_MAX_BLOCK * 2u, &q), ASX_OK);
+    bytes = (uint8_t *)q;
+    ASSERT_EQ(bytes[0], (uint8_t)0x5A);
+    ASSERT_EQ(bytes[23], (uint8_t)0x5A);
+    ASSERT_EQ(asx_runtime_free(q), ASX_OK);
+    asx_pool_allocator_destroy(&pool);
+}
+
+TEST(pool_honours_seal_and_fault_injection) {
+    asx_pool_allocator pool;
+    asx_pool_class_stats st;
+    asx_fault_injection fault;
+    void *p;
+    void *q;
+
+    ASSERT_TRUE(install_pool(&pool, ASX_CLASS_R1));
+    ASSERT_EQ(asx_runtime_alloc(16, &p), ASX_OK);
+
+    memset(&fault, 0, sizeof(fault));
+    fault.kind = ASX_FAULT_ALLOC_FAIL;
+    fault.trigger_after = 1; /* second allocation since install */
+    fault.trigger_count = 1;
+    ASSERT_EQ(asx_fault_inject(&fault), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc(16, &q), ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_runtime_alloc(16, &q), ASX_OK);
+    ASSERT_EQ(asx_runtime_free(q), ASX_OK);
+    ASSERT_EQ(asx_fault_clear(), ASX_OK);
+
+    /* Sealed: no new blocks, but frees still return to the free list */
+    ASSERT_EQ(asx_runtime_seal_allocator(), ASX_OK);
+    ASSERT_EQ(asx_runtime_alloc(16, &q), ASX_E_ALLOCATOR_SEALED);
+    ASSERT_EQ(asx_runtime_free(p), ASX_OK);
+    ASSERT_EQ(asx_pool_class_stats_get(&pool, 0, &st), ASX_OK);
+    ASSERT_EQ(st.in_use, (uint32_t)0);
+    ASSERT_EQ(st.cached, (uint32_t)2);
+    asx_pool_allocator_destroy(&pool);
+}
+
+TEST(pool_rejects_bad_arguments) {
+    asx_pool_allocator pool;
+    asx_allocator_hooks hooks;
+    asx_allocator_hooks bad;
+    asx_pool_class_stats st;
+
+    memset(&bad, 0, sizeof(bad));
+    memset(&pool, 0, sizeof(pool));
+    ASSERT_EQ(asx_pool_allocator_init(NULL, ASX_CLASS_R1, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_pool_allocator_init(&pool, ASX_CLASS_COUNT, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_pool_allocator_init(&pool, ASX_CLASS_R1, &bad),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_pool_allocator_bind(&pool, &hooks), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_pool_allocator_init(&pool, ASX_CLASS_R1, NULL), ASX_OK);
+    ASSERT_EQ(asx_pool_class_stats_get(&pool, ASX_POOL_CLASS_COUNT, &st),
+              ASX_E_INVALID_ARGUMENT);
+    asx_pool_allocator_destroy(&pool);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_pool_alloc ===\n");
+
+    RUN_TEST(pool_class_mapping);
+    RUN_TEST(pool_free_then_alloc_reuses_block);
+    RUN_TEST(pool_reserve_is_bounded);
+    RUN_TEST(pool_oversize_is_charged_to_the_reserve);
+    RUN_TEST(pool_realloc_preserves_contents);
+    RUN_TEST(pool_honours_seal_and_fault_injection);
+    RUN_TEST(pool_rejects_bad_arguments);
+
+    TEST_REPORT();
+    return test_failures;
+}
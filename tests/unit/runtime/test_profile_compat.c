@@ -131,6 +131,28 @@ TEST(descriptor_embedded_router_defaults)
     ASSERT_EQ(desc.allocator_sealable, 1);
 }
 
+TEST(idle_strategy_per_profile)
+{
+    asx_idle_strategy hft;
+    asx_idle_strategy router;
+    asx_idle_strategy automotive;
+
+    ASSERT_EQ((int)asx_profile_get_idle_strategy(ASX_PROFILE_ID_HFT, &hft),
+              (int)ASX_OK);
+    ASSERT_EQ((int)asx_profile_get_idle_strategy(ASX_PROFILE_ID_EMBEDDED_ROUTER,
+                                                 &router), (int)ASX_OK);
+    ASSERT_EQ((int)asx_profile_get_idle_strategy(ASX_PROFILE_ID_AUTOMOTIVE,
+                                                 &automotive), (int)ASX_OK);
+    /* HFT spins longest; every profile but FREESTANDING can park */
+    ASSERT_TRUE(hft.spin_ns > router.spin_ns);
+    ASSERT_EQ(automotive.spin_ns, (uint64_t)0);
+    ASSERT_TRUE(router.park_timeout_ms > 0);
+    ASSERT_EQ((int)asx_profile_get_idle_strategy(ASX_PROFILE_ID_COUNT, &hft),
+              (int)ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ((int)asx_profile_get_idle_strategy(ASX_PROFILE_ID_HFT, NULL),
+              (int)ASX_E_INVALID_ARGUMENT);
+}
+
 TEST(descriptor_limits_align_runtime_capacities)
 {
     int i;
@@ -675,6 +697,7 @@ int main(void)
     RUN_TEST(descriptor_limits_align_runtime_capacities);
     RUN_TEST(active_profile_wait_matches_runtime_config_default);
     RUN_TEST(descriptor_all_profiles_nonzero_limits);
+    RUN_TEST(idle_strategy_per_profile);
 
     /* Properties */
     RUN_TEST(all_properties_are_operational);
@@ -0,0 +1,216 @@
+/*
+ * test_region_tree.c — nested region tree tests
+ *
+ * Tests: child linkage, cascading cancel, hierarchical drain,
+ * O(1) subtree quiescence counters, and budget split across children.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/core/ghost.h>
+
+/* ---- Test poll functions ---- */
+
+/* Always pending; ignores cancellation until force-completed */
+static asx_status poll_forever(void *data, asx_task_id self) {
+    (void)data; (void)self;
+    return ASX_E_PENDING;
+}
+
+/* Completes as soon as it observes cancellation */
+static asx_status poll_until_cancelled(void *data, asx_task_id self) {
+    asx_checkpoint_result cr;
+    (void)data;
+    if (asx_checkpoint(self, &cr) == ASX_OK && cr.cancelled) {
+        return ASX_OK;
+    }
+    return ASX_E_PENDING;
+}
+
+/* ---- Tests ---- */
+
+TEST(region_tree_open_child_links_parent) {
+    asx_region_id parent, child, root_parent, got;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &child), ASX_OK);
+
+    ASSERT_EQ(asx_region_get_parent(child, &got), ASX_OK);
+    ASSERT_EQ(got, parent);
+    ASSERT_EQ(asx_region_get_parent(parent, &root_parent), ASX_OK);
+    ASSERT_EQ(root_parent, ASX_INVALID_ID);
+
+    ASSERT_EQ(asx_region_open_child(parent, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_region_get_parent(child, NULL), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(region_tree_open_child_requires_open_parent) {
+    asx_region_id parent, child;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_region_close(parent), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &child), ASX_E_REGION_NOT_OPEN);
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_region_poison(parent), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &child), ASX_E_REGION_POISONED);
+}
+
+TEST(region_tree_cancel_cascades_to_descendants) {
+    asx_region_id parent, child, grandchild;
+    asx_task_id tp, tc, tg;
+    asx_task_state s;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &child), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(child, &grandchild), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(parent, poll_forever, NULL, &tp), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(child, poll_forever, NULL, &tc), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(grandchild, poll_forever, NULL, &tg), ASX_OK);
+
+    /* Cancelling the middle of the tree leaves the parent alone */
+    ASSERT_EQ(asx_cancel_propagate(child, ASX_CANCEL_SHUTDOWN), (uint32_t)2);
+    ASSERT_EQ(asx_task_get_state(tp, &s), ASX_OK);
+    ASSERT_EQ((int)s, (int)ASX_TASK_CREATED);
+    ASSERT_EQ(asx_task_get_state(tg, &s), ASX_OK);
+    ASSERT_EQ((int)s, (int)ASX_TASK_CANCEL_REQUESTED);
+
+    /* Re-signalling already-cancelled tasks still counts them */
+    ASSERT_EQ(asx_cancel_propagate(parent, ASX_CANCEL_SHUTDOWN), (uint32_t)3);
+    ASSERT_EQ(asx_task_get_state(tp, &s), ASX_OK);
+    ASSERT_EQ((int)s, (int)ASX_TASK_CANCEL_REQUESTED);
+    (void)tc;
+}
+
+TEST(region_tree_drain_closes_whole_subtree) {
+    asx_region_id parent, c1, c2, grandchild;
+    asx_task_id tid;
+    asx_region_state rs;
+    asx_budget budget;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &c1), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &c2), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(c1, &grandchild), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(parent, poll_until_cancelled, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(c1, poll_until_cancelled, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(c2, poll_until_cancelled, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(grandchild, poll_until_cancelled, NULL, &tid), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(parent, &budget), ASX_OK);
+
+    ASSERT_EQ(asx_region_get_state(grandchild, &rs), ASX_OK);
+    ASSERT_EQ((int)rs, (int)ASX_REGION_CLOSED);
+    ASSERT_EQ(asx_region_get_state(c2, &rs), ASX_OK);
+    ASSERT_EQ((int)rs, (int)ASX_REGION_CLOSED);
+    ASSERT_EQ(asx_quiescence_check(parent), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(c1), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check_subtree(parent), ASX_OK);
+
+    /* Closed children detach from their parent */
+    ASSERT_EQ(asx_region_get_parent(c1, &c2), ASX_OK);
+    ASSERT_EQ(c2, ASX_INVALID_ID);
+}
+
+TEST(region_tree_subtree_quiescence_counters) {
+    asx_region_id parent, child;
+    asx_task_id tid;
+    asx_budget budget;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check_subtree(parent), ASX_OK);
+
+    ASSERT_EQ(asx_region_open_child(parent, &child), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check_subtree(parent), ASX_E_INCOMPLETE_CHILDREN);
+    ASSERT_EQ(asx_quiescence_check_subtree(child), ASX_OK);
+
+    ASSERT_EQ(asx_task_spawn(child, poll_until_cancelled, NULL, &tid), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check_subtree(child), ASX_E_QUIESCENCE_TASKS_LIVE);
+
+    /* Draining the child alone leaves the (still open) parent idle */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(child, &budget), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check_subtree(parent), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(parent), ASX_E_QUIESCENCE_NOT_REACHED);
+}
+
+TEST(region_tree_budget_split_prevents_child_starvation) {
+    asx_region_id parent, busy, quick;
+    asx_task_id tid;
+    asx_task_state s;
+    asx_task_id quick_tid;
+    asx_budget budget;
+    int i;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &busy), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &quick), ASX_OK);
+    for (i = 0; i < 3; i++) {
+        ASSERT_EQ(asx_task_spawn(busy, poll_forever, NULL, &tid), ASX_OK);
+    }
+    ASSERT_EQ(asx_task_spawn(quick, poll_until_cancelled, NULL, &quick_tid), ASX_OK);
+
+    /* Two children share 4 polls: busy gets 2, quick still gets polled */
+    budget = asx_budget_from_polls(4);
+    ASSERT_EQ(asx_region_drain(parent, &budget), ASX_E_INCOMPLETE_CHILDREN);
+    ASSERT_EQ(asx_task_get_state(quick_tid, &s), ASX_OK);
+    ASSERT_EQ((int)s, (int)ASX_TASK_COMPLETED);
+    ASSERT_EQ(asx_quiescence_check(quick), ASX_OK);
+    ASSERT_EQ(asx_budget_polls(&budget), (uint32_t)1);
+
+    /* A second drain with ample budget finishes the tree */
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(parent, &budget), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(parent), ASX_OK);
+    ASSERT_EQ(asx_quiescence_check(busy), ASX_OK);
+}
+
+TEST(region_tree_closed_child_slot_recycles) {
+    asx_region_id parent, child, again;
+    asx_budget budget;
+
+    asx_runtime_reset();
+
+    ASSERT_EQ(asx_region_open(&parent), ASX_OK);
+    ASSERT_EQ(asx_region_open_child(parent, &child), ASX_OK);
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_region_drain(child, &budget), ASX_OK);
+
+    /* Reclaimed slot must not stay linked under the old parent */
+    ASSERT_EQ(asx_region_open(&again), ASX_OK);
+    ASSERT_EQ(asx_handle_slot(again), asx_handle_slot(child));
+    ASSERT_EQ(asx_quiescence_check_subtree(parent), ASX_OK);
+    ASSERT_EQ(asx_region_get_state(child, NULL), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_quiescence_check(child), ASX_E_STALE_HANDLE);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_region_tree ===\n");
+
+    RUN_TEST(region_tree_open_child_links_parent);
+    RUN_TEST(region_tree_open_child_requires_open_parent);
+    RUN_TEST(region_tree_cancel_cascades_to_descendants);
+    RUN_TEST(region_tree_drain_closes_whole_subtree);
+    RUN_TEST(region_tree_subtree_quiescence_counters);
+    RUN_TEST(region_tree_budget_split_prevents_child_starvation);
+    RUN_TEST(region_tree_closed_child_slot_recycles);
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -0,0 +1,339 @@
+/*
+ * test_restart.c — warm restart from a runtime state image
+ *
+ * Tests that a saved image restores into a fresh instance with the
+ * same snapshot digest, that pre-save handles (region tree, tasks,
+ * channels, timers) stay valid and work resumes from captured state,
+ * that pointers are re-bound through the binding table, that missing
+ * bindings and corrupted images are rejected without touching the
+ * instance, and that image size follows live state, not history.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/instance.h>
+#include <asx/runtime/restart.h>
+#include <asx/runtime/snapshot.h>
+#include <asx/core/channel.h>
+#include <asx/time/timer_wheel.h>
+#include <string.h>
+#include "../../../src/runtime/runtime_internal.h"
+
+#define SCHED_RUN_IGNORE(rid, bud) \
+    do { asx_status s_ = asx_scheduler_run((rid), (bud)); (void)s_; } while (0)
+
+typedef struct {
+    uint32_t remaining;
+    uint32_t polls;
+} countdown_state;
+
+static uint8_t g_image[8192];
+static uint8_t g_image2[8192];
+static int g_static_counter;
+static int g_cleanup_hits;
+static int g_waker;
+
+static asx_status poll_countdown(void *data, asx_task_id self) {
+    countdown_state *s = (countdown_state *)data;
+    (void)self;
+    s->polls++;
+    if (s->remaining > 0) {
+        s->remaining--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+static asx_status poll_yield_n(void *data, asx_task_id self) {
+    int *counter = (int *)data;
+    (void)self;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+static void cleanup_count(void *data) {
+    (*(int *)data)++;
+}
+
+static const asx_restart_binding g_bindings[] = {
+    { 1u, poll_countdown, NULL, NULL, NULL },
+    { 2u, poll_yield_n, NULL, NULL, &g_static_counter },
+    { 3u, NULL, NULL, cleanup_count, &g_cleanup_hits },
+    { 4u, NULL, NULL, NULL, &g_waker }
+};
+
+typedef struct {
+    asx_region_id     root, left, right, leaf;
+    asx_task_id       counted, yielder;
+    asx_obligation_id ob;
+    asx_channel_id    ch;
+    asx_timer_handle  timer;
+    countdown_state  *state;
+} world;
+
+/* Region tree root -> {left -> leaf, right}, a captured countdown in
+ * leaf, a static-data task in root, an obligation in right, a channel
+ * with two queued values and a permit out, two timers, a cleanup. */
+static int build_world(world *w) {
+    asx_send_permit permit;
+    asx_timer_handle quiet;
+    asx_region_slot *rs;
+    asx_cleanup_handle ch;
+    asx_budget budget;
+    void *state;
+
+    g_static_counter = 5;
+    g_cleanup_hits = 0;
+    asx_runtime_set_restart_bindings(g_bindings, 4u);
+    if (asx_region_open(&w->root) != ASX_OK) return 0;
+    if (asx_region_open_child(w->root, &w->left) != ASX_OK) return 0;
+    if (asx_region_open_child(w->root, &w->right) != ASX_OK) return 0;
+    if (asx_region_open_child(w->left, &w->leaf) != ASX_OK) return 0;
+    if (asx_task_spawn_captured(w->leaf, poll_countdown,
+                                (uint32_t)sizeof(countdown_state), NULL,
+                                &w->counted, &state) != ASX_OK) return 0;
+    w->state = (countdown_state *)state;
+    w->state->remaining = 6;
+    if (asx_task_spawn(w->root, poll_yield_n, &g_static_counter,
+                       &w->yielder) != ASX_OK) return 0;
+    if (asx_obligation_reserve(w->right, &w->ob) != ASX_OK) return 0;
+
+    if (asx_channel_create(w->root, 4u, &w->ch) != ASX_OK) return 0;
+    if (asx_channel_try_reserve(w->ch, &permit) != ASX_OK) return 0;
+    if (asx_send_permit_send(&permit, 11u) != ASX_OK) return 0;
+    if (asx_channel_try_reserve(w->ch, &permit) != ASX_OK) return 0;
+    if (asx_send_permit_send(&permit, 22u) != ASX_OK) return 0;
+    if (asx_channel_try_reserve(w->ch, &permit) != ASX_OK) return 0;
+
+    if (asx_timer_register(asx_timer_wheel_global(), 100u, &g_waker,
+                           &w->timer) != ASX_OK) return 0;
+    if (asx_timer_register(asx_timer_wheel_global(), 200u, NULL,
+                           &quiet) != ASX_OK) return 0;
+
+    if (asx_region_slot_lookup(w->root, &rs) != ASX_OK) return 0;
+    if (asx_cleanup_push(&rs->cleanup, cleanup_count, &g_cleanup_hits,
+                         &ch) != ASX_OK) return 0;
+
+    /* Some progress before the save */
+    budget = asx_budget_from_polls(2);
+    SCHED_RUN_IGNORE(w->leaf, &budget);
+    return w->state->polls > 0;
+}
+
+TEST(restore_rebuilds_state_in_fresh_instance) {
+    asx_runtime *fresh;
+    asx_runtime *prev;
+    asx_region_id parent;
+    asx_task_state ts;
+    asx_budget budget;
+    world w;
+    uint64_t digest, value;
+    uint32_t len, ch_len;
+    void *wakers[4];
+
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    ASSERT_TRUE(build_world(&w));
+    digest = asx_runtime_state_digest();
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len), ASX_OK);
+
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &fresh), ASX_OK);
+    prev = asx_runtime_enter(fresh);
+    asx_runtime_set_restart_bindings(g_bindings, 4u);
+    ASSERT_EQ(asx_runtime_restore(g_image, len), ASX_OK);
+    ASSERT_EQ(asx_runtime_state_digest(), digest);
+
+    /* Old handles resolve; the tree is intact */
+    ASSERT_EQ(asx_region_get_parent(w.leaf, &parent), ASX_OK);
+    ASSERT_EQ(parent, w.left);
+    ASSERT_EQ(asx_region_get_parent(w.right, &parent), ASX_OK);
+    ASSERT_EQ(parent, w.root);
+    ASSERT_EQ(asx_task_get_state(w.counted, &ts), ASX_OK);
+    ASSERT_EQ(ts, ASX_TASK_RUNNING);
+
+    ASSERT_EQ(asx_channel_queue_len(w.ch, &ch_len), ASX_OK);
+    ASSERT_EQ(ch_len, (uint32_t)2);
+    ASSERT_EQ(asx_channel_reserved_count(w.ch, &ch_len), ASX_OK);
+    ASSERT_EQ(ch_len, (uint32_t)1);
+    ASSERT_EQ(asx_channel_try_recv(w.ch, &value), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)11);
+    ASSERT_EQ(asx_channel_try_recv(w.ch, &value), ASX_OK);
+    ASSERT_EQ(value, (uint64_t)22);
+
+    ASSERT_EQ(asx_timer_active_count(asx_timer_wheel_global()), (uint32_t)2);
+    ASSERT_EQ(asx_timer_collect_expired(asx_timer_wheel_global(), 150u,
+                                        wakers, 4u), (uint32_t)1);
+    ASSERT_TRUE(wakers[0] == &g_waker);
+
+    /* The countdown resumes from its restored state */
+    budget = asx_budget_from_polls(100);
+    SCHED_RUN_IGNORE(w.leaf, &budget);
+    ASSERT_EQ(asx_task_get_state(w.counted, &ts), ASX_OK);
+    ASSERT_EQ(ts, ASX_TASK_COMPLETED);
+
+    /* The cleanup was re-bound: closing the root runs it */
+    ASSERT_EQ(asx_region_drain(w.root, &budget), ASX_OK);
+    ASSERT_EQ(g_cleanup_hits, 1);
+
+    asx_runtime_enter(prev);
+    asx_runtime_destroy(fresh);
+}
+
+TEST(restore_over_live_instance_replaces_state) {
+    world w;
+    asx_region_id extra;
+    uint32_t len, len2;
+
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    ASSERT_TRUE(build_world(&w));
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len), ASX_OK);
+
+    ASSERT_EQ(asx_region_open(&extra), ASX_OK);
+    ASSERT_EQ(asx_runtime_restore(g_image, len), ASX_OK);
+    ASSERT_EQ(asx_region_close(extra), ASX_E_NOT_FOUND);
+
+    /* Saving again reproduces the image */
+    ASSERT_EQ(asx_runtime_save(g_image2, sizeof(g_image2), &len2), ASX_OK);
+    ASSERT_EQ(len2, len);
+    ASSERT_EQ(memcmp(g_image, g_image2, len), 0);
+}
+
+TEST(save_requires_bindings) {
+    asx_region_id rid;
+    asx_task_id tid;
+    int other = 1;
+    uint32_t len;
+
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    asx_runtime_set_restart_bindings(g_bindings, 4u);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &other, &tid), ASX_OK);
+
+    /* user_data differs from every binding's data */
+    memset(g_image, 0xAB, 64);
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len),
+              ASX_E_NOT_FOUND);
+    ASSERT_EQ(g_image[0], (uint8_t)0xAB);
+    ASSERT_EQ(asx_runtime_save(NULL, 0, &len), ASX_E_INVALID_ARGUMENT);
+
+    /* Once complete the task needs no binding */
+    {
+        asx_budget budget = asx_budget_from_polls(10);
+        SCHED_RUN_IGNORE(rid, &budget);
+    }
+    ASSERT_EQ(asx_runtime_save(g_image, 4u, &len), ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(g_image[0], (uint8_t)0xAB);
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len), ASX_OK);
+}
+
+TEST(bad_images_leave_instance_untouched) {
+    world w;
+    uint64_t digest;
+    uint32_t len;
+
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    ASSERT_TRUE(build_world(&w));
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len), ASX_OK);
+    digest = asx_runtime_state_digest();
+
+    /* Corruption anywhere fails the checksum */
+    g_image[len / 2u] ^= 0x10u;
+    ASSERT_EQ(asx_runtime_restore(g_image, len), ASX_E_INVALID_ARGUMENT);
+    g_image[len / 2u] ^= 0x10u;
+    ASSERT_EQ(asx_runtime_restore(g_image, len - 1u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_restore(g_image, 3u), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_runtime_restore(NULL, len), ASX_E_INVALID_ARGUMENT);
+
+    /* A table without the cleanup binding cannot re-bind the image */
+    asx_runtime_set_restart_bindings(g_bindings, 2u);
+    ASSERT_EQ(asx_runtime_restore(g_image, len), ASX_E_NOT_FOUND);
+
+    ASSERT_EQ(asx_runtime_state_digest(), digest);
+    asx_runtime_set_restart_bindings(g_bindings, 4u);
+    ASSERT_EQ(asx_runtime_restore(g_image, len), ASX_OK);
+    ASSERT_EQ(asx_runtime_state_digest(), digest);
+}
+
+TEST(image_size_follows_live_state) {
+    asx_region_id rid;
+    asx_budget budget;
+    uint32_t len_short, len_long, i;
+
+    asx_runtime_reset();
+    asx_channel_reset();
+    asx_timer_wheel_reset(asx_timer_wheel_global());
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len_short), ASX_OK);
+
+    /* Open and close the same slot many times: history grows, live
+     * state does not */
+    for (i = 0; i < 200u; i++) {
+        budget = asx_budget_from_polls(10);
+        ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+        ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    }
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len_long), ASX_OK);
+    ASSERT_TRUE(len_long <= len_short + 1u); /* generation varint width */
+    ASSERT_EQ(asx_runtime_restore(g_image, len_long), ASX_OK);
+    ASSERT_EQ(asx_region_close(rid), ASX_OK);
+}
+
+TEST(failed_apply_leaves_instance_reset) {
+    asx_runtime *rt;
+    asx_runtime *prev;
+    asx_region_id rid;
+    asx_channel_id ch[2];
+    asx_send_permit permit;
+    uint32_t len, i;
+
+    ASSERT_EQ(asx_runtime_create(NULL, ASX_CLASS_R2, &rt), ASX_OK);
+    prev = asx_runtime_enter(rt);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    for (i = 0; i < 2u; i++) {
+        ASSERT_EQ(asx_channel_create(rid, 600, &ch[i]), ASX_OK);
+    }
+    ASSERT_EQ(asx_runtime_save(g_image, sizeof(g_image), &len), ASX_OK);
+
+    /* The second ring can only come from the allocator hook */
+    ASSERT_EQ(asx_rt_seal_allocator(rt), ASX_OK);
+    ASSERT_EQ(asx_runtime_restore(g_image, len), ASX_E_RESOURCE_EXHAUSTED);
+
+    /* No channel survives half-attached */
+    for (i = 0; i < 2u; i++) {
+        ASSERT_NE(asx_channel_try_reserve(ch[i], &permit), ASX_OK);
+    }
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &ch[0]), ASX_OK);
+    ASSERT_EQ(asx_channel_try_reserve(ch[0], &permit), ASX_OK);
+    ASSERT_EQ(asx_send_permit_send(&permit, 1u), ASX_OK);
+
+    asx_runtime_enter(prev);
+    asx_runtime_destroy(rt);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_restart ===\n");
+
+    RUN_TEST(restore_rebuilds_state_in_fresh_instance);
+    RUN_TEST(restore_over_live_instance_replaces_state);
+    RUN_TEST(save_requires_bindings);
+    RUN_TEST(bad_images_leave_instance_untouched);
+    RUN_TEST(failed_apply_leaves_instance_reset);
+    RUN_TEST(image_size_follows_live_state);
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -2,7 +2,8 @@
  * test_scheduler.c — unit tests for deterministic scheduler loop
  *
  * Tests: event sequencing, deterministic ordering, budget exhaustion,
- * round tracking, multi-task tie-break, and replay identity.
+ * round tracking, multi-task tie-break, replay identity, scheduling
+ * policies, and the idle strategy.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -11,6 +12,10 @@
 #include <asx/asx.h>
 #include <asx/runtime/runtime.h>
 #include <asx/core/ghost.h>
+#include <asx/runtime/automotive_instrument.h>
+#include <asx/runtime/hft_instrument.h>
+#include <asx/runtime/combinator.h>
+#include <asx/runtime/trace.h>
 
 /* ---- Test poll functions ---- */
 
@@ -281,6 +286,38 @@ TEST(scheduler_event_reset_clears) {
     ASSERT_EQ(asx_scheduler_event_count(), (uint32_t)0);
 }
 
+TEST(scheduler_events_readable_past_trace_capacity) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_scheduler_event ev;
+    uint32_t run, i, count;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_forever, NULL, &tid), ASX_OK);
+
+    /* Many short runs on one instance overflow the trace ring; every
+     * run must still read back its own events */
+    for (run = 0; run < 200u; run++) {
+        budget = asx_budget_from_polls(8);
+        ASSERT_EQ(asx_scheduler_run(rid, &budget),
+                  ASX_E_POLL_BUDGET_EXHAUSTED);
+        count = asx_scheduler_event_count();
+        ASSERT_EQ(count, (uint32_t)9);
+        for (i = 0; i < count; i++) {
+            ASSERT_TRUE(asx_scheduler_event_get(i, &ev));
+            ASSERT_EQ(ev.sequence, i);
+            ASSERT_EQ(ev.kind, i + 1u < count ? ASX_SCHED_EVENT_POLL
+                                              : ASX_SCHED_EVENT_BUDGET);
+        }
+        ASSERT_FALSE(asx_scheduler_event_get(count, &ev));
+    }
+    ASSERT_TRUE(asx_trace_event_count() > ASX_TRACE_CAPACITY);
+}
+
 TEST(scheduler_round_tracking_multi_round) {
     asx_region_id rid;
     asx_task_id tid;
@@ -329,6 +366,534 @@ TEST(scheduler_no_tasks_is_quiescent) {
     ASSERT_EQ(ev.kind, ASX_SCHED_EVENT_QUIESCENT);
 }
 
+/* ---- EDF policy and deadline monitor ---- */
+
+static asx_time g_sched_clock;
+
+static asx_time sched_test_clock(void *ctx) {
+    (void)ctx;
+    return g_sched_clock;
+}
+
+/* Advances the test clock by 100ns per poll, completes after N polls */
+static asx_status poll_tick_n(void *data, asx_task_id self) {
+    int *counter = (int *)data;
+    (void)self;
+    g_sched_clock += 100u;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+static uint16_t nth_poll_slot(uint32_t n) {
+    uint32_t i, seen = 0;
+    asx_scheduler_event ev;
+    for (i = 0; i < asx_scheduler_event_count(); i++) {
+        if (asx_scheduler_event_get(i, &ev) && ev.kind == ASX_SCHED_EVENT_POLL) {
+            if (seen == n) return asx_handle_slot(ev.task_id);
+            seen++;
+        }
+    }
+    return UINT16_MAX;
+}
+
+TEST(scheduler_edf_polls_tightest_deadline_first) {
+    asx_region_id rid;
+    asx_task_id none, late, early, urgent;
+    asx_budget b, budget;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_EDF), ASX_OK);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &none), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &late), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &early), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &urgent), ASX_OK);
+
+    b = asx_budget_infinite();
+    b.deadline = 5000;
+    ASSERT_EQ(asx_task_set_budget(late, &b), ASX_OK);
+    b.deadline = 1000;
+    ASSERT_EQ(asx_task_set_budget(early, &b), ASX_OK);
+    /* Same deadline, tighter priority wins over arena order */
+    b.priority = 1;
+    ASSERT_EQ(asx_task_set_budget(urgent, &b), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(nth_poll_slot(0), asx_handle_slot(urgent));
+    ASSERT_EQ(nth_poll_slot(1), asx_handle_slot(early));
+    ASSERT_EQ(nth_poll_slot(2), asx_handle_slot(late));
+    ASSERT_EQ(nth_poll_slot(3), asx_handle_slot(none));
+
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_ARENA_ORDER), ASX_OK);
+}
+
+TEST(scheduler_edf_equal_keys_fall_back_to_arena_order) {
+    asx_region_id rid;
+    asx_task_id t0, t1, t2;
+    asx_budget budget;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_EDF), ASX_OK);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t0), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t1), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &t2), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(nth_poll_slot(0), asx_handle_slot(t0));
+    ASSERT_EQ(nth_poll_slot(1), asx_handle_slot(t1));
+    ASSERT_EQ(nth_poll_slot(2), asx_handle_slot(t2));
+
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_ARENA_ORDER), ASX_OK);
+    ASSERT_EQ(asx_scheduler_set_policy((asx_sched_policy)7),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(scheduler_deadline_monitor_reports_misses) {
+    asx_region_id rid;
+    asx_task_id fast, slow;
+    asx_budget b, budget;
+    asx_runtime_hooks hooks;
+    asx_auto_deadline_tracker *dt;
+    int fast_n = 0, slow_n = 5;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    asx_auto_instrument_reset();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.clock.now_ns_fn = sched_test_clock;
+    hooks.clock.logical_now_ns_fn = sched_test_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_sched_clock = 0;
+    asx_scheduler_set_deadline_monitor(1);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_tick_n, &fast_n, &fast), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_tick_n, &slow_n, &slow), ASX_OK);
+    b = asx_budget_infinite();
+    b.deadline = 1000;
+    ASSERT_EQ(asx_task_set_budget(fast, &b), ASX_OK);
+    b.deadline = 300;
+    ASSERT_EQ(asx_task_set_budget(slow, &b), ASX_OK);
+
+    budget = asx_budget_infinite();
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    /* fast completes at t=100 (hit); slow is reported once when the
+     * clock passes 300 and not again on completion */
+    dt = asx_auto_deadline_global();
+    ASSERT_EQ(dt->total_deadlines, (uint32_t)2);
+    ASSERT_EQ(dt->deadline_hits, (uint32_t)1);
+    ASSERT_EQ(dt->deadline_misses, (uint32_t)1);
+
+    ASSERT_EQ(asx_task_set_budget(slow, &b), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_task_set_budget(slow, NULL), ASX_E_INVALID_ARGUMENT);
+    asx_scheduler_set_deadline_monitor(0);
+}
+
+/* ---- Cost-weighted fair policy ---- */
+
+static int g_heavy_polls;
+static int g_light_done;
+static int g_heavy_at_light_done;
+
+/* Never completes; reports cost *data per poll (0 = leave unreported) */
+static asx_status poll_heavy(void *data, asx_task_id self) {
+    uint64_t cost = *(uint64_t *)data;
+    g_heavy_polls++;
+    if (cost != 0 && asx_task_report_cost(self, cost) != ASX_OK) {
+        return ASX_E_INVALID_STATE;
+    }
+    return ASX_E_PENDING;
+}
+
+/* Reports cost 1, completes after N polls */
+static asx_status poll_light_n(void *data, asx_task_id self) {
+    int *counter = (int *)data;
+    if (asx_task_report_cost(self, 1) != ASX_OK) return ASX_E_INVALID_STATE;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_PENDING;
+    }
+    if (++g_light_done == 3) g_heavy_at_light_done = g_heavy_polls;
+    return ASX_OK;
+}
+
+/* Advances the test clock by *data ns per poll, never completes */
+static asx_status poll_clocked(void *data, asx_task_id self) {
+    (void)self;
+    g_sched_clock += *(asx_time *)data;
+    return ASX_E_PENDING;
+}
+
+TEST(scheduler_fair_light_tasks_not_starved) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    uint64_t heavy_cost = 500;
+    int n0 = 20, n1 = 20, n2 = 20;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_FAIR), ASX_OK);
+    g_heavy_polls = 0;
+    g_light_done = 0;
+    g_heavy_at_light_done = -1;
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_heavy, &heavy_cost, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_light_n, &n0, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_light_n, &n1, &tid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_light_n, &n2, &tid), ASX_OK);
+
+    /* Round-robin would poll the heavy task once per light poll; fair
+     * queueing lets all 63 light polls through after its first one. */
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(g_light_done, 3);
+    ASSERT_EQ(g_heavy_at_light_done, 1);
+    ASSERT_EQ(g_heavy_polls, 100 - 63);
+
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_ARENA_ORDER), ASX_OK);
+}
+
+TEST(scheduler_fair_cost_quota_bounds_run) {
+    asx_region_id rid;
+    asx_task_id heavy, done;
+    asx_budget budget;
+    uint64_t heavy_cost = 300;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_FAIR), ASX_OK);
+    g_heavy_polls = 0;
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_heavy, &heavy_cost, &heavy), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_complete, NULL, &done), ASX_OK);
+
+    /* 1000 cost units: three 300-unit polls fit, the fourth overruns */
+    budget = asx_budget_infinite();
+    budget.cost_quota = 1000;
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(g_heavy_polls, 4);
+    ASSERT_EQ(budget.cost_quota, (uint64_t)0);
+
+    ASSERT_EQ(asx_task_report_cost(heavy, 0), ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_task_report_cost(done, 1), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_ARENA_ORDER), ASX_OK);
+}
+
+TEST(scheduler_fair_measures_unreported_cost) {
+    asx_region_id rid;
+    asx_task_id slow, quick;
+    asx_budget budget;
+    asx_runtime_hooks hooks;
+    asx_time slow_ns = 1000, quick_ns = 10;
+    uint32_t i, slow_polls = 0;
+    asx_scheduler_event ev;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.clock.now_ns_fn = sched_test_clock;
+    hooks.clock.logical_now_ns_fn = sched_test_clock;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_sched_clock = 0;
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_FAIR), ASX_OK);
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_clocked, &slow_ns, &slow), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_clocked, &quick_ns, &quick), ASX_OK);
+
+    budget = asx_budget_from_polls(50);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    for (i = 0; i < asx_scheduler_event_count(); i++) {
+        if (asx_scheduler_event_get(i, &ev) && ev.kind == ASX_SCHED_EVENT_POLL
+            && asx_handle_slot(ev.task_id) == asx_handle_slot(slow)) {
+            slow_polls++;
+        }
+    }
+#if ASX_DETERMINISTIC
+    /* Deterministic builds never consult the clock: each unreported
+     * poll costs 1, so the two alternate. */
+    ASSERT_EQ(slow_polls, (uint32_t)25);
+#else
+    /* Clock deltas weigh slow 100x quick: quick gets ~100 polls per
+     * slow poll, so slow is polled once in the first 50. */
+    ASSERT_EQ(slow_polls, (uint32_t)1);
+#endif
+
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_ARENA_ORDER), ASX_OK);
+}
+
+/* Awaits the task in *data, then completes */
+/* Counts its polls; pending until the count reaches 3 */
+static asx_status poll_count_to_3(void *data, asx_task_id self) {
+    int *polls = (int *)data;
+    (void)self;
+    return ++(*polls) < 3 ? ASX_E_PENDING : ASX_OK;
+}
+
+static asx_region_id g_inner_region;
+static asx_status g_inner_status;
+
+/* Runs the inner region once with a two-poll budget, then completes */
+static asx_status poll_run_inner(void *data, asx_task_id self) {
+    asx_budget inner = asx_budget_from_polls(2);
+    (void)data; (void)self;
+    g_inner_status = asx_scheduler_run(g_inner_region, &inner);
+    return ASX_OK;
+}
+
+TEST(scheduler_edf_nested_run_keeps_its_heap) {
+    asx_region_id outer;
+    asx_task_id nester, after, inner[4];
+    asx_task_state state;
+    asx_budget budget;
+    int polls[4] = {0, 0, 0, 0};
+    uint32_t i;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_EDF), ASX_OK);
+
+    ASSERT_EQ(asx_region_open(&outer), ASX_OK);
+    ASSERT_EQ(asx_region_open(&g_inner_region), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(outer, poll_run_inner, NULL, &nester), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(outer, poll_complete, NULL, &after), ASX_OK);
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_task_spawn(g_inner_region, poll_count_to_3, &polls[i],
+                                 &inner[i]), ASX_OK);
+    }
+
+    /* The inner run spends its two polls mid-round, with tasks still
+     * in its heap; the outer run goes on with its own tasks and never
+     * polls the inner region's */
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(outer, &budget), ASX_OK);
+    ASSERT_EQ(g_inner_status, ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(polls[0] + polls[1] + polls[2] + polls[3], 2);
+    ASSERT_EQ(asx_task_get_state(after, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_COMPLETED);
+
+    /* The inner region still drains on its own */
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(g_inner_region, &budget), ASX_OK);
+    for (i = 0; i < 4u; i++) {
+        ASSERT_EQ(asx_task_get_state(inner[i], &state), ASX_OK);
+        ASSERT_EQ(state, ASX_TASK_COMPLETED);
+    }
+
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_ARENA_ORDER), ASX_OK);
+}
+
+static asx_status poll_await_then_complete(void *data, asx_task_id self) {
+    return asx_task_await(self, *(asx_task_id *)data);
+}
+
+TEST(scheduler_fair_resumes_woken_tasks) {
+    asx_region_id rid;
+    asx_task_id waiter, child, other;
+    asx_task_state state;
+    asx_budget budget;
+    uint64_t heavy_cost = 1;
+    int n = 3;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_FAIR), ASX_OK);
+    g_light_done = 0;
+
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_light_n, &n, &child), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_await_then_complete, &child, &waiter),
+              ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_heavy, &heavy_cost, &other), ASX_OK);
+
+    /* The waiter parks, drops out of the ready heap, and must come
+     * back once the child completes although the heavy task stays
+     * runnable throughout. */
+    budget = asx_budget_from_polls(20);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(asx_task_get_state(child, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_COMPLETED);
+    ASSERT_EQ(asx_task_get_state(waiter, &state), ASX_OK);
+    ASSERT_EQ(state, ASX_TASK_COMPLETED);
+
+    ASSERT_EQ(asx_scheduler_set_policy(ASX_SCHED_POLICY_ARENA_ORDER), ASX_OK);
+}
+
+/* ---- Idle strategy ---- */
+
+static asx_time g_idle_clock_step;
+static uint32_t g_reactor_timeouts[8];
+static uint32_t g_reactor_calls;
+
+/* Advances by g_idle_clock_step on every read */
+static asx_time idle_ticking_clock(void *ctx) {
+    (void)ctx;
+    g_sched_clock += g_idle_clock_step;
+    return g_sched_clock;
+}
+
+/* Never ready; a positive timeout passes that much clock time */
+static asx_status idle_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                    uint32_t *ready_count) {
+    (void)ctx;
+    if (g_reactor_calls < 8u) g_reactor_timeouts[g_reactor_calls] = timeout_ms;
+    g_reactor_calls++;
+    g_sched_clock += (asx_time)timeout_ms * 1000000u;
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+/* Awaits a task that never runs until cancelled */
+static asx_status poll_await_until_cancelled(void *data, asx_task_id self) {
+    asx_checkpoint_result cr;
+    if (asx_checkpoint(self, &cr) == ASX_OK && cr.cancelled) return ASX_OK;
+    return asx_task_await(self, *(asx_task_id *)data);
+}
+
+/* Region rid gets a timeout combinator whose child parks forever, so
+ * every round is idle until the deadline passes. */
+static int idle_fixture(asx_region_id *rid, asx_task_id *blocker,
+                        asx_time deadline, asx_reactor_wait_fn reactor) {
+    asx_runtime_hooks hooks;
+    asx_region_id other;
+    asx_task_spec spec;
+    asx_task_id tmo;
+
+    asx_runtime_reset();
+    asx_ghost_reset();
+    if (asx_runtime_hooks_init(&hooks) != ASX_OK) return 0;
+    hooks.clock.now_ns_fn = idle_ticking_clock;
+    hooks.clock.logical_now_ns_fn = idle_ticking_clock;
+    hooks.reactor.ghost_wait_fn = NULL;
+    hooks.reactor.wait_fn = reactor;
+    if (asx_runtime_set_hooks(&hooks) != ASX_OK) return 0;
+    g_sched_clock = 0;
+    g_reactor_calls = 0;
+    asx_scheduler_idle_stats_reset();
+    asx_hft_instrument_reset();
+
+    spec.poll_fn = poll_await_until_cancelled;
+    spec.user_data = blocker;
+    return asx_region_open(&other) == ASX_OK
+        && asx_task_spawn(other, poll_complete, NULL, blocker) == ASX_OK
+        && asx_region_open(rid) == ASX_OK
+        && asx_timeout_spawn(*rid, &spec, deadline, &tmo) == ASX_OK;
+}
+
+TEST(scheduler_idle_spin_waits_for_deadline) {
+    asx_region_id rid;
+    asx_task_id blocker;
+    asx_budget budget;
+    asx_idle_strategy idle;
+    asx_idle_stats st;
+    uint32_t plain_polls;
+
+    /* Without a strategy the idle rounds burn polls until expiry */
+    g_idle_clock_step = 100;
+    ASSERT_TRUE(idle_fixture(&rid, &blocker, 50000u, NULL));
+    budget = asx_budget_from_polls(10000);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    plain_polls = 10000u - budget.poll_quota;
+    ASSERT_EQ(asx_scheduler_idle_stats(&st), ASX_OK);
+    ASSERT_EQ(st.waits, (uint64_t)0);
+
+    /* Spinning reaches the deadline inside one idle wait */
+    ASSERT_TRUE(idle_fixture(&rid, &blocker, 50000u, NULL));
+    idle.spin_ns = 1000000u;
+    idle.yield_count = 0;
+    idle.park_timeout_ms = 0;
+    asx_scheduler_set_idle_strategy(&idle);
+    budget = asx_budget_from_polls(10000);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_TRUE(10000u - budget.poll_quota < plain_polls);
+    ASSERT_EQ(asx_scheduler_idle_stats(&st), ASX_OK);
+    ASSERT_EQ(st.waits, (uint64_t)1);
+    ASSERT_EQ(st.wakes[ASX_IDLE_WAKE_SPIN], (uint64_t)1);
+    ASSERT_EQ(asx_hft_wake_histogram()->total, (uint32_t)1);
+    ASSERT_TRUE(asx_hft_wake_histogram()->max_ns <= 200u);
+
+    asx_scheduler_set_idle_strategy(NULL);
+}
+
+TEST(scheduler_idle_wait_keeps_fault_clock_ticks) {
+    asx_region_id rid;
+    asx_task_id blocker;
+    asx_budget budget;
+    asx_idle_strategy idle;
+    asx_idle_stats st;
+    asx_fault_injection f;
+    asx_time now = 0;
+
+    /* A skew from the 64th counted clock read on; the spin alone
+     * reads the clock about 500 times */
+    g_idle_clock_step = 100;
+    ASSERT_TRUE(idle_fixture(&rid, &blocker, 50000u, NULL));
+    asx_fault_clear();
+    memset(&f, 0, sizeof(f));
+    f.kind = ASX_FAULT_CLOCK_SKEW;
+    f.param = 1000000000u;
+    f.trigger_after = 64;
+    ASSERT_EQ(asx_fault_inject(&f), ASX_OK);
+    idle.spin_ns = 1000000u;
+    idle.yield_count = 0;
+    idle.park_timeout_ms = 0;
+    asx_scheduler_set_idle_strategy(&idle);
+    budget = asx_budget_from_polls(10000);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_scheduler_idle_stats(&st), ASX_OK);
+    ASSERT_EQ(st.wakes[ASX_IDLE_WAKE_SPIN], (uint64_t)1);
+
+    /* The idle reads did not move the fault schedule */
+    ASSERT_EQ(asx_runtime_now_ns(&now), ASX_OK);
+    ASSERT_TRUE(now < 1000000000u);
+
+    asx_fault_clear();
+    asx_scheduler_set_idle_strategy(NULL);
+}
+
+TEST(scheduler_idle_yields_then_parks_on_reactor) {
+    asx_region_id rid;
+    asx_task_id blocker;
+    asx_budget budget;
+    asx_idle_strategy idle;
+    asx_idle_stats st;
+
+    /* Frozen clock: spin cannot end the wait, the park does */
+    g_idle_clock_step = 0;
+    ASSERT_TRUE(idle_fixture(&rid, &blocker, 2500000u, idle_reactor_wait));
+    idle.spin_ns = 0;
+    idle.yield_count = 3;
+    idle.park_timeout_ms = 5;
+    asx_scheduler_set_idle_strategy(&idle);
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    /* Three zero-timeout yields, then a park cut to the deadline */
+    ASSERT_TRUE(g_reactor_calls >= 4u);
+    ASSERT_EQ(g_reactor_timeouts[0], (uint32_t)0);
+    ASSERT_EQ(g_reactor_timeouts[2], (uint32_t)0);
+    ASSERT_EQ(g_reactor_timeouts[3], (uint32_t)3);
+    ASSERT_EQ(asx_scheduler_idle_stats(&st), ASX_OK);
+    ASSERT_EQ(st.wakes[ASX_IDLE_WAKE_PARK], (uint64_t)1);
+    ASSERT_EQ(asx_hft_wake_histogram()->total, (uint32_t)1);
+
+    asx_scheduler_set_idle_strategy(NULL);
+}
+
 int main(void) {
     fprintf(stderr, "=== test_scheduler ===\n");
 
@@ -340,8 +905,20 @@ int main(void) {
     RUN_TEST(scheduler_replay_identity);
     RUN_TEST(scheduler_event_get_out_of_bounds);
     RUN_TEST(scheduler_event_reset_clears);
+    RUN_TEST(scheduler_events_readable_past_trace_capacity);
     RUN_TEST(scheduler_round_tracking_multi_round);
     RUN_TEST(scheduler_no_tasks_is_quiescent);
+    RUN_TEST(scheduler_edf_polls_tightest_deadline_first);
+    RUN_TEST(scheduler_edf_equal_keys_fall_back_to_arena_order);
+    RUN_TEST(scheduler_deadline_monitor_reports_misses);
+    RUN_TEST(scheduler_fair_light_tasks_not_starved);
+    RUN_TEST(scheduler_fair_cost_quota_bounds_run);
+    RUN_TEST(scheduler_edf_nested_run_keeps_its_heap);
+    RUN_TEST(scheduler_fair_resumes_woken_tasks);
+    RUN_TEST(scheduler_fair_measures_unreported_cost);
+    RUN_TEST(scheduler_idle_spin_waits_for_deadline);
+    RUN_TEST(scheduler_idle_wait_keeps_fault_clock_ticks);
+    RUN_TEST(scheduler_idle_yields_then_parks_on_reactor);
 
     TEST_REPORT();
     return test_failures;
@@ -0,0 +1,355 @@
+/*
+ * test_shard.c — shard-per-core groups and cross-shard rings
+ *
+ * Tests: ping-pong across two shards through bounded rings (with
+ * back-pressure), per-shard isolation, reproducible combined digest,
+ * poll budget and stop, root drain spanning several quanta, disconnect
+ * on shard exit, argument handling,
+ * and (POSIX profile) the same ping-pong on pinned pthreads.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/shard.h>
+#include <string.h>
+
+#define PING_COUNT 200u   /* well above ASX_SHARD_RING_CAPACITY */
+
+static asx_shard_group g_group;
+
+/* -------------------------------------------------------------------
+ * Ping-pong: shard 0 sends 0..N-1, shard 1 echoes v + 1000
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t out_of_order;
+    int      has_pending;
+    uint64_t pending;
+    uint32_t self_seen;
+} ping_state;
+
+static ping_state g_ping[2];
+
+static asx_status poll_ping(void *data, asx_task_id self) {
+    ping_state *ps = &g_ping[0];
+    asx_shard_permit permit;
+    uint64_t v;
+    (void)data; (void)self;
+
+    while (ps->sent < PING_COUNT
+           && asx_shard_try_reserve(&g_group, 1, &permit) == ASX_OK) {
+        if (asx_shard_permit_send(&permit, ps->sent) != ASX_OK) {
+            return ASX_E_INVALID_STATE;
+        }
+        ps->sent++;
+    }
+    while (asx_shard_try_recv(&g_group, 1, &v) == ASX_OK) {
+        if (v != (uint64_t)ps->received + 1000u) ps->out_of_order++;
+        ps->received++;
+    }
+    return ps->received == PING_COUNT ? ASX_OK : ASX_E_PENDING;
+}
+
+static asx_status poll_echo(void *data, asx_task_id self) {
+    ping_state *ps = &g_ping[1];
+    asx_shard_permit permit;
+    uint64_t v;
+    (void)data; (void)self;
+
+    for (;;) {
+        if (ps->has_pending) {
+            if (asx_shard_try_reserve(&g_group, 0, &permit) != ASX_OK) {
+                return ASX_E_PENDING;
+            }
+            if (asx_shard_permit_send(&permit, ps->pending) != ASX_OK) {
+                return ASX_E_INVALID_STATE;
+            }
+            ps->has_pending = 0;
+            ps->sent++;
+            if (ps->sent == PING_COUNT) return ASX_OK;
+        }
+        if (asx_shard_try_recv(&g_group, 0, &v) != ASX_OK) {
+            return ASX_E_PENDING;
+        }
+        ps->received++;
+        ps->pending = v + 1000u;
+        ps->has_pending = 1;
+    }
+}
+
+static asx_status setup_ping_pong(void *arg, uint32_t shard,
+                                  asx_region_id root) {
+    asx_task_id t;
+    (void)arg;
+
+    g_ping[shard].self_seen = asx_shard_self(&g_group);
+    return asx_task_spawn(root, shard == 0 ? poll_ping : poll_echo, NULL, &t);
+}
+
+static asx_status run_ping_pong(const asx_shard_thread_hooks *threads) {
+    asx_shard_config cfg;
+    asx_status st;
+
+    memset(g_ping, 0, sizeof(g_ping));
+    asx_shard_config_init(&cfg);
+    cfg.shard_count = 2;
+    cfg.setup_fn = setup_ping_pong;
+    cfg.poll_quantum = 8;
+    if (threads != NULL) cfg.threads = *threads;
+    st = asx_shard_group_init(&g_group, &cfg);
+    if (st != ASX_OK) return st;
+    return asx_shard_group_run(&g_group);
+}
+
+TEST(shard_ping_pong_inline) {
+    asx_shard_stats s0;
+    asx_shard_stats s1;
+
+    ASSERT_EQ(run_ping_pong(NULL), ASX_OK);
+    ASSERT_EQ(g_ping[0].received, PING_COUNT);
+    ASSERT_EQ(g_ping[0].out_of_order, (uint32_t)0);
+    ASSERT_EQ(g_ping[1].received, PING_COUNT);
+    ASSERT_EQ(g_ping[0].self_seen, (uint32_t)0);
+    ASSERT_EQ(g_ping[1].self_seen, (uint32_t)1);
+
+    ASSERT_EQ(asx_shard_stats_get(&g_group, 0, &s0), ASX_OK);
+    ASSERT_EQ(asx_shard_stats_get(&g_group, 1, &s1), ASX_OK);
+    ASSERT_EQ(s0.status, ASX_OK);
+    ASSERT_EQ(s0.sent, (uint64_t)PING_COUNT);
+    ASSERT_EQ(s0.received, (uint64_t)PING_COUNT);
+    ASSERT_EQ(s1.sent, (uint64_t)PING_COUNT);
+    ASSERT_TRUE(s0.polls > 1);
+    ASSERT_TRUE(s0.trace_digest != s1.trace_digest);
+
+    /* Shards ran in their own instances, not the caller's */
+    ASSERT_TRUE(asx_runtime_current() == asx_runtime_default());
+    ASSERT_EQ(asx_shard_self(&g_group), ASX_SHARD_NONE);
+    ASSERT_TRUE(asx_shard_runtime(&g_group, 0) != asx_shard_runtime(&g_group, 1));
+    asx_shard_group_destroy(&g_group);
+}
+
+TEST(shard_group_digest_is_reproducible) {
+    uint64_t first;
+
+    ASSERT_EQ(run_ping_pong(NULL), ASX_OK);
+    first = asx_shard_group_digest(&g_group);
+    asx_shard_group_destroy(&g_group);
+
+    ASSERT_EQ(run_ping_pong(NULL), ASX_OK);
+    ASSERT_EQ(asx_shard_group_digest(&g_group), first);
+    asx_shard_group_destroy(&g_group);
+}
+
+/* -------------------------------------------------------------------
+ * Budget, stop and disconnect
+ * ------------------------------------------------------------------- */
+
+static uint32_t g_spins;
+static int      g_stop_after;
+
+static asx_status poll_spin(void *data, asx_task_id self) {
+    asx_checkpoint_result cr;
+    (void)data;
+
+    if (asx_checkpoint(self, &cr) == ASX_OK && cr.cancelled) return ASX_OK;
+    g_spins++;
+    if (g_stop_after > 0 && g_spins == (uint32_t)g_stop_after) {
+        asx_shard_group_stop(&g_group);
+    }
+    return ASX_E_PENDING;
+}
+
+static asx_status setup_spin(void *arg, uint32_t shard, asx_region_id root) {
+    asx_task_id t;
+    (void)arg; (void)shard;
+    return asx_task_spawn(root, poll_spin, NULL, &t);
+}
+
+TEST(shard_poll_budget_and_stop) {
+    asx_shard_config cfg;
+    asx_shard_stats st;
+
+    asx_shard_config_init(&cfg);
+    cfg.setup_fn = setup_spin;
+    cfg.poll_quantum = 16;
+    cfg.poll_budget = 100;
+    g_spins = 0;
+    g_stop_after = 0;
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_OK);
+    ASSERT_EQ(asx_shard_group_run(&g_group), ASX_E_POLL_BUDGET_EXHAUSTED);
+    ASSERT_EQ(asx_shard_stats_get(&g_group, 0, &st), ASX_OK);
+    ASSERT_EQ(st.polls, (uint32_t)100);
+    ASSERT_EQ(asx_shard_group_run(&g_group), ASX_E_INVALID_STATE);
+    asx_shard_group_destroy(&g_group);
+
+    cfg.poll_budget = 0;
+    g_spins = 0;
+    g_stop_after = 20;
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_OK);
+    ASSERT_EQ(asx_shard_group_run(&g_group), ASX_E_CANCELLED);
+    ASSERT_EQ(asx_shard_stats_get(&g_group, 0, &st), ASX_OK);
+    ASSERT_TRUE(st.polls >= 20 && st.polls <= 32);
+    asx_shard_group_destroy(&g_group);
+}
+
+/* Once cancelled, needs 40 more polls (several quanta) to finish */
+static uint32_t g_unwind;
+
+static asx_status poll_slow_unwind(void *data, asx_task_id self) {
+    asx_checkpoint_result cr;
+    (void)data;
+
+    if (asx_checkpoint(self, &cr) == ASX_OK && cr.cancelled) {
+        return ++g_unwind == 40u ? ASX_OK : ASX_E_PENDING;
+    }
+    asx_shard_group_stop(&g_group);
+    return ASX_E_PENDING;
+}
+
+static asx_status setup_slow_unwind(void *arg, uint32_t shard,
+                                    asx_region_id root) {
+    asx_task_id t;
+    (void)arg; (void)shard;
+    return asx_task_spawn(root, poll_slow_unwind, NULL, &t);
+}
+
+TEST(shard_drain_spans_quanta) {
+    asx_shard_config cfg;
+
+    asx_shard_config_init(&cfg);
+    cfg.setup_fn = setup_slow_unwind;
+    cfg.poll_quantum = 8;
+    g_unwind = 0;
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_OK);
+    ASSERT_EQ(asx_shard_group_run(&g_group), ASX_E_CANCELLED);
+    ASSERT_EQ(g_unwind, 40u);
+    asx_shard_group_destroy(&g_group);
+
+    /* A drain allowance below the unwind leaves the task unfinished */
+    cfg.poll_budget = 20;
+    g_unwind = 0;
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_OK);
+    ASSERT_EQ(asx_shard_group_run(&g_group), ASX_E_CANCELLED);
+    ASSERT_EQ(g_unwind, 20u);
+    asx_shard_group_destroy(&g_group);
+}
+
+static int g_disconnects;
+
+static asx_status poll_until_disconnect(void *data, asx_task_id self) {
+    asx_shard_permit permit;
+    asx_status st;
+    uint64_t v;
+    (void)data; (void)self;
+
+    st = asx_shard_try_reserve(&g_group, 1, &permit);
+    if (st == ASX_OK) {
+        asx_shard_permit_abort(&permit);
+        asx_shard_permit_abort(&permit);
+        return ASX_E_PENDING;
+    }
+    if (st != ASX_E_DISCONNECTED) return st;
+    if (asx_shard_try_recv(&g_group, 1, &v) != ASX_E_DISCONNECTED) {
+        return ASX_E_INVALID_STATE;
+    }
+    g_disconnects++;
+    return ASX_OK;
+}
+
+static asx_status setup_one_sided(void *arg, uint32_t shard,
+                                  asx_region_id root) {
+    asx_task_id t;
+    (void)arg;
+    if (shard != 0) return ASX_OK; /* shard 1 is empty and exits */
+    return asx_task_spawn(root, poll_until_disconnect, NULL, &t);
+}
+
+TEST(shard_exit_disconnects_peers) {
+    asx_shard_config cfg;
+
+    asx_shard_config_init(&cfg);
+    cfg.shard_count = 2;
+    cfg.setup_fn = setup_one_sided;
+    g_disconnects = 0;
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_OK);
+    ASSERT_EQ(asx_shard_group_run(&g_group), ASX_OK);
+    ASSERT_EQ(g_disconnects, 1);
+    asx_shard_group_destroy(&g_group);
+}
+
+TEST(shard_rejects_bad_arguments) {
+    asx_shard_config cfg;
+    asx_shard_permit permit;
+    asx_shard_stats st;
+    uint64_t v;
+
+    asx_shard_config_init(&cfg);
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_E_INVALID_ARGUMENT);
+    cfg.setup_fn = setup_spin;
+    cfg.shard_count = ASX_MAX_SHARDS + 1u;
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_E_INVALID_ARGUMENT);
+    cfg.shard_count = 2;
+    cfg.poll_quantum = 0;
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_E_INVALID_ARGUMENT);
+    cfg.poll_quantum = 1;
+
+    ASSERT_EQ(asx_shard_group_init(&g_group, &cfg), ASX_OK);
+    /* Messaging from outside any shard */
+    ASSERT_EQ(asx_shard_try_reserve(&g_group, 1, &permit), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_shard_try_recv(&g_group, 1, &v), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_shard_try_reserve(&g_group, 2, &permit),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_shard_stats_get(&g_group, 2, &st), ASX_E_INVALID_ARGUMENT);
+    ASSERT_TRUE(asx_shard_runtime(&g_group, 2) == NULL);
+
+    /* Messaging to self from inside a shard */
+    (void)asx_runtime_enter(asx_shard_runtime(&g_group, 0));
+    ASSERT_EQ(asx_shard_self(&g_group), (uint32_t)0);
+    ASSERT_EQ(asx_shard_try_reserve(&g_group, 0, &permit),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_shard_try_reserve(&g_group, 1, &permit), ASX_OK);
+    ASSERT_EQ(asx_shard_permit_send(&permit, 7), ASX_OK);
+    ASSERT_EQ(asx_shard_permit_send(&permit, 8), ASX_E_INVALID_STATE);
+    (void)asx_runtime_enter(asx_shard_runtime(&g_group, 1));
+    ASSERT_EQ(asx_shard_try_recv(&g_group, 0, &v), ASX_OK);
+    ASSERT_EQ(v, (uint64_t)7);
+    ASSERT_EQ(asx_shard_try_recv(&g_group, 0, &v), ASX_E_WOULD_BLOCK);
+    (void)asx_runtime_enter(NULL);
+
+    ASSERT_EQ(asx_shard_permit_send(NULL, 1), ASX_E_INVALID_ARGUMENT);
+    asx_shard_group_destroy(&g_group);
+}
+
+#if defined(ASX_PROFILE_POSIX)
+TEST(shard_ping_pong_threaded) {
+    asx_shard_thread_hooks threads;
+
+    ASSERT_EQ(asx_posix_shard_thread_hooks(&threads), ASX_OK);
+    ASSERT_EQ(run_ping_pong(&threads), ASX_OK);
+    ASSERT_EQ(g_ping[0].received, PING_COUNT);
+    ASSERT_EQ(g_ping[0].out_of_order, (uint32_t)0);
+    ASSERT_EQ(g_ping[1].self_seen, (uint32_t)1);
+    asx_shard_group_destroy(&g_group);
+}
+#endif
+
+int main(void) {
+    fprintf(stderr, "=== test_shard ===\n");
+
+    RUN_TEST(shard_ping_pong_inline);
+    RUN_TEST(shard_group_digest_is_reproducible);
+    RUN_TEST(shard_poll_budget_and_stop);
+    RUN_TEST(shard_drain_spans_quanta);
+    RUN_TEST(shard_exit_disconnects_peers);
+    RUN_TEST(shard_rejects_bad_arguments);
+#if defined(ASX_PROFILE_POSIX)
+    RUN_TEST(shard_ping_pong_threaded);
+#endif
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -0,0 +1,246 @@
+/*
+ * test_snapshot.c — runtime snapshots and change tracking
+ *
+ * Tests that asx_runtime_snapshot_update re-reads only the changed
+ * entities and matches a fresh capture, that the incremental state
+ * digest agrees with the snapshot hash, that detached snapshots are
+ * recaptured in full, and that the binary encoding round-trips and
+ * rejects corrupted buffers.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/runtime.h>
+#include <asx/runtime/snapshot.h>
+#include <asx/codec/codec.h>
+#include <string.h>
+
+#define SCHED_RUN_IGNORE(rid, bud) \
+    do { asx_status s_ = asx_scheduler_run((rid), (bud)); (void)s_; } while (0)
+
+static asx_runtime_snapshot g_snap;
+static asx_runtime_snapshot g_fresh;
+static uint8_t g_bin[4096];
+
+static asx_status poll_yield_n(void *data, asx_task_id self) {
+    int *counter = (int *)data;
+    (void)self;
+    if (*counter > 0) {
+        (*counter)--;
+        return ASX_E_PENDING;
+    }
+    return ASX_OK;
+}
+
+/* Eight regions with two tasks and an obligation each */
+static void build_population(asx_region_id *rids, asx_task_id *tids,
+                             asx_obligation_id *oids, int *counters) {
+    uint32_t i;
+
+    for (i = 0; i < 8u; i++) {
+        counters[2u * i] = 100;
+        counters[2u * i + 1u] = 100;
+        if (asx_region_open(&rids[i]) != ASX_OK) return;
+        if (asx_task_spawn(rids[i], poll_yield_n, &counters[2u * i],
+                           &tids[2u * i]) != ASX_OK) return;
+        if (asx_task_spawn(rids[i], poll_yield_n, &counters[2u * i + 1u],
+                           &tids[2u * i + 1u]) != ASX_OK) return;
+        if (asx_obligation_reserve(rids[i], &oids[i]) != ASX_OK) return;
+    }
+}
+
+TEST(update_rereads_only_changed_entities) {
+    asx_region_id rids[8];
+    asx_task_id tids[16];
+    asx_obligation_id oids[8];
+    int counters[16];
+    asx_budget budget;
+    uint32_t changed;
+
+    asx_runtime_reset();
+    build_population(rids, tids, oids, counters);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_snap), ASX_OK);
+    ASSERT_EQ(g_snap.region_count, (uint32_t)8);
+    ASSERT_EQ(g_snap.task_count, (uint32_t)16);
+    ASSERT_EQ(g_snap.obligation_count, (uint32_t)8);
+
+    /* Nothing happened: nothing to re-read */
+    ASSERT_EQ(asx_runtime_snapshot_update(&g_snap, &changed), ASX_OK);
+    ASSERT_EQ(changed, (uint32_t)0);
+
+    /* Commit one obligation, finish one task */
+    ASSERT_EQ(asx_obligation_commit(oids[3]), ASX_OK);
+    counters[10] = 0;
+    budget = asx_budget_from_polls(1);
+    SCHED_RUN_IGNORE(rids[5], &budget);
+
+    ASSERT_EQ(asx_runtime_snapshot_update(&g_snap, &changed), ASX_OK);
+    ASSERT_TRUE(changed >= 2u && changed <= 4u);
+    ASSERT_EQ(g_snap.obligations[3].state, ASX_OBLIGATION_COMMITTED);
+    ASSERT_EQ(g_snap.tasks[10].state, ASX_TASK_COMPLETED);
+    ASSERT_EQ(g_snap.tasks[10].outcome_status, ASX_OK);
+    ASSERT_EQ(g_snap.tasks[11].outcome_status, ASX_E_TASK_NOT_COMPLETED);
+    ASSERT_EQ(g_snap.regions[5].task_count, (uint32_t)1);
+
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_fresh), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&g_snap, &g_fresh), ASX_OK);
+}
+
+TEST(update_tracks_region_reclaim) {
+    asx_region_id rid, rid2;
+    asx_budget budget;
+    uint32_t changed;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_snap), ASX_OK);
+
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_region_drain(rid, &budget), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_update(&g_snap, &changed), ASX_OK);
+    ASSERT_EQ(changed, (uint32_t)1);
+    ASSERT_EQ(g_snap.regions[0].state, ASX_REGION_CLOSED);
+
+    /* A reclaimed slot reappears with the next generation */
+    ASSERT_EQ(asx_region_open(&rid2), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_update(&g_snap, &changed), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_fresh), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&g_snap, &g_fresh), ASX_OK);
+    ASSERT_EQ(g_snap.regions[0].id, rid2);
+}
+
+TEST(digest_matches_snapshot_hash) {
+    asx_region_id rids[8];
+    asx_task_id tids[16];
+    asx_obligation_id oids[8];
+    int counters[16];
+    asx_budget budget;
+    uint64_t before;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_state_digest(), (uint64_t)0);
+    build_population(rids, tids, oids, counters);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_snap), ASX_OK);
+    ASSERT_EQ(g_snap.digest, asx_runtime_snapshot_hash(&g_snap));
+    ASSERT_EQ(asx_runtime_state_digest(), g_snap.digest);
+
+    before = asx_runtime_state_digest();
+    ASSERT_EQ(asx_obligation_abort(oids[0]), ASX_OK);
+    ASSERT_NE(asx_runtime_state_digest(), before);
+
+    counters[0] = 0;
+    budget = asx_budget_from_polls(1);
+    SCHED_RUN_IGNORE(rids[0], &budget);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_fresh), ASX_OK);
+    ASSERT_EQ(asx_runtime_state_digest(), asx_runtime_snapshot_hash(&g_fresh));
+
+    /* Reset forgets everything */
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_state_digest(), (uint64_t)0);
+}
+
+TEST(detached_snapshots_are_recaptured) {
+    asx_region_id rid;
+    uint32_t changed;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+
+    asx_runtime_snapshot_init(&g_snap);
+    ASSERT_EQ(asx_runtime_snapshot_update(&g_snap, &changed), ASX_OK);
+    ASSERT_EQ(changed, ASX_SNAPSHOT_FULL);
+    ASSERT_EQ(g_snap.region_count, (uint32_t)1);
+
+    /* A newer capture supersedes g_snap */
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_fresh), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_update(&g_snap, &changed), ASX_OK);
+    ASSERT_EQ(changed, ASX_SNAPSHOT_FULL);
+
+    /* And so does a reset */
+    asx_runtime_reset();
+    ASSERT_EQ(asx_runtime_snapshot_update(&g_snap, &changed), ASX_OK);
+    ASSERT_EQ(changed, ASX_SNAPSHOT_FULL);
+    ASSERT_EQ(g_snap.region_count, (uint32_t)0);
+
+    ASSERT_EQ(asx_runtime_snapshot_update(NULL, &changed),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(binary_roundtrip_and_rejects_corruption) {
+    asx_region_id rids[8];
+    asx_task_id tids[16];
+    asx_obligation_id oids[8];
+    int counters[16];
+    uint32_t len, small_len;
+
+    asx_runtime_reset();
+    build_population(rids, tids, oids, counters);
+    ASSERT_EQ(asx_obligation_commit(oids[1]), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_snap), ASX_OK);
+
+    ASSERT_EQ(asx_runtime_snapshot_encode(&g_snap, g_bin, sizeof(g_bin),
+                                          &len), ASX_OK);
+    ASSERT_TRUE(len < 8u * 32u); /* 32 records in a few bytes each */
+    ASSERT_EQ(asx_runtime_snapshot_decode(g_bin, len, &g_fresh), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_eq(&g_snap, &g_fresh), ASX_OK);
+    ASSERT_EQ(g_fresh.digest, g_snap.digest);
+    ASSERT_TRUE(g_fresh.owner == NULL);
+
+    /* Too small: the size is reported and nothing is written */
+    memset(g_bin, 0xAB, sizeof(g_bin));
+    ASSERT_EQ(asx_runtime_snapshot_encode(&g_snap, g_bin, 10u, &small_len),
+              ASX_E_BUFFER_TOO_SMALL);
+    ASSERT_EQ(small_len, len);
+    ASSERT_EQ(g_bin[0], (uint8_t)0xAB);
+
+    ASSERT_EQ(asx_runtime_snapshot_encode(&g_snap, g_bin, sizeof(g_bin),
+                                          &len), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_decode(g_bin, len - 1u, &g_fresh),
+              ASX_E_INVALID_ARGUMENT);
+    g_bin[len - 2u] ^= 0x01u; /* last obligation's region generation */
+    ASSERT_EQ(asx_runtime_snapshot_decode(g_bin, len, &g_fresh),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(g_fresh.region_count, (uint32_t)0);
+    g_bin[len - 2u] ^= 0x01u;
+    g_bin[4] = 9u;
+    ASSERT_EQ(asx_runtime_snapshot_decode(g_bin, len, &g_fresh),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(json_lists_records_and_digests) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_codec_buffer buf;
+    int counter = 0;
+
+    asx_runtime_reset();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_yield_n, &counter, &tid), ASX_OK);
+    ASSERT_EQ(asx_runtime_snapshot_capture(&g_snap), ASX_OK);
+
+    asx_codec_buffer_init(&buf);
+    ASSERT_EQ(asx_runtime_snapshot_to_json(&g_snap, &buf), ASX_OK);
+    ASSERT_TRUE(strstr(buf.data, "{\"regions\":[{\"id\":") == buf.data);
+    ASSERT_TRUE(strstr(buf.data, "\"outcome_status\":") != NULL);
+    ASSERT_TRUE(strstr(buf.data, "\"obligations\":[]") != NULL);
+    ASSERT_TRUE(strstr(buf.data, "\"digest\":") != NULL);
+    asx_codec_buffer_reset(&buf);
+    ASSERT_EQ(asx_runtime_snapshot_to_json(NULL, &buf),
+              ASX_E_INVALID_ARGUMENT);
+}
+
+int main(void) {
+    fprintf(stderr, "=== test_snapshot ===\n");
+
+    RUN_TEST(update_rereads_only_changed_entities);
+    RUN_TEST(update_tracks_region_reclaim);
+    RUN_TEST(digest_matches_snapshot_hash);
+    RUN_TEST(detached_snapshots_are_recaptured);
+    RUN_TEST(binary_roundtrip_and_rejects_corruption);
+    RUN_TEST(json_lists_records_and_digests);
+
+    TEST_REPORT();
+    return test_failures;
+}
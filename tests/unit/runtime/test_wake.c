@@ -0,0 +1,459 @@
+/*
+ * test_wake.c — cross-thread wake handles
+ *
+ * Tests: signal coalescing over a burst with FIFO drain and hindsight
+ * record, drain-fn backpressure keeping order, scheduler-driven drain
+ * into a channel, idle wait ending on a submission, a submission racing
+ * the drain keeping its wakeup, argument handling,
+ * and (POSIX profile) eventfd/pipe signalling from producer pthreads.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/runtime/wake.h>
+#include <asx/runtime/hindsight.h>
+#include <stddef.h>
+#include <string.h>
+
+#define BURST 10000u
+
+static asx_wake_node g_nodes[BURST];
+static asx_wake_handle g_handle;
+
+static uint32_t g_signal_calls;
+static uint32_t g_clear_calls;
+
+static void count_signal(void *ctx) { (void)ctx; g_signal_calls++; }
+static void count_clear(void *ctx)  { (void)ctx; g_clear_calls++; }
+
+/* Records accepted values; refuses once g_accept_limit is reached */
+static uint64_t g_seen[BURST];
+static uint32_t g_seen_count;
+static uint32_t g_accept_limit;
+
+static asx_status record_drain(void *ctx, asx_wake_node *node) {
+    (void)ctx;
+    if (g_seen_count >= g_accept_limit) return ASX_E_WOULD_BLOCK;
+    g_seen[g_seen_count++] = node->value;
+    return ASX_OK;
+}
+
+static void wake_setup(void) {
+    asx_runtime_reset();
+    asx_hindsight_reset();
+    g_signal_calls = 0;
+    g_clear_calls = 0;
+    g_seen_count = 0;
+    g_accept_limit = BURST;
+}
+
+static asx_status submit_range(uint32_t from, uint32_t to) {
+    asx_status st;
+    uint32_t i;
+
+    for (i = from; i < to; i++) {
+        g_nodes[i].value = i;
+        st = asx_wake_submit(&g_handle, &g_nodes[i]);
+        if (st != ASX_OK) return st;
+    }
+    return ASX_OK;
+}
+
+TEST(wake_burst_coalesces_and_drains_fifo) {
+    asx_region_id rid;
+    asx_wake_signal sig;
+    asx_wake_stats st;
+    asx_hindsight_event ev;
+    uint32_t count;
+    uint32_t i;
+    uint32_t out_of_order = 0;
+
+    wake_setup();
+    sig.ctx = NULL;
+    sig.signal_fn = count_signal;
+    sig.clear_fn = count_clear;
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, record_drain, NULL, &sig),
+              ASX_OK);
+
+    /* One signal for the whole burst */
+    ASSERT_EQ(submit_range(0, BURST), ASX_OK);
+    ASSERT_EQ(g_signal_calls, (uint32_t)1);
+
+    ASSERT_EQ(asx_wake_drain(&g_handle, &count), ASX_OK);
+    ASSERT_EQ(count, BURST);
+    ASSERT_EQ(g_clear_calls, (uint32_t)1);
+    for (i = 0; i < BURST; i++) {
+        if (g_seen[i] != i) out_of_order++;
+    }
+    ASSERT_EQ(out_of_order, (uint32_t)0);
+
+    /* The drain is on record for replay */
+    ASSERT_EQ(asx_hindsight_readable_count(), (uint32_t)1);
+    ASSERT_TRUE(asx_hindsight_get(0, &ev));
+    ASSERT_EQ(ev.kind, ASX_ND_WAKE_DRAIN);
+    ASSERT_EQ(ev.entity_id, (uint64_t)rid);
+    ASSERT_EQ(ev.observed_value, (uint64_t)BURST);
+
+    /* The next submission after a drain signals again */
+    ASSERT_EQ(submit_range(0, 1), ASX_OK);
+    ASSERT_EQ(g_signal_calls, (uint32_t)2);
+    ASSERT_EQ(asx_wake_stats_get(&g_handle, &st), ASX_OK);
+    ASSERT_EQ(st.signals, (uint32_t)2);
+    ASSERT_EQ(st.drains, (uint32_t)1);
+    ASSERT_EQ(st.delivered, (uint64_t)BURST);
+
+    asx_wake_handle_destroy(&g_handle);
+}
+
+TEST(wake_backpressure_keeps_order) {
+    asx_region_id rid;
+    asx_wake_stats st;
+    uint32_t count;
+    uint32_t i;
+    uint32_t out_of_order = 0;
+
+    wake_setup();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, record_drain, NULL, NULL),
+              ASX_OK);
+
+    g_accept_limit = 3;
+    ASSERT_EQ(submit_range(0, 10), ASX_OK);
+    ASSERT_EQ(asx_wake_drain(&g_handle, &count), ASX_OK);
+    ASSERT_EQ(count, (uint32_t)3);
+
+    /* Later submissions queue behind the refused ones */
+    ASSERT_EQ(submit_range(10, 20), ASX_OK);
+    g_accept_limit = BURST;
+    ASSERT_EQ(asx_wake_drain(&g_handle, &count), ASX_OK);
+    ASSERT_EQ(count, (uint32_t)17);
+    ASSERT_EQ(g_seen_count, (uint32_t)20);
+    for (i = 0; i < 20u; i++) {
+        if (g_seen[i] != i) out_of_order++;
+    }
+    ASSERT_EQ(out_of_order, (uint32_t)0);
+    ASSERT_EQ(asx_wake_stats_get(&g_handle, &st), ASX_OK);
+    ASSERT_EQ(st.stalls, (uint32_t)1);
+    ASSERT_EQ(st.drains, (uint32_t)2);
+
+    asx_wake_handle_destroy(&g_handle);
+}
+
+/* -------------------------------------------------------------------
+ * Scheduler drain into a channel
+ * ------------------------------------------------------------------- */
+
+typedef struct {
+    asx_channel_id ch;
+    uint32_t       received;
+    uint32_t       out_of_order;
+    uint32_t       want;
+} consumer_state;
+
+static asx_status poll_consumer(void *data, asx_task_id self) {
+    consumer_state *cs = (consumer_state *)data;
+    uint64_t v;
+    (void)self;
+
+    while (asx_channel_try_recv(cs->ch, &v) == ASX_OK) {
+        if (v != cs->received) cs->out_of_order++;
+        cs->received++;
+    }
+    return cs->received == cs->want ? ASX_OK : ASX_E_PENDING;
+}
+
+TEST(wake_scheduler_drains_into_channel) {
+    asx_region_id rid;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_wake_stats st;
+    consumer_state cs;
+
+    wake_setup();
+    memset(&cs, 0, sizeof(cs));
+    cs.want = 40;
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_channel_create(rid, 4, &cs.ch), ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, asx_wake_drain_to_channel,
+                                   &cs.ch, NULL), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_consumer, &cs, &tid), ASX_OK);
+
+    /* Submitted before the run; the full channel meters the drain */
+    ASSERT_EQ(submit_range(0, 40), ASX_OK);
+    budget = asx_budget_from_polls(100);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+    ASSERT_EQ(cs.received, (uint32_t)40);
+    ASSERT_EQ(cs.out_of_order, (uint32_t)0);
+    ASSERT_EQ(asx_wake_stats_get(&g_handle, &st), ASX_OK);
+    ASSERT_EQ(st.delivered, (uint64_t)40);
+    ASSERT_TRUE(st.stalls > 0u);
+
+    asx_wake_handle_destroy(&g_handle);
+}
+
+/* -------------------------------------------------------------------
+ * Idle wait ends on a submission
+ * ------------------------------------------------------------------- */
+
+static uint32_t g_reactor_calls;
+
+/* Never ready; the second poll sees a submission arrive, as if a
+ * producer thread had raced the scheduler into the wait. */
+static asx_status submitting_reactor_wait(void *ctx, uint32_t timeout_ms,
+                                          uint32_t *ready_count) {
+    (void)ctx; (void)timeout_ms;
+    g_reactor_calls++;
+    if (g_reactor_calls == 2u) {
+        g_nodes[0].value = 7;
+        if (asx_wake_submit(&g_handle, &g_nodes[0]) != ASX_OK) {
+            return ASX_E_INVALID_STATE;
+        }
+    }
+    *ready_count = 0;
+    return ASX_OK;
+}
+
+static asx_status poll_until_woken(void *data, asx_task_id self) {
+    if (g_seen_count > 0) return ASX_OK;
+    return asx_task_await(self, *(asx_task_id *)data);
+}
+
+TEST(wake_submission_ends_idle_wait) {
+    asx_runtime_hooks hooks;
+    asx_region_id other;
+    asx_region_id rid;
+    asx_task_id blocker;
+    asx_task_id tid;
+    asx_budget budget;
+    asx_idle_strategy idle;
+    asx_idle_stats st;
+
+    wake_setup();
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    hooks.reactor.ghost_wait_fn = NULL;
+    hooks.reactor.wait_fn = submitting_reactor_wait;
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+    g_reactor_calls = 0;
+    asx_scheduler_idle_stats_reset();
+
+    ASSERT_EQ(asx_region_open(&other), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(other, poll_until_woken, &blocker, &blocker),
+              ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_task_spawn(rid, poll_until_woken, &blocker, &tid), ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, record_drain, NULL, NULL),
+              ASX_OK);
+
+    idle.spin_ns = 0;
+    idle.yield_count = 8;
+    idle.park_timeout_ms = 50;
+    asx_scheduler_set_idle_strategy(&idle);
+    budget = asx_budget_from_polls(20);
+    ASSERT_EQ(asx_scheduler_run(rid, &budget), ASX_OK);
+
+    /* Woken in the yield phase, before any park */
+    ASSERT_EQ(g_reactor_calls, (uint32_t)2);
+    ASSERT_EQ(g_seen_count, (uint32_t)1);
+    ASSERT_EQ(g_seen[0], (uint64_t)7);
+    ASSERT_EQ(asx_scheduler_idle_stats(&st), ASX_OK);
+    ASSERT_EQ(st.waits, (uint64_t)1);
+    ASSERT_EQ(st.wakes[ASX_IDLE_WAKE_YIELD], (uint64_t)1);
+
+    asx_scheduler_set_idle_strategy(NULL);
+    asx_wake_handle_destroy(&g_handle);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    ASSERT_EQ(asx_runtime_set_hooks(&hooks), ASX_OK);
+}
+
+/* Signal token count, as an eventfd would hold; the clear drains it.
+ * g_race_node is submitted from inside the first clear, standing in
+ * for a producer racing the consumer's take. */
+static uint32_t g_tokens;
+static asx_wake_node *g_race_node;
+
+static void token_signal(void *ctx) { (void)ctx; g_tokens++; }
+static void token_clear(void *ctx) {
+    asx_wake_node *node = g_race_node;
+    (void)ctx;
+    g_race_node = NULL;
+    if (node != NULL && asx_wake_submit(&g_handle, node) != ASX_OK) return;
+    g_tokens = 0;
+}
+
+TEST(wake_racing_submit_is_not_lost) {
+    asx_region_id rid;
+    asx_wake_signal sig;
+    uint32_t count;
+
+    wake_setup();
+    g_tokens = 0;
+    sig.ctx = NULL;
+    sig.signal_fn = token_signal;
+    sig.clear_fn = token_clear;
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, record_drain, NULL, &sig),
+              ASX_OK);
+
+    g_nodes[0].value = 0;
+    g_nodes[1].value = 1;
+    g_race_node = &g_nodes[1];
+    ASSERT_EQ(asx_wake_submit(&g_handle, &g_nodes[0]), ASX_OK);
+    ASSERT_EQ(asx_wake_drain(&g_handle, &count), ASX_OK);
+    ASSERT_EQ(count, (uint32_t)2);
+
+    /* The next submission must still leave a token to wake on */
+    g_nodes[2].value = 2;
+    ASSERT_EQ(asx_wake_submit(&g_handle, &g_nodes[2]), ASX_OK);
+    ASSERT_EQ(g_tokens, (uint32_t)1);
+    ASSERT_EQ(asx_wake_drain(&g_handle, &count), ASX_OK);
+    ASSERT_EQ(count, (uint32_t)1);
+
+    asx_wake_handle_destroy(&g_handle);
+}
+
+TEST(wake_rejects_bad_arguments) {
+    asx_wake_handle extra[ASX_MAX_WAKE_HANDLES];
+    asx_region_id rid;
+    uint32_t count = 99;
+    uint32_t i;
+
+    wake_setup();
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(NULL, rid, record_drain, NULL, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, NULL, NULL, NULL),
+              ASX_E_INVALID_ARGUMENT);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, ASX_INVALID_ID, record_drain,
+                                   NULL, NULL), ASX_E_NOT_FOUND);
+
+    /* A bound handle is not re-bound over its queue */
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, record_drain, NULL, NULL),
+              ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, record_drain, NULL, NULL),
+              ASX_E_INVALID_STATE);
+    asx_wake_handle_destroy(&g_handle);
+
+    /* Unbound handles refuse work */
+    memset(&g_handle, 0, sizeof(g_handle));
+    ASSERT_EQ(asx_wake_submit(&g_handle, &g_nodes[0]), ASX_E_INVALID_STATE);
+    ASSERT_EQ(asx_wake_drain(&g_handle, &count), ASX_E_INVALID_STATE);
+    ASSERT_EQ(count, (uint32_t)0);
+    ASSERT_EQ(asx_wake_submit(NULL, &g_nodes[0]), ASX_E_INVALID_ARGUMENT);
+
+    for (i = 0; i < ASX_MAX_WAKE_HANDLES; i++) {
+        ASSERT_EQ(asx_wake_handle_init(&extra[i], rid, record_drain, NULL,
+                                       NULL), ASX_OK);
+    }
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, record_drain, NULL, NULL),
+              ASX_E_RESOURCE_EXHAUSTED);
+    ASSERT_EQ(asx_wake_submit(&g_handle, NULL), ASX_E_INVALID_ARGUMENT);
+
+    /* A runtime reset unbinds every handle */
+    asx_runtime_reset();
+    ASSERT_EQ(asx_wake_submit(&extra[0], &g_nodes[0]), ASX_E_INVALID_STATE);
+}
+
+TEST(wake_handle_splits_fields_at_cache_line) {
+    ASSERT_EQ(offsetof(asx_wake_handle, backlog_head),
+              (size_t)ASX_CACHE_LINE);
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+    ASSERT_EQ(sizeof(asx_wake_handle) % ASX_CACHE_LINE, (size_t)0);
+    ASSERT_EQ((uintptr_t)&g_handle % ASX_CACHE_LINE, (uintptr_t)0);
+#endif
+}
+
+#if defined(ASX_PROFILE_POSIX)
+#include <pthread.h>
+
+#define PRODUCERS     4u
+#define PER_PRODUCER  1000u
+
+static asx_wake_node g_mt_nodes[PRODUCERS][PER_PRODUCER];
+static uint32_t g_mt_next[PRODUCERS];
+static uint32_t g_mt_out_of_order;
+
+static asx_status mt_drain(void *ctx, asx_wake_node *node) {
+    uint32_t p = (uint32_t)(node->value >> 32);
+    uint32_t seq = (uint32_t)node->value;
+    (void)ctx;
+
+    if (seq != g_mt_next[p]) g_mt_out_of_order++;
+    g_mt_next[p] = seq + 1u;
+    g_seen_count++;
+    return ASX_OK;
+}
+
+static void *mt_producer(void *arg) {
+    uint32_t p = (uint32_t)(uintptr_t)arg;
+    uint32_t i;
+
+    for (i = 0; i < PER_PRODUCER; i++) {
+        g_mt_nodes[p][i].value = ((uint64_t)p << 32) | i;
+        if (asx_wake_submit(&g_handle, &g_mt_nodes[p][i]) != ASX_OK) break;
+    }
+    return NULL;
+}
+
+TEST(wake_posix_fd_cross_thread) {
+    asx_posix_wake_fd wfd;
+    asx_wake_signal sig;
+    asx_wake_stats st;
+    asx_region_id rid;
+    pthread_t threads[PRODUCERS];
+    uint32_t count;
+    uint32_t i;
+    uint32_t rounds = 0;
+
+    wake_setup();
+    memset(g_mt_next, 0, sizeof(g_mt_next));
+    g_mt_out_of_order = 0;
+    ASSERT_EQ(asx_posix_wake_fd_open(&wfd, &sig), ASX_OK);
+    ASSERT_EQ(asx_region_open(&rid), ASX_OK);
+    ASSERT_EQ(asx_wake_handle_init(&g_handle, rid, mt_drain, NULL, &sig),
+              ASX_OK);
+
+    for (i = 0; i < PRODUCERS; i++) {
+        ASSERT_EQ(pthread_create(&threads[i], NULL, mt_producer,
+                                 (void *)(uintptr_t)i), 0);
+    }
+    while (g_seen_count < PRODUCERS * PER_PRODUCER && rounds < 10000000u) {
+        if (asx_wake_drain(&g_handle, &count) != ASX_OK) break;
+        rounds++;
+    }
+    for (i = 0; i < PRODUCERS; i++) {
+        ASSERT_EQ(pthread_join(threads[i], NULL), 0);
+    }
+    ASSERT_EQ(asx_wake_drain(&g_handle, &count), ASX_OK);
+
+    /* Per-producer order survives interleaving; signals coalesce */
+    ASSERT_EQ(g_seen_count, PRODUCERS * PER_PRODUCER);
+    ASSERT_EQ(g_mt_out_of_order, (uint32_t)0);
+    ASSERT_EQ(asx_wake_stats_get(&g_handle, &st), ASX_OK);
+    ASSERT_TRUE(st.signals >= 1u);
+    ASSERT_TRUE(st.signals <= PRODUCERS * PER_PRODUCER);
+
+    asx_wake_handle_destroy(&g_handle);
+    asx_posix_wake_fd_close(&wfd);
+}
+#endif
+
+int main(void) {
+    fprintf(stderr, "=== test_wake ===\n");
+
+    RUN_TEST(wake_burst_coalesces_and_drains_fifo);
+    RUN_TEST(wake_backpressure_keeps_order);
+    RUN_TEST(wake_scheduler_drains_into_channel);
+    RUN_TEST(wake_submission_ends_idle_wait);
+    RUN_TEST(wake_racing_submit_is_not_lost);
+    RUN_TEST(wake_rejects_bad_arguments);
+    RUN_TEST(wake_handle_splits_fields_at_cache_line);
+#if defined(ASX_PROFILE_POSIX)
+    RUN_TEST(wake_posix_fd_cross_thread);
+#endif
+
+    TEST_REPORT();
+    return test_failures;
+}
@@ -2,7 +2,8 @@
  * test_timer_wheel.c — timer wheel unit tests (bd-2cw.4)
  *
  * Tests timer registration, firing, deterministic ordering, O(1) cancel,
- * generation validation, resource exhaustion, and churn scenarios.
+ * generation validation, resource exhaustion, churn scenarios, and
+ * slack-based batching.
  *
  * SPDX-License-Identifier: MIT
  */
@@ -514,6 +515,128 @@ TEST(timer_large_time_jump) {
     ASSERT_EQ(wakers[2], (void *)5);
 }
 
+/* -------------------------------------------------------------------
+ * Test: slack coalesces spread timers into few batches
+ * ------------------------------------------------------------------- */
+
+/* Drive the wheel like a reactor loop: sleep to the next batch, collect.
+ * Returns the number of wakeups needed to fire every timer. */
+static uint32_t drain_in_batches(asx_timer_wheel *w, uint32_t *out_fired,
+                                 uint32_t *out_misordered) {
+    void *wakers[ASX_MAX_TIMERS];
+    asx_time next;
+    uintptr_t last = 0;
+    uint32_t wakeups = 0;
+    uint32_t i, n;
+
+    *out_fired = 0;
+    *out_misordered = 0;
+    while (asx_timer_next_expiry(w, &next) && wakeups < ASX_MAX_TIMERS) {
+        n = asx_timer_collect_expired(w, next, wakers, ASX_MAX_TIMERS);
+        for (i = 0; i < n; i++) {
+            if ((uintptr_t)wakers[i] <= last) (*out_misordered)++;
+            last = (uintptr_t)wakers[i];
+        }
+        *out_fired += n;
+        wakeups++;
+    }
+    return wakeups;
+}
+
+TEST(timer_slack_coalesces_into_batches) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle h;
+    uint32_t fired, misordered, exact, batched;
+    uint32_t i;
+
+    /* 100 timers spread 10ms apart across one second */
+    asx_timer_wheel_reset(w);
+    for (i = 0; i < 100u; i++) {
+        ASSERT_EQ(asx_timer_register(w, (asx_time)(i + 1u) * 10000000u,
+                                     (void *)(uintptr_t)(i + 1u), &h), ASX_OK);
+    }
+    exact = drain_in_batches(w, &fired, &misordered);
+    ASSERT_EQ(exact, (uint32_t)100);
+    ASSERT_EQ(fired, (uint32_t)100);
+
+    /* 100ms of slack: each wakeup takes the next ten or so */
+    asx_timer_wheel_reset(w);
+    for (i = 0; i < 100u; i++) {
+        ASSERT_EQ(asx_timer_register_slack(w, (asx_time)(i + 1u) * 10000000u,
+                                           100000000u,
+                                           (void *)(uintptr_t)(i + 1u), &h),
+                  ASX_OK);
+    }
+    batched = drain_in_batches(w, &fired, &misordered);
+    ASSERT_EQ(fired, (uint32_t)100);
+    ASSERT_EQ(misordered, (uint32_t)0);
+    ASSERT_TRUE(batched <= 10u);
+    ASSERT_EQ(asx_timer_active_count(w), (uint32_t)0);
+}
+
+/* -------------------------------------------------------------------
+ * Test: batch fires in (deadline, insertion) order, never early
+ * ------------------------------------------------------------------- */
+
+TEST(timer_slack_batch_keeps_order) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle h;
+    void *wakers[8];
+    asx_time next;
+    uint32_t count;
+
+    asx_timer_wheel_reset(w);
+    /* The exact timer at 150 bounds the batch; 300 stays behind */
+    ASSERT_EQ(asx_timer_register_slack(w, 120, 500, (void *)3, &h), ASX_OK);
+    ASSERT_EQ(asx_timer_register_slack(w, 100, 500, (void *)1, &h), ASX_OK);
+    ASSERT_EQ(asx_timer_register(w, 150, (void *)4, &h), ASX_OK);
+    ASSERT_EQ(asx_timer_register_slack(w, 120, 0, (void *)2, &h), ASX_OK);
+    ASSERT_EQ(asx_timer_register_slack(w, 300, 10, (void *)5, &h), ASX_OK);
+
+    ASSERT_EQ(asx_timer_next_expiry(w, &next), 1);
+    ASSERT_EQ(next, (asx_time)120);
+    count = asx_timer_collect_expired(w, next, wakers, 8);
+    ASSERT_EQ(count, (uint32_t)3);
+    ASSERT_EQ(wakers[0], (void *)1);
+    ASSERT_EQ(wakers[1], (void *)3);
+    ASSERT_EQ(wakers[2], (void *)2);
+
+    ASSERT_EQ(asx_timer_next_expiry(w, &next), 1);
+    ASSERT_EQ(next, (asx_time)150);
+    count = asx_timer_collect_expired(w, next, wakers, 8);
+    ASSERT_EQ(count, (uint32_t)1);
+    ASSERT_EQ(asx_timer_next_expiry(w, &next), 1);
+    ASSERT_EQ(next, (asx_time)310);
+}
+
+/* -------------------------------------------------------------------
+ * Test: reactor wait timeout follows the next batch
+ * ------------------------------------------------------------------- */
+
+TEST(timer_wait_ms_tracks_next_batch) {
+    asx_timer_wheel *w = asx_timer_wheel_global();
+    asx_timer_handle h;
+    asx_time next;
+
+    asx_timer_wheel_reset(w);
+    ASSERT_EQ(asx_timer_next_expiry(w, &next), 0);
+    ASSERT_EQ(asx_timer_wait_ms(w, 0, 50), (uint32_t)50);
+
+    ASSERT_EQ(asx_timer_register_slack(w, 2000000u, 1500000u, NULL, &h),
+              ASX_OK);
+    ASSERT_EQ(asx_timer_wait_ms(w, 0, 50), (uint32_t)4);
+    ASSERT_EQ(asx_timer_wait_ms(w, 0, 2), (uint32_t)2);
+    ASSERT_EQ(asx_timer_wait_ms(w, 3500000u, 50), (uint32_t)0);
+
+    /* Slack saturates instead of wrapping */
+    asx_timer_wheel_reset(w);
+    asx_timer_advance(w, UINT64_MAX - 10u);
+    ASSERT_EQ(asx_timer_register_slack(w, UINT64_MAX - 5u, 100, NULL, &h),
+              ASX_OK);
+    ASSERT_EQ(asx_timer_next_expiry(w, &next), 1);
+    ASSERT_EQ(next, (asx_time)UINT64_MAX);
+}
+
 /* -------------------------------------------------------------------
  * Main
  * ------------------------------------------------------------------- */
@@ -543,6 +666,9 @@ int main(void) {
     RUN_TEST(timer_double_cancel_returns_false);
     RUN_TEST(timer_cancellation_race);
     RUN_TEST(timer_large_time_jump);
+    RUN_TEST(timer_slack_coalesces_into_batches);
+    RUN_TEST(timer_slack_batch_keeps_order);
+    RUN_TEST(timer_wait_ms_tracks_next_batch);
 
     TEST_REPORT();
     return test_failures;
@@ -0,0 +1,199 @@
+/*
+ * test_tsc_clock.c — calibrated cycle-counter clock
+ *
+ * Tests calibration and conversion against a simulated 3 GHz counter,
+ * drift correction on resync, the monotonic clamp, fallback for
+ * non-invariant sources, the clock hook, and (POSIX profile) the
+ * platform source against CLOCK_MONOTONIC.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../../test_harness.h"
+#include <asx/asx.h>
+#include <asx/time/tsc_clock.h>
+
+/* Simulated hardware: the reference advances ref_step ns per read and
+ * the counter runs at cycles_per_us relative to it. */
+typedef struct {
+    uint64_t ref_ns;
+    uint64_t ref_step;
+    uint64_t cycles_per_us;
+    uint64_t skew_cycles;   /* added to every counter read */
+    uint32_t ref_reads;
+} fake_hw;
+
+static asx_time fake_ref(void *ctx) {
+    fake_hw *hw = (fake_hw *)ctx;
+
+    hw->ref_ns += hw->ref_step;
+    hw->ref_reads++;
+    return hw->ref_ns;
+}
+
+static uint64_t fake_counter(void *ctx) {
+    fake_hw *hw = (fake_hw *)ctx;
+
+    return hw->ref_ns * hw->cycles_per_us / 1000u + hw->skew_cycles;
+}
+
+static void fake_source(fake_hw *hw, asx_tsc_source *src, int invariant) {
+    hw->ref_ns = 1000000u;
+    hw->ref_step = 1000u;
+    hw->cycles_per_us = 3000u;
+    hw->skew_cycles = 0;
+    hw->ref_reads = 0;
+    src->ctx = hw;
+    src->read_counter = fake_counter;
+    src->read_ref = fake_ref;
+    src->invariant = invariant;
+}
+
+static uint64_t abs_diff(uint64_t a, uint64_t b) {
+    return a > b ? a - b : b - a;
+}
+
+TEST(tsc_calibrates_and_converts) {
+    fake_hw hw;
+    asx_tsc_source src;
+    asx_tsc_clock clk;
+    uint32_t reads;
+    asx_time t;
+
+    fake_source(&hw, &src, 1);
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 1000000u, 500000000u), ASX_OK);
+    ASSERT_EQ(asx_tsc_clock_is_fallback(&clk), 0);
+
+    /* Reads between resyncs touch only the counter */
+    reads = hw.ref_reads;
+    hw.ref_ns += 250000u;           /* 250 us pass */
+    t = asx_tsc_clock_now(&clk);
+    ASSERT_EQ(hw.ref_reads, reads);
+    ASSERT_TRUE(abs_diff(t, hw.ref_ns) <= 2u);
+}
+
+TEST(tsc_resync_corrects_drift) {
+    fake_hw hw;
+    asx_tsc_source src;
+    asx_tsc_clock clk;
+    asx_time t;
+
+    fake_source(&hw, &src, 1);
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 1000000u, 10000000u), ASX_OK);
+
+    /* The counter slows by 1%: conversion falls behind until resync */
+    hw.skew_cycles = fake_counter(&hw) / 100u;
+    hw.cycles_per_us = 2970u;
+    hw.ref_ns += 5000000u;
+    t = asx_tsc_clock_now(&clk);
+    ASSERT_TRUE(t < hw.ref_ns);
+    ASSERT_EQ(clk.resyncs, (uint32_t)0);
+
+    /* Past the interval: one reference read rebases and re-rates */
+    hw.ref_ns += 10000000u;
+    t = asx_tsc_clock_now(&clk);
+    ASSERT_EQ(clk.resyncs, (uint32_t)1);
+    ASSERT_EQ(t, hw.ref_ns);
+    hw.ref_ns += 1000000u;
+    t = asx_tsc_clock_now(&clk);
+    /* within one simulated reference read of the truth */
+    ASSERT_TRUE(abs_diff(t, hw.ref_ns) <= 2u * hw.ref_step);
+}
+
+TEST(tsc_never_goes_backwards) {
+    fake_hw hw;
+    asx_tsc_source src;
+    asx_tsc_clock clk;
+    asx_time t0, t1;
+
+    fake_source(&hw, &src, 1);
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 1000000u, 10000000u), ASX_OK);
+    hw.ref_ns += 9000000u;
+    t0 = asx_tsc_clock_now(&clk);
+
+    /* Reference jumps back relative to the counter at resync */
+    hw.ref_step = 0;
+    hw.ref_ns -= 500000u;
+    hw.skew_cycles = 30000000u;
+    t1 = asx_tsc_clock_now(&clk);
+    ASSERT_EQ(clk.resyncs, (uint32_t)1);
+    ASSERT_TRUE(t1 >= t0);
+}
+
+TEST(tsc_non_invariant_falls_back) {
+    fake_hw hw;
+    asx_tsc_source src;
+    asx_tsc_clock clk;
+    asx_time t;
+
+    fake_source(&hw, &src, 0);
+    src.read_counter = NULL;
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 0, 0), ASX_OK);
+    ASSERT_EQ(asx_tsc_clock_is_fallback(&clk), 1);
+    t = asx_tsc_clock_now(&clk);
+    ASSERT_EQ(t, hw.ref_ns);
+
+    /* A counter that does not advance is no better */
+    fake_source(&hw, &src, 1);
+    hw.cycles_per_us = 0;
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 1000000u, 0), ASX_OK);
+    ASSERT_EQ(asx_tsc_clock_is_fallback(&clk), 1);
+
+    ASSERT_EQ(asx_tsc_clock_init(NULL, &src, 0, 0), ASX_E_INVALID_ARGUMENT);
+    src.read_counter = NULL;
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 0, 0), ASX_E_INVALID_ARGUMENT);
+}
+
+TEST(tsc_installs_as_clock_hook) {
+    fake_hw hw;
+    asx_tsc_source src;
+    asx_tsc_clock clk;
+    asx_runtime_hooks hooks;
+    asx_time t;
+
+    fake_source(&hw, &src, 1);
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 1000000u, 0), ASX_OK);
+    ASSERT_EQ(asx_runtime_hooks_init(&hooks), ASX_OK);
+    asx_tsc_clock_hooks(&clk, &hooks.clock);
+    ASSERT_TRUE(hooks.clock.ctx == &clk);
+    ASSERT_TRUE(hooks.clock.logical_now_ns_fn != NULL);
+    hw.ref_ns += 1000u;
+    t = hooks.clock.now_ns_fn(hooks.clock.ctx);
+    ASSERT_TRUE(abs_diff(t, hw.ref_ns) <= 2u);
+}
+
+#if defined(ASX_PROFILE_POSIX)
+TEST(tsc_posix_source_tracks_monotonic) {
+    asx_tsc_source src;
+    asx_tsc_clock clk;
+    asx_time a, b, ref;
+    uint32_t i;
+
+    ASSERT_EQ(asx_posix_tsc_source(&src), ASX_OK);
+    ASSERT_EQ(asx_tsc_clock_init(&clk, &src, 2000000u, 0), ASX_OK);
+    a = asx_tsc_clock_now(&clk);
+    for (i = 0; i < 1000u; i++) {
+        b = asx_tsc_clock_now(&clk);
+        ASSERT_TRUE(b >= a);
+        a = b;
+    }
+    ref = src.read_ref(src.ctx);
+    ASSERT_TRUE(abs_diff(asx_tsc_clock_now(&clk), ref) < 1000000u);
+}
+#endif
+
+int main(void) {
+    fprintf(stderr, "=== test_tsc_clock ===\n");
+
+    RUN_TEST(tsc_calibrates_and_converts);
+    RUN_TEST(tsc_resync_corrects_drift);
+    RUN_TEST(tsc_never_goes_backwards);
+    RUN_TEST(tsc_non_invariant_falls_back);
+    RUN_TEST(tsc_installs_as_clock_hook);
+#if defined(ASX_PROFILE_POSIX)
+    RUN_TEST(tsc_posix_source_tracks_monotonic);
+#endif
+
+    TEST_REPORT();
+    return test_failures;
+}